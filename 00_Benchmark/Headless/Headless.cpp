@@ -0,0 +1,260 @@
+#include "Simplex/Simplex.h"
+#include "FreeImage/FreeImage.h"
+using namespace Simplex;
+
+//Definitions of the framework the portable build links instead of the Simplex DLL. There is no window
+//or context: nothing is drawn, no texture is decoded and no file is read through the model, the OBJ
+//files still come through the cooker. The benchmark only walks the entities, so none of this runs
+
+//  OpenGL
+//the entry points past OpenGL 1.1 are pointers GLEW fills in once there is a context, there is none
+#define HEADLESS_GL(TYPE, NAME) TYPE __glew##NAME = nullptr;
+HEADLESS_GL(PFNGLATTACHSHADERPROC, AttachShader)
+HEADLESS_GL(PFNGLBEGINQUERYPROC, BeginQuery)
+HEADLESS_GL(PFNGLBINDBUFFERPROC, BindBuffer)
+HEADLESS_GL(PFNGLBINDVERTEXARRAYPROC, BindVertexArray)
+HEADLESS_GL(PFNGLBUFFERDATAPROC, BufferData)
+HEADLESS_GL(PFNGLBUFFERSUBDATAPROC, BufferSubData)
+HEADLESS_GL(PFNGLCOMPILESHADERPROC, CompileShader)
+HEADLESS_GL(PFNGLCOMPRESSEDTEXIMAGE2DPROC, CompressedTexImage2D)
+HEADLESS_GL(PFNGLCREATEPROGRAMPROC, CreateProgram)
+HEADLESS_GL(PFNGLCREATESHADERPROC, CreateShader)
+HEADLESS_GL(PFNGLDELETEBUFFERSPROC, DeleteBuffers)
+HEADLESS_GL(PFNGLDELETEPROGRAMPROC, DeleteProgram)
+HEADLESS_GL(PFNGLDELETEQUERIESPROC, DeleteQueries)
+HEADLESS_GL(PFNGLDELETESHADERPROC, DeleteShader)
+HEADLESS_GL(PFNGLDELETEVERTEXARRAYSPROC, DeleteVertexArrays)
+HEADLESS_GL(PFNGLDETACHSHADERPROC, DetachShader)
+HEADLESS_GL(PFNGLENABLEVERTEXATTRIBARRAYPROC, EnableVertexAttribArray)
+HEADLESS_GL(PFNGLENDQUERYPROC, EndQuery)
+HEADLESS_GL(PFNGLGENBUFFERSPROC, GenBuffers)
+HEADLESS_GL(PFNGLGENQUERIESPROC, GenQueries)
+HEADLESS_GL(PFNGLGENVERTEXARRAYSPROC, GenVertexArrays)
+HEADLESS_GL(PFNGLGENERATEMIPMAPPROC, GenerateMipmap)
+HEADLESS_GL(PFNGLGETATTRIBLOCATIONPROC, GetAttribLocation)
+HEADLESS_GL(PFNGLGETPROGRAMBINARYPROC, GetProgramBinary)
+HEADLESS_GL(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog)
+HEADLESS_GL(PFNGLGETPROGRAMIVPROC, GetProgramiv)
+HEADLESS_GL(PFNGLGETQUERYOBJECTUIVPROC, GetQueryObjectuiv)
+HEADLESS_GL(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog)
+HEADLESS_GL(PFNGLGETSHADERIVPROC, GetShaderiv)
+HEADLESS_GL(PFNGLGETSTRINGIPROC, GetStringi)
+HEADLESS_GL(PFNGLGETUNIFORMLOCATIONPROC, GetUniformLocation)
+HEADLESS_GL(PFNGLLINKPROGRAMPROC, LinkProgram)
+HEADLESS_GL(PFNGLMAPBUFFERRANGEPROC, MapBufferRange)
+HEADLESS_GL(PFNGLPROGRAMBINARYPROC, ProgramBinary)
+HEADLESS_GL(PFNGLPROGRAMPARAMETERIPROC, ProgramParameteri)
+HEADLESS_GL(PFNGLSHADERSOURCEPROC, ShaderSource)
+HEADLESS_GL(PFNGLUNIFORM3FVPROC, Uniform3fv)
+HEADLESS_GL(PFNGLUNIFORMMATRIX4FVPROC, UniformMatrix4fv)
+HEADLESS_GL(PFNGLUNMAPBUFFERPROC, UnmapBuffer)
+HEADLESS_GL(PFNGLUSEPROGRAMPROC, UseProgram)
+HEADLESS_GL(PFNGLVERTEXATTRIBPOINTERPROC, VertexAttribPointer)
+#undef HEADLESS_GL
+
+//  FreeImage
+//every image is of an unknown format, the texture cooker gives up on it before it is loaded
+FREE_IMAGE_FORMAT DLL_CALLCONV FreeImage_GetFileType(const char* filename, int size) { return FIF_UNKNOWN; }
+FREE_IMAGE_FORMAT DLL_CALLCONV FreeImage_GetFIFFromFilename(const char* filename) { return FIF_UNKNOWN; }
+BOOL DLL_CALLCONV FreeImage_FIFSupportsReading(FREE_IMAGE_FORMAT fif) { return FALSE; }
+FIBITMAP* DLL_CALLCONV FreeImage_Load(FREE_IMAGE_FORMAT fif, const char* filename, int flags) { return nullptr; }
+FIBITMAP* DLL_CALLCONV FreeImage_ConvertTo32Bits(FIBITMAP* dib) { return nullptr; }
+void DLL_CALLCONV FreeImage_Unload(FIBITMAP* dib) { }
+BYTE* DLL_CALLCONV FreeImage_GetBits(FIBITMAP* dib) { return nullptr; }
+unsigned DLL_CALLCONV FreeImage_GetWidth(FIBITMAP* dib) { return 0; }
+unsigned DLL_CALLCONV FreeImage_GetHeight(FIBITMAP* dib) { return 0; }
+unsigned DLL_CALLCONV FreeImage_GetPitch(FIBITMAP* dib) { return 0; }
+
+//  Folder
+Folder* Folder::m_pInstance = nullptr;
+Folder* Folder::GetInstance(void)
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new Folder();
+	}
+	return m_pInstance;
+}
+String Folder::GetFolderData(void) { return ""; }
+String Folder::GetFolderMOBJ(void) { return ""; }
+String Folder::GetFolderTextures(void) { return ""; }
+String Folder::GetFolderShaders(void) { return ""; }
+
+//  Frame
+Frame::Frame(void) { }
+Frame::Frame(vector3 a_v3Position, vector3 a_v3Angle, vector3 a_v3Size, bool a_bVisible, bool a_bKeyframe)
+{
+	m_v3Position = a_v3Position;
+	m_v3Angle = a_v3Angle;
+	m_v3Size = a_v3Size;
+	m_bVisible = a_bVisible;
+	m_bKeyframe = a_bKeyframe;
+}
+vector3 Frame::GetPos(void) { return m_v3Position; }
+vector3 Frame::GetAng(void) { return m_v3Angle; }
+vector3 Frame::GetSize(void) { return m_v3Size; }
+bool Frame::IsVisible(void) { return m_bVisible; }
+bool Frame::IsKeyframe(void) { return m_bKeyframe; }
+
+//  Material
+void Material::SetDiffuseMapName(String a_sFileName) { m_sDiffuse = a_sFileName; }
+void Material::SetDiffuseMapID(GLuint a_uID) { }
+void Material::SetNormalMapName(String a_sFileName) { m_sNormal = a_sFileName; }
+void Material::SetNormalMapID(GLuint a_uID) { }
+void Material::SetSpecularMapName(String a_sFileName) { m_sSpecular = a_sFileName; }
+void Material::SetSpecularMapID(GLuint a_uID) { }
+
+//  MaterialManager
+MaterialManager* MaterialManager::m_pInstance = nullptr;
+MaterialManager* MaterialManager::GetInstance(void)
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MaterialManager();
+	}
+	return m_pInstance;
+}
+int MaterialManager::IdentifyMaterial(String a_sName)
+{
+	for (uint i = 0; i < m_lName.size(); ++i)
+	{
+		if (m_lName[i] == a_sName)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+int MaterialManager::AddMaterial(String a_sName)
+{
+	int nIndex = IdentifyMaterial(a_sName);
+	if (nIndex >= 0)
+		return nIndex;
+	m_lName.push_back(a_sName);
+	m_lMaterial.push_back(Material());
+	return static_cast<int>(m_lName.size()) - 1;
+}
+Material* MaterialManager::GetMaterial(uint a_nIndex)
+{
+	if (a_nIndex >= m_lMaterial.size())
+		return nullptr;
+	return &m_lMaterial[a_nIndex];
+}
+
+//  Mesh
+Mesh::Mesh(void) { }
+Mesh::~Mesh(void) { }
+void Mesh::CompileOpenGL3X(void) { }
+void Mesh::SetMaterial(int a_nMaterialIndex) { }
+void Mesh::SetMaterial(String a_sMaterialName, String a_sDiffuseMapName, String a_sNormalMapName, String a_sSpecularName) { }
+void Mesh::SetVertexList(std::vector<vector3> a_lVertex) { m_uVertexCount = static_cast<uint>(a_lVertex.size()); }
+void Mesh::SetColorList(std::vector<vector3> a_lColor) { }
+void Mesh::SetUVList(std::vector<vector3> a_lUV) { }
+void Mesh::SetNormalList(std::vector<vector3> a_lNormal) { }
+void Mesh::SetName(String a_sName) { m_sName = a_sName; }
+
+//  MeshManager
+MeshManager* MeshManager::m_pInstance = nullptr;
+MeshManager* MeshManager::GetInstance(void)
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MeshManager();
+	}
+	return m_pInstance;
+}
+int MeshManager::AddMesh(Mesh* a_pMesh)
+{
+	m_lMesh.push_back(a_pMesh);
+	return static_cast<int>(m_lMesh.size()) - 1;
+}
+
+//  Group
+Group::Group(void) { GenerateFrames(1); }
+Group::~Group(void) { }
+void Group::SetName(String a_sName) { m_sName = a_sName; }
+String Group::GetName(void) { return m_sName; }
+void Group::AddMesh(Mesh* a_pMesh, MeshOptions a_otions) { m_lMesh.push_back(a_pMesh); }
+void Group::ComputeTransforms(void)
+{
+	for (uint i = 0; i < m_lFrame.size(); ++i)
+	{
+		Frame& frame = m_lFrame[i];
+		m_lModelMatrix[i] = glm::translate(frame.GetPos()) * ToMatrix4(quaternion(glm::radians(frame.GetAng()))) *
+			glm::scale(frame.GetSize());
+	}
+}
+void Group::SetFrame(uint a_nFrame, vector3 a_v3Translation, vector3 a_v3Rotation, vector3 a_v3Scale, bool a_bVisible, bool a_bKeyframe)
+{
+	if (a_nFrame >= m_lFrame.size())
+		return;
+	m_lFrame[a_nFrame] = Frame(a_v3Translation, a_v3Rotation, a_v3Scale, a_bVisible, a_bKeyframe);
+}
+uint Group::GetFrameCount(void) { return static_cast<uint>(m_lFrame.size()); }
+Frame Group::GetFrame(uint a_nFrame)
+{
+	if (a_nFrame >= m_lFrame.size())
+		return Frame();
+	return m_lFrame[a_nFrame];
+}
+Group* Group::GetParent(void) { return m_pParent; }
+vector3 Group::GetPivot(void) { return m_v3Pivot; }
+void Group::GenerateFrames(int a_nFrames)
+{
+	uint uFrames = static_cast<uint>(std::max(a_nFrames, 1));
+	m_lFrame.assign(uFrames, Frame());
+	m_lModelMatrix.assign(uFrames, IDENTITY_M4);
+}
+matrix4 Group::GetModelMatrix(uint a_uFrame)
+{
+	if (a_uFrame >= m_lModelMatrix.size())
+		return IDENTITY_M4;
+	return m_lModelMatrix[a_uFrame];
+}
+void Group::SetModelMatrix(matrix4 a_m4Transform, uint a_uFrame)
+{
+	if (a_uFrame < m_lModelMatrix.size())
+		m_lModelMatrix[a_uFrame] = a_m4Transform;
+}
+
+//  Model
+Model::Model(void) { }
+Model::~Model(void)
+{
+	for (uint i = 0; i < m_lGroup.size(); ++i)
+		SafeDelete(m_lGroup[i]);
+	m_lGroup.clear();
+}
+void Model::AddGroup(Group* a_pGroup) { m_lGroup.push_back(a_pGroup); }
+void Model::AddToRenderList(uint a_nFrame) { }
+void Model::SetModelMatrix(matrix4 a_mToWorld) { }
+String Model::Load(String a_sFileName) { return ""; }
+Group* Model::GetGroup(String a_sGroupName)
+{
+	for (uint i = 0; i < m_lGroup.size(); ++i)
+	{
+		if (m_lGroup[i]->GetName() == a_sGroupName)
+			return m_lGroup[i];
+	}
+	return nullptr;
+}
+String Model::SetName(String a_sDesiredName, bool bForce)
+{
+	m_sName = a_sDesiredName;
+	return m_sName;
+}
+String Model::GetName(void) { return m_sName; }
+std::vector<vector3> Model::GetVertexList(uint a_nFrame) { return std::vector<vector3>(); }
+
+//  CameraManager
+CameraManager* CameraManager::m_pInstance = nullptr;
+CameraManager* CameraManager::GetInstance(void)
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new CameraManager();
+	}
+	return m_pInstance;
+}
+std::pair<vector3, vector3> CameraManager::GetClickAndDirectionOnWorldSpace(uint a_nMouseX, uint a_nMouseY, int a_nIndex)
+{
+	return std::pair<vector3, vector3>(ZERO_V3, -AXIS_Z);
+}
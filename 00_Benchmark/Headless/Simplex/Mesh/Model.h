@@ -0,0 +1,11 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __HEADLESS_MODEL_H_
+#define __HEADLESS_MODEL_H_
+
+//the portable build declares every class of the framework it uses in one header
+#include "Simplex/Simplex.h"
+
+#endif //__HEADLESS_MODEL_H_
@@ -0,0 +1,294 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __SIMPLEXFRAMEWORK_H_
+#define __SIMPLEXFRAMEWORK_H_
+
+//Stand-in for the Simplex headers in the portable build of the benchmark. The framework pulls in
+//Windows.h and its classes live in a DLL, here only the part of them the sandbox sources name is
+//declared; Headless.cpp defines it without a window, a context or files behind it
+
+#define GLEW_STATIC
+#define GLEW_NO_GLU
+#include <GL/glew.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <map>
+#include <set>
+#include <deque>
+#include <cstring>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/ext.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
+
+#define SimplexDLL
+#define EXPIMP_TEMPLATE extern
+
+namespace Simplex
+{
+	typedef unsigned int uint;
+	typedef std::string String;
+	typedef glm::vec2 vector2;
+	typedef glm::vec3 vector3;
+	typedef glm::vec4 vector4;
+	typedef glm::mat3 matrix3;
+	typedef glm::mat4 matrix4;
+	typedef glm::quat quaternion;
+
+#define SafeDelete(p){ if(p) { delete p; p = nullptr; } }
+
+#define PI 3.14159265358979323846
+#define IDENTITY_M4 matrix4(1.0f)
+
+#define ZERO_V3 vector3(0.0f, 0.0f, 0.0f)
+
+#define C_BLACK vector3(0.0f, 0.0f, 0.0f)
+#define C_WHITE vector3(1.0f, 1.0f, 1.0f)
+#define C_GRAY vector3(0.3f, 0.3f, 0.3f)
+
+#define C_RED vector3(1.0f, 0.0f, 0.0f)
+#define C_MAGENTA vector3(1.0f, 0.0f, 1.0f)
+#define C_BROWN vector3(0.6f,0.3f,0.0f)
+
+#define C_GREEN vector3(0.0f, 1.0f, 0.0f)
+#define C_GREEN_DARK vector3(0.0f, 5.0f, 0.0f)
+#define C_GREEN_LIME vector3(0.33f,0.90f,0.33f)
+
+#define C_BLUE vector3(0.0f, 0.0f, 1.0f)
+#define C_BLUE_CORNFLOWER vector3(0.4f, 0.6f, 0.9f)
+#define C_CYAN vector3(0.0f,1.0f,1.0f)
+
+#define C_INDIGO vector3(0.30f, 0.0f, 0.52)
+
+#define C_YELLOW vector3(1.0f, 1.0f, 0.0f)
+#define C_ORANGE vector3(1.0f,0.5f,0.0f)
+#define C_VIOLET vector3(0.54f,0.16f,0.88f)
+#define C_PURPLE vector3(0.50f,0.0f,0.50f)
+
+#define AXIS_X vector3(1.0f, 0.0f, 0.0f)
+#define AXIS_XY vector3(1.0f, 1.0f, 0.0f)
+#define AXIS_XZ vector3(1.0f, 0.0f, 1.0f)
+#define AXIS_Y vector3(0.0f, 1.0f, 0.0f)
+#define AXIS_YZ vector3(0.0f, 1.0f, 1.0f)
+#define AXIS_Z vector3(0.0f, 0.0f, 1.0f)
+
+enum BTO_OUTPUT
+{
+	OUT_ERR_NONE,
+	OUT_ERR_GENERAL,
+	OUT_ERR_FILE_MISSING,
+	OUT_ERR_CONTEXT,
+	OUT_ERR_MEMORY,
+	OUT_ERR_NAME,
+	OUT_ERR_NOT_INITIALIZED,
+	OUT_ERR_FILE,
+	OUT_ERR_NO_EXTENSION,
+	OUT_DONE,
+	OUT_RUNNING,
+};
+enum BTO_RENDER
+{
+	RENDER_NONE = 0,
+	RENDER_SOLID = 1,
+	RENDER_WIRE = 2,
+};
+enum eSATResults
+{
+	SAT_NONE = 0,
+
+	SAT_AX,
+	SAT_AY,
+	SAT_AZ,
+
+	SAT_BX,
+	SAT_BY,
+	SAT_BZ,
+
+	SAT_AXxBX,
+	SAT_AXxBY,
+	SAT_AXxBZ,
+
+	SAT_AYxBX,
+	SAT_AYxBY,
+	SAT_AYxBZ,
+
+	SAT_AZxBX,
+	SAT_AZxBY,
+	SAT_AZxBZ,
+};
+
+struct MeshOptions
+{
+	matrix4 m_m4Transform;
+	int m_nRender;
+	MeshOptions():m_m4Transform(IDENTITY_M4), m_nRender(RENDER_SOLID) {};
+	MeshOptions(matrix4 a_m4Transform, int a_nRender):m_m4Transform(a_m4Transform), m_nRender(a_nRender){};
+};
+
+/*
+USAGE: Will take a glm::quat and return a glm::mat4 wrapping glm::mat4_cast
+ARGUMENTS: quaternion a_qInput -> quaternion to translate from
+OUTPUT: matrix4 conversion of a_qInput
+*/
+static matrix4 ToMatrix4(quaternion a_qInput)
+{
+	return glm::mat4_cast(a_qInput);
+}
+
+//Working directories, all of them are the one the benchmark runs from
+class Folder
+{
+	static Folder* m_pInstance;
+public:
+	static Folder* GetInstance(void);
+	String GetFolderData(void);
+	String GetFolderMOBJ(void);
+	String GetFolderTextures(void);
+	String GetFolderShaders(void);
+};
+
+//Transformation of a group in a frame of its animation
+class Frame
+{
+	vector3 m_v3Position = ZERO_V3;
+	vector3 m_v3Angle = ZERO_V3;
+	vector3 m_v3Size = vector3(1.0f);
+	bool m_bVisible = true;
+	bool m_bKeyframe = false;
+public:
+	Frame(void);
+	Frame(vector3 a_v3Position, vector3 a_v3Angle, vector3 a_v3Size, bool a_bVisible, bool a_bKeyframe);
+	vector3 GetPos(void);
+	vector3 GetAng(void);
+	vector3 GetSize(void);
+	bool IsVisible(void);
+	bool IsKeyframe(void);
+};
+
+//Material of a mesh, it keeps the names of its maps and no textures
+class Material
+{
+	String m_sDiffuse = "";
+	String m_sNormal = "";
+	String m_sSpecular = "";
+public:
+	void SetDiffuseMapName(String a_sFileName);
+	void SetDiffuseMapID(GLuint a_uID);
+	void SetNormalMapName(String a_sFileName);
+	void SetNormalMapID(GLuint a_uID);
+	void SetSpecularMapName(String a_sFileName);
+	void SetSpecularMapID(GLuint a_uID);
+};
+
+//Materials by name
+class MaterialManager
+{
+	std::vector<Material> m_lMaterial;
+	std::vector<String> m_lName;
+	static MaterialManager* m_pInstance;
+public:
+	static MaterialManager* GetInstance(void);
+	int IdentifyMaterial(String a_sName);
+	int AddMaterial(String a_sName);
+	Material* GetMaterial(uint a_nIndex);
+};
+
+//Mesh, it is never compiled into buffers
+class Mesh
+{
+	String m_sName = "";
+	uint m_uVertexCount = 0;
+public:
+	Mesh(void);
+	virtual ~Mesh(void);
+	void CompileOpenGL3X(void);
+	void SetMaterial(int a_nMaterialIndex);
+	void SetMaterial(String a_sMaterialName, String a_sDiffuseMapName, String a_sNormalMapName = "", String a_sSpecularName = "");
+	void SetVertexList(std::vector<vector3> a_lVertex);
+	void SetColorList(std::vector<vector3> a_lColor);
+	void SetUVList(std::vector<vector3> a_lUV);
+	void SetNormalList(std::vector<vector3> a_lNormal);
+	virtual void SetName(String a_sName);
+};
+
+//Meshes of the framework, they are owned here
+class MeshManager
+{
+	std::vector<Mesh*> m_lMesh;
+	static MeshManager* m_pInstance;
+public:
+	static MeshManager* GetInstance(void);
+	int AddMesh(Mesh* a_pMesh);
+};
+
+//Group of meshes with its frames
+class Group
+{
+	String m_sName = "";
+	Group* m_pParent = nullptr;
+	vector3 m_v3Pivot = ZERO_V3;
+	std::vector<Frame> m_lFrame;
+	std::vector<matrix4> m_lModelMatrix;
+	std::vector<Mesh*> m_lMesh;
+public:
+	Group(void);
+	~Group(void);
+	void SetName(String a_sName);
+	String GetName(void);
+	void AddMesh(Mesh* a_pMesh, MeshOptions a_otions = MeshOptions());
+	void ComputeTransforms(void);
+	void SetFrame(uint a_nFrame, vector3 a_v3Translation, vector3 a_v3Rotation, vector3 a_v3Scale, bool a_bVisible, bool a_bKeyframe);
+	uint GetFrameCount(void);
+	Frame GetFrame(uint a_nFrame);
+	Group* GetParent(void);
+	vector3 GetPivot(void);
+	void GenerateFrames(int a_nFrames);
+	matrix4 GetModelMatrix(uint a_uFrame);
+	void SetModelMatrix(matrix4 a_m4Transform, uint a_uFrame);
+};
+
+//Model made of groups, nothing is drawn and no file is read through it
+class Model
+{
+	String m_sName = "";
+	std::vector<Group*> m_lGroup;
+public:
+	Model(void);
+	~Model(void);
+	void AddGroup(Group* a_pGroup);
+	void AddToRenderList(uint a_nFrame = 0);
+	void SetModelMatrix(matrix4 a_mToWorld);
+	String Load(String a_sFileName);
+	Group* GetGroup(String a_sGroupName);
+	String SetName(String a_sDesiredName, bool bForce = false);
+	String GetName(void);
+	std::vector<vector3> GetVertexList(uint a_nFrame = 0);
+};
+
+//Camera of the application, there is none so no click reaches the world
+class CameraManager
+{
+	static CameraManager* m_pInstance;
+public:
+	static CameraManager* GetInstance(void);
+	std::pair<vector3, vector3> GetClickAndDirectionOnWorldSpace(uint a_nMouseX, uint a_nMouseY, int a_nIndex = -1);
+};
+
+} //namespace Simplex
+
+#endif //__SIMPLEXFRAMEWORK_H_
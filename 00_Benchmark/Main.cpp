@@ -0,0 +1,80 @@
+// Include standard headers
+#include "Main.h"
+
+/*
+Runs the collision and physics code of 00_Sandbox without a window and prints the results as JSON
+	--entities N	number of cubes (1849)
+	--radius R		radius of the spawn sphere (34)
+	--frames F		number of frames to run (300)
+	--moving		use the physics solver so the cubes move
+	--continuous	sweep the moving cubes so they do not cross each other
+	--iterations I	impulse iterations per frame, 0 separates the cubes with forces (8)
+	--octree L		levels of the octree, 0 tests all pairs (0)
+	--ideal C		ideal number of entities per octant (5)
+	--loose F		scale of the octant bounds, above 1 each cube is stored once and relinked as it moves (1)
+	--tune			search the levels and ideal entities per octant while running, from --octree and --ideal
+	--seed S		seed of the spawn positions (0)
+	--queries Q		box, sphere and nearest neighbor queries against the octree and brute force, needs --octree (0)
+	--query-radius R	radius of the sphere queries and half size of the box queries (4)
+	--nearest K		entities wanted by the nearest neighbor queries (8)
+	--out FILE		also write the JSON to FILE
+*/
+int main(int argc, char* argv[])
+{
+	using namespace Simplex;
+	MyBenchmarkConfig config;
+	String sOutput = "";
+	for (int i = 1; i < argc; ++i)
+	{
+		String sArgument = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (sArgument == "--moving")
+			config.m_bMoving = true;
+		else if (sArgument == "--continuous")
+			config.m_bContinuous = true;
+		else if (sArgument == "--entities" && bHasValue)
+			config.m_uEntityCount = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--radius" && bHasValue)
+			config.m_fRadius = static_cast<float>(std::atof(argv[++i]));
+		else if (sArgument == "--frames" && bHasValue)
+			config.m_uFrameCount = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--iterations" && bHasValue)
+			config.m_uContactIterations = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--octree" && bHasValue)
+			config.m_uOctreeLevels = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--ideal" && bHasValue)
+			config.m_uIdealEntityCount = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--loose" && bHasValue)
+			config.m_fLooseness = static_cast<float>(std::atof(argv[++i]));
+		else if (sArgument == "--tune")
+			config.m_bTune = true;
+		else if (sArgument == "--seed" && bHasValue)
+			config.m_uSeed = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--queries" && bHasValue)
+			config.m_uQueryCount = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--query-radius" && bHasValue)
+			config.m_fQueryRadius = static_cast<float>(std::atof(argv[++i]));
+		else if (sArgument == "--nearest" && bHasValue)
+			config.m_uQueryNearest = static_cast<uint>(std::atoi(argv[++i]));
+		else if (sArgument == "--out" && bHasValue)
+			sOutput = argv[++i];
+		else
+		{
+			std::cerr << "Unknown argument: " << sArgument << std::endl;
+			return 1;
+		}
+	}
+
+	MyBenchmark* pBenchmark = new MyBenchmark(config);
+	pBenchmark->Run();
+	String sReport = pBenchmark->GetReport();
+	SafeDelete(pBenchmark);
+
+	std::cout << sReport;
+	if (sOutput != "")
+	{
+		std::ofstream file(sOutput);
+		file << sReport;
+	}
+	return 0;
+}
@@ -0,0 +1,16 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MAIN_H_
+#define __MAIN_H_
+
+#include "MyBenchmark.h"
+
+#endif //__MAIN_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
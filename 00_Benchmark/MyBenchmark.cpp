@@ -0,0 +1,454 @@
+#include "MyBenchmark.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <new>
+using namespace Simplex;
+//  Allocation counting
+namespace
+{
+	std::atomic<unsigned long long> g_uAllocationCount(0); //allocations done through operator new
+	std::atomic<unsigned long long> g_uAllocatedBytes(0); //bytes requested through operator new
+}
+//replacing the global operators counts every allocation of this executable
+void* operator new(size_t a_uSize)
+{
+	++g_uAllocationCount;
+	g_uAllocatedBytes += a_uSize;
+	void* pMemory = std::malloc(a_uSize == 0 ? 1 : a_uSize);
+	if (pMemory == nullptr)
+		throw std::bad_alloc();
+	return pMemory;
+}
+void* operator new[](size_t a_uSize) { return operator new(a_uSize); }
+void operator delete(void* a_pMemory) noexcept { std::free(a_pMemory); }
+void operator delete[](void* a_pMemory) noexcept { std::free(a_pMemory); }
+//the sized forms are what C++14 calls when the size is known, they have to free the same memory
+void operator delete(void* a_pMemory, size_t) noexcept { std::free(a_pMemory); }
+void operator delete[](void* a_pMemory, size_t) noexcept { std::free(a_pMemory); }
+unsigned long long MyBenchmark::GetAllocationCount(void) { return g_uAllocationCount; }
+unsigned long long MyBenchmark::GetAllocatedBytes(void) { return g_uAllocatedBytes; }
+//  MyBenchmark
+void MyBenchmark::Init(void)
+{
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_pRoot = nullptr;
+	m_pTuner = nullptr;
+	m_TunerReport = MyTunerReport();
+
+	m_Broadphase = MyPhaseTiming();
+	m_Narrowphase = MyPhaseTiming();
+	m_Resolve = MyPhaseTiming();
+	m_Integrate = MyPhaseTiming();
+	m_Frame = MyPhaseTiming();
+
+	m_uPairsTested = 0;
+	m_uContactEvents = 0;
+	m_uContactCount = 0;
+	m_uAllocations = 0;
+	m_uAllocatedBytes = 0;
+	m_uOctantCount = 0;
+
+	m_BoxQuery = MyQueryTiming();
+	m_SphereQuery = MyQueryTiming();
+	m_NearestQuery = MyQueryTiming();
+}
+void MyBenchmark::Swap(MyBenchmark& other)
+{
+	std::swap(m_Config, other.m_Config);
+	std::swap(m_pEntityMngr, other.m_pEntityMngr);
+	std::swap(m_pRoot, other.m_pRoot);
+	std::swap(m_pTuner, other.m_pTuner);
+	std::swap(m_TunerReport, other.m_TunerReport);
+
+	std::swap(m_Broadphase, other.m_Broadphase);
+	std::swap(m_Narrowphase, other.m_Narrowphase);
+	std::swap(m_Resolve, other.m_Resolve);
+	std::swap(m_Integrate, other.m_Integrate);
+	std::swap(m_Frame, other.m_Frame);
+
+	std::swap(m_uPairsTested, other.m_uPairsTested);
+	std::swap(m_uContactEvents, other.m_uContactEvents);
+	std::swap(m_uContactCount, other.m_uContactCount);
+	std::swap(m_uAllocations, other.m_uAllocations);
+	std::swap(m_uAllocatedBytes, other.m_uAllocatedBytes);
+	std::swap(m_uOctantCount, other.m_uOctantCount);
+	std::swap(m_BoxQuery, other.m_BoxQuery);
+	std::swap(m_SphereQuery, other.m_SphereQuery);
+	std::swap(m_NearestQuery, other.m_NearestQuery);
+}
+void MyBenchmark::Release(void)
+{
+	SafeDelete(m_pTuner);
+	SafeDelete(m_pRoot);
+	//the entities of the scene belong to the entity manager
+	m_pEntityMngr = nullptr;
+	MyEntityManager::ReleaseInstance();
+}
+//The big 3
+MyBenchmark::MyBenchmark(MyBenchmarkConfig a_Config)
+{
+	Init();
+	m_Config = a_Config;
+}
+MyBenchmark::MyBenchmark(MyBenchmark const& other)
+{
+	//the scene lives in the entity manager singleton, only the settings and results are copied
+	m_Config = other.m_Config;
+	m_pEntityMngr = other.m_pEntityMngr;
+	m_pRoot = nullptr;
+	m_pTuner = nullptr;
+	m_TunerReport = other.m_TunerReport;
+
+	m_Broadphase = other.m_Broadphase;
+	m_Narrowphase = other.m_Narrowphase;
+	m_Resolve = other.m_Resolve;
+	m_Integrate = other.m_Integrate;
+	m_Frame = other.m_Frame;
+
+	m_uPairsTested = other.m_uPairsTested;
+	m_uContactEvents = other.m_uContactEvents;
+	m_uContactCount = other.m_uContactCount;
+	m_uAllocations = other.m_uAllocations;
+	m_uAllocatedBytes = other.m_uAllocatedBytes;
+	m_uOctantCount = other.m_uOctantCount;
+	m_BoxQuery = other.m_BoxQuery;
+	m_SphereQuery = other.m_SphereQuery;
+	m_NearestQuery = other.m_NearestQuery;
+}
+MyBenchmark& MyBenchmark::operator=(MyBenchmark const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyBenchmark temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyBenchmark::~MyBenchmark() { Release(); }
+//--- Methods
+void MyBenchmark::SpawnScene(void)
+{
+	//corners of a unit cube, there is no model so the rigid body is generated from them
+	std::vector<vector3> lCube;
+	lCube.push_back(vector3(-0.5f, -0.5f, -0.5f));
+	lCube.push_back(vector3(0.5f, 0.5f, 0.5f));
+
+	m_pEntityMngr->SetContactIterations(m_Config.m_uContactIterations);
+
+	//glm uses std::rand, seeding it makes the scene the same on every run
+	std::srand(m_Config.m_uSeed);
+	std::vector<matrix4> lTransform(m_Config.m_uEntityCount);
+	for (uint i = 0; i < m_Config.m_uEntityCount; ++i)
+	{
+		vector3 v3Position = glm::sphericalRand(m_Config.m_fRadius);
+		//lift the sphere over the ground plane so the cubes fall into each other
+		if (m_Config.m_bMoving)
+			v3Position.y += m_Config.m_fRadius;
+		lTransform[i] = glm::translate(v3Position);
+	}
+
+	//the whole scene is added in one batch, the broadphase is built after it
+	uint uFlags = SPAWN_NONE;
+	if (m_Config.m_bMoving)
+		uFlags |= SPAWN_PHYSICS | (m_Config.m_bContinuous ? SPAWN_CONTINUOUS : SPAWN_NONE);
+	uint uCount = m_pEntityMngr->AddEntities(lCube, m_Config.m_uEntityCount, lTransform.data(), uFlags, "Cube");
+	if (m_Config.m_bMoving)
+	{
+		for (uint i = 0; i < uCount; ++i)
+			m_pEntityMngr->SetMass(1.5f, i);
+	}
+}
+void MyBenchmark::BuildBroadphase(void)
+{
+	if (m_Config.m_uOctreeLevels == 0)
+		return;
+
+	//the octree adds dimensions to the entities, the old ones need to go first
+	m_pEntityMngr->ClearDimensionSetAll();
+	SafeDelete(m_pRoot);
+	m_pRoot = new MyOctree(m_Config.m_uOctreeLevels, m_Config.m_uIdealEntityCount, m_Config.m_fLooseness);
+	m_uOctantCount = m_pRoot->GetOctantCount();
+	//ray queries go through the same tree
+	m_pEntityMngr->SetOctree(m_pRoot);
+}
+void MyBenchmark::RelinkBroadphase(void)
+{
+	//an entity that still fits in its octant costs a bounds test
+	uint uCount = m_pEntityMngr->GetEntityCount();
+	for (uint i = 0; i < uCount; ++i)
+		m_pRoot->Relink(i);
+}
+void MyBenchmark::AddTiming(MyPhaseTiming& a_Timing, double a_dTime, bool a_bFirst)
+{
+	a_Timing.m_dTotal += a_dTime;
+	if (a_bFirst || a_dTime < a_Timing.m_dMin)
+		a_Timing.m_dMin = a_dTime;
+	if (a_bFirst || a_dTime > a_Timing.m_dMax)
+		a_Timing.m_dMax = a_dTime;
+}
+void MyBenchmark::Run(void)
+{
+	typedef std::chrono::steady_clock Clock;
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+	SpawnScene();
+	if (m_Config.m_bTune)
+		m_pTuner = new MyOctreeTuner(m_Config.m_uOctreeLevels, m_Config.m_uIdealEntityCount, m_Config.m_fLooseness);
+
+	unsigned long long uAllocations = GetAllocationCount();
+	unsigned long long uAllocatedBytes = GetAllocatedBytes();
+
+	for (uint uFrame = 0; uFrame < m_Config.m_uFrameCount; ++uFrame)
+	{
+		bool bFirst = uFrame == 0;
+		Clock::time_point start = Clock::now();
+
+		Clock::time_point broadphase;
+		Clock::time_point narrowphase;
+		if (m_pTuner != nullptr)
+		{
+			//the tuner builds the tree and tests the pairs itself, it knows where the time went
+			m_pTuner->Update();
+			narrowphase = Clock::now();
+			broadphase = start + std::chrono::duration_cast<Clock::duration>(Milliseconds(m_pTuner->GetBuildTime()));
+		}
+		else
+		{
+			//static scenes only need the octree once, a loose one follows the moving entities
+			if (bFirst || (m_Config.m_bMoving && (m_pRoot == nullptr || !m_pRoot->IsLoose())))
+				BuildBroadphase();
+			else if (m_Config.m_bMoving)
+				RelinkBroadphase();
+			broadphase = Clock::now();
+
+			m_pEntityMngr->CheckCollisions();
+			narrowphase = Clock::now();
+		}
+
+		m_pEntityMngr->ResolveCollisions();
+		Clock::time_point resolve = Clock::now();
+
+		m_pEntityMngr->IntegrateEntities();
+		Clock::time_point integrate = Clock::now();
+
+		AddTiming(m_Broadphase, Milliseconds(broadphase - start).count(), bFirst);
+		AddTiming(m_Narrowphase, Milliseconds(narrowphase - broadphase).count(), bFirst);
+		AddTiming(m_Resolve, Milliseconds(resolve - narrowphase).count(), bFirst);
+		AddTiming(m_Integrate, Milliseconds(integrate - resolve).count(), bFirst);
+		AddTiming(m_Frame, Milliseconds(integrate - start).count(), bFirst);
+
+		m_uPairsTested += m_pEntityMngr->GetPairTestCount();
+		m_uContactEvents += m_pEntityMngr->GetContactEventCount();
+		m_uContactCount = m_pEntityMngr->GetContactCount();
+	}
+
+	m_uAllocations = GetAllocationCount() - uAllocations;
+	m_uAllocatedBytes = GetAllocatedBytes() - uAllocatedBytes;
+
+	//the queries and the report use the best configuration the tuner found
+	if (m_pTuner != nullptr)
+	{
+		m_TunerReport = m_pTuner->GetReport();
+		m_Config.m_uOctreeLevels = m_TunerReport.m_uBestLevel;
+		m_Config.m_uIdealEntityCount = m_TunerReport.m_uBestIdealEntityCount;
+		SafeDelete(m_pTuner);
+		BuildBroadphase();
+	}
+
+	RunQueries();
+}
+void MyBenchmark::RunQueries(void)
+{
+	typedef std::chrono::steady_clock Clock;
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+	if (m_Config.m_uQueryCount == 0 || m_Config.m_uOctreeLevels == 0)
+		return;
+	//the octree has to match the bounds brute force reads
+	if (m_Config.m_bMoving || m_pRoot == nullptr)
+		BuildBroadphase();
+
+	//the buffers are the only allocation, the queries themselves allocate nothing
+	uint uCapacity = m_pEntityMngr->GetEntityCount();
+	uint uNearest = m_Config.m_uQueryNearest;
+	std::vector<uint> lOctree(std::max(uCapacity, uNearest));
+	std::vector<uint> lBruteForce(std::max(uCapacity, uNearest));
+	std::vector<float> lOctreeDistance(uNearest);
+	std::vector<float> lBruteForceDistance(uNearest);
+
+	//the points are spread over the volume the entities were spawned in
+	std::srand(m_Config.m_uSeed + 1);
+	vector3 v3Lift = m_Config.m_bMoving ? vector3(0.0f, m_Config.m_fRadius, 0.0f) : ZERO_V3;
+	vector3 v3Size = vector3(m_Config.m_fQueryRadius);
+	for (uint i = 0; i < m_Config.m_uQueryCount; ++i)
+	{
+		vector3 v3Point = glm::ballRand(m_Config.m_fRadius) + v3Lift;
+
+		Clock::time_point start = Clock::now();
+		uint uOctree = m_pRoot->QueryBox(v3Point - v3Size, v3Point + v3Size, lOctree.data(), uCapacity);
+		Clock::time_point octree = Clock::now();
+		uint uBruteForce = BruteForceBox(v3Point - v3Size, v3Point + v3Size, lBruteForce.data(), uCapacity);
+		Clock::time_point bruteForce = Clock::now();
+		m_BoxQuery.m_dOctree += Milliseconds(octree - start).count();
+		m_BoxQuery.m_dBruteForce += Milliseconds(bruteForce - octree).count();
+		m_BoxQuery.m_uFound += uOctree;
+		if (uOctree != uBruteForce)
+			++m_BoxQuery.m_uMismatches;
+
+		start = Clock::now();
+		uOctree = m_pRoot->QuerySphere(v3Point, m_Config.m_fQueryRadius, lOctree.data(), uCapacity);
+		octree = Clock::now();
+		uBruteForce = BruteForceSphere(v3Point, m_Config.m_fQueryRadius, lBruteForce.data(), uCapacity);
+		bruteForce = Clock::now();
+		m_SphereQuery.m_dOctree += Milliseconds(octree - start).count();
+		m_SphereQuery.m_dBruteForce += Milliseconds(bruteForce - octree).count();
+		m_SphereQuery.m_uFound += uOctree;
+		if (uOctree != uBruteForce)
+			++m_SphereQuery.m_uMismatches;
+
+		start = Clock::now();
+		uOctree = m_pRoot->QueryNearest(v3Point, uNearest, lOctree.data(), lOctreeDistance.data());
+		octree = Clock::now();
+		uBruteForce = BruteForceNearest(v3Point, uNearest, lBruteForce.data(), lBruteForceDistance.data());
+		bruteForce = Clock::now();
+		m_NearestQuery.m_dOctree += Milliseconds(octree - start).count();
+		m_NearestQuery.m_dBruteForce += Milliseconds(bruteForce - octree).count();
+		m_NearestQuery.m_uFound += uOctree;
+		//ties can swap entities, the distances have to agree
+		if (uOctree != uBruteForce || (uOctree > 0 && lOctreeDistance[uOctree - 1] != lBruteForceDistance[uOctree - 1]))
+			++m_NearestQuery.m_uMismatches;
+	}
+}
+uint MyBenchmark::BruteForceBox(vector3 a_v3Min, vector3 a_v3Max, uint* a_pResult, uint a_uCapacity)
+{
+	uint uFound = 0;
+	uint uCount = m_pEntityMngr->GetEntityCount();
+	for (uint i = 0; i < uCount; ++i)
+	{
+		if (glm::any(glm::lessThan(a_v3Max, m_pEntityMngr->GetMinGlobal(i))) || glm::any(glm::greaterThan(a_v3Min, m_pEntityMngr->GetMaxGlobal(i))))
+			continue;
+		if (uFound < a_uCapacity)
+			a_pResult[uFound] = i;
+		++uFound;
+	}
+	return uFound;
+}
+uint MyBenchmark::BruteForceSphere(vector3 a_v3Center, float a_fRadius, uint* a_pResult, uint a_uCapacity)
+{
+	uint uFound = 0;
+	uint uCount = m_pEntityMngr->GetEntityCount();
+	for (uint i = 0; i < uCount; ++i)
+	{
+		vector3 v3Offset = a_v3Center - glm::clamp(a_v3Center, m_pEntityMngr->GetMinGlobal(i), m_pEntityMngr->GetMaxGlobal(i));
+		if (glm::dot(v3Offset, v3Offset) > a_fRadius * a_fRadius)
+			continue;
+		if (uFound < a_uCapacity)
+			a_pResult[uFound] = i;
+		++uFound;
+	}
+	return uFound;
+}
+uint MyBenchmark::BruteForceNearest(vector3 a_v3Point, uint a_uCount, uint* a_pResult, float* a_pDistance)
+{
+	uint uFound = 0;
+	uint uCount = m_pEntityMngr->GetEntityCount();
+	for (uint i = 0; i < uCount && a_uCount > 0; ++i)
+	{
+		vector3 v3Offset = a_v3Point - glm::clamp(a_v3Point, m_pEntityMngr->GetMinGlobal(i), m_pEntityMngr->GetMaxGlobal(i));
+		float fDistance = glm::dot(v3Offset, v3Offset);
+		if (uFound == a_uCount && fDistance >= a_pDistance[uFound - 1])
+			continue;
+		uint uSlot = uFound < a_uCount ? uFound++ : a_uCount - 1;
+		while (uSlot > 0 && a_pDistance[uSlot - 1] > fDistance)
+		{
+			a_pResult[uSlot] = a_pResult[uSlot - 1];
+			a_pDistance[uSlot] = a_pDistance[uSlot - 1];
+			--uSlot;
+		}
+		a_pResult[uSlot] = i;
+		a_pDistance[uSlot] = fDistance;
+	}
+	for (uint i = 0; i < uFound; ++i)
+		a_pDistance[i] = std::sqrt(a_pDistance[i]);
+	return uFound;
+}
+String MyBenchmark::TimingToJSON(MyPhaseTiming const& a_Timing, uint a_uFrameCount)
+{
+	std::ostringstream sJSON;
+	sJSON << std::fixed << std::setprecision(4);
+	sJSON << "{ \"total\": " << a_Timing.m_dTotal;
+	sJSON << ", \"avg\": " << (a_uFrameCount > 0 ? a_Timing.m_dTotal / a_uFrameCount : 0.0);
+	sJSON << ", \"min\": " << a_Timing.m_dMin;
+	sJSON << ", \"max\": " << a_Timing.m_dMax << " }";
+	return sJSON.str();
+}
+String MyBenchmark::QueryToJSON(MyQueryTiming const& a_Timing, uint a_uQueryCount)
+{
+	std::ostringstream sJSON;
+	sJSON << std::fixed << std::setprecision(4);
+	sJSON << "{ \"octree_ms\": " << a_Timing.m_dOctree;
+	sJSON << ", \"brute_force_ms\": " << a_Timing.m_dBruteForce;
+	sJSON << ", \"speedup\": " << (a_Timing.m_dOctree > 0.0 ? a_Timing.m_dBruteForce / a_Timing.m_dOctree : 0.0);
+	sJSON << ", \"found_per_query\": " << (a_uQueryCount > 0 ? double(a_Timing.m_uFound) / a_uQueryCount : 0.0);
+	sJSON << ", \"mismatches\": " << a_Timing.m_uMismatches << " }";
+	return sJSON.str();
+}
+String MyBenchmark::GetReport(void)
+{
+	uint uFrames = m_Config.m_uFrameCount;
+	double dNarrowphaseSeconds = m_Narrowphase.m_dTotal / 1000.0;
+
+	std::ostringstream sJSON;
+	sJSON << std::fixed << std::setprecision(4);
+	sJSON << "{\n";
+	sJSON << "  \"scene\": {\n";
+	sJSON << "    \"entities\": " << m_pEntityMngr->GetEntityCount() << ",\n";
+	sJSON << "    \"radius\": " << m_Config.m_fRadius << ",\n";
+	sJSON << "    \"moving\": " << (m_Config.m_bMoving ? "true" : "false") << ",\n";
+	sJSON << "    \"continuous\": " << (m_Config.m_bContinuous ? "true" : "false") << ",\n";
+	sJSON << "    \"contact_iterations\": " << m_Config.m_uContactIterations << ",\n";
+	sJSON << "    \"frames\": " << uFrames << ",\n";
+	sJSON << "    \"seed\": " << m_Config.m_uSeed << "\n";
+	sJSON << "  },\n";
+	sJSON << "  \"broadphase\": {\n";
+	sJSON << "    \"type\": \"" << (m_Config.m_uOctreeLevels > 0 ? "octree" : "all_pairs") << "\",\n";
+	sJSON << "    \"octree_levels\": " << m_Config.m_uOctreeLevels << ",\n";
+	sJSON << "    \"ideal_entity_count\": " << m_Config.m_uIdealEntityCount << ",\n";
+	sJSON << "    \"looseness\": " << m_Config.m_fLooseness << ",\n";
+	sJSON << "    \"octants\": " << m_uOctantCount << ",\n";
+	sJSON << "    \"tuned\": " << (m_Config.m_bTune ? "true" : "false") << ",\n";
+	sJSON << "    \"tuned_cost_ms\": " << m_TunerReport.m_dBestCost << "\n";
+	sJSON << "  },\n";
+	sJSON << "  \"phases_ms\": {\n";
+	sJSON << "    \"broadphase\": " << TimingToJSON(m_Broadphase, uFrames) << ",\n";
+	sJSON << "    \"narrowphase\": " << TimingToJSON(m_Narrowphase, uFrames) << ",\n";
+	sJSON << "    \"resolve\": " << TimingToJSON(m_Resolve, uFrames) << ",\n";
+	sJSON << "    \"integrate\": " << TimingToJSON(m_Integrate, uFrames) << ",\n";
+	sJSON << "    \"frame\": " << TimingToJSON(m_Frame, uFrames) << "\n";
+	sJSON << "  },\n";
+	sJSON << "  \"pairs\": {\n";
+	sJSON << "    \"tested\": " << m_uPairsTested << ",\n";
+	sJSON << "    \"tested_per_frame\": " << (uFrames > 0 ? double(m_uPairsTested) / uFrames : 0.0) << ",\n";
+	sJSON << "    \"tested_per_second\": " << (dNarrowphaseSeconds > 0.0 ? m_uPairsTested / dNarrowphaseSeconds : 0.0) << ",\n";
+	sJSON << "    \"contact_events\": " << m_uContactEvents << ",\n";
+	sJSON << "    \"contacts_last_frame\": " << m_uContactCount << "\n";
+	sJSON << "  },\n";
+	sJSON << "  \"allocations\": {\n";
+	sJSON << "    \"count\": " << m_uAllocations << ",\n";
+	sJSON << "    \"bytes\": " << m_uAllocatedBytes << ",\n";
+	sJSON << "    \"per_frame\": " << (uFrames > 0 ? double(m_uAllocations) / uFrames : 0.0) << "\n";
+	sJSON << "  },\n";
+	sJSON << "  \"queries\": {\n";
+	sJSON << "    \"count\": " << m_Config.m_uQueryCount << ",\n";
+	sJSON << "    \"radius\": " << m_Config.m_fQueryRadius << ",\n";
+	sJSON << "    \"nearest\": " << m_Config.m_uQueryNearest << ",\n";
+	sJSON << "    \"box\": " << QueryToJSON(m_BoxQuery, m_Config.m_uQueryCount) << ",\n";
+	sJSON << "    \"sphere\": " << QueryToJSON(m_SphereQuery, m_Config.m_uQueryCount) << ",\n";
+	sJSON << "    \"nearest_neighbor\": " << QueryToJSON(m_NearestQuery, m_Config.m_uQueryCount) << "\n";
+	sJSON << "  }\n";
+	sJSON << "}\n";
+	return sJSON.str();
+}
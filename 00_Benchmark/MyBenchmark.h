@@ -0,0 +1,236 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYBENCHMARK_H_
+#define __MYBENCHMARK_H_
+
+#include "MyOctreeTuner.h"
+
+namespace Simplex
+{
+
+//Scene and run settings of a benchmark
+struct MyBenchmarkConfig
+{
+	uint m_uEntityCount = 1849; //number of cubes to spawn
+	float m_fRadius = 34.0f; //cubes are spawned on a sphere of this radius
+	uint m_uFrameCount = 300; //number of frames to run
+	bool m_bMoving = false; //use the physics solver so the cubes move every frame
+	bool m_bContinuous = false; //sweep the moving cubes so they can not cross each other
+	uint m_uContactIterations = CONTACT_ITERATIONS; //impulse iterations per frame, 0 uses forces
+	uint m_uOctreeLevels = 0; //levels of the octree, 0 tests every pair against each other
+	uint m_uIdealEntityCount = 5; //ideal number of entities per octant
+	float m_fLooseness = 1.0f; //above 1 the octree is loose, built once and relinked every frame
+	bool m_bTune = false; //search the levels and ideal entity count while running, starting from the ones above
+	uint m_uSeed = 0; //seed for the spawn positions
+	uint m_uQueryCount = 0; //queries of each kind run against the octree and brute force after the frames
+	float m_fQueryRadius = 4.0f; //radius of the sphere queries and half size of the box queries
+	uint m_uQueryNearest = 8; //entities wanted by the nearest neighbor queries
+};
+
+//Timings of a phase of the frame in milliseconds
+struct MyPhaseTiming
+{
+	double m_dTotal = 0.0; //sum of all frames
+	double m_dMin = 0.0; //fastest frame
+	double m_dMax = 0.0; //slowest frame
+};
+
+//Timings of one kind of query in milliseconds, for all the queries run
+struct MyQueryTiming
+{
+	double m_dOctree = 0.0; //walking the octree
+	double m_dBruteForce = 0.0; //testing every entity
+	unsigned long long m_uFound = 0; //entities found by the octree
+	uint m_uMismatches = 0; //queries where the octree and brute force did not agree
+};
+
+//System Class
+class MyBenchmark
+{
+	MyBenchmarkConfig m_Config; //settings of the run
+	MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager Singleton
+	MyOctree* m_pRoot = nullptr; //broadphase, only used if the config asks for levels
+	MyOctreeTuner* m_pTuner = nullptr; //broadphase while the frames run if the config asks to tune it
+	MyTunerReport m_TunerReport; //configuration the tuner ended with
+
+	MyPhaseTiming m_Broadphase; //rebuilding the octree and assigning dimensions
+	MyPhaseTiming m_Narrowphase; //testing the pairs that share a dimension
+	MyPhaseTiming m_Resolve; //resolving the contact events
+	MyPhaseTiming m_Integrate; //updating entities and the solver
+	MyPhaseTiming m_Frame; //the whole frame
+
+	unsigned long long m_uPairsTested = 0; //pairs tested in all frames
+	unsigned long long m_uContactEvents = 0; //contact events generated in all frames
+	uint m_uContactCount = 0; //contacts solved with impulses in the last frame
+	unsigned long long m_uAllocations = 0; //allocations done while running the frames
+	unsigned long long m_uAllocatedBytes = 0; //bytes allocated while running the frames
+	uint m_uOctantCount = 0; //octants in the last octree built
+
+	MyQueryTiming m_BoxQuery; //box range queries
+	MyQueryTiming m_SphereQuery; //sphere range queries
+	MyQueryTiming m_NearestQuery; //nearest neighbor queries
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: MyBenchmarkConfig a_Config -> settings of the run
+	Output: class object instance
+	*/
+	MyBenchmark(MyBenchmarkConfig a_Config);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyBenchmark(MyBenchmark const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyBenchmark& operator=(MyBenchmark const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyBenchmark(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyBenchmark& other);
+
+	/*
+	USAGE: Spawns the scene and runs the frames, no window or GL context is needed
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Run(void);
+	/*
+	USAGE: Gets the results of the last run as a JSON object
+	ARGUMENTS: ---
+	OUTPUT: JSON text
+	*/
+	String GetReport(void);
+
+	/*
+	USAGE: Gets the number of allocations done by the process so far
+	ARGUMENTS: ---
+	OUTPUT: allocation count
+	*/
+	static unsigned long long GetAllocationCount(void);
+	/*
+	USAGE: Gets the number of bytes allocated by the process so far
+	ARGUMENTS: ---
+	OUTPUT: allocated bytes
+	*/
+	static unsigned long long GetAllocatedBytes(void);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Adds the cubes of the scene to the entity manager
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SpawnScene(void);
+	/*
+	USAGE: Rebuilds the octree and the dimensions of the entities
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void BuildBroadphase(void);
+	/*
+	USAGE: Moves every entity to the octant of the loose octree it fits in now
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void RelinkBroadphase(void);
+	/*
+	USAGE: Adds the time of a frame to the timing of a phase
+	ARGUMENTS:
+	-	MyPhaseTiming& a_Timing -> timing of the phase
+	-	double a_dTime -> time of the frame in milliseconds
+	-	bool a_bFirst -> is it the first frame?
+	OUTPUT: ---
+	*/
+	static void AddTiming(MyPhaseTiming& a_Timing, double a_dTime, bool a_bFirst);
+	/*
+	USAGE: Runs the box, sphere and nearest neighbor queries through the octree and by brute force
+	at random points of the scene and compares the results
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void RunQueries(void);
+	/*
+	USAGE: Finds the entities whose global ARBB overlaps a box by testing all of them
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum of the box
+	-	vector3 a_v3Max -> maximum of the box
+	-	uint* a_pResult -> gets the index of each entity found
+	-	uint a_uCapacity -> size of the buffer
+	OUTPUT: number of entities found
+	*/
+	uint BruteForceBox(vector3 a_v3Min, vector3 a_v3Max, uint* a_pResult, uint a_uCapacity);
+	/*
+	USAGE: Finds the entities whose global ARBB overlaps a sphere by testing all of them
+	ARGUMENTS:
+	-	vector3 a_v3Center -> center of the sphere
+	-	float a_fRadius -> radius of the sphere
+	-	uint* a_pResult -> gets the index of each entity found
+	-	uint a_uCapacity -> size of the buffer
+	OUTPUT: number of entities found
+	*/
+	uint BruteForceSphere(vector3 a_v3Center, float a_fRadius, uint* a_pResult, uint a_uCapacity);
+	/*
+	USAGE: Finds the entities whose global ARBB is nearest to a point by testing all of them
+	ARGUMENTS:
+	-	vector3 a_v3Point -> point
+	-	uint a_uCount -> number of entities wanted
+	-	uint* a_pResult -> gets the index of each entity found, nearest first
+	-	float* a_pDistance -> gets the distance to each entity found
+	OUTPUT: number of entities found
+	*/
+	uint BruteForceNearest(vector3 a_v3Point, uint a_uCount, uint* a_pResult, float* a_pDistance);
+	/*
+	USAGE: Writes the timing of a kind of query as a JSON object
+	ARGUMENTS:
+	-	MyQueryTiming const& a_Timing -> timing of the queries
+	-	uint a_uQueryCount -> queries that were run
+	OUTPUT: JSON text
+	*/
+	static String QueryToJSON(MyQueryTiming const& a_Timing, uint a_uQueryCount);
+	/*
+	USAGE: Writes the timing of a phase as a JSON object
+	ARGUMENTS:
+	-	MyPhaseTiming const& a_Timing -> timing of the phase
+	-	uint a_uFrameCount -> frames that were run
+	OUTPUT: JSON text
+	*/
+	static String TimingToJSON(MyPhaseTiming const& a_Timing, uint a_uFrameCount);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYBENCHMARK_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -14,26 +14,48 @@ void Application::InitVariables(void)
 
 															 
 	m_pEntityMngr = MyEntityManager::GetInstance(); //Initialize the entity manager
-	m_pEntityMngr->AddEntity("Minecraft\\Steve.obj", "Steve");
+	m_pFrameGraph = new MyTaskGraph(); //Initialize the workers of the frame
+
+	//the spawn positions come from std::rand, a replay gets the seed of its log
+	std::srand(MyInputRecorder::GetInstance()->GetSeed());
+	m_pEntityMngr->AddEntity("Minecraft\\Steve.fbx", "Steve");
 	m_pEntityMngr->UsePhysicsSolver();
+	//the limbs of Steve come with a take, their frames are compressed and sampled when he is drawn;
+	//a limb without frames is remembered, it follows the one it hangs from
+	String lLimb[] = { "mc_steve_head", "mc_steve_body", "mc_steve_Larm", "mc_steve_Rarm", "mc_steve_Lleg", "mc_steve_Rleg" };
+	for (uint i = 0; i < 6; i++)
+	{
+		m_pEntityMngr->CompressAnimation(lLimb[i], "Steve");
+	}
+	m_pEntityMngr->SetAnimationFrame(0.0f, "Steve");
+	m_uFrameClock = m_pSystem->GenClock();
 
-	for (int i = 0; i < 100; i++)
+	//the cubes share the model and are added together, they do not wait for it to be cooked
+	std::vector<matrix4> lTransform(100);
+	for (uint i = 0; i < lTransform.size(); i++)
 	{
-		m_pEntityMngr->AddEntity("Minecraft\\Cube.obj", "Cube_" + std::to_string(i));
 		vector3 v3Position = vector3(glm::sphericalRand(12.0f));
 		v3Position.y = 0.0f;
-		matrix4 m4Position = glm::translate(v3Position);
-		m_pEntityMngr->SetModelMatrix(m4Position * glm::scale(vector3(1.5f)));
-		m_pEntityMngr->UsePhysicsSolver(true);
-		m_pEntityMngr->SetMass(1.5);
+		lTransform[i] = glm::translate(v3Position) * glm::scale(vector3(1.5f));
+	}
+	uint uFirst = m_pEntityMngr->GetEntityCount();
+	uint uCount = m_pEntityMngr->AddEntities("Minecraft\\Cube.obj", static_cast<uint>(lTransform.size()), lTransform.data(), SPAWN_PHYSICS | SPAWN_STREAM, "Cube");
+	for (uint i = uFirst; i < uFirst + uCount; i++)
+	{
+		m_pEntityMngr->SetMass(1.5f, i);
 
-		//m_pEntityMngr->SetMass(i+1);
+		//m_pEntityMngr->SetMass(i+1, i);
 	}
+
+	//the broadphase starts from a shallow loose tree and searches for the cheapest one as the scene runs
+	m_pOctreeTuner = new MyOctreeTuner(1, 5, 1.5f);
 }
 void Application::Update(void)
 {
 	//Update the system so it knows how much time has passed since the last call
 	m_pSystem->Update();
+	//the recorder keeps one time per frame, it is measured here and nowhere else
+	m_fDeltaTime = MyInputRecorder::GetInstance()->FilterDeltaTime(m_pSystem->GetDeltaTime(m_uFrameClock));
 
 	//Is the arcball active?
 	ArcBall();
@@ -41,11 +63,38 @@ void Application::Update(void)
 	//Is the first person camera active?
 	CameraRotation();
 
-	//Update Entity Manager
-	m_pEntityMngr->Update();
+	//Upload the textures and models the workers finished, within the frame budget
+	MyAssetStreamer::GetInstance()->Update();
+	m_pEntityMngr->UpdateStreamedModels();
+
+	//Read the occlusion tests of the last frame before the entities are submitted
+	MyOcclusionCuller::GetInstance()->Update(m_pCameraMngr->GetPosition());
+
+	//Advance the take of Steve, the time is the one a replay uses
+	int nSteve = m_pEntityMngr->GetEntityIndex("Steve");
+	float fLength = nSteve >= 0 ? m_pEntityMngr->GetAnimationLength(nSteve) : 0.0f;
+	if (fLength > 0.0f)
+	{
+		float fFrame = m_pEntityMngr->GetAnimationFrame(nSteve) + m_fDeltaTime * ANIMATION_FPS;
+		m_pEntityMngr->SetAnimationFrame(std::fmod(fFrame, fLength), nSteve);
+	}
 
-	//Add objects to render list
+	//Add objects to render list, it keeps its own copy of the transforms
 	m_pEntityMngr->AddEntityToRenderList(-1, true);
+
+	//The layout of the tree comes from timings, it is frozen while the input is recorded or replayed
+	//so both runs build the same tree; the GUI reads the tuner while the workers run, it gets a copy
+	m_pOctreeTuner->SetAdaptive(m_bTuneOctree && MyInputRecorder::GetInstance()->GetMode() == RECORDER_OFF);
+	m_OctreeReport = m_pOctreeTuner->GetReport();
+
+	//Simulate the next frame on the workers while this one is drawn, Display waits for it at the end;
+	//the tuner builds the octree and tests the pairs, then the contacts are resolved and the entities moved
+	uint uPairs = m_pFrameGraph->AddTask(std::bind(&MyOctreeTuner::Update, m_pOctreeTuner));
+	uint uResolve = m_pFrameGraph->AddTask(std::bind(&MyEntityManager::ResolveCollisions, m_pEntityMngr));
+	uint uIntegrate = m_pFrameGraph->AddTask(std::bind(&MyEntityManager::IntegrateEntities, m_pEntityMngr));
+	m_pFrameGraph->AddDependency(uResolve, uPairs);
+	m_pFrameGraph->AddDependency(uIntegrate, uResolve);
+	m_pFrameGraph->Launch();
 }
 void Application::Display(void)
 {
@@ -57,6 +106,12 @@ void Application::Display(void)
 		
 	//render list call
 	m_uRenderCallCount = m_pMeshMngr->Render();
+
+	//test the bounds against the depth just drawn, the next frame skips what is hidden
+	m_uRenderCallCount += MyOcclusionCuller::GetInstance()->Render(m_pCameraMngr->GetVP(), m_pCameraMngr->GetPosition());
+
+	//debug lines, every box, sphere and axis of the frame in one call
+	m_uRenderCallCount += MyDebugDraw::GetInstance()->Render(m_pCameraMngr->GetVP());
 	
 	//clear the render list
 	m_pMeshMngr->ClearRenderList();
@@ -66,10 +121,27 @@ void Application::Display(void)
 	
 	//end the current frame (internally swaps the front and back buffers)
 	m_pWindow->display();
+
+	//the next frame is built from the simulated entities
+	m_pFrameGraph->Wait();
 }
 
 void Application::Release(void)
 {
+	//stop the workers before anything they use is released
+	SafeDelete(m_pFrameGraph);
+	SafeDelete(m_pOctreeTuner);
+
 	//release GUI
 	ShutdownGUI();
+
+	//the debug lines and the occlusion tests use cached programs, they go first
+	MyDebugDraw::ReleaseInstance();
+	MyOcclusionCuller::ReleaseInstance();
+
+	//closes the log, a replay writes its timing
+	MyInputRecorder::ReleaseInstance();
+
+	//release the cached programs, the GUI one included
+	MyShaderCache::ReleaseInstance();
 }
\ No newline at end of file
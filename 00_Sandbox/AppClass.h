@@ -11,6 +11,14 @@ Date: 2017/06
 #include "imgui\ImGuiObject.h"
 
 #include "MyEntityManager.h"
+#include "MyShaderCache.h"
+#include "MyDebugDraw.h"
+#include "MyOcclusionCuller.h"
+#include "MyTaskGraph.h"
+#include "MyInputRecorder.h"
+#include "MyOctreeTuner.h"
+
+#define ANIMATION_FPS 24.0f //frames of a take played each second
 
 namespace Simplex
 {
@@ -18,6 +26,12 @@ namespace Simplex
 class Application
 {
 	MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager
+	MyTaskGraph* m_pFrameGraph = nullptr; //workers that simulate the next frame while this one is drawn
+	MyOctreeTuner* m_pOctreeTuner = nullptr; //octree of the entities, its levels and entities per octant are searched
+	uint m_uFrameClock = 0; //clock the time of each frame is measured with
+	float m_fDeltaTime = 0.0f; //seconds of the frame, measured once so the animation and the GUI get the same time a replay does
+	MyTunerReport m_OctreeReport; //state of the tuner, copied for the GUI while the workers are idle
+	bool m_bTuneOctree = true; //search the configuration of the octree? applied while the workers are idle, never while recording or replaying
 
 private:
 	static ImGuiObject gui; //GUI object
@@ -197,6 +211,12 @@ private:
 #pragma endregion
 
 #pragma region Process Events
+	/*
+	USAGE: Sends an event from the window or from a replayed log to its handler
+	ARGUMENTS: sf::Event a_event -> event
+	OUTPUT: ---
+	*/
+	void ProcessEvent(sf::Event a_event);
 	/*
 	USAGE: Resizes the window
 	ARGUMENTS: ---
@@ -3,9 +3,9 @@ using namespace Simplex;
 //Mouse
 void Application::ProcessMouseMovement(sf::Event a_event)
 {
-	//get global mouse position
-	sf::Vector2i mouse = sf::Mouse::getPosition();
+	//get global mouse position, from the log if it is being replayed
 	sf::Vector2i window = m_pWindow->getPosition();
+	sf::Vector2i mouse = MyInputRecorder::GetInstance()->GetMousePosition(window);
 	m_v3Mouse.x = static_cast<float>(mouse.x - window.x);
 	m_v3Mouse.y = static_cast<float>(mouse.y - window.y);
 	if(!m_pSystem->IsWindowFullscreen() && !m_pSystem->IsWindowBorderless())
@@ -56,10 +56,11 @@ void Application::ProcessMouseReleased(sf::Event a_event)
 }
 void Application::ProcessMouseScroll(sf::Event a_event)
 {
+	MyInputRecorder* pRecorder = MyInputRecorder::GetInstance();
 	gui.io.MouseWheel = a_event.mouseWheelScroll.delta;
 	float fSpeed = a_event.mouseWheelScroll.delta;
-	float fMultiplier = sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) ||
-		sf::Keyboard::isKeyPressed(sf::Keyboard::RShift);
+	float fMultiplier = pRecorder->IsKeyPressed(sf::Keyboard::LShift) ||
+		pRecorder->IsKeyPressed(sf::Keyboard::RShift);
 
 	if (fMultiplier)
 		fSpeed *= 2.0f;
@@ -311,11 +312,11 @@ void Application::ArcBall(float a_fSensitivity)
 	CenterX = m_pSystem->GetWindowX() + m_pSystem->GetWindowWidth() / 2;
 	CenterY = m_pSystem->GetWindowY() + m_pSystem->GetWindowHeight() / 2;
 
-	//Calculate the position of the mouse and store it
-	POINT pt;
-	GetCursorPos(&pt);
-	MouseX = pt.x;
-	MouseY = pt.y;
+	//Calculate the position of the mouse and store it, from the log if it is being replayed
+	MyInputRecorder* pRecorder = MyInputRecorder::GetInstance();
+	sf::Vector2i mouse = pRecorder->GetMousePosition(sf::Vector2i(m_pSystem->GetWindowX(), m_pSystem->GetWindowY()));
+	MouseX = mouse.x;
+	MouseY = mouse.y;
 
 	//Calculate the difference in position and update the quaternion orientation based on it
 	float DeltaMouse;
@@ -341,7 +342,8 @@ void Application::ArcBall(float a_fSensitivity)
 		m_qArcBall = quaternion(vector3(glm::radians(a_fSensitivity * DeltaMouse), 0.0f, 0.0f)) * m_qArcBall;
 	}
 
-	SetCursorPos(CenterX, CenterY);//Position the mouse in the center
+	if (!pRecorder->IsReplaying())
+		SetCursorPos(CenterX, CenterY);//Position the mouse in the center
 								   //return qArcBall; // return the new quaternion orientation
 }
 void Application::CameraRotation(float a_fSpeed)
@@ -356,11 +358,11 @@ void Application::CameraRotation(float a_fSpeed)
 	CenterX = m_pSystem->GetWindowX() + m_pSystem->GetWindowWidth() / 2;
 	CenterY = m_pSystem->GetWindowY() + m_pSystem->GetWindowHeight() / 2;
 
-	//Calculate the position of the mouse and store it
-	POINT pt;
-	GetCursorPos(&pt);
-	MouseX = pt.x;
-	MouseY = pt.y;
+	//Calculate the position of the mouse and store it, from the log if it is being replayed
+	MyInputRecorder* pRecorder = MyInputRecorder::GetInstance();
+	sf::Vector2i mouse = pRecorder->GetMousePosition(sf::Vector2i(m_pSystem->GetWindowX(), m_pSystem->GetWindowY()));
+	MouseX = mouse.x;
+	MouseY = mouse.y;
 
 	//Calculate the difference in view with the angle
 	float fAngleX = 0.0f;
@@ -390,7 +392,8 @@ void Application::CameraRotation(float a_fSpeed)
 	//Change the Yaw and the Pitch of the camera
 	m_pCameraMngr->ChangeYaw(fAngleY * 0.25f);
 	m_pCameraMngr->ChangePitch(-fAngleX * 0.25f);
-	SetCursorPos(CenterX, CenterY);//Position the mouse in the center
+	if (!pRecorder->IsReplaying())
+		SetCursorPos(CenterX, CenterY);//Position the mouse in the center
 }
 //Keyboard
 void Application::ProcessKeyboard(void)
@@ -402,30 +405,32 @@ void Application::ProcessKeyboard(void)
 	for discreet on/off use ProcessKeyboardPressed/Released
 	*/
 #pragma region Camera Position
-	bool bMultiplier = sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) ||
-		sf::Keyboard::isKeyPressed(sf::Keyboard::RShift);
+	//the keys come from the log if it is being replayed
+	MyInputRecorder* pRecorder = MyInputRecorder::GetInstance();
+	bool bMultiplier = pRecorder->IsKeyPressed(sf::Keyboard::LShift) ||
+		pRecorder->IsKeyPressed(sf::Keyboard::RShift);
 
 	float fMultiplier = 1.0f;
 
 	if (bMultiplier)
 		fMultiplier = 5.0f;
 
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::W))
+	if (pRecorder->IsKeyPressed(sf::Keyboard::W))
 		m_pCameraMngr->MoveForward(m_fMovementSpeed * fMultiplier);
 
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
+	if (pRecorder->IsKeyPressed(sf::Keyboard::S))
 		m_pCameraMngr->MoveForward(-m_fMovementSpeed * fMultiplier);
 
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::A))
+	if (pRecorder->IsKeyPressed(sf::Keyboard::A))
 		m_pCameraMngr->MoveSideways(-m_fMovementSpeed * fMultiplier);
 
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::D))
+	if (pRecorder->IsKeyPressed(sf::Keyboard::D))
 		m_pCameraMngr->MoveSideways(m_fMovementSpeed * fMultiplier);
 
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Q))
+	if (pRecorder->IsKeyPressed(sf::Keyboard::Q))
 		m_pCameraMngr->MoveVertical(-m_fMovementSpeed * fMultiplier);
 
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::E))
+	if (pRecorder->IsKeyPressed(sf::Keyboard::E))
 		m_pCameraMngr->MoveVertical(m_fMovementSpeed * fMultiplier);
 #pragma endregion
 }
@@ -160,7 +160,7 @@ void Application::DrawGUI(void)
 	{
 		static float f = 0.0f;
 		ImGui::SetNextWindowPos(ImVec2(1, 44), ImGuiSetCond_FirstUseEver);
-		ImGui::SetNextWindowSize(ImVec2(315, 107), ImGuiSetCond_FirstUseEver);
+		ImGui::SetNextWindowSize(ImVec2(315, 178), ImGuiSetCond_FirstUseEver);
 		ImGui::SetNextWindowCollapsed(false, ImGuiSetCond_FirstUseEver);
 		String sWindowName = m_pSystem->GetAppName() + " - Main";
 		ImGui::Begin(sWindowName.c_str());
@@ -168,6 +168,18 @@ void Application::DrawGUI(void)
 			ImGui::Text("FrameRate: %.2f [FPS] -> %.3f [ms/frame] ",
 				ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
 			ImGui::Text("RenderCalls: %d", m_uRenderCallCount);
+			MyOcclusionCuller* pCuller = MyOcclusionCuller::GetInstance();
+			ImGui::Text("Occluded: %d entities, %d octants (%d tests)",
+				pCuller->GetCulledCount(), pCuller->GetOctantCulledCount(), pCuller->GetTestedCount());
+			char const* sTunerPhase[] = { "fixed", "measuring", "probing", "settled" };
+			ImGui::Text("Octree: %d levels, %d per octant, %d octants",
+				m_OctreeReport.m_uMaxLevel, m_OctreeReport.m_uIdealEntityCount, m_OctreeReport.m_uOctantCount);
+			ImGui::Text("Tree: %.3f [ms] Pairs: %.3f [ms] (%d tests)",
+				m_OctreeReport.m_dBuild, m_OctreeReport.m_dNarrowphase, m_OctreeReport.m_uPairTestCount);
+			ImGui::Checkbox("Tune", &m_bTuneOctree);
+			ImGui::SameLine();
+			ImGui::Text("%s, best %d/%d at %.3f [ms]", sTunerPhase[m_OctreeReport.m_ePhase],
+				m_OctreeReport.m_uBestLevel, m_OctreeReport.m_uBestIdealEntityCount, m_OctreeReport.m_dBestCost);
 			ImGui::Text("Controllers: %d", m_uControllerCount);
 			ImGui::Separator();
 			if (ImGui::Button("Console"))
@@ -428,16 +440,10 @@ bool Application::CreateDeviceObjects()
 		"	Out_Color = Frag_Color * texture( Texture, Frag_UV.st);\n"
 		"}\n";
 
-	gui.m_nShader = glCreateProgram();
-	gui.m_nVertHandle = glCreateShader(GL_VERTEX_SHADER);
-	gui.m_nFragHandle = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(gui.m_nVertHandle, 1, &vertex_shader, 0);
-	glShaderSource(gui.m_nFragHandle, 1, &fragment_shader, 0);
-	glCompileShader(gui.m_nVertHandle);
-	glCompileShader(gui.m_nFragHandle);
-	glAttachShader(gui.m_nShader, gui.m_nVertHandle);
-	glAttachShader(gui.m_nShader, gui.m_nFragHandle);
-	glLinkProgram(gui.m_nShader);
+	//the cache owns the program, it comes from the binary saved by the last run if it is still valid
+	MyShaderCache* pShaderCache = MyShaderCache::GetInstance();
+	pShaderCache->AddProgram("ImGui", vertex_shader, fragment_shader);
+	gui.m_nShader = pShaderCache->GetProgram("ImGui");
 
 	gui.m_nTex = glGetUniformLocation(gui.m_nShader, "Texture");
 	gui.m_nProjMtx = glGetUniformLocation(gui.m_nShader, "ProjMtx");
@@ -490,7 +496,8 @@ void Application::NewFrame()
 	height > 0 ? ((float)m_viewport[3] / height) : 0);
 	*/
 	// Setup time step
-	float fDelta = m_pSystem->GetDeltaTime(gui.m_nClock);
+	//the time of the frame Update measured, the recorder only holds that one
+	float fDelta = m_fDeltaTime;
 	io.DeltaTime = fDelta;
 	gui.m_dTimeTotal += fDelta;
 
@@ -530,9 +537,6 @@ void Application::InitIMGUI(void)
 	//io.ClipboardUserData = NULL;
 	io.ClipboardUserData = m_pWindow;
 	io.ImeWindowHandle = m_pWindow->getSystemHandle();
-
-	//Setup clock
-	gui.m_nClock = m_pSystem->GenClock();
 }
 void Application::ShutdownGUI(void)
 {
@@ -541,15 +545,7 @@ void Application::ShutdownGUI(void)
 	if (gui.m_uElements) glDeleteBuffers(1, &gui.m_uElements);
 	gui.m_uVAO = gui.m_uVBO = gui.m_uElements = 0;
 
-	if (gui.m_nShader && gui.m_nVertHandle) glDetachShader(gui.m_nShader, gui.m_nVertHandle);
-	if (gui.m_nVertHandle) glDeleteShader(gui.m_nVertHandle);
-	gui.m_nVertHandle = 0;
-
-	if (gui.m_nShader && gui.m_nFragHandle) glDetachShader(gui.m_nShader, gui.m_nFragHandle);
-	if (gui.m_nFragHandle) glDeleteShader(gui.m_nFragHandle);
-	gui.m_nFragHandle = 0;
-
-	if (gui.m_nShader) glDeleteProgram(gui.m_nShader);
+	//the program belongs to MyShaderCache, it is deleted with it
 	gui.m_nShader = 0;
 
 	if (gui.m_uFontTexture)
@@ -1,4 +1,5 @@
 #include "AppClass.h"
+#include <chrono>
 using namespace Simplex;
 sf::Image LoadImageFromResource(const std::string& name)
 {
@@ -80,89 +81,115 @@ void Application::Run(void)
 	// run the main loop
 	m_bRunning = true;
 	sf::Vector2i pos = m_pWindow->getPosition();
-	sf::Vector2u size = m_pWindow->getSize();
+	m_pSystem->SetWindowX(pos.x);
+	m_pSystem->SetWindowY(pos.y);
+	MyInputRecorder* pRecorder = MyInputRecorder::GetInstance();
 	while (m_bRunning)
 	{
-		// handle events
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		//a replay ends with its log
+		if (!pRecorder->BeginFrame())
+			break;
+
+		// handle events, while replaying only the window itself is listened to
 		sf::Event appEvent;
 		while (m_pWindow->pollEvent(appEvent))
 		{
-			switch (appEvent.type)
-			{
-			case sf::Event::Closed:
-				// end the program
-				m_bRunning = false;
-				break;
-			case sf::Event::Resized:
-				size = m_pWindow->getSize();
-				m_pSystem->SetWindowWidth(size.x);
-				m_pSystem->SetWindowHeight(size.y);
-				Reshape();
-				break;
-			case sf::Event::MouseMoved:
-				ProcessMouseMovement(appEvent);
-				if (pos != m_pWindow->getPosition())
-				{
-					pos = m_pWindow->getPosition();
-					size = m_pWindow->getSize();
-
-					m_pSystem->SetWindowX(pos.x);
-					m_pSystem->SetWindowY(pos.y);
-					m_pSystem->SetWindowWidth(size.x);
-					m_pSystem->SetWindowHeight(size.y);
-				}
-				break;
-			case sf::Event::MouseButtonPressed:
-				ProcessMousePressed(appEvent);
-				break;
-			case sf::Event::MouseButtonReleased:
-				ProcessMouseReleased(appEvent);
-				break;
-			case sf::Event::MouseWheelScrolled:
-				ProcessMouseScroll(appEvent);
-				break;
-			case sf::Event::KeyPressed:
-				ProcessKeyPressed(appEvent);
-				break;
-			case sf::Event::KeyReleased:
-				ProcessKeyReleased(appEvent);
-				break;
-			case sf::Event::TextEntered:
-				if (appEvent.text.unicode > 0 && appEvent.text.unicode < 0x10000)
-					ImGui::GetIO().AddInputCharacter(appEvent.text.unicode);
-				break;
-			case sf::Event::JoystickButtonPressed:
-				ProcessJoystickPressed(appEvent);
-				break;
-			case sf::Event::JoystickButtonReleased:
-				ProcessJoystickReleased(appEvent);
-				break;
-			case sf::Event::JoystickMoved:
-				ProcessJoystickMoved(appEvent);
-				break;
-			case sf::Event::JoystickConnected:
-				ProcessJoystickConnected(appEvent.joystickConnect.joystickId);
-				break;
-			case sf::Event::JoystickDisconnected:
-				InitControllers();
-				break;
-			case sf::Event::GainedFocus:
-				m_bFocused = true;
-				break;
-			case sf::Event::LostFocus:
-				m_bFocused = false;
-				break;
-			}
+			if (pRecorder->IsReplaying() &&
+				appEvent.type != sf::Event::Closed && appEvent.type != sf::Event::Resized)
+				continue;
+			pRecorder->RecordEvent(appEvent);
+			ProcessEvent(appEvent);
 		}
+		for (uint i = 0; i < pRecorder->GetEventCount(); ++i)
+			ProcessEvent(pRecorder->GetEvent(i));
+
 		ProcessKeyboard();//Continuous events
 		ProcessJoystick();//Continuous events
 		Update();
 		Display();
+
+		pRecorder->EndFrame(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
 	}
 
+	//a capture is flushed and a replay writes its timing
+	pRecorder->Stop();
+
 	//Write configuration of this program
 	WriteConfig();
 }
+void Application::ProcessEvent(sf::Event a_event)
+{
+	sf::Vector2i pos;
+	sf::Vector2u size;
+	switch (a_event.type)
+	{
+	case sf::Event::Closed:
+		// end the program
+		m_bRunning = false;
+		break;
+	case sf::Event::Resized:
+		size = m_pWindow->getSize();
+		m_pSystem->SetWindowWidth(size.x);
+		m_pSystem->SetWindowHeight(size.y);
+		Reshape();
+		break;
+	case sf::Event::MouseMoved:
+		ProcessMouseMovement(a_event);
+		pos = m_pWindow->getPosition();
+		if (pos.x != m_pSystem->GetWindowX() || pos.y != m_pSystem->GetWindowY())
+		{
+			size = m_pWindow->getSize();
+
+			m_pSystem->SetWindowX(pos.x);
+			m_pSystem->SetWindowY(pos.y);
+			m_pSystem->SetWindowWidth(size.x);
+			m_pSystem->SetWindowHeight(size.y);
+		}
+		break;
+	case sf::Event::MouseButtonPressed:
+		ProcessMousePressed(a_event);
+		break;
+	case sf::Event::MouseButtonReleased:
+		ProcessMouseReleased(a_event);
+		break;
+	case sf::Event::MouseWheelScrolled:
+		ProcessMouseScroll(a_event);
+		break;
+	case sf::Event::KeyPressed:
+		ProcessKeyPressed(a_event);
+		break;
+	case sf::Event::KeyReleased:
+		ProcessKeyReleased(a_event);
+		break;
+	case sf::Event::TextEntered:
+		if (a_event.text.unicode > 0 && a_event.text.unicode < 0x10000)
+			ImGui::GetIO().AddInputCharacter(a_event.text.unicode);
+		break;
+	case sf::Event::JoystickButtonPressed:
+		ProcessJoystickPressed(a_event);
+		break;
+	case sf::Event::JoystickButtonReleased:
+		ProcessJoystickReleased(a_event);
+		break;
+	case sf::Event::JoystickMoved:
+		ProcessJoystickMoved(a_event);
+		break;
+	case sf::Event::JoystickConnected:
+		ProcessJoystickConnected(a_event.joystickConnect.joystickId);
+		break;
+	case sf::Event::JoystickDisconnected:
+		InitControllers();
+		break;
+	case sf::Event::GainedFocus:
+		m_bFocused = true;
+		break;
+	case sf::Event::LostFocus:
+		m_bFocused = false;
+		break;
+	}
+}
 void Application::ClearScreen(vector4 a_v4ClearColor)
 {
 	if (a_v4ClearColor != vector4(-1.0f))
@@ -282,8 +309,10 @@ void Application::InitWindow(String a_sWindowName)
 														0,	//Attributes
 														false //sRGB
 													)); //context settings
-	m_pWindow->setVerticalSyncEnabled(true);
-	m_pWindow->setFramerateLimit(m_pSystem->GetMaxFrameRate());
+	//a timed replay draws as fast as it can
+	bool bFast = MyInputRecorder::GetInstance()->IsFast();
+	m_pWindow->setVerticalSyncEnabled(!bFast);
+	m_pWindow->setFramerateLimit(bFast ? 0 : m_pSystem->GetMaxFrameRate());
 	sf::Image icon = LoadImageFromResource("iconPNG");
 	m_pWindow->setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
 
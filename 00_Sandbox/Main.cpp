@@ -1,12 +1,34 @@
 // Include standard headers
 #include "Main.h"
 
-int main(void)
+/*
+Runs the sandbox, the input can be recorded and replayed so two builds run the same frames
+	--record FILE	write the seed, the input and the frame times to FILE
+	--replay FILE	take the seed and the input from FILE and write the time of each frame
+	--timing FILE	where --replay writes the time of each frame (replay.json)
+	--fast			draw without vertical sync or frame limit
+*/
+int main(int argc, char* argv[])
 {
 	using namespace Simplex;
+	MyInputRecorder* pRecorder = MyInputRecorder::GetInstance();
+	for (int i = 1; i < argc; ++i)
+	{
+		String sArgument = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (sArgument == "--record" && bHasValue)
+			pRecorder->StartCapture(argv[++i]);
+		else if (sArgument == "--replay" && bHasValue)
+			pRecorder->StartReplay(argv[++i]);
+		else if (sArgument == "--timing" && bHasValue)
+			pRecorder->SetTimingFile(argv[++i]);
+		else if (sArgument == "--fast")
+			pRecorder->SetFast(true);
+	}
+
 	Application* pApp = new Application();
 	pApp->Init("", RES_C_1280x720_16x9_HD, false, false);
 	pApp->Run();
 	SafeDelete(pApp);
 	return 0;
-}
\ No newline at end of file
+}
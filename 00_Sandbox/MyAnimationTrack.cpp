@@ -0,0 +1,321 @@
+#include "MyAnimationTrack.h"
+using namespace Simplex;
+//  MyAnimationTrack
+void MyAnimationTrack::Init(void)
+{
+	m_fLength = 0.0f;
+	m_v3Pivot = ZERO_V3;
+
+	m_v3TranslationMin = ZERO_V3;
+	m_v3TranslationRange = ZERO_V3;
+	m_v3ScaleMin = ZERO_V3;
+	m_v3ScaleRange = ZERO_V3;
+
+	m_TranslationList.clear();
+	m_RotationList.clear();
+	m_ScaleList.clear();
+	m_VisibleList.clear();
+	m_bVisible = true;
+}
+void MyAnimationTrack::Release(void)
+{
+	m_TranslationList.clear();
+	m_RotationList.clear();
+	m_ScaleList.clear();
+	m_VisibleList.clear();
+}
+void MyAnimationTrack::Swap(MyAnimationTrack& other)
+{
+	std::swap(m_fLength, other.m_fLength);
+	std::swap(m_v3Pivot, other.m_v3Pivot);
+
+	std::swap(m_v3TranslationMin, other.m_v3TranslationMin);
+	std::swap(m_v3TranslationRange, other.m_v3TranslationRange);
+	std::swap(m_v3ScaleMin, other.m_v3ScaleMin);
+	std::swap(m_v3ScaleRange, other.m_v3ScaleRange);
+
+	std::swap(m_TranslationList, other.m_TranslationList);
+	std::swap(m_RotationList, other.m_RotationList);
+	std::swap(m_ScaleList, other.m_ScaleList);
+	std::swap(m_VisibleList, other.m_VisibleList);
+	std::swap(m_bVisible, other.m_bVisible);
+}
+//The big 3
+MyAnimationTrack::MyAnimationTrack(void) { Init(); }
+MyAnimationTrack::MyAnimationTrack(MyAnimationTrack const& other)
+{
+	m_fLength = other.m_fLength;
+	m_v3Pivot = other.m_v3Pivot;
+
+	m_v3TranslationMin = other.m_v3TranslationMin;
+	m_v3TranslationRange = other.m_v3TranslationRange;
+	m_v3ScaleMin = other.m_v3ScaleMin;
+	m_v3ScaleRange = other.m_v3ScaleRange;
+
+	m_TranslationList = other.m_TranslationList;
+	m_RotationList = other.m_RotationList;
+	m_ScaleList = other.m_ScaleList;
+	m_VisibleList = other.m_VisibleList;
+	m_bVisible = other.m_bVisible;
+}
+MyAnimationTrack& MyAnimationTrack::operator=(MyAnimationTrack const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyAnimationTrack temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyAnimationTrack::~MyAnimationTrack() { Release(); };
+//Accessors
+float MyAnimationTrack::GetLength(void) { return m_fLength; }
+uint MyAnimationTrack::GetKeyCount(void)
+{
+	return static_cast<uint>(m_TranslationList.size() + m_RotationList.size() + m_ScaleList.size() + m_VisibleList.size());
+}
+size_t MyAnimationTrack::GetMemoryUsage(void)
+{
+	return sizeof(MyAnimationTrack) + m_TranslationList.capacity() * sizeof(MyVectorKey) +
+		m_RotationList.capacity() * sizeof(MyRotationKey) + m_ScaleList.capacity() * sizeof(MyVectorKey) +
+		m_VisibleList.capacity() * sizeof(unsigned short);
+}
+//--- Methods
+bool MyAnimationTrack::Compress(Group* a_pGroup)
+{
+	uint uFrameCount = a_pGroup->GetFrameCount();
+	std::vector<vector3> lTranslation(uFrameCount);
+	std::vector<quaternion> lRotation(uFrameCount);
+	std::vector<vector3> lScale(uFrameCount);
+	std::vector<bool> lVisible(uFrameCount);
+	for (uint i = 0; i < uFrameCount; ++i)
+	{
+		Frame frame = a_pGroup->GetFrame(i);
+		lTranslation[i] = frame.GetPos();
+		//the frames keep euler angles in degrees
+		lRotation[i] = quaternion(glm::radians(frame.GetAng()));
+		lScale[i] = frame.GetSize();
+		lVisible[i] = frame.IsVisible();
+	}
+	Compress(lTranslation, lRotation, lScale, lVisible, a_pGroup->GetPivot());
+	return uFrameCount > 1;
+}
+void MyAnimationTrack::Compress(std::vector<vector3> const& a_lTranslation, std::vector<quaternion> const& a_lRotation,
+	std::vector<vector3> const& a_lScale, std::vector<bool> const& a_lVisible, vector3 a_v3Pivot)
+{
+	Release();
+	Init();
+	m_v3Pivot = a_v3Pivot;
+	if (a_lTranslation.size() == 0)
+		return;
+	m_fLength = static_cast<float>(a_lTranslation.size() - 1);
+
+	CompressVector(a_lTranslation, m_v3TranslationMin, m_v3TranslationRange, m_TranslationList);
+	CompressRotation(a_lRotation, m_RotationList);
+	CompressVector(a_lScale, m_v3ScaleMin, m_v3ScaleRange, m_ScaleList);
+
+	m_bVisible = a_lVisible.size() == 0 || a_lVisible[0];
+	for (uint i = 1; i < a_lVisible.size(); ++i)
+	{
+		//rounded down so sampling the frame itself already sees the flip
+		if (a_lVisible[i] != a_lVisible[i - 1])
+			m_VisibleList.push_back(static_cast<unsigned short>(GetTick(static_cast<float>(i))));
+	}
+	m_VisibleList.shrink_to_fit();
+}
+void MyAnimationTrack::Sample(float a_fFrame, vector3& a_v3Translation, quaternion& a_qRotation, vector3& a_v3Scale)
+{
+	float fTick = GetTick(a_fFrame);
+	a_v3Translation = SampleVector(m_TranslationList, m_v3TranslationMin, m_v3TranslationRange, fTick);
+	a_qRotation = SampleRotation(m_RotationList, fTick);
+	a_v3Scale = m_ScaleList.size() > 0 ? SampleVector(m_ScaleList, m_v3ScaleMin, m_v3ScaleRange, fTick) : vector3(1.0f);
+}
+matrix4 MyAnimationTrack::GetTransform(float a_fFrame)
+{
+	vector3 v3Translation;
+	quaternion qRotation;
+	vector3 v3Scale;
+	Sample(a_fFrame, v3Translation, qRotation, v3Scale);
+	return ComposeTransform(v3Translation, qRotation, v3Scale, m_v3Pivot);
+}
+matrix4 MyAnimationTrack::ComposeTransform(vector3 a_v3Translation, quaternion a_qRotation, vector3 a_v3Scale, vector3 a_v3Pivot)
+{
+	return glm::translate(a_v3Translation + a_v3Pivot) * ToMatrix4(a_qRotation) * glm::scale(a_v3Scale) * glm::translate(-a_v3Pivot);
+}
+bool MyAnimationTrack::IsVisible(float a_fFrame)
+{
+	//every flip before the time toggles the first visibility
+	float fTick = GetTick(a_fFrame);
+	bool bVisible = m_bVisible;
+	for (uint i = 0; i < m_VisibleList.size() && static_cast<float>(m_VisibleList[i]) <= fTick; ++i)
+		bVisible = !bVisible;
+	return bVisible;
+}
+void MyAnimationTrack::Apply(Group* a_pGroup, float a_fFrame)
+{
+	vector3 v3Translation;
+	quaternion qRotation;
+	vector3 v3Scale;
+	Sample(a_fFrame, v3Translation, qRotation, v3Scale);
+	if (a_pGroup->GetFrameCount() < 1)
+		a_pGroup->GenerateFrames(1);
+	a_pGroup->SetFrame(0, v3Translation, glm::degrees(glm::eulerAngles(qRotation)), v3Scale, IsVisible(a_fFrame), true);
+	a_pGroup->ComputeTransforms();
+}
+float MyAnimationTrack::GetTick(float a_fFrame)
+{
+	if (m_fLength <= 0.0f)
+		return 0.0f;
+	float fTick = a_fFrame / m_fLength * static_cast<float>(ANIMATION_TICKS);
+	return glm::clamp(fTick, 0.0f, static_cast<float>(ANIMATION_TICKS));
+}
+void MyAnimationTrack::CompressVector(std::vector<vector3> const& a_lValue, vector3& a_v3Min, vector3& a_v3Range, std::vector<MyVectorKey>& a_lKey)
+{
+	a_lKey.clear();
+	uint uCount = static_cast<uint>(a_lValue.size());
+	if (uCount == 0)
+		return;
+
+	vector3 v3Max = a_lValue[0];
+	a_v3Min = a_lValue[0];
+	for (uint i = 1; i < uCount; ++i)
+	{
+		a_v3Min = glm::min(a_v3Min, a_lValue[i]);
+		v3Max = glm::max(v3Max, a_lValue[i]);
+	}
+	a_v3Range = v3Max - a_v3Min;
+	float fTolerance = ANIMATION_VECTOR_TOLERANCE * std::max(std::max(a_v3Range.x, a_v3Range.y), a_v3Range.z);
+
+	//a segment grows while the line between its ends goes through every frame it skips
+	std::vector<uint> lKept;
+	lKept.push_back(0);
+	uint uStart = 0;
+	for (uint uEnd = 2; uEnd < uCount; ++uEnd)
+	{
+		bool bFits = true;
+		for (uint i = uStart + 1; i < uEnd && bFits; ++i)
+		{
+			float fT = static_cast<float>(i - uStart) / static_cast<float>(uEnd - uStart);
+			vector3 v3Error = glm::abs(glm::mix(a_lValue[uStart], a_lValue[uEnd], fT) - a_lValue[i]);
+			bFits = std::max(std::max(v3Error.x, v3Error.y), v3Error.z) <= fTolerance;
+		}
+		if (!bFits)
+		{
+			uStart = uEnd - 1;
+			lKept.push_back(uStart);
+		}
+	}
+	if (uCount > 1)
+		lKept.push_back(uCount - 1);
+
+	//a constant channel is a single key
+	if (fTolerance <= 0.0f)
+		lKept.resize(1);
+
+	a_lKey.resize(lKept.size());
+	for (uint i = 0; i < lKept.size(); ++i)
+	{
+		a_lKey[i].m_uTime = static_cast<unsigned short>(GetTick(static_cast<float>(lKept[i])) + 0.5f);
+		vector3 v3Value = a_lValue[lKept[i]];
+		for (uint j = 0; j < 3; ++j)
+		{
+			float fValue = a_v3Range[j] > 0.0f ? (v3Value[j] - a_v3Min[j]) / a_v3Range[j] : 0.0f;
+			a_lKey[i].m_uValue[j] = static_cast<unsigned short>(glm::clamp(fValue, 0.0f, 1.0f) * 65535.0f + 0.5f);
+		}
+	}
+}
+void MyAnimationTrack::CompressRotation(std::vector<quaternion> const& a_lValue, std::vector<MyRotationKey>& a_lKey)
+{
+	a_lKey.clear();
+	uint uCount = static_cast<uint>(a_lValue.size());
+	if (uCount == 0)
+		return;
+
+	//q and -q are the same rotation, keeping neighbours in the same hemisphere makes slerp take the short way
+	std::vector<quaternion> lValue(a_lValue);
+	for (uint i = 0; i < uCount; ++i)
+	{
+		lValue[i] = glm::normalize(lValue[i]);
+		if (i > 0 && glm::dot(lValue[i - 1], lValue[i]) < 0.0f)
+			lValue[i] = -lValue[i];
+	}
+
+	std::vector<uint> lKept;
+	lKept.push_back(0);
+	uint uStart = 0;
+	for (uint uEnd = 2; uEnd < uCount; ++uEnd)
+	{
+		bool bFits = true;
+		for (uint i = uStart + 1; i < uEnd && bFits; ++i)
+		{
+			float fT = static_cast<float>(i - uStart) / static_cast<float>(uEnd - uStart);
+			quaternion qSample = glm::slerp(lValue[uStart], lValue[uEnd], fT);
+			bFits = 1.0f - std::abs(glm::dot(qSample, lValue[i])) <= ANIMATION_ROTATION_TOLERANCE;
+		}
+		if (!bFits)
+		{
+			uStart = uEnd - 1;
+			lKept.push_back(uStart);
+		}
+	}
+	if (uCount > 1)
+		lKept.push_back(uCount - 1);
+
+	//a track that never turns keeps only the first key
+	if (lKept.size() == 2 && 1.0f - std::abs(glm::dot(lValue[0], lValue[uCount - 1])) <= ANIMATION_ROTATION_TOLERANCE)
+	{
+		bool bConstant = true;
+		for (uint i = 1; i < uCount - 1 && bConstant; ++i)
+			bConstant = 1.0f - std::abs(glm::dot(lValue[0], lValue[i])) <= ANIMATION_ROTATION_TOLERANCE;
+		if (bConstant)
+			lKept.resize(1);
+	}
+
+	a_lKey.resize(lKept.size());
+	for (uint i = 0; i < lKept.size(); ++i)
+	{
+		a_lKey[i].m_uTime = static_cast<unsigned short>(GetTick(static_cast<float>(lKept[i])) + 0.5f);
+		quaternion qValue = lValue[lKept[i]];
+		float fValue[4] = { qValue.x, qValue.y, qValue.z, qValue.w };
+		for (uint j = 0; j < 4; ++j)
+			a_lKey[i].m_nValue[j] = static_cast<short>(std::floor(glm::clamp(fValue[j], -1.0f, 1.0f) * 32767.0f + 0.5f));
+	}
+}
+vector3 MyAnimationTrack::SampleVector(std::vector<MyVectorKey> const& a_lKey, vector3 a_v3Min, vector3 a_v3Range, float a_fTick)
+{
+	if (a_lKey.size() == 0)
+		return ZERO_V3;
+	uint uKey = FindKey(a_lKey, a_fTick);
+	if (uKey + 1 >= a_lKey.size())
+		return GetValue(a_lKey[uKey], a_v3Min, a_v3Range);
+
+	float fStart = static_cast<float>(a_lKey[uKey].m_uTime);
+	float fEnd = static_cast<float>(a_lKey[uKey + 1].m_uTime);
+	float fT = fEnd > fStart ? glm::clamp((a_fTick - fStart) / (fEnd - fStart), 0.0f, 1.0f) : 0.0f;
+	return glm::mix(GetValue(a_lKey[uKey], a_v3Min, a_v3Range), GetValue(a_lKey[uKey + 1], a_v3Min, a_v3Range), fT);
+}
+quaternion MyAnimationTrack::SampleRotation(std::vector<MyRotationKey> const& a_lKey, float a_fTick)
+{
+	if (a_lKey.size() == 0)
+		return quaternion();
+	uint uKey = FindKey(a_lKey, a_fTick);
+	if (uKey + 1 >= a_lKey.size())
+		return GetValue(a_lKey[uKey]);
+
+	float fStart = static_cast<float>(a_lKey[uKey].m_uTime);
+	float fEnd = static_cast<float>(a_lKey[uKey + 1].m_uTime);
+	float fT = fEnd > fStart ? glm::clamp((a_fTick - fStart) / (fEnd - fStart), 0.0f, 1.0f) : 0.0f;
+	return glm::normalize(glm::slerp(GetValue(a_lKey[uKey]), GetValue(a_lKey[uKey + 1]), fT));
+}
+vector3 MyAnimationTrack::GetValue(MyVectorKey const& a_Key, vector3 a_v3Min, vector3 a_v3Range)
+{
+	return a_v3Min + a_v3Range * vector3(a_Key.m_uValue[0], a_Key.m_uValue[1], a_Key.m_uValue[2]) / 65535.0f;
+}
+quaternion MyAnimationTrack::GetValue(MyRotationKey const& a_Key)
+{
+	//glm takes w first
+	return glm::normalize(quaternion(a_Key.m_nValue[3] / 32767.0f, a_Key.m_nValue[0] / 32767.0f,
+		a_Key.m_nValue[1] / 32767.0f, a_Key.m_nValue[2] / 32767.0f));
+}
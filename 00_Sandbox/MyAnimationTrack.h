@@ -0,0 +1,259 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYANIMATIONTRACK_H_
+#define __MYANIMATIONTRACK_H_
+
+#include "Simplex\Simplex.h"
+
+#define ANIMATION_TICKS 65535 //ticks between the first and the last frame, the time resolution of a key
+#define ANIMATION_VECTOR_TOLERANCE 0.0005f //error allowed when a key is dropped, as a fraction of the range of the channel
+#define ANIMATION_ROTATION_TOLERANCE 0.00001f //error allowed when a key is dropped, as 1 - |dot| of the quaternions (about half a degree)
+
+namespace Simplex
+{
+
+//Key of a translation or scale channel, the value quantized in the range of the channel
+struct MyVectorKey
+{
+	unsigned short m_uTime = 0; //tick of the key
+	unsigned short m_uValue[3] = { 0, 0, 0 }; //x, y and z from the minimum (0) to the maximum (65535) of the channel
+};
+
+//Key of the rotation channel, a quaternion quantized per component
+struct MyRotationKey
+{
+	unsigned short m_uTime = 0; //tick of the key
+	short m_nValue[4] = { 0, 0, 0, 32767 }; //x, y, z and w from -1 (-32767) to 1 (32767)
+};
+
+//Animation of a group stored as sparse keys, sampled at any time
+class MyAnimationTrack
+{
+	float m_fLength = 0.0f; //frames between the first and the last key
+	vector3 m_v3Pivot = ZERO_V3; //pivot of the group, the rotation and the scale happen around it
+
+	vector3 m_v3TranslationMin = ZERO_V3; //minimum of the translation channel
+	vector3 m_v3TranslationRange = ZERO_V3; //maximum minus minimum of the translation channel
+	vector3 m_v3ScaleMin = ZERO_V3; //minimum of the scale channel
+	vector3 m_v3ScaleRange = ZERO_V3; //maximum minus minimum of the scale channel
+
+	std::vector<MyVectorKey> m_TranslationList; //translation keys, linearly interpolated
+	std::vector<MyRotationKey> m_RotationList; //rotation keys, spherically interpolated
+	std::vector<MyVectorKey> m_ScaleList; //scale keys, linearly interpolated
+	std::vector<unsigned short> m_VisibleList; //ticks where the visibility flips
+	bool m_bVisible = true; //visibility at the first frame
+
+public:
+	/*
+	Usage: Constructor, the track is empty until compressed
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyAnimationTrack(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyAnimationTrack(MyAnimationTrack const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyAnimationTrack& operator=(MyAnimationTrack const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyAnimationTrack(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyAnimationTrack& other);
+	/*
+	USAGE: Compresses the frames of a group, the keys that the neighbouring keys interpolate within
+	the tolerances are dropped, so the frames Animation::Interpolation filled in cost nothing
+	ARGUMENTS: Group* a_pGroup -> group with its frames generated
+	OUTPUT: does the group have more than one frame?
+	*/
+	bool Compress(Group* a_pGroup);
+	/*
+	USAGE: Compresses one value per frame of each channel
+	ARGUMENTS:
+	-	std::vector<vector3> const& a_lTranslation -> translation of every frame
+	-	std::vector<quaternion> const& a_lRotation -> rotation of every frame
+	-	std::vector<vector3> const& a_lScale -> scale of every frame
+	-	std::vector<bool> const& a_lVisible -> visibility of every frame
+	-	vector3 a_v3Pivot -> pivot of the group
+	OUTPUT: ---
+	*/
+	void Compress(std::vector<vector3> const& a_lTranslation, std::vector<quaternion> const& a_lRotation,
+		std::vector<vector3> const& a_lScale, std::vector<bool> const& a_lVisible, vector3 a_v3Pivot);
+	/*
+	USAGE: Samples the track, between keys the translation and the scale are lerped and the rotation
+	is slerped; the time is clamped to the track
+	ARGUMENTS:
+	-	float a_fFrame -> time in frames, fractions included
+	-	vector3& a_v3Translation -> translation at that time
+	-	quaternion& a_qRotation -> rotation at that time
+	-	vector3& a_v3Scale -> scale at that time
+	OUTPUT: ---
+	*/
+	void Sample(float a_fFrame, vector3& a_v3Translation, quaternion& a_qRotation, vector3& a_v3Scale);
+	/*
+	USAGE: Gets the transform of the group at a time, relative to its parent
+	ARGUMENTS: float a_fFrame -> time in frames, fractions included
+	OUTPUT: translation * pivot * rotation * scale * -pivot
+	*/
+	matrix4 GetTransform(float a_fFrame);
+	/*
+	USAGE: Composes a transform the way the tracks do
+	ARGUMENTS:
+	-	vector3 a_v3Translation -> translation
+	-	quaternion a_qRotation -> rotation around the pivot
+	-	vector3 a_v3Scale -> scale around the pivot
+	-	vector3 a_v3Pivot -> pivot
+	OUTPUT: translation * pivot * rotation * scale * -pivot
+	*/
+	static matrix4 ComposeTransform(vector3 a_v3Translation, quaternion a_qRotation, vector3 a_v3Scale, vector3 a_v3Pivot);
+	/*
+	USAGE: Gets the visibility of the group at a time
+	ARGUMENTS: float a_fFrame -> time in frames, fractions included
+	OUTPUT: is it visible?
+	*/
+	bool IsVisible(float a_fFrame);
+	/*
+	USAGE: Writes the sample of a time as the only frame of the group and computes its transform
+	ARGUMENTS:
+	-	Group* a_pGroup -> group the track was compressed from
+	-	float a_fFrame -> time in frames, fractions included
+	OUTPUT: ---
+	*/
+	void Apply(Group* a_pGroup, float a_fFrame);
+	/*
+	USAGE: Gets the frames between the first and the last key
+	ARGUMENTS: ---
+	OUTPUT: length
+	*/
+	float GetLength(void);
+	/*
+	USAGE: Gets the number of keys left in every channel
+	ARGUMENTS: ---
+	OUTPUT: key count
+	*/
+	uint GetKeyCount(void);
+	/*
+	USAGE: Gets the bytes used by the keys and the track itself
+	ARGUMENTS: ---
+	OUTPUT: memory usage
+	*/
+	size_t GetMemoryUsage(void);
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Gets the tick of a time
+	ARGUMENTS: float a_fFrame -> time in frames
+	OUTPUT: ticks from the first frame, fractions included
+	*/
+	float GetTick(float a_fFrame);
+	/*
+	USAGE: Keeps the keys a linear interpolation cannot skip and quantizes them
+	ARGUMENTS:
+	-	std::vector<vector3> const& a_lValue -> value of every frame
+	-	vector3& a_v3Min -> gets the minimum of the channel
+	-	vector3& a_v3Range -> gets the range of the channel
+	-	std::vector<MyVectorKey>& a_lKey -> gets the keys
+	OUTPUT: ---
+	*/
+	void CompressVector(std::vector<vector3> const& a_lValue, vector3& a_v3Min, vector3& a_v3Range, std::vector<MyVectorKey>& a_lKey);
+	/*
+	USAGE: Keeps the keys a spherical interpolation cannot skip and quantizes them
+	ARGUMENTS:
+	-	std::vector<quaternion> const& a_lValue -> value of every frame
+	-	std::vector<MyRotationKey>& a_lKey -> gets the keys
+	OUTPUT: ---
+	*/
+	void CompressRotation(std::vector<quaternion> const& a_lValue, std::vector<MyRotationKey>& a_lKey);
+	/*
+	USAGE: Samples a translation or scale channel
+	ARGUMENTS:
+	-	std::vector<MyVectorKey> const& a_lKey -> keys of the channel
+	-	vector3 a_v3Min -> minimum of the channel
+	-	vector3 a_v3Range -> range of the channel
+	-	float a_fTick -> time in ticks
+	OUTPUT: value at that time
+	*/
+	static vector3 SampleVector(std::vector<MyVectorKey> const& a_lKey, vector3 a_v3Min, vector3 a_v3Range, float a_fTick);
+	/*
+	USAGE: Samples the rotation channel
+	ARGUMENTS:
+	-	std::vector<MyRotationKey> const& a_lKey -> keys of the channel
+	-	float a_fTick -> time in ticks
+	OUTPUT: value at that time
+	*/
+	static quaternion SampleRotation(std::vector<MyRotationKey> const& a_lKey, float a_fTick);
+	/*
+	USAGE: Dequantizes a vector key
+	ARGUMENTS:
+	-	MyVectorKey const& a_Key -> key
+	-	vector3 a_v3Min -> minimum of the channel
+	-	vector3 a_v3Range -> range of the channel
+	OUTPUT: value of the key
+	*/
+	static vector3 GetValue(MyVectorKey const& a_Key, vector3 a_v3Min, vector3 a_v3Range);
+	/*
+	USAGE: Dequantizes a rotation key
+	ARGUMENTS: MyRotationKey const& a_Key -> key
+	OUTPUT: normalized value of the key
+	*/
+	static quaternion GetValue(MyRotationKey const& a_Key);
+	/*
+	USAGE: Finds the last key at or before a time, by binary search
+	ARGUMENTS:
+	-	std::vector<T> const& a_lKey -> keys of a channel, at least one
+	-	float a_fTick -> time in ticks
+	OUTPUT: index of the key, the time falls between it and the next one
+	*/
+	template <class T>
+	static uint FindKey(std::vector<T> const& a_lKey, float a_fTick)
+	{
+		uint uFirst = 0;
+		uint uLast = static_cast<uint>(a_lKey.size()) - 1;
+		while (uFirst < uLast)
+		{
+			uint uMiddle = (uFirst + uLast + 1) / 2;
+			if (static_cast<float>(a_lKey[uMiddle].m_uTime) <= a_fTick)
+				uFirst = uMiddle;
+			else
+				uLast = uMiddle - 1;
+		}
+		return uFirst;
+	}
+};//class
+
+} //namespace Simplex
+
+#endif //__MYANIMATIONTRACK_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,274 @@
+#include "MyAssetStreamer.h"
+using namespace Simplex;
+//  MyAssetStreamer
+MyAssetStreamer* MyAssetStreamer::m_pInstance = nullptr;
+void MyAssetStreamer::Init(void)
+{
+	m_bExit = false;
+	m_uBudget = STREAM_UPLOAD_BUDGET;
+	m_uInFlight = 0;
+	m_uUploadCount = 0;
+	glGenBuffers(1, &m_uPBO);
+
+	//the workers get touched by nothing but the job lists, so the cookers are made here on the GL thread
+	MyModelCooker::GetInstance();
+	MyTextureCooker::GetInstance();
+	uint uThreadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	for (uint i = 0; i < uThreadCount; ++i)
+	{
+		m_ThreadList.push_back(std::thread(&MyAssetStreamer::Work, this));
+	}
+}
+void MyAssetStreamer::Release(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bExit = true;
+	}
+	m_Condition.notify_all();
+	for (uint i = 0; i < m_ThreadList.size(); ++i)
+	{
+		m_ThreadList[i].join();
+	}
+	m_ThreadList.clear();
+
+	//the jobs nobody finished keep their placeholder
+	for (uint i = 0; i < m_PendingList.size(); ++i)
+	{
+		SafeDelete(m_PendingList[i]);
+	}
+	m_PendingList.clear();
+	for (uint i = 0; i < m_ReadyList.size(); ++i)
+	{
+		SafeDelete(m_ReadyList[i]);
+	}
+	m_ReadyList.clear();
+
+	for (auto texture = m_TextureMap.begin(); texture != m_TextureMap.end(); ++texture)
+	{
+		glDeleteTextures(1, &texture->second);
+	}
+	m_TextureMap.clear();
+	m_ModelSet.clear();
+	if (m_uPBO != 0)
+	{
+		glDeleteBuffers(1, &m_uPBO);
+		m_uPBO = 0;
+	}
+	m_uInFlight = 0;
+}
+MyAssetStreamer* MyAssetStreamer::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyAssetStreamer();
+	}
+	return m_pInstance;
+}
+void MyAssetStreamer::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyAssetStreamer::MyAssetStreamer() { Init(); }
+MyAssetStreamer::MyAssetStreamer(MyAssetStreamer const& a_pOther) { }
+MyAssetStreamer& MyAssetStreamer::operator=(MyAssetStreamer const& a_pOther) { return *this; }
+MyAssetStreamer::~MyAssetStreamer() { Release(); };
+//Accessors
+void MyAssetStreamer::SetBudget(uint a_uBytes) { m_uBudget = a_uBytes; }
+uint MyAssetStreamer::GetBudget(void) { return m_uBudget; }
+uint MyAssetStreamer::GetPendingCount(void) { return m_uInFlight; }
+uint MyAssetStreamer::GetUploadCount(void) { return m_uUploadCount; }
+//--- Methods
+GLuint MyAssetStreamer::RequestTexture(String a_sFileName, vector3 a_v3Placeholder)
+{
+	//relative names are in the textures folder, like the library looks for them
+	String sPath = a_sFileName;
+	bool bAbsolute = sPath.find(':') != String::npos || (sPath.size() > 0 && (sPath[0] == '\\' || sPath[0] == '/'));
+	if (!bAbsolute)
+		sPath = Folder::GetInstance()->GetFolderTextures() + sPath;
+	auto texture = m_TextureMap.find(sPath);
+	if (texture != m_TextureMap.end())
+		return texture->second;
+
+	//the placeholder is a single texel of the given color
+	BYTE lTexel[4] = { static_cast<BYTE>(a_v3Placeholder.b * 255.0f), static_cast<BYTE>(a_v3Placeholder.g * 255.0f),
+		static_cast<BYTE>(a_v3Placeholder.r * 255.0f), 255 };
+	GLuint uTexture = 0;
+	glGenTextures(1, &uTexture);
+	glBindTexture(GL_TEXTURE_2D, uTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_BGRA, GL_UNSIGNED_BYTE, lTexel);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	m_TextureMap[sPath] = uTexture;
+
+	MyStreamJob* pJob = new MyStreamJob();
+	pJob->m_sFileName = sPath;
+	pJob->m_uTexture = uTexture;
+	Queue(pJob);
+	return uTexture;
+}
+void MyAssetStreamer::RequestModel(String a_sFileName)
+{
+	String sKey = MyModelCache::ResolvePath(a_sFileName);
+	if (m_ModelSet.find(sKey) != m_ModelSet.end())
+		return;
+	m_ModelSet.insert(sKey);
+
+	MyStreamJob* pJob = new MyStreamJob();
+	pJob->m_bModel = true;
+	pJob->m_sFileName = a_sFileName;
+	Queue(pJob);
+}
+void MyAssetStreamer::Queue(MyStreamJob* a_pJob)
+{
+	++m_uInFlight;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_PendingList.push_back(a_pJob);
+	}
+	m_Condition.notify_one();
+}
+void MyAssetStreamer::Update(void)
+{
+	uint uBytes = 0;
+	while (m_uInFlight > 0)
+	{
+		MyStreamJob* pJob = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_ReadyList.size() == 0)
+				break;
+			//the budget is checked before the job is taken so a big texture waits for the next frame
+			MyStreamJob* pNext = m_ReadyList.front();
+			if (uBytes > 0 && (uBytes >= m_uBudget || pNext->m_uBytes > m_uBudget - uBytes))
+				break;
+			m_ReadyList.pop_front();
+			pJob = pNext;
+		}
+		--m_uInFlight;
+
+		if (pJob->m_bModel)
+		{
+			//the cooked file is up to date, loading it is a map and a copy; the entities waiting on a
+			//model that could not be cooked still get it, loaded the slow way
+			MyModelCache::GetInstance()->FinishStreaming(pJob->m_sFileName);
+			//a purged model can be requested again
+			m_ModelSet.erase(MyModelCache::ResolvePath(pJob->m_sFileName));
+		}
+		else if (pJob->m_bLoaded)
+		{
+			uBytes += static_cast<uint>(pJob->m_uBytes);
+			Upload(pJob);
+		}
+		SafeDelete(pJob);
+	}
+}
+void MyAssetStreamer::Flush(void)
+{
+	uint uBudget = m_uBudget;
+	m_uBudget = static_cast<uint>(-1);
+	while (m_uInFlight > 0)
+	{
+		Update();
+		if (m_uInFlight > 0)
+			std::this_thread::yield();
+	}
+	m_uBudget = uBudget;
+}
+void MyAssetStreamer::Work(void)
+{
+	while (true)
+	{
+		MyStreamJob* pJob = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			while (!m_bExit && m_PendingList.size() == 0)
+				m_Condition.wait(lock);
+			if (m_bExit)
+				return;
+			pJob = m_PendingList.front();
+			m_PendingList.pop_front();
+		}
+
+		if (pJob->m_bModel)
+			pJob->m_bLoaded = MyModelCooker::GetInstance()->Prepare(pJob->m_sFileName);
+		else
+			Decode(pJob);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_ReadyList.push_back(pJob);
+	}
+}
+void MyAssetStreamer::Decode(MyStreamJob* a_pJob)
+{
+	if (MyTextureCooker::GetInstance()->Load(a_pJob->m_sFileName, a_pJob->m_File, a_pJob->m_Cooked))
+	{
+		a_pJob->m_uBytes = a_pJob->m_Cooked.m_uSize;
+		a_pJob->m_bLoaded = true;
+		return;
+	}
+
+	//the image could not be cooked, it is used as it is
+	a_pJob->m_bLoaded = MyTextureCooker::ReadImage(a_pJob->m_sFileName, a_pJob->m_uWidth, a_pJob->m_uHeight, a_pJob->m_Texels);
+	a_pJob->m_uBytes = a_pJob->m_Texels.size();
+}
+void MyAssetStreamer::Upload(MyStreamJob* a_pJob)
+{
+	MyCookedTexture const& cooked = a_pJob->m_Cooked;
+	char const* pData = cooked.m_uFormat != 0 ? a_pJob->m_File.GetData() + cooked.m_uOffset :
+		reinterpret_cast<char const*>(a_pJob->m_Texels.data());
+	GLsizeiptr uSize = static_cast<GLsizeiptr>(a_pJob->m_uBytes);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uPBO);
+	//orphaning the storage lets the driver keep reading the last upload while this one is written
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, uSize, nullptr, GL_STREAM_DRAW);
+	void* pBuffer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, uSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	char const* pSource = nullptr;
+	if (pBuffer != nullptr)
+	{
+		memcpy(pBuffer, pData, a_pJob->m_uBytes);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	}
+	else
+	{
+		//no mapping, upload from client memory
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		pSource = pData;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, a_pJob->m_uTexture);
+	if (cooked.m_uFormat != 0)
+	{
+		//every level is in the file, the blocks go to the GPU as they are
+		uint uWidth = cooked.m_uWidth;
+		uint uHeight = cooked.m_uHeight;
+		size_t uOffset = 0;
+		for (uint i = 0; i < cooked.m_uLevels; ++i)
+		{
+			uint uLevelSize = MyTextureCooker::GetLevelSize(cooked.m_uFormat, uWidth, uHeight);
+			glCompressedTexImage2D(GL_TEXTURE_2D, i, cooked.m_uFormat, uWidth, uHeight, 0, uLevelSize, pSource + uOffset);
+			uOffset += uLevelSize;
+			uWidth = std::max(uWidth / 2, 1u);
+			uHeight = std::max(uHeight / 2, 1u);
+		}
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, cooked.m_uLevels - 1);
+	}
+	else
+	{
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, a_pJob->m_uWidth, a_pJob->m_uHeight, 0, GL_BGRA, GL_UNSIGNED_BYTE, pSource);
+		glGenerateMipmap(GL_TEXTURE_2D);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	a_pJob->m_File.Close();
+	++m_uUploadCount;
+}
@@ -0,0 +1,194 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYASSETSTREAMER_H_
+#define __MYASSETSTREAMER_H_
+
+#include "MyModelCache.h"
+#include "MyTextureCooker.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define STREAM_UPLOAD_BUDGET 4194304 //bytes of texels uploaded per frame unless changed with SetBudget
+
+namespace Simplex
+{
+
+//Work for the streamer, decoded on a worker thread and finished on the GL thread
+struct MyStreamJob
+{
+	bool m_bModel = false; //cook a model instead of decoding a texture
+	String m_sFileName = ""; //full path of the texture or name of the model
+	GLuint m_uTexture = 0; //texture that gets the texels, it holds the placeholder until then
+	MyMappedFile m_File; //cooked texture, mapped by the worker
+	MyCookedTexture m_Cooked; //levels of the cooked texture, no format if the image is used instead
+	uint m_uWidth = 0; //width of the decoded image
+	uint m_uHeight = 0; //height of the decoded image
+	std::vector<BYTE> m_Texels; //BGRA rows from the bottom up, the way both FreeImage and OpenGL store them
+	size_t m_uBytes = 0; //bytes to upload, counted against the budget
+	bool m_bLoaded = false; //did the worker succeed?
+};
+
+//System Class
+class MyAssetStreamer
+{
+	std::vector<std::thread> m_ThreadList; //workers that read and decode the files
+	std::mutex m_Mutex; //guards the job lists and the exit flag
+	std::condition_variable m_Condition; //wakes the workers when there is a job or on exit
+	std::deque<MyStreamJob*> m_PendingList; //jobs waiting for a worker
+	std::deque<MyStreamJob*> m_ReadyList; //jobs waiting for the GL thread
+	bool m_bExit = false; //tells the workers to stop
+
+	std::map<String, GLuint> m_TextureMap; //textures requested so far by full path
+	std::set<String> m_ModelSet; //models requested and not loaded yet
+	GLuint m_uPBO = 0; //pixel buffer the texels are uploaded through
+	uint m_uBudget = STREAM_UPLOAD_BUDGET; //bytes uploaded per update
+	uint m_uInFlight = 0; //jobs requested and not finished yet, only used by the GL thread
+	uint m_uUploadCount = 0; //textures uploaded since the start
+
+	static MyAssetStreamer* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer, the first call has to be made from the GL thread
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyAssetStreamer* GetInstance();
+	/*
+	Usage: Releases the content of the singleton, waits for the workers
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Requests a texture, the file is decoded on a worker and uploaded by a later Update. The
+	returned texture holds a 1x1 placeholder until then and keeps its name after, so it can be handed
+	to materials right away. Has to be called from the GL thread
+	ARGUMENTS:
+	-	String a_sFileName -> name of the file relative to the textures folder, or an absolute path
+	-	vector3 a_v3Placeholder -> color of the placeholder
+	OUTPUT: OpenGL name of the texture, the same for every request of the same file
+	*/
+	GLuint RequestTexture(String a_sFileName, vector3 a_v3Placeholder = C_WHITE);
+	/*
+	USAGE: Requests a model, it is cooked on a worker and loaded into the model cache by a later
+	Update, so entities made after that do not wait for it and the ones that acquired it streamed get
+	it in place of their placeholder. Its maps stream like any other texture
+	ARGUMENTS: String a_sFileName -> Name of the model, as it would be given to MyModelCache::Acquire
+	OUTPUT: ---
+	*/
+	void RequestModel(String a_sFileName);
+	/*
+	USAGE: Finishes the jobs the workers are done with, uploading at most the budget in texels. At
+	least one job is finished per call so a texture bigger than the budget still arrives. Has to be
+	called once per frame from the GL thread
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Update(void);
+	/*
+	USAGE: Waits for every request and finishes them all, for when the assets are needed right now
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Flush(void);
+	/*
+	USAGE: Sets the bytes of texels uploaded per update
+	ARGUMENTS: uint a_uBytes -> budget
+	OUTPUT: ---
+	*/
+	void SetBudget(uint a_uBytes);
+	/*
+	USAGE: Gets the bytes of texels uploaded per update
+	ARGUMENTS: ---
+	OUTPUT: budget
+	*/
+	uint GetBudget(void);
+	/*
+	USAGE: Gets the number of requests that are not finished yet
+	ARGUMENTS: ---
+	OUTPUT: pending count
+	*/
+	uint GetPendingCount(void);
+	/*
+	USAGE: Gets the number of textures uploaded since the start
+	ARGUMENTS: ---
+	OUTPUT: upload count
+	*/
+	uint GetUploadCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyAssetStreamer(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyAssetStreamer(MyAssetStreamer const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyAssetStreamer& operator=(MyAssetStreamer const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyAssetStreamer(void);
+	/*
+	Usage: stops the workers and releases the jobs and the OpenGL objects
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton and starts the workers
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Loop of a worker, takes jobs until the streamer is released
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Work(void);
+	/*
+	USAGE: Maps the cooked texture of an image, cooking it if needed, or decodes the image into 32 bit
+	texels if it cannot be cooked; runs on a worker
+	ARGUMENTS: MyStreamJob* a_pJob -> job to decode
+	OUTPUT: ---
+	*/
+	void Decode(MyStreamJob* a_pJob);
+	/*
+	USAGE: Copies the levels or the texels into the pixel buffer and moves them to the texture, runs on
+	the GL thread
+	ARGUMENTS: MyStreamJob* a_pJob -> decoded job
+	OUTPUT: ---
+	*/
+	void Upload(MyStreamJob* a_pJob);
+	/*
+	USAGE: Hands a job to the workers
+	ARGUMENTS: MyStreamJob* a_pJob -> job to queue
+	OUTPUT: ---
+	*/
+	void Queue(MyStreamJob* a_pJob);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYASSETSTREAMER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
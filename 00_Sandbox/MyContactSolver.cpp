@@ -0,0 +1,188 @@
+#include "MyContactSolver.h"
+using namespace Simplex;
+//  MyContactSolver
+void MyContactSolver::Init(void)
+{
+	m_uIterations = CONTACT_ITERATIONS;
+	m_ContactList.clear();
+	m_ContactMap.clear();
+}
+void MyContactSolver::Swap(MyContactSolver& other)
+{
+	std::swap(m_uIterations, other.m_uIterations);
+	std::swap(m_ContactList, other.m_ContactList);
+	std::swap(m_ContactMap, other.m_ContactMap);
+}
+void MyContactSolver::Release(void)
+{
+	m_ContactList.clear();
+	m_ContactMap.clear();
+}
+//The big 3
+MyContactSolver::MyContactSolver(void) { Init(); }
+MyContactSolver::MyContactSolver(MyContactSolver const& other)
+{
+	m_uIterations = other.m_uIterations;
+	m_ContactList = other.m_ContactList;
+	m_ContactMap = other.m_ContactMap;
+}
+MyContactSolver& MyContactSolver::operator=(MyContactSolver const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyContactSolver temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyContactSolver::~MyContactSolver() { Release(); }
+//Accessors
+void MyContactSolver::SetIterations(uint a_uIterations) { m_uIterations = a_uIterations; }
+uint MyContactSolver::GetIterations(void) { return m_uIterations; }
+uint MyContactSolver::GetContactCount(void) { return static_cast<uint>(m_ContactList.size()); }
+MyContact MyContactSolver::GetContact(uint a_uIndex)
+{
+	//if the list is empty return a default contact
+	if (m_ContactList.size() == 0)
+		return MyContact();
+
+	//if out of bounds ask for the last one
+	if (a_uIndex >= m_ContactList.size())
+		a_uIndex = static_cast<uint>(m_ContactList.size()) - 1;
+
+	return m_ContactList[a_uIndex];
+}
+//Methods
+MyContactSolver::ContactKey MyContactSolver::MakeKey(uint a_uA, uint a_uB)
+{
+	if (a_uA > a_uB)
+		std::swap(a_uA, a_uB);
+	return (static_cast<ContactKey>(a_uA) << 32) | static_cast<ContactKey>(a_uB);
+}
+void MyContactSolver::AddContact(uint a_uBodyA, uint a_uBodyB, vector3 a_v3Normal, float a_fPenetration, vector3 a_v3Point)
+{
+	//contacts are stored smallest handle first, the normal has to follow
+	if (a_uBodyA > a_uBodyB)
+	{
+		std::swap(a_uBodyA, a_uBodyB);
+		a_v3Normal = -a_v3Normal;
+	}
+
+	ContactKey key = MakeKey(a_uBodyA, a_uBodyB);
+	auto entry = m_ContactMap.find(key);
+	if (entry == m_ContactMap.end())
+	{
+		MyContact contact;
+		contact.m_uBodyA = a_uBodyA;
+		contact.m_uBodyB = a_uBodyB;
+		contact.m_v3Normal = a_v3Normal;
+		contact.m_fPenetration = a_fPenetration;
+		contact.m_v3Point = a_v3Point;
+		m_ContactMap[key] = static_cast<uint>(m_ContactList.size());
+		m_ContactList.push_back(contact);
+		return;
+	}
+
+	MyContact& contact = m_ContactList[entry->second];
+	//the impulses of last frame are only a good guess if the contact did not turn
+	if (glm::dot(contact.m_v3Normal, a_v3Normal) < CONTACT_WARMSTART)
+	{
+		contact.m_fNormalImpulse = 0.0f;
+		contact.m_v3TangentImpulse = ZERO_V3;
+	}
+	contact.m_v3Normal = a_v3Normal;
+	contact.m_fPenetration = a_fPenetration;
+	contact.m_v3Point = a_v3Point;
+}
+void MyContactSolver::RemoveIndex(uint a_uIndex)
+{
+	uint uLast = static_cast<uint>(m_ContactList.size()) - 1;
+	m_ContactMap.erase(MakeKey(m_ContactList[a_uIndex].m_uBodyA, m_ContactList[a_uIndex].m_uBodyB));
+	//swap and pop, the moved contact needs its new index
+	if (a_uIndex != uLast)
+	{
+		m_ContactList[a_uIndex] = m_ContactList[uLast];
+		m_ContactMap[MakeKey(m_ContactList[a_uIndex].m_uBodyA, m_ContactList[a_uIndex].m_uBodyB)] = a_uIndex;
+	}
+	m_ContactList.pop_back();
+}
+void MyContactSolver::RemoveContact(uint a_uBodyA, uint a_uBodyB)
+{
+	auto entry = m_ContactMap.find(MakeKey(a_uBodyA, a_uBodyB));
+	if (entry == m_ContactMap.end())
+		return;
+	RemoveIndex(entry->second);
+}
+void MyContactSolver::RemoveBody(uint a_uBody)
+{
+	//go backwards so the contact moved into a removed slot was already checked
+	for (uint i = static_cast<uint>(m_ContactList.size()); i > 0; --i)
+	{
+		if (m_ContactList[i - 1].m_uBodyA == a_uBody || m_ContactList[i - 1].m_uBodyB == a_uBody)
+			RemoveIndex(i - 1);
+	}
+}
+void MyContactSolver::Clear(void)
+{
+	m_ContactList.clear();
+	m_ContactMap.clear();
+}
+void MyContactSolver::ApplyImpulse(MySolverManager* a_pSolverMngr, MyContact const& a_Contact, vector3 a_v3Impulse)
+{
+	if (a_Contact.m_fInvMassA > 0.0f)
+		a_pSolverMngr->SetVelocity(a_Contact.m_uBodyA, a_pSolverMngr->GetVelocity(a_Contact.m_uBodyA) - a_v3Impulse * a_Contact.m_fInvMassA);
+	if (a_Contact.m_fInvMassB > 0.0f)
+		a_pSolverMngr->SetVelocity(a_Contact.m_uBodyB, a_pSolverMngr->GetVelocity(a_Contact.m_uBodyB) + a_v3Impulse * a_Contact.m_fInvMassB);
+}
+void MyContactSolver::Solve(MySolverManager* a_pSolverMngr)
+{
+	if (m_uIterations == 0)
+		return;
+
+	//bodies are not rotated by the solver manager, so the contacts only need the linear terms
+	for (uint i = 0; i < m_ContactList.size(); ++i)
+	{
+		MyContact& contact = m_ContactList[i];
+		contact.m_fInvMassA = a_pSolverMngr->IsSimulated(contact.m_uBodyA) ? 1.0f / a_pSolverMngr->GetMass(contact.m_uBodyA) : 0.0f;
+		contact.m_fInvMassB = a_pSolverMngr->IsSimulated(contact.m_uBodyB) ? 1.0f / a_pSolverMngr->GetMass(contact.m_uBodyB) : 0.0f;
+		//the velocities are per frame, so the bias is a fraction of the penetration
+		contact.m_fBias = CONTACT_BAUMGARTE * std::max(contact.m_fPenetration - CONTACT_SLOP, 0.0f);
+
+		//warm start with what was needed last frame
+		ApplyImpulse(a_pSolverMngr, contact, contact.m_v3Normal * contact.m_fNormalImpulse + contact.m_v3TangentImpulse);
+	}
+
+	for (uint uIteration = 0; uIteration < m_uIterations; ++uIteration)
+	{
+		for (uint i = 0; i < m_ContactList.size(); ++i)
+		{
+			MyContact& contact = m_ContactList[i];
+			float fInvMassSum = contact.m_fInvMassA + contact.m_fInvMassB;
+			if (fInvMassSum <= 0.0f)
+				continue;
+
+			//normal impulse, the accumulated value can only push
+			vector3 v3Relative = a_pSolverMngr->GetVelocity(contact.m_uBodyB) - a_pSolverMngr->GetVelocity(contact.m_uBodyA);
+			float fNormalVelocity = glm::dot(v3Relative, contact.m_v3Normal);
+			float fImpulse = (contact.m_fBias - fNormalVelocity) / fInvMassSum;
+			float fAccumulated = std::max(contact.m_fNormalImpulse + fImpulse, 0.0f);
+			fImpulse = fAccumulated - contact.m_fNormalImpulse;
+			contact.m_fNormalImpulse = fAccumulated;
+			ApplyImpulse(a_pSolverMngr, contact, contact.m_v3Normal * fImpulse);
+
+			//friction impulse, limited by the normal impulse
+			v3Relative = a_pSolverMngr->GetVelocity(contact.m_uBodyB) - a_pSolverMngr->GetVelocity(contact.m_uBodyA);
+			vector3 v3Tangent = v3Relative - contact.m_v3Normal * glm::dot(v3Relative, contact.m_v3Normal);
+			vector3 v3Accumulated = contact.m_v3TangentImpulse - v3Tangent / fInvMassSum;
+			float fMaxFriction = CONTACT_FRICTION * contact.m_fNormalImpulse;
+			float fFriction2 = glm::dot(v3Accumulated, v3Accumulated);
+			if (fFriction2 > fMaxFriction * fMaxFriction)
+				v3Accumulated *= fMaxFriction / std::sqrt(fFriction2);
+			vector3 v3Impulse = v3Accumulated - contact.m_v3TangentImpulse;
+			contact.m_v3TangentImpulse = v3Accumulated;
+			ApplyImpulse(a_pSolverMngr, contact, v3Impulse);
+		}
+	}
+}
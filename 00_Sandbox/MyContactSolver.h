@@ -0,0 +1,187 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYCONTACTSOLVER_H_
+#define __MYCONTACTSOLVER_H_
+
+#include "MySolverManager.h"
+#include <unordered_map>
+
+#define CONTACT_ITERATIONS 8 //default number of passes over the contacts every frame
+#define CONTACT_BAUMGARTE 0.2f //fraction of the penetration corrected every frame
+#define CONTACT_SLOP 0.01f //penetration allowed before correcting it, keeps resting contacts from jittering
+#define CONTACT_FRICTION 0.4f //friction coefficient between bodies
+#define CONTACT_WARMSTART 0.95f //cosine between the old and new normal needed to reuse the impulses
+
+namespace Simplex
+{
+
+//Contact between two bodies of the solver manager, built from the SAT axis of minimum penetration
+struct MyContact
+{
+	uint m_uBodyA = 0; //solver handle of the first body (always the smallest)
+	uint m_uBodyB = 0; //solver handle of the second body (always the largest)
+	vector3 m_v3Normal = AXIS_Y; //contact normal, points from A to B
+	vector3 m_v3Point = ZERO_V3; //point halfway through the overlap
+	float m_fPenetration = 0.0f; //overlap along the normal
+	float m_fNormalImpulse = 0.0f; //accumulated impulse along the normal, kept for warm starting
+	vector3 m_v3TangentImpulse = ZERO_V3; //accumulated friction impulse, kept for warm starting
+	float m_fInvMassA = 0.0f; //inverse mass of A in the current solve, 0 for bodies that do not move
+	float m_fInvMassB = 0.0f; //inverse mass of B in the current solve, 0 for bodies that do not move
+	float m_fBias = 0.0f; //separation velocity asked to correct the penetration
+};
+
+//System Class
+class MyContactSolver
+{
+	typedef unsigned long long ContactKey; //(min, max) body handle pair packed in 64 bits
+
+	uint m_uIterations = CONTACT_ITERATIONS; //passes over the contacts every solve
+	std::vector<MyContact> m_ContactList; //contacts of the bodies, contiguous for the iterations
+	std::unordered_map<ContactKey, uint> m_ContactMap; //pair to index in the contact list
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyContactSolver(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyContactSolver(MyContactSolver const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyContactSolver& operator=(MyContactSolver const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyContactSolver(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyContactSolver& other);
+
+	/*
+	USAGE: Adds or refreshes the contact between two bodies, the accumulated impulses are kept if
+	the normal did not change much so the next solve starts from them
+	ARGUMENTS:
+	-	uint a_uBodyA -> solver handle of one body
+	-	uint a_uBodyB -> solver handle of the other body
+	-	vector3 a_v3Normal -> contact normal, points from a_uBodyA to a_uBodyB
+	-	float a_fPenetration -> overlap along the normal
+	-	vector3 a_v3Point -> contact point
+	OUTPUT: ---
+	*/
+	void AddContact(uint a_uBodyA, uint a_uBodyB, vector3 a_v3Normal, float a_fPenetration, vector3 a_v3Point);
+	/*
+	USAGE: Removes the contact between two bodies, if any
+	ARGUMENTS:
+	-	uint a_uBodyA -> solver handle of one body
+	-	uint a_uBodyB -> solver handle of the other body
+	OUTPUT: ---
+	*/
+	void RemoveContact(uint a_uBodyA, uint a_uBodyB);
+	/*
+	USAGE: Removes every contact of the body
+	ARGUMENTS: uint a_uBody -> solver handle of the body
+	OUTPUT: ---
+	*/
+	void RemoveBody(uint a_uBody);
+	/*
+	USAGE: Removes all contacts
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Applies the accumulated impulses of last frame and then runs the sequential impulse
+	iterations over all contacts, changing the velocities of the bodies in the solver manager.
+	Call it after the velocities are integrated and before the positions are
+	ARGUMENTS: MySolverManager* a_pSolverMngr -> store of the bodies
+	OUTPUT: ---
+	*/
+	void Solve(MySolverManager* a_pSolverMngr);
+	/*
+	USAGE: Sets the number of passes over the contacts every solve
+	ARGUMENTS: uint a_uIterations -> passes, 0 leaves the velocities untouched
+	OUTPUT: ---
+	*/
+	void SetIterations(uint a_uIterations);
+	/*
+	USAGE: Gets the number of passes over the contacts every solve
+	ARGUMENTS: ---
+	OUTPUT: passes
+	*/
+	uint GetIterations(void);
+	/*
+	USAGE: Gets the number of contacts
+	ARGUMENTS: ---
+	OUTPUT: contact count
+	*/
+	uint GetContactCount(void);
+	/*
+	USAGE: Gets the contact specified by index
+	ARGUMENTS: uint a_uIndex -> index of the contact
+	OUTPUT: contact
+	*/
+	MyContact GetContact(uint a_uIndex);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Removes the contact at the index, the last contact takes its place
+	ARGUMENTS: uint a_uIndex -> index of the contact
+	OUTPUT: ---
+	*/
+	void RemoveIndex(uint a_uIndex);
+	/*
+	USAGE: Applies an impulse to both bodies of the contact, opposite on each
+	ARGUMENTS:
+	-	MySolverManager* a_pSolverMngr -> store of the bodies
+	-	MyContact const& a_Contact -> contact
+	-	vector3 a_v3Impulse -> impulse applied on B, A gets the opposite
+	OUTPUT: ---
+	*/
+	static void ApplyImpulse(MySolverManager* a_pSolverMngr, MyContact const& a_Contact, vector3 a_v3Impulse);
+	/*
+	USAGE: Packs the pair into a key, smallest handle first
+	ARGUMENTS:
+	-	uint a_uA -> handle of one body
+	-	uint a_uB -> handle of the other body
+	OUTPUT: key of the pair
+	*/
+	static ContactKey MakeKey(uint a_uA, uint a_uB);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYCONTACTSOLVER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,246 @@
+#include "MyDebugDraw.h"
+using namespace Simplex;
+//  MyDebugDraw
+MyDebugDraw* MyDebugDraw::m_pInstance = nullptr;
+void MyDebugDraw::Init(void)
+{
+	m_uVAO = 0;
+	m_uVBO = 0;
+	m_uCapacity = 0;
+	m_uVertexCount = 0;
+	for (uint i = 0; i < DEBUG_SPHERE_SEGMENTS; ++i)
+	{
+		float fAngle = glm::two_pi<float>() * i / DEBUG_SPHERE_SEGMENTS;
+		m_v3Circle[i] = vector3(std::cos(fAngle), std::sin(fAngle), 0.0f);
+	}
+}
+void MyDebugDraw::Release(void)
+{
+	//nothing was created if no frame was drawn, there might not even be a context
+	if (m_uVBO != 0)
+		glDeleteBuffers(1, &m_uVBO);
+	if (m_uVAO != 0)
+		glDeleteVertexArrays(1, &m_uVAO);
+	m_uVBO = 0;
+	m_uVAO = 0;
+	m_uCapacity = 0;
+	m_LineList.clear();
+	m_ShapeList.clear();
+	m_OffsetList.clear();
+	m_VertexList.clear();
+}
+MyDebugDraw* MyDebugDraw::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyDebugDraw();
+	}
+	return m_pInstance;
+}
+void MyDebugDraw::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyDebugDraw::MyDebugDraw() { Init(); }
+MyDebugDraw::MyDebugDraw(MyDebugDraw const& a_pOther) { }
+MyDebugDraw& MyDebugDraw::operator=(MyDebugDraw const& a_pOther) { return *this; }
+MyDebugDraw::~MyDebugDraw() { Release(); };
+//Accessors
+uint MyDebugDraw::GetShapeCount(void) { return static_cast<uint>(m_ShapeList.size()); }
+uint MyDebugDraw::GetVertexCount(void) { return m_uVertexCount; }
+//--- Methods
+void MyDebugDraw::AddLine(vector3 a_v3Start, vector3 a_v3End, vector3 a_v3Color)
+{
+	MyDebugVertex vertex;
+	vertex.m_v3Color = a_v3Color;
+	vertex.m_v3Position = a_v3Start;
+	m_LineList.push_back(vertex);
+	vertex.m_v3Position = a_v3End;
+	m_LineList.push_back(vertex);
+}
+void MyDebugDraw::AddBox(matrix4 a_m4ToWorld, vector3 a_v3Color)
+{
+	MyDebugShape shape;
+	shape.m_m4ToWorld = a_m4ToWorld;
+	shape.m_v3Color = a_v3Color;
+	shape.m_eType = DEBUG_BOX;
+	m_ShapeList.push_back(shape);
+}
+void MyDebugDraw::AddBox(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Color)
+{
+	AddBox(glm::translate((a_v3Min + a_v3Max) * 0.5f) * glm::scale(a_v3Max - a_v3Min), a_v3Color);
+}
+void MyDebugDraw::AddSphere(matrix4 a_m4ToWorld, vector3 a_v3Color)
+{
+	MyDebugShape shape;
+	shape.m_m4ToWorld = a_m4ToWorld;
+	shape.m_v3Color = a_v3Color;
+	shape.m_eType = DEBUG_SPHERE;
+	m_ShapeList.push_back(shape);
+}
+void MyDebugDraw::AddAxis(matrix4 a_m4ToWorld)
+{
+	MyDebugShape shape;
+	shape.m_m4ToWorld = a_m4ToWorld;
+	shape.m_eType = DEBUG_AXIS;
+	m_ShapeList.push_back(shape);
+}
+void MyDebugDraw::Clear(void)
+{
+	//the lists keep their memory for the next frame
+	m_LineList.clear();
+	m_ShapeList.clear();
+}
+uint MyDebugDraw::GetShapeVertexCount(eDebugShape a_eType)
+{
+	switch (a_eType)
+	{
+	case DEBUG_BOX:
+		return 24;
+	case DEBUG_SPHERE:
+		return 3 * DEBUG_SPHERE_SEGMENTS * 2;
+	case DEBUG_AXIS:
+		return 6;
+	}
+	return 0;
+}
+uint MyDebugDraw::Render(matrix4 a_m4ViewProjection)
+{
+	//every shape knows where its vertices go before any is expanded, the lines go first
+	uint uShapeCount = static_cast<uint>(m_ShapeList.size());
+	uint uVertexCount = static_cast<uint>(m_LineList.size());
+	m_OffsetList.resize(uShapeCount);
+	for (uint i = 0; i < uShapeCount; ++i)
+	{
+		m_OffsetList[i] = uVertexCount;
+		uVertexCount += GetShapeVertexCount(m_ShapeList[i].m_eType);
+	}
+	m_uVertexCount = uVertexCount;
+	if (uVertexCount == 0)
+		return 0;
+
+	m_VertexList.resize(uVertexCount);
+	std::copy(m_LineList.begin(), m_LineList.end(), m_VertexList.begin());
+
+	//the calling thread takes the first share
+	uint uThreadCount = std::max(std::min(std::thread::hardware_concurrency(), uShapeCount / DEBUG_THREAD_SHAPES), 1u);
+	uint uShare = (uShapeCount + uThreadCount - 1) / uThreadCount;
+	std::vector<std::thread> lThread;
+	for (uint uFirst = uShare; uFirst < uShapeCount; uFirst += uShare)
+		lThread.push_back(std::thread(&MyDebugDraw::ExpandShapes, this, uFirst, std::min(uShare, uShapeCount - uFirst)));
+	ExpandShapes(0, std::min(uShare, uShapeCount));
+	for (uint i = 0; i < lThread.size(); ++i)
+		lThread[i].join();
+	Clear();
+
+	if (m_uVAO == 0)
+		InitDevice();
+	GLuint uProgram = MyShaderCache::GetInstance()->GetProgram("DebugLine");
+	if (uProgram == 0)
+		return 0;
+
+	//the storage of the last frame is orphaned, the driver does not wait for it to be drawn
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+	if (uVertexCount > m_uCapacity)
+		m_uCapacity = std::max(uVertexCount, m_uCapacity * 2);
+	glBufferData(GL_ARRAY_BUFFER, m_uCapacity * sizeof(MyDebugVertex), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, uVertexCount * sizeof(MyDebugVertex), m_VertexList.data());
+
+	//the vertices are global already, Line.vs still multiplies by the matrix of its instance
+	matrix4 m4Identity = IDENTITY_M4;
+	glUseProgram(uProgram);
+	glUniformMatrix4fv(glGetUniformLocation(uProgram, "VP"), 1, GL_FALSE, glm::value_ptr(a_m4ViewProjection));
+	glUniformMatrix4fv(glGetUniformLocation(uProgram, "m4ToWorld"), 1, GL_FALSE, glm::value_ptr(m4Identity));
+	glDrawArrays(GL_LINES, 0, uVertexCount);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glUseProgram(0);
+	return 1;
+}
+void MyDebugDraw::InitDevice(void)
+{
+	glGenVertexArrays(1, &m_uVAO);
+	glGenBuffers(1, &m_uVBO);
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MyDebugVertex), (GLvoid*)offsetof(MyDebugVertex, m_v3Position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MyDebugVertex), (GLvoid*)offsetof(MyDebugVertex, m_v3Color));
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (!MyShaderCache::GetInstance()->AddProgramFiles("DebugLine", "Line.vs", "Line.fs"))
+		std::cout << "Debug draw: could not read Line.vs and Line.fs" << std::endl;
+}
+void MyDebugDraw::ExpandShapes(uint a_uFirst, uint a_uCount)
+{
+	//corners of the cube by bits (x, y, z) and the 12 edges between corners that differ in one bit
+	static uint const uEdge[24] = { 0, 1, 2, 3, 4, 5, 6, 7, 0, 2, 1, 3, 4, 6, 5, 7, 0, 4, 1, 5, 2, 6, 3, 7 };
+	vector3 v3Corner[8];
+
+	for (uint i = a_uFirst; i < a_uFirst + a_uCount; ++i)
+	{
+		MyDebugShape const& shape = m_ShapeList[i];
+		matrix4 const& m4ToWorld = shape.m_m4ToWorld;
+		MyDebugVertex* pVertex = &m_VertexList[m_OffsetList[i]];
+		switch (shape.m_eType)
+		{
+		case DEBUG_BOX:
+			for (uint j = 0; j < 8; ++j)
+			{
+				vector4 v4Corner((j & 1) ? 0.5f : -0.5f, (j & 2) ? 0.5f : -0.5f, (j & 4) ? 0.5f : -0.5f, 1.0f);
+				v3Corner[j] = vector3(m4ToWorld * v4Corner);
+			}
+			for (uint j = 0; j < 24; ++j)
+			{
+				pVertex[j].m_v3Position = v3Corner[uEdge[j]];
+				pVertex[j].m_v3Color = shape.m_v3Color;
+			}
+			break;
+		case DEBUG_SPHERE:
+			//the circle in the XY plane, then moved to the YZ and the XZ planes
+			for (uint uPlane = 0; uPlane < 3; ++uPlane)
+			{
+				for (uint j = 0; j < DEBUG_SPHERE_SEGMENTS; ++j)
+				{
+					vector3 v3Point[2] = { m_v3Circle[j], m_v3Circle[(j + 1) % DEBUG_SPHERE_SEGMENTS] };
+					for (uint k = 0; k < 2; ++k)
+					{
+						vector3 v3Local = v3Point[k];
+						if (uPlane == 1)
+							v3Local = vector3(0.0f, v3Point[k].x, v3Point[k].y);
+						else if (uPlane == 2)
+							v3Local = vector3(v3Point[k].x, 0.0f, v3Point[k].y);
+						pVertex->m_v3Position = vector3(m4ToWorld * vector4(v3Local, 1.0f));
+						pVertex->m_v3Color = shape.m_v3Color;
+						++pVertex;
+					}
+				}
+			}
+			break;
+		case DEBUG_AXIS:
+		{
+			vector3 v3Origin = vector3(m4ToWorld * vector4(ZERO_V3, 1.0f));
+			vector3 v3Color[3] = { C_RED, C_GREEN, C_BLUE };
+			for (uint j = 0; j < 3; ++j)
+			{
+				vector4 v4End(0.0f, 0.0f, 0.0f, 1.0f);
+				v4End[j] = 1.0f;
+				pVertex[j * 2].m_v3Position = v3Origin;
+				pVertex[j * 2].m_v3Color = v3Color[j];
+				pVertex[j * 2 + 1].m_v3Position = vector3(m4ToWorld * v4End);
+				pVertex[j * 2 + 1].m_v3Color = v3Color[j];
+			}
+			break;
+		}
+		}
+	}
+}
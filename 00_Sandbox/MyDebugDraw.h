@@ -0,0 +1,200 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYDEBUGDRAW_H_
+#define __MYDEBUGDRAW_H_
+
+#include "MyShaderCache.h"
+#include <thread>
+
+#define DEBUG_SPHERE_SEGMENTS 24 //segments of each of the three circles of a sphere
+#define DEBUG_THREAD_SHAPES 4096 //fewest shapes a thread is started for when they are expanded
+
+namespace Simplex
+{
+
+//Shapes expanded into lines when the frame is drawn
+enum eDebugShape
+{
+	DEBUG_BOX = 0, //cube of size 1 centered in the origin of its space
+	DEBUG_SPHERE = 1, //sphere of radius 1 centered in the origin of its space
+	DEBUG_AXIS = 2, //x, y and z axis of length 1 in red, green and blue
+};
+
+//Vertex of the line buffer, the layout Line.vs reads
+struct MyDebugVertex
+{
+	vector3 m_v3Position = ZERO_V3; //position in global space
+	vector3 m_v3Color = C_WHITE; //color of the line
+};
+
+//Shape waiting to be drawn
+struct MyDebugShape
+{
+	matrix4 m_m4ToWorld = IDENTITY_M4; //space of the shape
+	vector3 m_v3Color = C_WHITE; //color of the lines, the axis have their own
+	eDebugShape m_eType = DEBUG_BOX; //kind of shape
+};
+
+//System Class
+class MyDebugDraw
+{
+	std::vector<MyDebugVertex> m_LineList; //lines added this frame, two vertices each
+	std::vector<MyDebugShape> m_ShapeList; //shapes added this frame
+	std::vector<uint> m_OffsetList; //first vertex of each shape in the vertex list
+	std::vector<MyDebugVertex> m_VertexList; //lines and expanded shapes of the frame
+	vector3 m_v3Circle[DEBUG_SPHERE_SEGMENTS]; //points of a circle of radius 1 in the XY plane
+
+	GLuint m_uVAO = 0; //vertex array of the line buffer, 0 until the first frame is drawn
+	GLuint m_uVBO = 0; //line buffer, streamed every frame
+	uint m_uCapacity = 0; //vertices the line buffer can hold
+	uint m_uVertexCount = 0; //vertices drawn in the last frame
+
+	static MyDebugDraw* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer, shapes can be added without a GL context
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyDebugDraw* GetInstance();
+	/*
+	Usage: Releases the content of the singleton, from the GL thread if a frame was drawn
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a line for this frame
+	ARGUMENTS:
+	-	vector3 a_v3Start -> start of the line in global space
+	-	vector3 a_v3End -> end of the line in global space
+	-	vector3 a_v3Color -> color of the line
+	OUTPUT: ---
+	*/
+	void AddLine(vector3 a_v3Start, vector3 a_v3End, vector3 a_v3Color);
+	/*
+	USAGE: Adds the edges of a box for this frame, the same space AddWireCubeToRenderList takes
+	ARGUMENTS:
+	-	matrix4 a_m4ToWorld -> space of a cube of size 1 centered in its origin
+	-	vector3 a_v3Color -> color of the edges
+	OUTPUT: ---
+	*/
+	void AddBox(matrix4 a_m4ToWorld, vector3 a_v3Color);
+	/*
+	USAGE: Adds the edges of an axis aligned box for this frame
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum of the box in global space
+	-	vector3 a_v3Max -> maximum of the box in global space
+	-	vector3 a_v3Color -> color of the edges
+	OUTPUT: ---
+	*/
+	void AddBox(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Color);
+	/*
+	USAGE: Adds a sphere for this frame as three circles, one per plane of its space
+	ARGUMENTS:
+	-	matrix4 a_m4ToWorld -> space of a sphere of radius 1 centered in its origin
+	-	vector3 a_v3Color -> color of the circles
+	OUTPUT: ---
+	*/
+	void AddSphere(matrix4 a_m4ToWorld, vector3 a_v3Color);
+	/*
+	USAGE: Adds the axis of a space for this frame, x in red, y in green and z in blue
+	ARGUMENTS: matrix4 a_m4ToWorld -> space of the axis
+	OUTPUT: ---
+	*/
+	void AddAxis(matrix4 a_m4ToWorld);
+	/*
+	USAGE: Expands the shapes of the frame into lines, between threads if there are many, streams
+	them into the line buffer and draws all of them with one call; the frame is cleared after it
+	ARGUMENTS: matrix4 a_m4ViewProjection -> projection * view of the camera
+	OUTPUT: draw calls made, 0 if there was nothing to draw
+	*/
+	uint Render(matrix4 a_m4ViewProjection);
+	/*
+	USAGE: Removes the lines and shapes added this frame without drawing them
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the shapes added this frame, lines not included
+	ARGUMENTS: ---
+	OUTPUT: shape count
+	*/
+	uint GetShapeCount(void);
+	/*
+	USAGE: Gets the vertices drawn in the last frame
+	ARGUMENTS: ---
+	OUTPUT: vertex count
+	*/
+	uint GetVertexCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyDebugDraw(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyDebugDraw(MyDebugDraw const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyDebugDraw& operator=(MyDebugDraw const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyDebugDraw(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	Usage: creates the vertex array and the line buffer and adds the program to the shader cache
+	Arguments: ---
+	Output: ---
+	*/
+	void InitDevice(void);
+	/*
+	Usage: expands a range of shapes into the vertex list, the body of each thread of Render
+	Arguments:
+	-	uint a_uFirst -> index of the first shape
+	-	uint a_uCount -> number of shapes
+	Output: ---
+	*/
+	void ExpandShapes(uint a_uFirst, uint a_uCount);
+	/*
+	Usage: gets the vertices a kind of shape expands into
+	Arguments: eDebugShape a_eType -> kind of shape
+	Output: vertex count
+	*/
+	static uint GetShapeVertexCount(eDebugShape a_eType);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYDEBUGDRAW_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
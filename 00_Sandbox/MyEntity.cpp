@@ -1,142 +1,267 @@
 #include "MyEntity.h"
+#include "MyEntityManager.h"
 using namespace Simplex;
-std::map<String, MyEntity*> MyEntity::m_IDMap;
+MyIDTable MyEntity::m_IDTable;
+std::vector<MyEntity*> MyEntity::m_IDEntityList;
 //  Accessors
-Simplex::MySolver* Simplex::MyEntity::GetSolver(void) { return m_pSolver; }
+uint Simplex::MyEntity::GetSolverID(void) { return m_uSolverID; }
 bool Simplex::MyEntity::HasThisRigidBody(MyRigidBody* a_pRigidBody) { return m_pRigidBody == a_pRigidBody; }
 Simplex::MyRigidBody::PRigidBody* Simplex::MyEntity::GetColliderArray(void) { return m_pRigidBody->GetColliderArray(); }
 uint Simplex::MyEntity::GetCollidingCount(void) { return m_pRigidBody->GetCollidingCount(); }
-matrix4 Simplex::MyEntity::GetModelMatrix(void){ return m_m4ToWorld; }
+matrix4 Simplex::MyEntity::GetModelMatrix(void)
+{
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+		return MyEntityManager::GetInstance()->GetModelMatrix(static_cast<uint>(nIndex));
+	return m_m4ToWorld;
+}
 void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 {
-	if (!m_bInMemory || m_m4ToWorld == a_m4ToWorld)
+	if (!m_bInMemory)
+		return;
+
+	//the manager writes the rigid body and the solver along with its components
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+	{
+		MyEntityManager::GetInstance()->SetModelMatrix(a_m4ToWorld, static_cast<uint>(nIndex));
 		return;
+	}
 
+	if (m_m4ToWorld == a_m4ToWorld)
+		return;
 	m_m4ToWorld = a_m4ToWorld;
-	m_pModel->SetModelMatrix(m_m4ToWorld);
 	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
+	if (m_bUsePhysicsSolver)
+		m_pSolverMngr->SetTransform(m_uSolverID, m_m4ToWorld);
+}
+Model* Simplex::MyEntity::GetModel(void){return m_pModel;}
+bool Simplex::MyEntity::FinishStreaming(void)
+{
+	if (m_pModelCache == nullptr || m_sModelKey == "")
+		return true;
+	if (m_pModelCache->IsStreaming(m_sModelKey))
+		return false;
 
-	if (m_bUsePhysicsSolver) {
-		//experimental way of calculating a matrix components
-		glm::vec3 scale;
-		glm::quat orientation;
-		glm::vec3 translation;
-		glm::vec3 skew;
-		glm::vec4 perspective;
-		glm::decompose(m_m4ToWorld, scale, orientation, translation, skew, perspective);
-
-		//TODO: this is a hot fix the orientation inverses itself without this using the decompose
-		matrix4 temp = glm::translate(translation) * ToMatrix4(orientation) * glm::scale(scale);
-		glm::decompose(temp, scale, orientation, translation, skew, perspective);
-		//....
-
-		m_pSolver->SetPosition(translation);
-		m_pSolver->SetOrientation(orientation);
-		m_pSolver->SetSize(scale);
+	Model* pModel = m_pModelCache->GetModel(m_sModelKey);
+	if (pModel != m_pModel)
+	{
+		m_pModel = pModel;
+		//the placeholder box gives way to the bounds of the model
+		m_pRigidBody->SetLocalBounds(m_pModelCache->GetBounds(m_sModelKey));
 	}
+	return true;
 }
-Model* Simplex::MyEntity::GetModel(void){return m_pModel;}
+void Simplex::MyEntity::SetAnimationFrame(float a_fFrame)
+{
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+		MyEntityManager::GetInstance()->SetAnimationFrame(a_fFrame, static_cast<uint>(nIndex));
+	else
+		m_fAnimationFrame = a_fFrame;
+}
+float Simplex::MyEntity::GetAnimationFrame(void)
+{
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+		return MyEntityManager::GetInstance()->GetAnimationFrame(static_cast<uint>(nIndex));
+	return m_fAnimationFrame;
+}
+String Simplex::MyEntity::GetModelKey(void) { return m_sModelKey; }
 MyRigidBody* Simplex::MyEntity::GetRigidBody(void){	return m_pRigidBody; }
 bool Simplex::MyEntity::IsInitialized(void){ return m_bInMemory; }
 String Simplex::MyEntity::GetUniqueID(void) { return m_sUniqueID; }
-void Simplex::MyEntity::SetAxisVisible(bool a_bSetAxis) { m_bSetAxis = a_bSetAxis; }
-void Simplex::MyEntity::SetPosition(vector3 a_v3Position) { if(m_pSolver) m_pSolver->SetPosition(a_v3Position); }
+uint Simplex::MyEntity::GetID(void) { return m_uID; }
+void Simplex::MyEntity::SetAxisVisible(bool a_bSetAxis)
+{
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+		MyEntityManager::GetInstance()->SetAxisVisibility(a_bSetAxis, static_cast<uint>(nIndex));
+	else
+		m_bSetAxis = a_bSetAxis;
+}
+bool Simplex::MyEntity::GetAxisVisible(void)
+{
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+		return MyEntityManager::GetInstance()->GetAxisVisibility(static_cast<uint>(nIndex));
+	return m_bSetAxis;
+}
+uint Simplex::MyEntity::GetDimensionCount(void)
+{
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+		return MyEntityManager::GetInstance()->GetDimensionCount(static_cast<uint>(nIndex));
+	return m_nDimensionCount;
+}
+uint* Simplex::MyEntity::GetDimensionArray(void)
+{
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+		return MyEntityManager::GetInstance()->GetDimensionArray(static_cast<uint>(nIndex));
+	return m_DimensionArray;
+}
+void Simplex::MyEntity::SetHandle(MyHandle a_Handle) { m_Handle = a_Handle; }
+MyHandle Simplex::MyEntity::GetHandle(void) { return m_Handle; }
+void Simplex::MyEntity::SetPosition(vector3 a_v3Position) { if(m_pSolverMngr) m_pSolverMngr->SetPosition(m_uSolverID, a_v3Position); }
 Simplex::vector3 Simplex::MyEntity::GetPosition(void)
 {
-	if (m_pSolver != nullptr)
-		return m_pSolver->GetPosition();
+	if (m_pSolverMngr != nullptr)
+		return m_pSolverMngr->GetPosition(m_uSolverID);
 	return vector3();
 }
 
-void Simplex::MyEntity::SetVelocity(vector3 a_v3Velocity) { if (m_pSolver) m_pSolver->SetVelocity(a_v3Velocity); }
+void Simplex::MyEntity::SetVelocity(vector3 a_v3Velocity) { if (m_pSolverMngr) m_pSolverMngr->SetVelocity(m_uSolverID, a_v3Velocity); }
 Simplex::vector3 Simplex::MyEntity::GetVelocity(void)
 {
-	if (m_pSolver != nullptr)
-		return m_pSolver->GetVelocity();
+	if (m_pSolverMngr != nullptr)
+		return m_pSolverMngr->GetVelocity(m_uSolverID);
 	return vector3();
 }
 
-void Simplex::MyEntity::SetMass(float a_fMass) { if (m_pSolver) m_pSolver->SetMass(a_fMass); }
+void Simplex::MyEntity::SetMass(float a_fMass) { if (m_pSolverMngr) m_pSolverMngr->SetMass(m_uSolverID, a_fMass); }
 float Simplex::MyEntity::GetMass(void)
 {
-	if (m_pSolver != nullptr)
-		return m_pSolver->GetMass();
+	if (m_pSolverMngr != nullptr)
+		return m_pSolverMngr->GetMass(m_uSolverID);
 	return 1.0f;
 }
 //  MyEntity
 void Simplex::MyEntity::Init(void)
 {
-	m_pMeshMngr = MeshManager::GetInstance();
+	//the debug draw is fetched the first time the entity is drawn
+	m_pDebugDraw = nullptr;
 	m_bInMemory = false;
 	m_bSetAxis = false;
 	m_pModel = nullptr;
+	m_sModelKey = "";
+	m_pModelCache = nullptr;
+	m_fAnimationFrame = -1.0f;
 	m_pRigidBody = nullptr;
 	m_DimensionArray = nullptr;
 	m_m4ToWorld = IDENTITY_M4;
 	m_sUniqueID = "";
+	m_uID = -1;
 	m_nDimensionCount = 0;
 	m_bUsePhysicsSolver = false;
-	m_pSolver = nullptr;
+	m_pSolverMngr = nullptr;
+	m_uSolverID = -1;
 }
 void Simplex::MyEntity::Swap(MyEntity& other)
 {
 	m_bInMemory = false;
 	std::swap(m_pModel, other.m_pModel);
+	std::swap(m_sModelKey, other.m_sModelKey);
+	std::swap(m_pModelCache, other.m_pModelCache);
+	std::swap(m_fAnimationFrame, other.m_fAnimationFrame);
 	std::swap(m_pRigidBody, other.m_pRigidBody);
 	std::swap(m_m4ToWorld, other.m_m4ToWorld);
-	std::swap(m_pMeshMngr, other.m_pMeshMngr);
+	std::swap(m_pDebugDraw, other.m_pDebugDraw);
 	std::swap(m_bInMemory, other.m_bInMemory);
 	std::swap(m_sUniqueID, other.m_sUniqueID);
+	std::swap(m_uID, other.m_uID);
 	std::swap(m_bSetAxis, other.m_bSetAxis);
 	std::swap(m_nDimensionCount, other.m_nDimensionCount);
 	std::swap(m_DimensionArray, other.m_DimensionArray);
-	std::swap(m_pSolver, other.m_pSolver);
+	std::swap(m_bUsePhysicsSolver, other.m_bUsePhysicsSolver);
+	std::swap(m_pSolverMngr, other.m_pSolverMngr);
+	std::swap(m_uSolverID, other.m_uSolverID);
 }
 void Simplex::MyEntity::Release(void)
 {
-	m_pMeshMngr = nullptr;
+	m_pDebugDraw = nullptr;
 	//it is not the job of the entity to release the model, 
 	//it is for the mesh manager to do so.
 	m_pModel = nullptr;
+	//the model is shared, only our reference to it goes away
+	if (m_pModelCache != nullptr && m_sModelKey != "")
+		m_pModelCache->Release(m_sModelKey);
+	m_sModelKey = "";
+	m_pModelCache = nullptr;
 	if (m_DimensionArray)
 	{
 		delete[] m_DimensionArray;
 		m_DimensionArray = nullptr;
 	}
 	SafeDelete(m_pRigidBody);
-	SafeDelete(m_pSolver);
-	m_IDMap.erase(m_sUniqueID);
+	//the state lives in the solver manager, give the slot back
+	if (m_pSolverMngr != nullptr)
+	{
+		m_pSolverMngr->RemoveBody(m_uSolverID);
+		m_pSolverMngr = nullptr;
+	}
+	m_uSolverID = -1;
+	//copies share the name, only the entity that holds it gives it back
+	if (m_uID < m_IDEntityList.size() && m_IDEntityList[m_uID] == this)
+	{
+		m_IDEntityList[m_uID] = nullptr;
+		m_IDTable.Remove(m_uID);
+	}
+	m_uID = -1;
 }
 //The big 3
-Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID)
+Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID, bool a_bStream)
 {
 	Init();
-	m_pModel = new Model();
-	m_pModel->Load(a_sFileName);
+	//the file is only loaded by the first entity that asks for it
+	m_pModelCache = MyModelCache::GetInstance();
+	m_sModelKey = m_pModelCache->Acquire(a_sFileName, a_bStream);
 	//if the model is loaded
-	if (m_pModel->GetName() != "")
+	if (m_sModelKey != "")
+	{
+		m_pModel = m_pModelCache->GetModel(m_sModelKey);
+		m_uID = GenUniqueID(a_sUniqueID);
+		m_sUniqueID = a_sUniqueID;
+		m_IDEntityList[m_uID] = this;
+		m_pRigidBody = new MyRigidBody(m_pModelCache->GetBounds(m_sModelKey)); //generate a rigid body
+		m_bInMemory = true; //mark this entity as viable
+	}
+	m_pSolverMngr = MySolverManager::GetInstance();
+	m_uSolverID = m_pSolverMngr->AddBody();
+}
+Simplex::MyEntity::MyEntity(std::vector<vector3> a_lVertexList, String a_sUniqueID)
+{
+	Init();
+	//there is no model to draw, the rigid body is generated from the incoming vertices
+	if (a_lVertexList.size() > 0)
 	{
-		GenUniqueID(a_sUniqueID);
+		m_uID = GenUniqueID(a_sUniqueID);
 		m_sUniqueID = a_sUniqueID;
-		m_IDMap[a_sUniqueID] = this;
-		m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); //generate a rigid body
+		m_IDEntityList[m_uID] = this;
+		m_pRigidBody = new MyRigidBody(a_lVertexList); //generate a rigid body
 		m_bInMemory = true; //mark this entity as viable
 	}
-	m_pSolver = new MySolver();
+	m_pSolverMngr = MySolverManager::GetInstance();
+	m_uSolverID = m_pSolverMngr->AddBody();
 }
 Simplex::MyEntity::MyEntity(MyEntity const& other)
 {
 	m_bInMemory = other.m_bInMemory;
 	m_pModel = other.m_pModel;
+	m_sModelKey = other.m_sModelKey;
+	m_pModelCache = other.m_pModelCache;
+	if (m_pModelCache != nullptr && m_sModelKey != "")
+		m_pModelCache->Acquire(m_sModelKey);
 	//generate a new rigid body we do not share the same rigid body as we do the model
-	m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); 
-	m_m4ToWorld = other.m_m4ToWorld;
-	m_pMeshMngr = other.m_pMeshMngr;
+	m_pRigidBody = new MyRigidBody(std::vector<vector3>{ other.m_pRigidBody->GetMinLocal(), other.m_pRigidBody->GetMaxLocal() });
+	//the copy is not in the entity manager, it keeps the state of the original in its own fields
+	MyEntity& source = const_cast<MyEntity&>(other);
+	m_m4ToWorld = source.GetModelMatrix();
+	m_pDebugDraw = other.m_pDebugDraw;
 	m_sUniqueID = other.m_sUniqueID;
-	m_bSetAxis = other.m_bSetAxis;
-	m_nDimensionCount = other.m_nDimensionCount;
-	m_DimensionArray = other.m_DimensionArray;
-	m_pSolver = new MySolver(*other.m_pSolver);
+	m_uID = other.m_uID;
+	m_bSetAxis = source.GetAxisVisible();
+	m_fAnimationFrame = source.GetAnimationFrame();
+	m_nDimensionCount = source.GetDimensionCount();
+	m_DimensionArray = nullptr;
+	if (m_nDimensionCount > 0)
+	{
+		m_DimensionArray = new uint[m_nDimensionCount];
+		memcpy(m_DimensionArray, source.GetDimensionArray(), sizeof(uint) * m_nDimensionCount);
+	}
+	m_bUsePhysicsSolver = other.m_bUsePhysicsSolver;
+	m_pSolverMngr = MySolverManager::GetInstance();
+	m_uSolverID = m_pSolverMngr->CopyBody(other.m_uSolverID);
 }
 MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
 {
@@ -157,39 +282,71 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 	if (!m_bInMemory)
 		return;
 
-	//draw model
-	m_pModel->AddToRenderList();
+	if (m_pDebugDraw == nullptr)
+		m_pDebugDraw = MyDebugDraw::GetInstance();
+
+	//draw model, it is shared so it takes our matrix right before being added
+	if (m_pModel != nullptr)
+	{
+		float fFrame = GetAnimationFrame();
+		if (fFrame >= 0.0f)
+			m_pModelCache->Animate(m_sModelKey, fFrame);
+		m_pModel->SetModelMatrix(GetModelMatrix());
+		m_pModel->AddToRenderList();
+	}
 	
 	//draw rigid body
 	if(a_bDrawRigidBody)
 		m_pRigidBody->AddToRenderList();
 
-	if (m_bSetAxis)
-		m_pMeshMngr->AddAxisToRenderList(m_m4ToWorld);
+	if (GetAxisVisible())
+		m_pDebugDraw->AddAxis(GetModelMatrix());
 }
 MyEntity* Simplex::MyEntity::GetEntity(String a_sUniqueID)
 {
 	//look the entity based on the unique id
-	auto entity = m_IDMap.find(a_sUniqueID);
+	return GetEntity(m_IDTable.Find(a_sUniqueID));
+}
+MyEntity* Simplex::MyEntity::GetEntity(uint a_uID)
+{
 	//if not found return nullptr, if found return it
-	return entity == m_IDMap.end() ? nullptr : entity->second;
+	return a_uID < m_IDEntityList.size() ? m_IDEntityList[a_uID] : nullptr;
 }
-void Simplex::MyEntity::GenUniqueID(String& a_sUniqueID)
+uint Simplex::MyEntity::GetID(String a_sUniqueID) { return m_IDTable.Find(a_sUniqueID); }
+Simplex::uint Simplex::MyEntity::GenUniqueID(String& a_sUniqueID)
 {
-	static uint index = 0;
-	String sName = a_sUniqueID;
-	MyEntity* pEntity = GetEntity(a_sUniqueID);
-	//while MyEntity exists keep changing name
-	while (pEntity)
+	uint uID = m_IDTable.Intern(a_sUniqueID);
+	if (GetEntity(uID) == nullptr)
 	{
-		a_sUniqueID = sName + "_" + std::to_string(index);
-		index++;
-		pEntity = GetEntity(a_sUniqueID);
+		//a name picked by hand may look like a generated one, its suffix is never generated again
+		m_IDTable.ClaimSuffix(a_sUniqueID);
+		return Reserve(uID);
 	}
-	return;
+
+	//the name is taken, the entity gets the next suffix counted for it; every suffix below the counter
+	//was either generated once or claimed, so the name it makes is free
+	uint uBase = uID;
+	a_sUniqueID = m_IDTable.GetName(uBase) + "_" + std::to_string(m_IDTable.NextSuffix(uBase));
+	m_IDTable.Remove(uBase);
+	uID = m_IDTable.Intern(a_sUniqueID);
+	return Reserve(uID);
+}
+Simplex::uint Simplex::MyEntity::Reserve(uint a_uID)
+{
+	//every interned name has a place in the list
+	if (m_IDEntityList.size() < m_IDTable.GetIDRange())
+		m_IDEntityList.resize(m_IDTable.GetIDRange(), nullptr);
+	return a_uID;
 }
 void Simplex::MyEntity::AddDimension(uint a_uDimension)
 {
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+	{
+		MyEntityManager::GetInstance()->AddDimension(static_cast<uint>(nIndex), a_uDimension);
+		return;
+	}
+
 	//we need to check that this dimension is not already allocated in the list
 	if (IsInDimension(a_uDimension))
 		return;//it is, so there is no need to add
@@ -212,6 +369,13 @@ void Simplex::MyEntity::AddDimension(uint a_uDimension)
 }
 void Simplex::MyEntity::RemoveDimension(uint a_uDimension)
 {
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+	{
+		MyEntityManager::GetInstance()->RemoveDimension(static_cast<uint>(nIndex), a_uDimension);
+		return;
+	}
+
 	//if there are no dimensions return
 	if (m_nDimensionCount == 0)
 		return;
@@ -241,6 +405,13 @@ void Simplex::MyEntity::RemoveDimension(uint a_uDimension)
 }
 void Simplex::MyEntity::ClearDimensionSet(void)
 {
+	int nIndex = GetManagedIndex();
+	if (nIndex >= 0)
+	{
+		MyEntityManager::GetInstance()->ClearDimensionSet(static_cast<uint>(nIndex));
+		return;
+	}
+
 	if (m_DimensionArray)
 	{
 		delete[] m_DimensionArray;
@@ -250,38 +421,35 @@ void Simplex::MyEntity::ClearDimensionSet(void)
 }
 bool Simplex::MyEntity::IsInDimension(uint a_uDimension)
 {
-	//see if the entry is in the set
-	for (uint i = 0; i < m_nDimensionCount; i++)
-	{
-		if (m_DimensionArray[i] == a_uDimension)
-			return true;
-	}
-	return false;
+	//the set is sorted whoever holds it
+	uint* pDimension = GetDimensionArray();
+	uint uCount = GetDimensionCount();
+	return std::binary_search(pDimension, pDimension + uCount, a_uDimension);
 }
 bool Simplex::MyEntity::SharesDimension(MyEntity* const a_pOther)
 {
-	
+	uint* pDimension = GetDimensionArray();
+	uint uCount = GetDimensionCount();
+	uint* pDimensionOther = a_pOther->GetDimensionArray();
+	uint uCountOther = a_pOther->GetDimensionCount();
+
 	//special case: if there are no dimensions on either MyEntity
 	//then they live in the special global dimension
-	if (0 == m_nDimensionCount)
-	{
-		//if no spatial optimization all cases should fall here as every 
-		//entity is by default, under the special global dimension only
-		if(0 == a_pOther->m_nDimensionCount)
-			return true;
-	}
+	if (uCount == 0 || uCountOther == 0)
+		return uCount == 0 && uCountOther == 0;
 
-	//for each dimension on both Entities we check if there is a common dimension
-	for (uint i = 0; i < m_nDimensionCount; ++i)
+	//both sets are sorted, walk them at the same time looking for a common one
+	uint i = 0;
+	uint j = 0;
+	while (i < uCount && j < uCountOther)
 	{
-		for (uint j = 0; j < a_pOther->m_nDimensionCount; j++)
-		{
-			if (m_DimensionArray[i] == a_pOther->m_DimensionArray[j])
-				return true; //as soon as we find one we know they share dimensionality
-		}
+		if (pDimension[i] == pDimensionOther[j])
+			return true;
+		if (pDimension[i] < pDimensionOther[j])
+			++i;
+		else
+			++j;
 	}
-
-	//could not find a common dimension
 	return false;
 }
 bool Simplex::MyEntity::IsColliding(MyEntity* const other)
@@ -300,7 +468,22 @@ bool Simplex::MyEntity::IsColliding(MyEntity* const other)
 void Simplex::MyEntity::ClearCollisionList(void)
 {
 	m_pRigidBody->ClearCollidingList();
-	m_pSolver->SetIsColliding(false);
+	m_pSolverMngr->SetIsColliding(m_uSolverID, false);
+}
+void Simplex::MyEntity::RemoveCollisionWith(MyEntity* const a_pOther)
+{
+	//if not in memory return
+	if (!m_bInMemory || !a_pOther->m_bInMemory)
+		return;
+
+	m_pRigidBody->RemoveCollisionWith(a_pOther->GetRigidBody());
+	a_pOther->GetRigidBody()->RemoveCollisionWith(m_pRigidBody);
+}
+int Simplex::MyEntity::GetManagedIndex(void)
+{
+	if (m_Handle.m_uSlot == static_cast<uint>(-1))
+		return -1;
+	return MyEntityManager::GetInstance()->GetEntityIndex(m_Handle);
 }
 void Simplex::MyEntity::SortDimensions(void)
 {
@@ -308,30 +491,38 @@ void Simplex::MyEntity::SortDimensions(void)
 }
 void Simplex::MyEntity::ApplyForce(vector3 a_v3Force)
 {
-	m_pSolver->ApplyForce(a_v3Force);
+	m_pSolverMngr->ApplyForce(m_uSolverID, a_v3Force);
 }
 void Simplex::MyEntity::Update(void)
 {
 	if (m_bUsePhysicsSolver)
 	{
-		if (m_pRigidBody->GetCollidingCount() > 0)
-			m_pSolver->SetIsColliding(true);
-
-		m_pSolver->Update();
-
-		//SetModelMatrix(glm::translate(m_pSolver->GetPosition()) * glm::scale(m_pSolver->GetSize()));
-		quaternion temp = m_pSolver->GetOrientation();
-		SetModelMatrix(glm::translate(m_pSolver->GetPosition()) * ToMatrix4(temp) *  glm::scale(m_pSolver->GetSize()));
+		//the colliding list persists between frames, so it can also clear the flag
+		//the integration happens for all entities at once in the solver manager
+		m_pSolverMngr->SetIsColliding(m_uSolverID, m_pRigidBody->GetCollidingCount() > 0);
+	}
+}
+void Simplex::MyEntity::SyncWithSolver(void)
+{
+	if (m_bUsePhysicsSolver)
+	{
+		quaternion temp = m_pSolverMngr->GetOrientation(m_uSolverID);
+		SetModelMatrix(glm::translate(m_pSolverMngr->GetPosition(m_uSolverID)) * ToMatrix4(temp) * glm::scale(m_pSolverMngr->GetSize(m_uSolverID)));
 	}
 }
 void Simplex::MyEntity::ResolveCollision(MyEntity* a_pOther)
 {
 	if (m_bUsePhysicsSolver)
 	{
-		m_pSolver->ResolveCollision(a_pOther->GetSolver());
+		m_pSolverMngr->ResolveCollision(m_uSolverID, a_pOther->GetSolverID());
 	}
 }
 void Simplex::MyEntity::UsePhysicsSolver(bool a_bUse)
 {
 	m_bUsePhysicsSolver = a_bUse;
+	m_pSolverMngr->SetSimulated(m_uSolverID, a_bUse);
+}
+void Simplex::MyEntity::UseContinuousCollision(bool a_bUse)
+{
+	m_pSolverMngr->SetContinuous(m_uSolverID, a_bUse);
 }
\ No newline at end of file
@@ -5,7 +5,10 @@ Date: 2017/07
 #ifndef __MYENTITY_H_
 #define __MYENTITY_H_
 
-#include "MySolver.h"
+#include "MySolverManager.h"
+#include "MyModelCache.h"
+#include "MyIDTable.h"
+#include "MySlotMap.h"
 
 namespace Simplex
 {
@@ -16,30 +19,50 @@ class MyEntity
 	bool m_bInMemory = false; //loaded flag
 	bool m_bSetAxis = false; //render axis flag
 	String m_sUniqueID = ""; //Unique identifier name
+	uint m_uID = -1; //Unique identifier name interned as a number
 
 	uint m_nDimensionCount = 0; //tells how many dimensions this entity lives in
 	uint* m_DimensionArray = nullptr; //Dimensions on which this entity is located
 
-	Model* m_pModel = nullptr; //Model associated with this MyEntity
+	Model* m_pModel = nullptr; //Model associated with this MyEntity, shared with the entities that load the same file
+	String m_sModelKey = ""; //Key of the model in the model cache, empty if there is no model
+	MyModelCache* m_pModelCache = nullptr; //Cache of the shared models
+	float m_fAnimationFrame = -1.0f; //time in frames the compressed tracks of the model are sampled at, negative if not animated
 	MyRigidBody* m_pRigidBody = nullptr; //Rigid Body associated with this MyEntity
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Model matrix associated with this MyEntity
-	MeshManager* m_pMeshMngr = nullptr; //For rendering shapes
+	MyDebugDraw* m_pDebugDraw = nullptr; //For rendering the axis
 
-	static std::map<String, MyEntity*> m_IDMap; //a map of the unique ID's
+	static MyIDTable m_IDTable; //the unique ID's interned as numbers
+	static std::vector<MyEntity*> m_IDEntityList; //entity that holds each interned ID, nullptr if none
 
 	bool m_bUsePhysicsSolver = false; //Indicates if we will use a physics solver 
 
-	MySolver* m_pSolver = nullptr; //Physics MySolver
+	MySolverManager* m_pSolverMngr = nullptr; //Physics solver manager
+	uint m_uSolverID = -1; //Handle of the body of this MyEntity in the solver manager
+
+	//while the handle is valid the entity manager holds the transform, the axis and the dimensions in
+	//its components, the fields above are only used by entities nobody manages
+	MyHandle m_Handle; //Handle of this MyEntity in the entity manager
 public:
 	/*
 	Usage: Constructor that specifies the name attached to the MyEntity
 	Arguments:
 	-	String a_sFileName -> Name of the model to load
 	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
+	-	bool a_bStream = false -> let the asset streamer load a model that is not in the cache, the
+		entity has no model and a placeholder rigid body until FinishStreaming picks it up
 	Output: class object instance
 	*/
-	MyEntity(String a_sFileName, String a_sUniqueID = "NA");
+	MyEntity(String a_sFileName, String a_sUniqueID = "NA", bool a_bStream = false);
+	/*
+	Usage: Constructor for an entity without a model, used when there is no window to render to
+	Arguments:
+	-	std::vector<vector3> a_lVertexList -> vertices used to generate the rigid body
+	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
+	Output: class object instance
+	*/
+	MyEntity(std::vector<vector3> a_lVertexList, String a_sUniqueID = "NA");
 	/*
 	Usage: Copy Constructor
 	Arguments: class object to copy
@@ -77,12 +100,37 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ToWorld);
 	/*
-	USAGE: Gets the model associated with this entity
+	USAGE: Gets the model associated with this entity, it is shared by every entity of the same file
 	ARGUMENTS: ---
 	OUTPUT: Model
 	*/
 	Model* GetModel(void);
 	/*
+	USAGE: Takes the model once the asset streamer loaded it and fits the rigid body to its bounds
+	ARGUMENTS: ---
+	OUTPUT: false while the model is still being streamed
+	*/
+	bool FinishStreaming(void);
+	/*
+	USAGE: Sets the time the compressed tracks of the model are sampled at when the entity is drawn,
+	see MyModelCache::CompressAnimation
+	ARGUMENTS: float a_fFrame -> time in frames, fractions included; negative to leave the model as it is
+	OUTPUT: ---
+	*/
+	void SetAnimationFrame(float a_fFrame);
+	/*
+	USAGE: Gets the time the compressed tracks of the model are sampled at
+	ARGUMENTS: ---
+	OUTPUT: time in frames, negative if not animated
+	*/
+	float GetAnimationFrame(void);
+	/*
+	USAGE: Gets the key of the model of the entity in the model cache
+	ARGUMENTS: ---
+	OUTPUT: key, empty if there is no model
+	*/
+	String GetModelKey(void);
+	/*
 	USAGE: Gets the Rigid Body associated with this entity
 	ARGUMENTS: ---
 	OUTPUT: Rigid Body
@@ -113,11 +161,31 @@ public:
 	*/
 	static MyEntity* GetEntity(String a_sUniqueID);
 	/*
-	USAGE: Will generate a unique id based on the name provided
+	USAGE: Gets the MyEntity specified by the interned unique ID, nullptr if not exists
+	ARGUMENTS: uint a_uID -> interned unique ID of the queried entity
+	OUTPUT: MyEntity specified by unique ID, nullptr if not exists
+	*/
+	static MyEntity* GetEntity(uint a_uID);
+	/*
+	USAGE: Gets the interned number of a unique ID, so it can be looked up without hashing it again
+	ARGUMENTS: String a_sUniqueID -> unique ID
+	OUTPUT: interned unique ID, -1 if it was never used
+	*/
+	static uint GetID(String a_sUniqueID);
+	/*
+	USAGE: Will generate a unique id based on the name provided, taken names get the next suffix
+	counted for that name instead of trying every number from 0; the entity holds a reference to
+	the name until it is released
 	ARGUMENTS: String& a_sUniqueID -> desired name
-	OUTPUT: will output though the argument
+	OUTPUT: will output the name though the argument, returns its interned number
+	*/
+	uint GenUniqueID(String& a_sUniqueID);
+	/*
+	USAGE: Makes room for the interned number in the list of entities by ID
+	ARGUMENTS: uint a_uID -> interned number of the name the entity takes
+	OUTPUT: the same number
 	*/
-	void GenUniqueID(String& a_sUniqueID);
+	uint Reserve(uint a_uID);
 	/*
 	USAGE: Gets the Unique ID name of this model
 	ARGUMENTS: ---
@@ -125,12 +193,36 @@ public:
 	*/
 	String GetUniqueID(void);
 	/*
+	USAGE: Gets the unique ID interned as a number
+	ARGUMENTS: ---
+	OUTPUT: interned unique ID, -1 if the entity is not initialized
+	*/
+	uint GetID(void);
+	/*
 	USAGE: Sets the visibility of the axis of this MyEntity
 	ARGUMENTS: bool a_bSetAxis = true -> axis visible?
 	OUTPUT: ---
 	*/
 	void SetAxisVisible(bool a_bSetAxis = true);
 	/*
+	USAGE: Asks if the axis of this MyEntity is visible
+	ARGUMENTS: ---
+	OUTPUT: axis visible?
+	*/
+	bool GetAxisVisible(void);
+	/*
+	USAGE: Gets the number of dimensions this MyEntity lives in
+	ARGUMENTS: ---
+	OUTPUT: dimension count
+	*/
+	uint GetDimensionCount(void);
+	/*
+	USAGE: Gets the sorted dimensions this MyEntity lives in
+	ARGUMENTS: ---
+	OUTPUT: dimension array, nullptr if there are none
+	*/
+	uint* GetDimensionArray(void);
+	/*
 	USAGE: Will set a dimension to the MyEntity
 	ARGUMENTS: uint a_uDimension -> dimension to set
 	OUTPUT: ---
@@ -167,6 +259,12 @@ public:
 	OUTPUT: ---
 	*/
 	void ClearCollisionList(void);
+	/*
+	USAGE: Removes the collision marked between this entity and the incoming one
+	ARGUMENTS: MyEntity* const a_pOther -> entity that stopped colliding with this one
+	OUTPUT: ---
+	*/
+	void RemoveCollisionWith(MyEntity* const a_pOther);
 
 	/*
 	USAGE: Will sort the array of dimensions
@@ -204,11 +302,24 @@ public:
 	void ResolveCollision(MyEntity* a_pOther);
 
 	/*
-	USAGE: Gets the solver applied to this MyEntity
+	USAGE: Gets the handle of the body of this MyEntity in the solver manager
+	ARGUMENTS: ---
+	OUTPUT: solver handle
+	*/
+	uint GetSolverID(void);
+	/*
+	USAGE: Sets the handle of this MyEntity in the entity manager, done by the manager when it takes
+	the entity; from then on the transform, the axis and the dimensions are read from its components
+	ARGUMENTS: MyHandle a_Handle -> handle in the entity manager
+	OUTPUT: ---
+	*/
+	void SetHandle(MyHandle a_Handle);
+	/*
+	USAGE: Gets the handle of this MyEntity in the entity manager
 	ARGUMENTS: ---
-	OUTPUT: MySolver applied
+	OUTPUT: handle, stale if no manager holds the entity
 	*/
-	MySolver* GetSolver(void);
+	MyHandle GetHandle(void);
 	/*
 	USAGE: Applies a force to the solver
 	ARGUMENTS: vector3 a_v3Force -> force to apply
@@ -255,17 +366,30 @@ public:
 	float GetMass(void);
 
 	/*
-	USAGE: Updates the MyEntity
+	USAGE: Updates the MyEntity, marks if the body is colliding before the solver integrates
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Sets the model matrix from the state of the solver, call after the solver manager update
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SyncWithSolver(void);
+	/*
 	USAGE: Resolves using physics solver or not in the update
 	ARGUMENTS: bool a_bUse = true -> using physics solver?
 	OUTPUT: ---
 	*/
 	void UsePhysicsSolver(bool a_bUse = true);
+	/*
+	USAGE: Sweeps the entity against the others before it moves so it can not cross them in one step,
+	meant for fast entities
+	ARGUMENTS: bool a_bUse = true -> using continuous collision?
+	OUTPUT: ---
+	*/
+	void UseContinuousCollision(bool a_bUse = true);
 
 private:
 	/*
@@ -280,6 +404,12 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	Usage: Finds this MyEntity in the entity manager
+	Arguments: ---
+	Output: index in the entity manager, -1 if it does not hold the entity
+	*/
+	int GetManagedIndex(void);
 };//class
 
 } //namespace Simplex
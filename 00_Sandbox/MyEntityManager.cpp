@@ -1,21 +1,50 @@
 #include "MyEntityManager.h"
+#include "MyOctree.h"
+#include "MyOcclusionCuller.h"
 using namespace Simplex;
 //  MyEntityManager
 Simplex::MyEntityManager* Simplex::MyEntityManager::m_pInstance = nullptr;
 void Simplex::MyEntityManager::Init(void)
 {
-	m_uEntityCount = 0;
-	m_mEntityArray = nullptr;
+	m_uPairTestCount = 0;
+	m_pDebugDraw = nullptr;
+	m_pCuller = nullptr;
+	m_pOctree = nullptr;
+	m_pPairCache = new MyPairCache();
+	m_pContactSolver = new MyContactSolver();
 }
 void Simplex::MyEntityManager::Release(void)
 {
-	for (uint uEntity = 0; uEntity < m_uEntityCount; ++uEntity)
+	for (uint uEntity = 0; uEntity < m_EntityMap.Size(); ++uEntity)
 	{
-		MyEntity* pEntity = m_mEntityArray[uEntity];
+		MyEntity* pEntity = m_EntityMap[uEntity];
 		SafeDelete(pEntity);
 	}
-	m_uEntityCount = 0;
-	m_mEntityArray = nullptr;
+	m_EntityMap.Clear();
+	m_HandleList.clear();
+	m_TransformList.clear();
+	m_CenterLocalList.clear();
+	m_HalfWidthLocalList.clear();
+	m_MinGlobalList.clear();
+	m_MaxGlobalList.clear();
+	m_BodyList.clear();
+	m_RigidBodyList.clear();
+	m_ModelList.clear();
+	m_AxisList.clear();
+	m_AnimationFrameList.clear();
+	m_DimensionList.clear();
+	m_pOctree = nullptr;
+	m_PairList.clear();
+	m_StreamingList.clear();
+	SafeDelete(m_pPairCache);
+	SafeDelete(m_pContactSolver);
+	//the entities gave their bodies and models back, the store and the cache can go; the streamer
+	//goes first so no worker is cooking when the cooker is released
+	MyAssetStreamer::ReleaseInstance();
+	MySolverManager::ReleaseInstance();
+	MyModelCache::ReleaseInstance();
+	MyModelCooker::ReleaseInstance();
+	MyTextureCooker::ReleaseInstance();
 }
 Simplex::MyEntityManager* Simplex::MyEntityManager::GetInstance()
 {
@@ -35,28 +64,58 @@ void Simplex::MyEntityManager::ReleaseInstance()
 }
 int Simplex::MyEntityManager::GetEntityIndex(String a_sUniqueID)
 {
-	//look one by one for the specified unique id
-	for (uint uIndex = 0; uIndex < m_uEntityCount; ++uIndex)
-	{
-		if (a_sUniqueID == m_mEntityArray[uIndex]->GetUniqueID())
-			return uIndex;
-	}
+	//the interned id gives the handle, the handle gives the index
+	uint uID = MyEntity::GetID(a_sUniqueID);
 	//if not found return -1
-	return -1;
+	if (uID >= m_HandleList.size())
+		return -1;
+	return GetEntityIndex(m_HandleList[uID]);
 }
 //Accessors
-Simplex::uint Simplex::MyEntityManager::GetEntityCount(void) {	return m_uEntityCount; }
+Simplex::uint Simplex::MyEntityManager::GetEntityCount(void) {	return m_EntityMap.Size(); }
+Simplex::uint Simplex::MyEntityManager::GetContactEventCount(void) { return m_pPairCache->GetEventCount(); }
+Simplex::MyContactEvent Simplex::MyEntityManager::GetContactEvent(uint a_uIndex) { return m_pPairCache->GetEvent(a_uIndex); }
+Simplex::uint Simplex::MyEntityManager::GetPairTestCount(void) { return m_uPairTestCount; }
+void Simplex::MyEntityManager::SetOctree(MyOctree* a_pOctree) { m_pOctree = a_pOctree; }
+Simplex::MyOctree* Simplex::MyEntityManager::GetOctree(void) { return m_pOctree; }
+void Simplex::MyEntityManager::SetContactIterations(uint a_uIterations) { m_pContactSolver->SetIterations(a_uIterations); }
+Simplex::uint Simplex::MyEntityManager::GetContactIterations(void) { return m_pContactSolver->GetIterations(); }
+Simplex::uint Simplex::MyEntityManager::GetContactCount(void) { return m_pContactSolver->GetContactCount(); }
+Simplex::vector3 Simplex::MyEntityManager::GetMinGlobal(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return ZERO_V3;
+
+	// if out of bounds
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	return m_MinGlobalList[a_uIndex];
+}
+Simplex::vector3 Simplex::MyEntityManager::GetMaxGlobal(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return ZERO_V3;
+
+	// if out of bounds
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	return m_MaxGlobalList[a_uIndex];
+}
 Simplex::Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return nullptr;
 
 	// if out of bounds
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->GetModel();
+	return m_ModelList[a_uIndex];
 }
 Simplex::Model* Simplex::MyEntityManager::GetModel(String a_sUniqueID)
 {
@@ -72,14 +131,14 @@ Simplex::Model* Simplex::MyEntityManager::GetModel(String a_sUniqueID)
 Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return nullptr;
 
 	// if out of bounds
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->GetRigidBody();
+	return m_RigidBodyList[a_uIndex];
 }
 Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(String a_sUniqueID)
 {
@@ -95,14 +154,14 @@ Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(String a_sUniqueID)
 Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return matrix4();
 
 	// if out of bounds
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->GetModelMatrix();
+	return m_TransformList[a_uIndex];
 }
 Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 {
@@ -118,46 +177,139 @@ Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->SetModelMatrix(a_m4ToWorld);
+		SetModelMatrix(a_m4ToWorld, static_cast<uint>(nIndex));
 	}
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	m_AxisList[a_uIndex] = a_bVisibility;
+}
+bool Simplex::MyEntityManager::GetAxisVisibility(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return false;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	return m_AxisList[a_uIndex];
+}
+void Simplex::MyEntityManager::SetAnimationFrame(float a_fFrame, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	m_AnimationFrameList[a_uIndex] = a_fFrame;
+}
+void Simplex::MyEntityManager::SetAnimationFrame(float a_fFrame, String a_sUniqueID)
+{
+	//Get the entity
+	int nIndex = GetEntityIndex(a_sUniqueID);
+	//if the entity exists
+	if (nIndex >= 0)
+	{
+		SetAnimationFrame(a_fFrame, static_cast<uint>(nIndex));
+	}
+}
+float Simplex::MyEntityManager::GetAnimationFrame(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return -1.0f;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	return m_AnimationFrameList[a_uIndex];
+}
+bool Simplex::MyEntityManager::CompressAnimation(String a_sGroup, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return false;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	String sKey = m_EntityMap[a_uIndex]->GetModelKey();
+	if (sKey == "")
+		return false;
+	return MyModelCache::GetInstance()->CompressAnimation(sKey, a_sGroup);
+}
+bool Simplex::MyEntityManager::CompressAnimation(String a_sGroup, String a_sUniqueID)
+{
+	//Get the entity
+	int nIndex = GetEntityIndex(a_sUniqueID);
+	//if the entity exists
+	if (nIndex >= 0)
+	{
+		return CompressAnimation(a_sGroup, static_cast<uint>(nIndex));
+	}
+	return false;
+}
+float Simplex::MyEntityManager::GetAnimationLength(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return 0.0f;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->SetAxisVisible(a_bVisibility);
+	String sKey = m_EntityMap[a_uIndex]->GetModelKey();
+	if (sKey == "")
+		return 0.0f;
+	return MyModelCache::GetInstance()->GetAnimationLength(sKey);
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->SetAxisVisible(a_bVisibility);
+		SetAxisVisibility(a_bVisibility, static_cast<uint>(nIndex));
 	}
 }
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	m_mEntityArray[a_uIndex]->SetModelMatrix(a_m4ToWorld);
+	if (m_TransformList[a_uIndex] == a_m4ToWorld)
+		return;
+	SetTransform(a_uIndex, a_m4ToWorld);
+	//a simulated body starts from the new matrix
+	MySolverManager* pSolverMngr = MySolverManager::GetInstance();
+	if (pSolverMngr->IsSimulated(m_BodyList[a_uIndex]))
+		pSolverMngr->SetTransform(m_BodyList[a_uIndex], a_m4ToWorld);
 }
 //The big 3
 Simplex::MyEntityManager::MyEntityManager(){Init();}
@@ -167,27 +319,204 @@ Simplex::MyEntityManager::~MyEntityManager(){Release();};
 // other methods
 void Simplex::MyEntityManager::Update(void)
 {
-	//Clear all collisions
-	for (uint i = 0; i < m_uEntityCount; i++)
+	CheckCollisions();
+	ResolveCollisions();
+	IntegrateEntities();
+}
+void Simplex::MyEntityManager::CheckCollisions(void)
+{
+	//start a new frame of contacts, the cache remembers the pairs of the last one
+	m_pPairCache->BeginFrame();
+	m_uPairTestCount = 0;
+
+	//a loose octree stores each entity once, its pairs come out once and need no dimension test
+	if (m_pOctree != nullptr && m_pOctree->IsLoose())
 	{
-		m_mEntityArray[i]->ClearCollisionList();
+		m_PairList.clear();
+		m_pOctree->GetPairs(m_PairList);
+		for (uint i = 0; i + 1 < m_PairList.size(); i += 2)
+			TestPair(m_PairList[i], m_PairList[i + 1]);
 	}
-	
-	//check collisions
-	for (uint i = 0; i < m_uEntityCount; i++)
+	else
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		//broadphase system, only the dimension and bounds components are read
+		uint uEntityCount = m_EntityMap.Size();
+		for (uint i = 0; i < uEntityCount; i++)
 		{
-			//if objects are colliding resolve the collision
-			if (m_mEntityArray[i]->IsColliding(m_mEntityArray[j]))
+			for (uint j = i + 1; j < uEntityCount; j++)
 			{
-				m_mEntityArray[i]->ResolveCollision(m_mEntityArray[j]);
+				//entities in different dimensions never reach the bounds test
+				if (SharesDimensionByIndex(i, j))
+					TestPair(i, j);
 			}
 		}
-		//Update each entity
-		m_mEntityArray[i]->Update();
+	}
+
+	//pairs that were not reported this frame generate an end event
+	m_pPairCache->EndFrame();
+}
+void Simplex::MyEntityManager::TestPair(uint a_uIndex, uint a_uOther)
+{
+	++m_uPairTestCount;
+	vector3 const& v3Min = m_MinGlobalList[a_uIndex];
+	vector3 const& v3Max = m_MaxGlobalList[a_uIndex];
+	vector3 const& v3MinOther = m_MinGlobalList[a_uOther];
+	vector3 const& v3MaxOther = m_MaxGlobalList[a_uOther];
+	if (v3Max.x < v3MinOther.x || v3Min.x > v3MaxOther.x ||
+		v3Max.y < v3MinOther.y || v3Min.y > v3MaxOther.y ||
+		v3Max.z < v3MinOther.z || v3Min.z > v3MaxOther.z)
+		return;
+
+	//the dimensions were already checked by the broadphase, the rigid bodies mark the collision
+	if (m_RigidBodyList[a_uIndex]->IsColliding(m_RigidBodyList[a_uOther]))
+	{
+		m_pPairCache->AddPair(m_EntityMap.GetSlot(a_uIndex), m_EntityMap.GetSlot(a_uOther));
+	}
+}
+void Simplex::MyEntityManager::ResolveCollisions(void)
+{
+	MySolverManager* pSolverMngr = MySolverManager::GetInstance();
+	bool bUseImpulses = m_pContactSolver->GetIterations() > 0;
+
+	//resolve the collisions using the events of this frame
+	uint uEventCount = m_pPairCache->GetEventCount();
+	for (uint i = 0; i < uEventCount; i++)
+	{
+		MyContactEvent event = m_pPairCache->GetEvent(i);
+		MyEntity* pA = m_EntityMap.GetBySlot(event.m_uA);
+		MyEntity* pB = m_EntityMap.GetBySlot(event.m_uB);
+		uint uBodyA = pA->GetSolverID();
+		uint uBodyB = pB->GetSolverID();
+		if (event.m_eState == CONTACT_END)
+		{
+			pA->RemoveCollisionWith(pB);
+			m_pContactSolver->RemoveContact(uBodyA, uBodyB);
+		}
+		else if (!bUseImpulses)
+		{
+			pA->ResolveCollision(pB);
+		}
+		else if (pSolverMngr->IsSimulated(uBodyA) || pSolverMngr->IsSimulated(uBodyB))
+		{
+			//the boxes overlap, the oriented ones may not
+			vector3 v3Normal;
+			vector3 v3Point;
+			float fPenetration;
+			if (pA->GetRigidBody()->GetContact(pB->GetRigidBody(), v3Normal, fPenetration, v3Point))
+				m_pContactSolver->AddContact(uBodyA, uBodyB, v3Normal, fPenetration, v3Point);
+			else
+				m_pContactSolver->RemoveContact(uBodyA, uBodyB);
+		}
 	}
 }
+void Simplex::MyEntityManager::IntegrateEntities(void)
+{
+	//Update each entity
+	for (uint i = 0; i < m_EntityMap.Size(); i++)
+	{
+		m_EntityMap[i]->Update();
+	}
+
+	//integrate all bodies at once, fast bodies are stopped at their first impact before moving
+	MySolverManager* pSolverMngr = MySolverManager::GetInstance();
+	//with impulses the contacts hold the bodies, not the colliding flag
+	bool bUseImpulses = m_pContactSolver->GetIterations() > 0;
+	pSolverMngr->IntegrateVelocity(!bUseImpulses);
+	if (bUseImpulses)
+		m_pContactSolver->Solve(pSolverMngr);
+	SweepContinuousEntities();
+	pSolverMngr->IntegratePosition();
+
+	//bring the results back to the components and the entities
+	UpdateTransforms();
+}
+void Simplex::MyEntityManager::SweepContinuousEntities(void)
+{
+	MySolverManager* pSolverMngr = MySolverManager::GetInstance();
+	uint uEntityCount = m_EntityMap.Size();
+
+	//broadphase over the step, every moving entity covers where it starts and where it ends
+	bool bContinuous = false;
+	m_SweptMinList.resize(uEntityCount);
+	m_SweptMaxList.resize(uEntityCount);
+	m_SweepOrder.resize(uEntityCount);
+	for (uint i = 0; i < uEntityCount; i++)
+	{
+		uint uBody = m_BodyList[i];
+		vector3 v3Min = m_MinGlobalList[i];
+		vector3 v3Max = m_MaxGlobalList[i];
+		if (pSolverMngr->IsSimulated(uBody))
+		{
+			vector3 v3Displacement = pSolverMngr->GetVelocity(uBody);
+			v3Min = glm::min(v3Min, v3Min + v3Displacement);
+			v3Max = glm::max(v3Max, v3Max + v3Displacement);
+			bContinuous = bContinuous || pSolverMngr->IsContinuous(uBody);
+		}
+		m_SweptMinList[i] = v3Min;
+		m_SweptMaxList[i] = v3Max;
+		m_SweepOrder[i] = std::make_pair(v3Min.x, i);
+	}
+	if (!bContinuous)
+		return;
+	std::sort(m_SweepOrder.begin(), m_SweepOrder.end());
+
+	for (uint k = 0; k < uEntityCount; k++)
+	{
+		uint i = m_SweepOrder[k].second;
+		uint uBody = m_BodyList[i];
+		bool bContinuousA = pSolverMngr->IsContinuous(uBody) && pSolverMngr->IsSimulated(uBody);
+		//the entities after this one in the order start further along x, past its end none overlap
+		for (uint l = k + 1; l < uEntityCount && m_SweepOrder[l].first <= m_SweptMaxList[i].x; l++)
+		{
+			uint j = m_SweepOrder[l].second;
+			uint uOther = m_BodyList[j];
+			bool bContinuousB = pSolverMngr->IsContinuous(uOther) && pSolverMngr->IsSimulated(uOther);
+			if (!bContinuousA && !bContinuousB)
+				continue;
+			if (m_SweptMaxList[i].y < m_SweptMinList[j].y || m_SweptMinList[i].y > m_SweptMaxList[j].y ||
+				m_SweptMaxList[i].z < m_SweptMinList[j].z || m_SweptMinList[i].z > m_SweptMaxList[j].z)
+				continue;
+			//pairs already touching are handled by the discrete resolution
+			if (m_pPairCache->IsCached(m_EntityMap.GetSlot(i), m_EntityMap.GetSlot(j)))
+				continue;
+
+			//static entities do not move
+			vector3 v3Displacement = ZERO_V3;
+			if (pSolverMngr->IsSimulated(uBody))
+				v3Displacement = pSolverMngr->GetVelocity(uBody);
+			vector3 v3DisplacementOther = ZERO_V3;
+			if (pSolverMngr->IsSimulated(uOther))
+				v3DisplacementOther = pSolverMngr->GetVelocity(uOther);
+
+			MyRigidBody* pRigidBody = m_RigidBodyList[i];
+			MyRigidBody* pOther = m_RigidBodyList[j];
+			if (!pRigidBody->IsSweptColliding(pOther, v3Displacement, v3DisplacementOther))
+				continue;
+
+			//both stop where they touch, the next frame reports the contact
+			float fTime = pRigidBody->TimeOfImpact(pOther, v3Displacement, v3DisplacementOther);
+			if (fTime < 1.0f)
+			{
+				pSolverMngr->SetTimeOfImpact(uBody, fTime);
+				pSolverMngr->SetTimeOfImpact(uOther, fTime);
+			}
+		}
+	}
+}
+void Simplex::MyEntityManager::PushEntity(MyEntity* a_pEntity)
+{
+	//the slot map grows geometrically, no need to copy the list every time
+	MyHandle handle = m_EntityMap.Insert(a_pEntity);
+	//the state of the entity moves into the components, from here on it reads them
+	PushComponents(a_pEntity);
+	a_pEntity->SetHandle(handle);
+
+	//remember the handle under the interned id of the entity
+	uint uID = a_pEntity->GetID();
+	if (uID >= m_HandleList.size())
+		m_HandleList.resize(uID + 1);
+	m_HandleList[uID] = handle;
+}
 void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 {
 	//Create a temporal entity to store the object
@@ -195,104 +524,295 @@ void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 	//if I was able to generate it add it to the list
 	if (pTemp->IsInitialized())
 	{
-		//create a new temp array with one extra entry
-		PEntity* tempArray = new PEntity[m_uEntityCount + 1];
-		//start from 0 to the current count
-		uint uCount = 0;
-		for (uint i = 0; i < m_uEntityCount; ++i)
+		PushEntity(pTemp);
+	}
+}
+void Simplex::MyEntityManager::AddEntity(std::vector<vector3> a_lVertexList, String a_sUniqueID)
+{
+	//Create a temporal entity to store the object
+	MyEntity* pTemp = new MyEntity(a_lVertexList, a_sUniqueID);
+	//if I was able to generate it add it to the list
+	if (pTemp->IsInitialized())
+	{
+		PushEntity(pTemp);
+	}
+	else
+	{
+		SafeDelete(pTemp);
+	}
+}
+Simplex::uint Simplex::MyEntityManager::AddEntities(String a_sFileName, uint a_uCount, matrix4 const* a_pTransforms, uint a_uFlags, String a_sUniqueID)
+{
+	uint uFirst = m_EntityMap.Size();
+	bool bStream = (a_uFlags & SPAWN_STREAM) != 0;
+	ReserveEntities(a_uCount);
+	//the first entity loads the model, the rest find it in the cache
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		MyEntity* pTemp = new MyEntity(a_sFileName, a_sUniqueID, bStream);
+		//if the first one could not load the file none of them will
+		if (!pTemp->IsInitialized())
+		{
+			SafeDelete(pTemp);
+			break;
+		}
+		PushEntity(pTemp);
+		if (bStream)
+			m_StreamingList.push_back(pTemp->GetHandle());
+	}
+	return SetupEntities(uFirst, a_pTransforms, a_uFlags);
+}
+Simplex::uint Simplex::MyEntityManager::AddEntities(std::vector<vector3> a_lVertexList, uint a_uCount, matrix4 const* a_pTransforms, uint a_uFlags, String a_sUniqueID)
+{
+	uint uFirst = m_EntityMap.Size();
+	if (a_lVertexList.size() == 0)
+		return 0;
+
+	//the vertices are walked once, the rigid body of every entity is built from the corners found
+	vector3 v3Min = a_lVertexList[0];
+	vector3 v3Max = a_lVertexList[0];
+	for (uint i = 1; i < a_lVertexList.size(); ++i)
+	{
+		v3Min = glm::min(v3Min, a_lVertexList[i]);
+		v3Max = glm::max(v3Max, a_lVertexList[i]);
+	}
+	std::vector<vector3> lCorner = { v3Min, v3Max };
+
+	ReserveEntities(a_uCount);
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		PushEntity(new MyEntity(lCorner, a_sUniqueID));
+	}
+	return SetupEntities(uFirst, a_pTransforms, a_uFlags);
+}
+void Simplex::MyEntityManager::ReserveEntities(uint a_uCount)
+{
+	uint uCount = m_EntityMap.Size() + a_uCount;
+	m_EntityMap.Reserve(uCount);
+	m_TransformList.reserve(uCount);
+	m_CenterLocalList.reserve(uCount);
+	m_HalfWidthLocalList.reserve(uCount);
+	m_MinGlobalList.reserve(uCount);
+	m_MaxGlobalList.reserve(uCount);
+	m_BodyList.reserve(uCount);
+	m_RigidBodyList.reserve(uCount);
+	m_ModelList.reserve(uCount);
+	m_AxisList.reserve(uCount);
+	m_AnimationFrameList.reserve(uCount);
+	m_DimensionList.reserve(uCount);
+
+	MySolverManager* pSolverMngr = MySolverManager::GetInstance();
+	pSolverMngr->Reserve(pSolverMngr->GetBodyCount() + a_uCount);
+}
+Simplex::uint Simplex::MyEntityManager::SetupEntities(uint a_uFirst, matrix4 const* a_pTransforms, uint a_uFlags)
+{
+	uint uCount = m_EntityMap.Size() - a_uFirst;
+	bool bPhysics = (a_uFlags & SPAWN_PHYSICS) != 0;
+	bool bContinuous = (a_uFlags & SPAWN_CONTINUOUS) != 0;
+	bool bAxis = (a_uFlags & SPAWN_AXIS) != 0;
+	MySolverManager* pSolverMngr = MySolverManager::GetInstance();
+	//the components, the rigid bodies and the solver are written here directly, the matrices are
+	//not compared or taken apart one entity at a time
+	for (uint i = 0; i < uCount; ++i)
+	{
+		uint uIndex = a_uFirst + i;
+		if (bPhysics)
 		{
-			tempArray[uCount] = m_mEntityArray[i];
-			++uCount;
+			MyEntity* pEntity = m_EntityMap[uIndex];
+			pEntity->UsePhysicsSolver(true);
+			pEntity->UseContinuousCollision(bContinuous);
 		}
-		tempArray[uCount] = pTemp;
-		//if there was an older array delete
-		if (m_mEntityArray)
+		m_AxisList[uIndex] = bAxis;
+
+		if (a_pTransforms != nullptr)
 		{
-			delete[] m_mEntityArray;
+			m_TransformList[uIndex] = a_pTransforms[i];
+			m_RigidBodyList[uIndex]->SetModelMatrix(a_pTransforms[i]);
+			if (bPhysics)
+				pSolverMngr->SetTransform(m_BodyList[uIndex], a_pTransforms[i]);
 		}
-		//make the member pointer the temp pointer
-		m_mEntityArray = tempArray;
-		//add one entity to the count
-		++m_uEntityCount;
 	}
+	//one pass for the bounds of the whole batch
+	UpdateBounds(a_uFirst, uCount);
+	//a loose tree takes the batch now, so the queries see it before the next frame
+	if (m_pOctree != nullptr)
+		m_pOctree->InsertEntities(a_uFirst, uCount);
+	return uCount;
 }
 void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	// if out of bounds choose the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	// if the entity is not the very last we swap it for the last one
-	if (a_uIndex != m_uEntityCount - 1)
-	{
-		std::swap(m_mEntityArray[a_uIndex], m_mEntityArray[m_uEntityCount - 1]);
-	}
-	
-	//and then pop the last one
-	//create a new temp array with one less entry
-	PEntity* tempArray = new PEntity[m_uEntityCount - 1];
-	//start from 0 to the current count
-	for (uint i = 0; i < m_uEntityCount - 1; ++i)
-	{
-		tempArray[i] = m_mEntityArray[i];
-	}
-	//if there was an older array delete
-	if (m_mEntityArray)
+	RemoveEntity(m_EntityMap.GetHandle(a_uIndex));
+}
+void Simplex::MyEntityManager::RemoveEntity(MyHandle a_Handle)
+{
+	MyEntity** ppEntity = m_EntityMap.Get(a_Handle);
+	//if the handle is stale there is nothing to remove
+	if (ppEntity == nullptr)
+		return;
+	MyEntity* pEntity = *ppEntity;
+
+	//the cached pairs of this entity are gone, the other slots do not change
+	for (uint i = 0; i < m_EntityMap.Size(); ++i)
 	{
-		delete[] m_mEntityArray;
+		uint uSlot = m_EntityMap.GetSlot(i);
+		if (uSlot != a_Handle.m_uSlot && m_pPairCache->IsCached(uSlot, a_Handle.m_uSlot))
+			m_EntityMap[i]->RemoveCollisionWith(pEntity);
 	}
-	//make the member pointer the temp pointer
-	m_mEntityArray = tempArray;
-	//add one entity to the count
-	--m_uEntityCount;
+	m_pPairCache->RemoveIndex(a_Handle.m_uSlot);
+	m_pContactSolver->RemoveBody(pEntity->GetSolverID());
+	//the slot can be reused, the tree must not think the next entity in it is already linked
+	if (m_pOctree != nullptr)
+		m_pOctree->RemoveEntity(a_Handle);
+
+	//the last entity takes its place in the list, its handle stays valid
+	RemoveComponents(m_EntityMap.GetDenseIndex(a_Handle));
+	m_EntityMap.Erase(a_Handle);
+	if (pEntity->GetID() < m_HandleList.size())
+		m_HandleList[pEntity->GetID()] = MyHandle();
+	bool bModel = pEntity->GetModelKey() != "";
+	SafeDelete(pEntity);
+	//the entity gave its model back, if it was the last one to use it the cache can let it go
+	if (bModel)
+		MyModelCache::GetInstance()->Purge();
 }
 void Simplex::MyEntityManager::RemoveEntity(String a_sUniqueID)
 {
 	int nIndex = GetEntityIndex(a_sUniqueID);
-	RemoveEntity((uint)nIndex);
+	//if not found there is nothing to remove
+	if (nIndex < 0)
+		return;
+	RemoveEntity(m_EntityMap.GetHandle(static_cast<uint>(nIndex)));
 }
 Simplex::String Simplex::MyEntityManager::GetUniqueID(uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return "";
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->GetUniqueID();
+	return m_EntityMap[a_uIndex]->GetUniqueID();
 }
 Simplex::MyEntity* Simplex::MyEntityManager::GetEntity(uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return nullptr;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	return m_EntityMap[a_uIndex];
+}
+Simplex::MyEntity* Simplex::MyEntityManager::GetEntity(MyHandle a_Handle)
+{
+	MyEntity** ppEntity = m_EntityMap.Get(a_Handle);
+	//if the handle is stale the entity is gone
+	return ppEntity == nullptr ? nullptr : *ppEntity;
+}
+Simplex::MyHandle Simplex::MyEntityManager::GetEntityHandle(uint a_uIndex)
+{
+	//if the list is empty return a stale handle
+	if (m_EntityMap.Size() == 0)
+		return MyHandle();
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex];
+	return m_EntityMap.GetHandle(a_uIndex);
+}
+int Simplex::MyEntityManager::GetEntityIndex(MyHandle a_Handle)
+{
+	return static_cast<int>(m_EntityMap.GetDenseIndex(a_Handle));
 }
 void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigidBody)
 {
 	//if out of bounds will do it for all
-	if (a_uIndex >= m_uEntityCount)
+	if (a_uIndex >= m_EntityMap.Size())
 	{
-		//add for each one in the entity list
-		for (a_uIndex = 0; a_uIndex < m_uEntityCount; ++a_uIndex)
+		if (m_pDebugDraw == nullptr)
+			m_pDebugDraw = MyDebugDraw::GetInstance();
+		if (m_pCuller == nullptr)
+			m_pCuller = MyOcclusionCuller::GetInstance();
+
+		MyModelCache* pModelCache = MyModelCache::GetInstance();
+
+		//render system, the models are shared so each one takes the transform right before being added;
+		//the ones the culler found hidden are skipped, the debug information is not
+		for (a_uIndex = 0; a_uIndex < m_EntityMap.Size(); ++a_uIndex)
 		{
-			m_mEntityArray[a_uIndex]->AddToRenderList(a_bRigidBody);
+			if (m_ModelList[a_uIndex] != nullptr && m_pCuller->IsVisible(a_uIndex))
+			{
+				//only the animated entities go through their pointer, for the key of their model
+				if (m_AnimationFrameList[a_uIndex] >= 0.0f)
+					pModelCache->Animate(m_EntityMap[a_uIndex]->GetModelKey(), m_AnimationFrameList[a_uIndex]);
+				m_ModelList[a_uIndex]->SetModelMatrix(m_TransformList[a_uIndex]);
+				m_ModelList[a_uIndex]->AddToRenderList();
+			}
+			if (m_AxisList[a_uIndex])
+				m_pDebugDraw->AddAxis(m_TransformList[a_uIndex]);
+		}
+		//the entities still waiting on the streamer are drawn as their placeholder box
+		for (uint i = 0; i < m_StreamingList.size(); ++i)
+		{
+			int nIndex = GetEntityIndex(m_StreamingList[i]);
+			if (nIndex < 0)
+				continue;
+			a_uIndex = static_cast<uint>(nIndex);
+			m_pDebugDraw->AddBox(m_TransformList[a_uIndex] * glm::translate(m_CenterLocalList[a_uIndex]) *
+				glm::scale(m_HalfWidthLocalList[a_uIndex] * 2.0f), C_GRAY);
+		}
+		//the rigid bodies are debug information, they are the only part that needs the entities
+		if (a_bRigidBody)
+		{
+			for (a_uIndex = 0; a_uIndex < m_EntityMap.Size(); ++a_uIndex)
+			{
+				m_RigidBodyList[a_uIndex]->AddToRenderList();
+			}
 		}
 	}
 	else //do it for the specified one
 	{
-		m_mEntityArray[a_uIndex]->AddToRenderList(a_bRigidBody);
+		m_EntityMap[a_uIndex]->AddToRenderList(a_bRigidBody);
+	}
+}
+void Simplex::MyEntityManager::UpdateStreamedModels(void)
+{
+	for (uint i = 0; i < m_StreamingList.size();)
+	{
+		int nIndex = GetEntityIndex(m_StreamingList[i]);
+		if (nIndex >= 0)
+		{
+			uint uIndex = static_cast<uint>(nIndex);
+			if (!m_EntityMap[uIndex]->FinishStreaming())
+			{
+				++i;
+				continue;
+			}
+			//the rigid body was fitted to the model, the components follow it
+			MyRigidBody* pRigidBody = m_RigidBodyList[uIndex];
+			vector3 v3MinLocal = pRigidBody->GetMinLocal();
+			vector3 v3MaxLocal = pRigidBody->GetMaxLocal();
+			m_CenterLocalList[uIndex] = (v3MinLocal + v3MaxLocal) * 0.5f;
+			m_HalfWidthLocalList[uIndex] = (v3MaxLocal - v3MinLocal) * 0.5f;
+			m_ModelList[uIndex] = m_EntityMap[uIndex]->GetModel();
+			UpdateBounds(uIndex, 1);
+		}
+		//removed entities and the ones that got their model leave the list
+		m_StreamingList[i] = m_StreamingList.back();
+		m_StreamingList.pop_back();
 	}
 }
 void Simplex::MyEntityManager::AddEntityToRenderList(String a_sUniqueID, bool a_bRigidBody)
@@ -308,50 +828,57 @@ void Simplex::MyEntityManager::AddEntityToRenderList(String a_sUniqueID, bool a_
 void Simplex::MyEntityManager::AddDimension(uint a_uIndex, uint a_uDimension)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->AddDimension(a_uDimension);
+	//keep the component sorted so two sets are compared in one walk
+	std::vector<uint>& lDimension = m_DimensionList[a_uIndex];
+	auto position = std::lower_bound(lDimension.begin(), lDimension.end(), a_uDimension);
+	if (position == lDimension.end() || *position != a_uDimension)
+		lDimension.insert(position, a_uDimension);
 }
 void Simplex::MyEntityManager::AddDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->AddDimension(a_uDimension);
+		AddDimension(static_cast<uint>(nIndex), a_uDimension);
 	}
 }
 void Simplex::MyEntityManager::RemoveDimension(uint a_uIndex, uint a_uDimension)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->RemoveDimension(a_uDimension);
+	std::vector<uint>& lDimension = m_DimensionList[a_uIndex];
+	auto position = std::lower_bound(lDimension.begin(), lDimension.end(), a_uDimension);
+	if (position != lDimension.end() && *position == a_uDimension)
+		lDimension.erase(position);
 }
 void Simplex::MyEntityManager::RemoveDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->RemoveDimension(a_uDimension);
+		RemoveDimension(static_cast<uint>(nIndex), a_uDimension);
 	}
 }
 void Simplex::MyEntityManager::ClearDimensionSetAll(void)
 {
-	for (uint i = 0; i < m_uEntityCount; ++i)
+	for (uint i = 0; i < m_EntityMap.Size(); ++i)
 	{
 		ClearDimensionSet(i);
 	}
@@ -359,36 +886,63 @@ void Simplex::MyEntityManager::ClearDimensionSetAll(void)
 void Simplex::MyEntityManager::ClearDimensionSet(uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->ClearDimensionSet();
+	//clear keeps the capacity, the octree fills it again when it is rebuilt
+	m_DimensionList[a_uIndex].clear();
 }
 void Simplex::MyEntityManager::ClearDimensionSet(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->ClearDimensionSet();
+		ClearDimensionSet(static_cast<uint>(nIndex));
 	}
 }
 bool Simplex::MyEntityManager::IsInDimension(uint a_uIndex, uint a_uDimension)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return false;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	std::vector<uint> const& lDimension = m_DimensionList[a_uIndex];
+	return std::binary_search(lDimension.begin(), lDimension.end(), a_uDimension);
+}
+Simplex::uint Simplex::MyEntityManager::GetDimensionCount(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return 0;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	return static_cast<uint>(m_DimensionList[a_uIndex].size());
+}
+Simplex::uint* Simplex::MyEntityManager::GetDimensionArray(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return nullptr;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->IsInDimension(a_uDimension);
+	std::vector<uint>& lDimension = m_DimensionList[a_uIndex];
+	return lDimension.empty() ? nullptr : lDimension.data();
 }
 bool Simplex::MyEntityManager::IsInDimension(String a_sUniqueID, uint a_uDimension)
 {
@@ -404,14 +958,14 @@ bool Simplex::MyEntityManager::IsInDimension(String a_sUniqueID, uint a_uDimensi
 bool Simplex::MyEntityManager::SharesDimension(uint a_uIndex, MyEntity* const a_pOther)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return false;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->SharesDimension(a_pOther);
+	return m_EntityMap[a_uIndex]->SharesDimension(a_pOther);
 }
 bool Simplex::MyEntityManager::SharesDimension(String a_sUniqueID, MyEntity* const a_pOther)
 {
@@ -436,14 +990,14 @@ void Simplex::MyEntityManager::ApplyForce(vector3 a_v3Force, String a_sUniqueID)
 void Simplex::MyEntityManager::ApplyForce(vector3 a_v3Force, uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->ApplyForce(a_v3Force);
+	return m_EntityMap[a_uIndex]->ApplyForce(a_v3Force);
 }
 void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, String a_sUniqueID)
 {
@@ -459,14 +1013,14 @@ void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, String a_sUniqu
 void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	m_mEntityArray[a_uIndex]->SetPosition(a_v3Position);
+	m_EntityMap[a_uIndex]->SetPosition(a_v3Position);
 
 	return;
 }
@@ -484,14 +1038,14 @@ void Simplex::MyEntityManager::SetMass(float a_fMass, String a_sUniqueID)
 void Simplex::MyEntityManager::SetMass(float a_fMass, uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	m_mEntityArray[a_uIndex]->SetMass(a_fMass);
+	m_EntityMap[a_uIndex]->SetMass(a_fMass);
 
 	return;
 }
@@ -508,12 +1062,282 @@ void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, String a_sUniqueID)
 void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, uint a_uIndex)
 {
 	//if the list is empty return
-	if (m_uEntityCount == 0)
+	if (m_EntityMap.Size() == 0)
 		return;
 
 	//if the index is larger than the number of entries we are asking for the last one
-	if (a_uIndex >= m_uEntityCount)
-		a_uIndex = m_uEntityCount - 1;
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
 
-	return m_mEntityArray[a_uIndex]->UsePhysicsSolver(a_bUse);
-}
\ No newline at end of file
+	return m_EntityMap[a_uIndex]->UsePhysicsSolver(a_bUse);
+}
+void Simplex::MyEntityManager::UseContinuousCollision(bool a_bUse, String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+
+	//if the entity does not exists return
+	if (pTemp)
+		pTemp->UseContinuousCollision(a_bUse);
+	return;
+}
+void Simplex::MyEntityManager::UseContinuousCollision(bool a_bUse, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_EntityMap.Size() == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_EntityMap.Size())
+		a_uIndex = m_EntityMap.Size() - 1;
+
+	return m_EntityMap[a_uIndex]->UseContinuousCollision(a_bUse);
+}
+void Simplex::MyEntityManager::PushComponents(MyEntity* a_pEntity)
+{
+	MyRigidBody* pRigidBody = a_pEntity->GetRigidBody();
+	vector3 v3MinLocal = pRigidBody->GetMinLocal();
+	vector3 v3MaxLocal = pRigidBody->GetMaxLocal();
+
+	m_TransformList.push_back(a_pEntity->GetModelMatrix());
+	m_CenterLocalList.push_back((v3MinLocal + v3MaxLocal) * 0.5f);
+	m_HalfWidthLocalList.push_back((v3MaxLocal - v3MinLocal) * 0.5f);
+	m_MinGlobalList.push_back(pRigidBody->GetMinGlobal());
+	m_MaxGlobalList.push_back(pRigidBody->GetMaxGlobal());
+	m_BodyList.push_back(a_pEntity->GetSolverID());
+	m_RigidBodyList.push_back(pRigidBody);
+	m_ModelList.push_back(a_pEntity->GetModel());
+	m_AxisList.push_back(a_pEntity->GetAxisVisible());
+	m_AnimationFrameList.push_back(a_pEntity->GetAnimationFrame());
+	uint* pDimension = a_pEntity->GetDimensionArray();
+	m_DimensionList.push_back(std::vector<uint>(pDimension, pDimension + a_pEntity->GetDimensionCount()));
+}
+void Simplex::MyEntityManager::RemoveComponents(uint a_uIndex)
+{
+	//swap and pop, the same way the entity map does it
+	uint uLast = static_cast<uint>(m_TransformList.size()) - 1;
+	if (a_uIndex != uLast)
+	{
+		m_TransformList[a_uIndex] = m_TransformList[uLast];
+		m_CenterLocalList[a_uIndex] = m_CenterLocalList[uLast];
+		m_HalfWidthLocalList[a_uIndex] = m_HalfWidthLocalList[uLast];
+		m_MinGlobalList[a_uIndex] = m_MinGlobalList[uLast];
+		m_MaxGlobalList[a_uIndex] = m_MaxGlobalList[uLast];
+		m_BodyList[a_uIndex] = m_BodyList[uLast];
+		m_RigidBodyList[a_uIndex] = m_RigidBodyList[uLast];
+		m_ModelList[a_uIndex] = m_ModelList[uLast];
+		m_AxisList[a_uIndex] = m_AxisList[uLast];
+		m_AnimationFrameList[a_uIndex] = m_AnimationFrameList[uLast];
+		std::swap(m_DimensionList[a_uIndex], m_DimensionList[uLast]);
+	}
+	m_TransformList.pop_back();
+	m_CenterLocalList.pop_back();
+	m_HalfWidthLocalList.pop_back();
+	m_MinGlobalList.pop_back();
+	m_MaxGlobalList.pop_back();
+	m_BodyList.pop_back();
+	m_RigidBodyList.pop_back();
+	m_ModelList.pop_back();
+	m_AxisList.pop_back();
+	m_AnimationFrameList.pop_back();
+	m_DimensionList.pop_back();
+}
+void Simplex::MyEntityManager::SetTransform(uint a_uIndex, matrix4 const& a_m4ToWorld)
+{
+	m_TransformList[a_uIndex] = a_m4ToWorld;
+	m_RigidBodyList[a_uIndex]->SetModelMatrix(a_m4ToWorld);
+	UpdateBounds(a_uIndex, 1);
+}
+void Simplex::MyEntityManager::UpdateBounds(uint a_uFirst, uint a_uCount)
+{
+	//the ARBB of a transformed box is its transformed center plus the absolute matrix times its half size,
+	//the same box the rigid body gets from its 8 corners. Written on the columns so there are no branches
+	uint uEnd = a_uFirst + a_uCount;
+	for (uint i = a_uFirst; i < uEnd; ++i)
+	{
+		matrix4 const& m4ToWorld = m_TransformList[i];
+		vector3 const& v3Center = m_CenterLocalList[i];
+		vector3 const& v3HalfWidth = m_HalfWidthLocalList[i];
+
+		vector3 v3Global = vector3(m4ToWorld[3]) +
+			vector3(m4ToWorld[0]) * v3Center.x +
+			vector3(m4ToWorld[1]) * v3Center.y +
+			vector3(m4ToWorld[2]) * v3Center.z;
+		vector3 v3Extent =
+			glm::abs(vector3(m4ToWorld[0])) * v3HalfWidth.x +
+			glm::abs(vector3(m4ToWorld[1])) * v3HalfWidth.y +
+			glm::abs(vector3(m4ToWorld[2])) * v3HalfWidth.z;
+
+		m_MinGlobalList[i] = v3Global - v3Extent;
+		m_MaxGlobalList[i] = v3Global + v3Extent;
+	}
+}
+bool Simplex::MyEntityManager::SharesDimensionByIndex(uint a_uIndex, uint a_uOther)
+{
+	std::vector<uint> const& lDimension = m_DimensionList[a_uIndex];
+	std::vector<uint> const& lDimensionOther = m_DimensionList[a_uOther];
+
+	//special case: if there are no dimensions on either entity
+	//then they live in the special global dimension
+	if (lDimension.empty() || lDimensionOther.empty())
+		return lDimension.empty() && lDimensionOther.empty();
+
+	//both lists are sorted, walk them at the same time looking for a common one
+	uint i = 0;
+	uint j = 0;
+	while (i < lDimension.size() && j < lDimensionOther.size())
+	{
+		if (lDimension[i] == lDimensionOther[j])
+			return true;
+		if (lDimension[i] < lDimensionOther[j])
+			++i;
+		else
+			++j;
+	}
+	return false;
+}
+void Simplex::MyEntityManager::UpdateTransforms(void)
+{
+	MySolverManager* pSolverMngr = MySolverManager::GetInstance();
+	for (uint i = 0; i < m_EntityMap.Size(); i++)
+	{
+		uint uBody = m_BodyList[i];
+		if (!pSolverMngr->IsSimulated(uBody))
+			continue;
+
+		matrix4 m4ToWorld = glm::translate(pSolverMngr->GetPosition(uBody)) *
+			ToMatrix4(pSolverMngr->GetOrientation(uBody)) * glm::scale(pSolverMngr->GetSize(uBody));
+		if (m4ToWorld == m_TransformList[i])
+			continue;
+
+		SetTransform(i, m4ToWorld);
+	}
+}
+bool Simplex::MyEntityManager::IntersectSlabs(vector3 a_v3Origin, vector3 a_v3InverseDirection, vector3 a_v3Min, vector3 a_v3Max,
+	float& a_fEnter, float& a_fExit)
+{
+	a_fEnter = -std::numeric_limits<float>::max();
+	a_fExit = std::numeric_limits<float>::max();
+	for (uint i = 0; i < 3; ++i)
+	{
+		//a direction of 0 gives infinities, the ray is inside the slab or never enters it
+		float fNear = (a_v3Min[i] - a_v3Origin[i]) * a_v3InverseDirection[i];
+		float fFar = (a_v3Max[i] - a_v3Origin[i]) * a_v3InverseDirection[i];
+		if (fNear > fFar)
+			std::swap(fNear, fFar);
+		//NaN (origin on the plane of a flat slab) fails both comparisons and keeps the previous value
+		if (fNear > a_fEnter)
+			a_fEnter = fNear;
+		if (fFar < a_fExit)
+			a_fExit = fFar;
+	}
+	return a_fEnter <= a_fExit && a_fExit >= 0.0f;
+}
+bool Simplex::MyEntityManager::IntersectRay(uint a_uIndex, vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance,
+	float& a_fDistance, vector3& a_v3Normal)
+{
+	//the ARBB is cheap and rejects most of the entities
+	float fEnter = 0.0f;
+	float fExit = 0.0f;
+	if (!IntersectSlabs(a_v3Origin, 1.0f / a_v3Direction, m_MinGlobalList[a_uIndex], m_MaxGlobalList[a_uIndex], fEnter, fExit) ||
+		fEnter > a_fMaxDistance)
+		return false;
+
+	//the oriented box is the local box, the ray goes into its space instead; the direction is not
+	//normalized again so the distances along it stay global
+	matrix4 m4ToLocal = glm::inverse(m_TransformList[a_uIndex]);
+	vector3 v3Origin = vector3(m4ToLocal * vector4(a_v3Origin, 1.0f));
+	vector3 v3Direction = vector3(m4ToLocal * vector4(a_v3Direction, 0.0f));
+	vector3 v3Center = m_CenterLocalList[a_uIndex];
+	vector3 v3HalfWidth = m_HalfWidthLocalList[a_uIndex];
+	if (!IntersectSlabs(v3Origin, 1.0f / v3Direction, v3Center - v3HalfWidth, v3Center + v3HalfWidth, fEnter, fExit) ||
+		fEnter > a_fMaxDistance)
+		return false;
+
+	if (fEnter < 0.0f)
+	{
+		a_fDistance = 0.0f;
+		a_v3Normal = ZERO_V3;
+		return true;
+	}
+	a_fDistance = fEnter;
+
+	//the face hit is the one the local point is furthest out of, relative to the size of the box
+	vector3 v3Offset = v3Origin + v3Direction * fEnter - v3Center;
+	uint uAxis = 0;
+	float fLargest = -1.0f;
+	for (uint i = 0; i < 3; ++i)
+	{
+		float fOut = v3HalfWidth[i] > 0.0f ? std::abs(v3Offset[i]) / v3HalfWidth[i] : 0.0f;
+		if (fOut > fLargest)
+		{
+			fLargest = fOut;
+			uAxis = i;
+		}
+	}
+	vector3 v3Normal = ZERO_V3;
+	v3Normal[uAxis] = v3Offset[uAxis] < 0.0f ? -1.0f : 1.0f;
+	//normals go back through the inverse transpose so a non uniform scale does not bend them
+	a_v3Normal = glm::normalize(glm::transpose(matrix3(m4ToLocal)) * v3Normal);
+	return true;
+}
+bool Simplex::MyEntityManager::RayCast(MyRay const& a_Ray, MyRayHit& a_Hit)
+{
+	a_Hit = MyRayHit();
+	float fLength = glm::length(a_Ray.m_v3Direction);
+	if (fLength <= 0.0f)
+		return false;
+	vector3 v3Direction = a_Ray.m_v3Direction / fLength;
+
+	if (m_pOctree != nullptr)
+		m_pOctree->RayCast(a_Ray.m_v3Origin, v3Direction, a_Ray.m_fMaxDistance, a_Hit);
+	else
+	{
+		float fBest = a_Ray.m_fMaxDistance;
+		float fDistance = 0.0f;
+		vector3 v3Normal = ZERO_V3;
+		for (uint i = 0; i < m_EntityMap.Size(); ++i)
+		{
+			if (!IntersectRay(i, a_Ray.m_v3Origin, v3Direction, fBest, fDistance, v3Normal))
+				continue;
+			fBest = fDistance;
+			a_Hit.m_nIndex = static_cast<int>(i);
+			a_Hit.m_fDistance = fDistance;
+			a_Hit.m_v3Normal = v3Normal;
+		}
+	}
+	if (a_Hit.m_nIndex < 0)
+		return false;
+
+	a_Hit.m_Handle = m_EntityMap.GetHandle(static_cast<uint>(a_Hit.m_nIndex));
+	a_Hit.m_v3Point = a_Ray.m_v3Origin + v3Direction * a_Hit.m_fDistance;
+	return true;
+}
+void Simplex::MyEntityManager::RayCast(MyRay const* a_pRays, uint a_uCount, MyRayHit* a_pHits)
+{
+	//a thread is only worth it for a few dozen rays
+	uint uThreadCount = std::max(std::min(std::thread::hardware_concurrency(), a_uCount / RAY_BATCH_SHARE), 1u);
+	uint uShare = (a_uCount + uThreadCount - 1) / uThreadCount;
+
+	//the calling thread takes the first share
+	std::vector<std::thread> lThread;
+	for (uint uFirst = uShare; uFirst < a_uCount; uFirst += uShare)
+		lThread.push_back(std::thread(&MyEntityManager::RayCastRange, this, a_pRays + uFirst,
+			std::min(uShare, a_uCount - uFirst), a_pHits + uFirst));
+	RayCastRange(a_pRays, std::min(uShare, a_uCount), a_pHits);
+	for (uint i = 0; i < lThread.size(); ++i)
+		lThread[i].join();
+}
+void Simplex::MyEntityManager::RayCastRange(MyRay const* a_pRays, uint a_uCount, MyRayHit* a_pHits)
+{
+	for (uint i = 0; i < a_uCount; ++i)
+		RayCast(a_pRays[i], a_pHits[i]);
+}
+bool Simplex::MyEntityManager::Pick(uint a_uX, uint a_uY, MyRayHit& a_Hit)
+{
+	std::pair<vector3, vector3> ray = CameraManager::GetInstance()->GetClickAndDirectionOnWorldSpace(a_uX, a_uY);
+	MyRay pick;
+	pick.m_v3Origin = ray.first;
+	pick.m_v3Direction = ray.second;
+	return RayCast(pick, a_Hit);
+}
@@ -6,16 +6,79 @@ Date: 2017/07
 #define __MYENTITYMANAGER_H_
 
 #include "MyEntity.h"
+#include "MyPairCache.h"
+#include "MyContactSolver.h"
+#include "MySlotMap.h"
+#include "MyAssetStreamer.h"
+
+#define RAY_BATCH_SHARE 64 //fewest rays a thread of a batched ray cast is started for
 
 namespace Simplex
 {
 
+//Options of the entities added together with AddEntities, they can be combined
+enum eSpawnFlags
+{
+	SPAWN_NONE = 0, //static entities
+	SPAWN_PHYSICS = 1, //entities simulated by the physics solver
+	SPAWN_CONTINUOUS = 2, //simulated entities swept before moving, needs SPAWN_PHYSICS
+	SPAWN_AXIS = 4, //entities with their axis visible
+	SPAWN_STREAM = 8, //a model that is not loaded yet is streamed, a placeholder box is drawn until it arrives
+};
+
+//Ray in global space for the picking queries
+struct MyRay
+{
+	vector3 m_v3Origin = ZERO_V3; //start of the ray
+	vector3 m_v3Direction = AXIS_Z; //direction of the ray, it does not need to be normalized
+	float m_fMaxDistance = std::numeric_limits<float>::max(); //hits further than this are ignored
+};
+
+//Nearest entity hit by a ray
+struct MyRayHit
+{
+	int m_nIndex = -1; //index of the entity, -1 if nothing was hit
+	MyHandle m_Handle; //handle of the entity
+	float m_fDistance = 0.0f; //distance from the origin of the ray to the hit
+	vector3 m_v3Point = ZERO_V3; //hit point in global space
+	vector3 m_v3Normal = ZERO_V3; //normal of the face of the oriented box that was hit, 0 if the ray starts inside
+};
+
+class MyOctree;
+class MyOcclusionCuller;
+
 //System Class
 class MyEntityManager
 {
 	typedef MyEntity* PEntity; //MyEntity Pointer
-	uint m_uEntityCount = 0; //number of elements in the list
-	PEntity* m_mEntityArray = nullptr; //array of MyEntity pointers
+	MySlotMap<PEntity> m_EntityMap; //MyEntity pointers, packed for iteration and reachable by stable handles
+	std::vector<MyHandle> m_HandleList; //handle of the entity of each interned unique ID
+	MyPairCache* m_pPairCache = nullptr; //colliding pairs that persist between frames
+	MyContactSolver* m_pContactSolver = nullptr; //contacts of the colliding pairs, solved with impulses
+	uint m_uPairTestCount = 0; //number of pairs that shared a dimension and were tested in the last update
+	MyDebugDraw* m_pDebugDraw = nullptr; //For rendering axes, fetched the first time something is drawn
+	MyOcclusionCuller* m_pCuller = nullptr; //skips the models hidden last frame, fetched the first time something is drawn
+
+	//Components of the entities, dense and in the same order as the entity map so the systems
+	//only walk the lists they need instead of every entity through its pointer. They are the only
+	//copy of the transform, axis, animation frame and dimensions, the entities read and write them through their handle
+	std::vector<matrix4> m_TransformList; //model matrix of each entity
+	std::vector<vector3> m_CenterLocalList; //center of the local bounding box of each entity
+	std::vector<vector3> m_HalfWidthLocalList; //half size of the local bounding box of each entity
+	std::vector<vector3> m_MinGlobalList; //minimum of the global ARBB of each entity
+	std::vector<vector3> m_MaxGlobalList; //maximum of the global ARBB of each entity
+	std::vector<uint> m_BodyList; //handle of each entity in the solver manager
+	std::vector<MyRigidBody*> m_RigidBodyList; //rigid body of each entity, owned by the entity
+	std::vector<Model*> m_ModelList; //shared model of each entity, nullptr if it is not drawn
+	std::vector<bool> m_AxisList; //does the entity draw its axis?
+	std::vector<float> m_AnimationFrameList; //time the compressed tracks of the model of each entity are sampled at, negative if not animated
+	std::vector<std::vector<uint>> m_DimensionList; //sorted dimensions of each entity, empty is the global one
+	MyOctree* m_pOctree = nullptr; //tree the ray queries walk, owned by whoever built it
+	std::vector<uint> m_PairList; //candidate pairs of a loose octree, kept so it is not allocated every frame
+	std::vector<vector3> m_SweptMinList; //minimum of the ARBB of each entity swept over the step
+	std::vector<vector3> m_SweptMaxList; //maximum of the ARBB of each entity swept over the step
+	std::vector<std::pair<float, uint>> m_SweepOrder; //entities sorted by the x of their swept minimum
+	std::vector<MyHandle> m_StreamingList; //entities added with SPAWN_STREAM that have not got their model yet
 	static MyEntityManager* m_pInstance; // Singleton pointer
 public:
 	/*
@@ -37,6 +100,13 @@ public:
 	*/
 	int GetEntityIndex(String a_sUniqueID);
 	/*
+	USAGE: Gets the index (from the list of entities) of the entity specified by handle, the index
+	of an entity changes when others are removed, the handle does not
+	ARGUMENTS: MyHandle a_Handle -> handle of the entity
+	OUTPUT: index from the list of entities, -1 if the handle is stale
+	*/
+	int GetEntityIndex(MyHandle a_Handle);
+	/*
 	USAGE: Will add an entity to the list
 	ARGUMENTS:
 	-	String a_sFileName -> Name of the model to load
@@ -45,6 +115,39 @@ public:
 	*/
 	void AddEntity(String a_sFileName, String a_sUniqueID = "NA");
 	/*
+	USAGE: Will add an entity without a model to the list, it can collide and be simulated but not drawn
+	ARGUMENTS:
+	-	std::vector<vector3> a_lVertexList -> vertices used to generate the rigid body
+	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
+	OUTPUT: ---
+	*/
+	void AddEntity(std::vector<vector3> a_lVertexList, String a_sUniqueID = "NA");
+	/*
+	USAGE: Will add a batch of entities that share the same model, the storage is reserved once
+	and the bounds of the whole batch are computed in a single pass. Spatial structures built after
+	the call (like MyOctree) take the whole batch at once, a loose octree in use links it right away.
+	With SPAWN_STREAM the call does not wait for the model, see UpdateStreamedModels
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model to load, it is loaded only once
+	-	uint a_uCount -> number of entities to add
+	-	matrix4 const* a_pTransforms -> model matrix of each entity, nullptr for identity
+	-	uint a_uFlags = SPAWN_NONE -> combination of eSpawnFlags
+	-	String a_sUniqueID = "NA" -> Base name of the identifiers, a suffix is added after the first
+	OUTPUT: number of entities added, they are the last ones of the list
+	*/
+	uint AddEntities(String a_sFileName, uint a_uCount, matrix4 const* a_pTransforms, uint a_uFlags = SPAWN_NONE, String a_sUniqueID = "NA");
+	/*
+	USAGE: Will add a batch of entities without a model, see the overload with a file name
+	ARGUMENTS:
+	-	std::vector<vector3> a_lVertexList -> vertices used to generate the rigid bodies
+	-	uint a_uCount -> number of entities to add
+	-	matrix4 const* a_pTransforms -> model matrix of each entity, nullptr for identity
+	-	uint a_uFlags = SPAWN_NONE -> combination of eSpawnFlags
+	-	String a_sUniqueID = "NA" -> Base name of the identifiers, a suffix is added after the first
+	OUTPUT: number of entities added, they are the last ones of the list
+	*/
+	uint AddEntities(std::vector<vector3> a_lVertexList, uint a_uCount, matrix4 const* a_pTransforms, uint a_uFlags = SPAWN_NONE, String a_sUniqueID = "NA");
+	/*
 	USAGE: Deletes the MyEntity Specified by unique ID and removes it from the list
 	ARGUMENTS: uint a_uIndex -> index of the queried entry, if < 0 asks for the last one added
 	OUTPUT: ---
@@ -57,6 +160,13 @@ public:
 	*/
 	void RemoveEntity(String a_sUniqueID);
 	/*
+	USAGE: Deletes the MyEntity specified by handle and removes it from the list, the last entity
+	takes its index but keeps its handle
+	ARGUMENTS: MyHandle a_Handle -> handle of the entity
+	OUTPUT: ---
+	*/
+	void RemoveEntity(MyHandle a_Handle);
+	/*
 	USAGE: Gets the uniqueID name of the entity indexed
 	ARGUMENTS: uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
 	OUTPUT: UniqueID of the entity, if the list is empty will return blank
@@ -69,12 +179,45 @@ public:
 	*/
 	MyEntity* GetEntity(uint a_uIndex = -1);
 	/*
-	USAGE: Will update the MyEntity manager
+	USAGE: Gets the entity specified by handle
+	ARGUMENTS: MyHandle a_Handle -> handle of the entity
+	OUTPUT: entity, nullptr if it was removed
+	*/
+	MyEntity* GetEntity(MyHandle a_Handle);
+	/*
+	USAGE: Gets a handle to the entity indexed, it stays valid until the entity is removed
+	ARGUMENTS: uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
+	OUTPUT: handle of the entity, stale if the list is empty
+	*/
+	MyHandle GetEntityHandle(uint a_uIndex = -1);
+	/*
+	USAGE: Will update the MyEntity manager, same as calling CheckCollisions, ResolveCollisions
+	and IntegrateEntities in that order
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Tests every pair of entities and reports the colliding ones to the pair cache
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CheckCollisions(void);
+	/*
+	USAGE: Resolves the contact events generated by the last CheckCollisions, builds the SAT
+	contacts for the impulse solver or, with 0 contact iterations, pushes the bodies apart with forces
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ResolveCollisions(void);
+	/*
+	USAGE: Updates every entity and integrates the physics solver, the contacts are solved between
+	the velocity and the position integration
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegrateEntities(void);
+	/*
 	USAGE: Gets the model associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: Model
@@ -143,6 +286,58 @@ public:
 	*/
 	void SetAxisVisibility(bool a_bVisibility, String a_sUniqueID);
 	/*
+	USAGE: Gets the axis visibility of the entity
+	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: is the axis visible?
+	*/
+	bool GetAxisVisibility(uint a_uIndex = -1);
+	/*
+	USAGE: Sets the time the compressed tracks of the model of the entity are sampled at when it is drawn
+	ARGUMENTS:
+	-	float a_fFrame -> time in frames, fractions included; negative to leave the model as it is
+	-	uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: ---
+	*/
+	void SetAnimationFrame(float a_fFrame, uint a_uIndex = -1);
+	/*
+	USAGE: Sets the time the compressed tracks of the model of the entity are sampled at when it is drawn
+	ARGUMENTS:
+	-	float a_fFrame -> time in frames, fractions included; negative to leave the model as it is
+	-	String a_sUniqueID -> id of the queried entity
+	OUTPUT: ---
+	*/
+	void SetAnimationFrame(float a_fFrame, String a_sUniqueID);
+	/*
+	USAGE: Gets the time the compressed tracks of the model of the entity are sampled at
+	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: time in frames, negative if not animated
+	*/
+	float GetAnimationFrame(uint a_uIndex = -1);
+	/*
+	USAGE: Compresses the frames of a group of the model of the entity into a track, see
+	MyModelCache::CompressAnimation; the model is shared so every entity of the same file gets it
+	ARGUMENTS:
+	-	String a_sGroup -> name of the group
+	-	uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: was the group animated?
+	*/
+	bool CompressAnimation(String a_sGroup, uint a_uIndex = -1);
+	/*
+	USAGE: Compresses the frames of a group of the model of the entity into a track, see
+	MyModelCache::CompressAnimation; the model is shared so every entity of the same file gets it
+	ARGUMENTS:
+	-	String a_sGroup -> name of the group
+	-	String a_sUniqueID -> id of the queried entity
+	OUTPUT: was the group animated?
+	*/
+	bool CompressAnimation(String a_sGroup, String a_sUniqueID);
+	/*
+	USAGE: Gets the length of the longest compressed track of the model of the entity
+	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: length in frames, 0 if nothing is animated
+	*/
+	float GetAnimationLength(uint a_uIndex = -1);
+	/*
 	USAGE: Will add the specified entity to the render list
 	ARGUMENTS:
 	-	uint a_uIndex = -1 -> index (from the list) of the entity queried if < 0 will add all
@@ -159,6 +354,14 @@ public:
 	*/
 	void AddEntityToRenderList(String a_sUniqueID, bool a_bRigidBody = false);
 	/*
+	USAGE: Gives the entities added with SPAWN_STREAM the models the asset streamer loaded, fitting
+	their rigid bodies and bounds to them; the rest keep their placeholder. Has to be called after
+	MyAssetStreamer::Update, while nothing else reads the entities
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateStreamedModels(void);
+	/*
 	USAGE: Will set a dimension to the MyEntity
 	ARGUMENTS:
 	-	uint a_uIndex -> index (from the list) of the entity queried if < 0 will use the last one
@@ -217,6 +420,18 @@ public:
 	*/
 	bool IsInDimension(uint a_uIndex, uint a_uDimension);
 	/*
+	USAGE: Gets how many dimensions the entity is located in
+	ARGUMENTS: uint a_uIndex -> index (from the list) of the entity queried if < 0 will use the last one
+	OUTPUT: dimension count
+	*/
+	uint GetDimensionCount(uint a_uIndex);
+	/*
+	USAGE: Gets the dimensions the entity is located in, sorted; it is invalidated when they change
+	ARGUMENTS: uint a_uIndex -> index (from the list) of the entity queried if < 0 will use the last one
+	OUTPUT: dimensions, nullptr if there are none
+	*/
+	uint* GetDimensionArray(uint a_uIndex);
+	/*
 	USAGE: Will ask if the MyEntity is located in a particular dimension
 	ARGUMENTS:
 	-	String a_sUniqueID -> unique identifier of the entity queried
@@ -246,6 +461,63 @@ public:
 	OUTPUT: MyEntity count
 	*/
 	uint GetEntityCount(void);
+	/*
+	USAGE: Will return the count of contact events generated in the last update
+	ARGUMENTS: ---
+	OUTPUT: contact event count
+	*/
+	uint GetContactEventCount(void);
+	/*
+	USAGE: Gets the contact event specified by index, the indices in the event are the slots of
+	the entity handles (MyHandle::m_uSlot), they do not change when other entities are removed
+	ARGUMENTS: uint a_uIndex -> index of the event
+	OUTPUT: begin, stay or end event of a pair of entities
+	*/
+	MyContactEvent GetContactEvent(uint a_uIndex);
+	/*
+	USAGE: Will return the number of pairs that shared a dimension and were tested for collision
+	in the last update
+	ARGUMENTS: ---
+	OUTPUT: pair test count
+	*/
+	uint GetPairTestCount(void);
+	/*
+	USAGE: Sets the number of sequential impulse iterations used to solve the contacts
+	ARGUMENTS: uint a_uIterations -> iterations, 0 goes back to separating the bodies with forces
+	OUTPUT: ---
+	*/
+	void SetContactIterations(uint a_uIterations);
+	/*
+	USAGE: Gets the number of sequential impulse iterations used to solve the contacts
+	ARGUMENTS: ---
+	OUTPUT: iterations
+	*/
+	uint GetContactIterations(void);
+	/*
+	USAGE: Gets the number of contacts being solved with impulses
+	ARGUMENTS: ---
+	OUTPUT: contact count
+	*/
+	uint GetContactCount(void);
+	/*
+	USAGE: Gets the minimum of the global ARBB of the entity from the bounds component
+	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: minimum in global space
+	*/
+	vector3 GetMinGlobal(uint a_uIndex = -1);
+	/*
+	USAGE: Gets the maximum of the global ARBB of the entity from the bounds component
+	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: maximum in global space
+	*/
+	vector3 GetMaxGlobal(uint a_uIndex = -1);
+	/*
+	USAGE: Transform system, copies the state of the simulated bodies into the transform and bounds
+	components and into their rigid bodies
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateTransforms(void);
 
 	/*
 	USAGE: applies a force to the specified object
@@ -311,6 +583,91 @@ public:
 	OUTPUT: ---
 	*/
 	void UsePhysicsSolver(bool a_bUse = true, uint a_uIndex = -1);
+	/*
+	USAGE: Sets the continuous collision flag for the specified object, fast objects get swept
+	against the others so they do not cross them in one step
+	ARGUMENTS:
+	-	bool a_bUse -> Using continuous collision?
+	-	String a_sUniqueID -> ID of the MyEntity
+	OUTPUT: ---
+	*/
+	void UseContinuousCollision(bool a_bUse, String a_sUniqueID);
+	/*
+	USAGE: Sets the continuous collision flag for the specified object, fast objects get swept
+	against the others so they do not cross them in one step
+	ARGUMENTS:
+	-	bool a_bUse -> Using continuous collision?
+	-	uint a_uIndex = -1 -> ID of the MyEntity if < 0 last object added
+	OUTPUT: ---
+	*/
+	void UseContinuousCollision(bool a_bUse = true, uint a_uIndex = -1);
+	/*
+	USAGE: Sets the octree the ray queries walk, a loose one also gives the pairs CheckCollisions tests;
+	it has to be rebuilt or relinked when the entities move or change; the manager does not own it
+	ARGUMENTS: MyOctree* a_pOctree -> tree built over the entities, nullptr to test every entity
+	OUTPUT: ---
+	*/
+	void SetOctree(MyOctree* a_pOctree);
+	/*
+	USAGE: Gets the octree the ray queries walk
+	ARGUMENTS: ---
+	OUTPUT: tree set by SetOctree, nullptr if there is none
+	*/
+	MyOctree* GetOctree(void);
+	/*
+	USAGE: Finds the nearest entity hit by a ray, through the octree front to back if there is one
+	ARGUMENTS:
+	-	MyRay const& a_Ray -> ray in global space
+	-	MyRayHit& a_Hit -> gets the nearest hit
+	OUTPUT: was an entity hit?
+	*/
+	bool RayCast(MyRay const& a_Ray, MyRayHit& a_Hit);
+	/*
+	USAGE: Finds the nearest entity hit by each ray of a batch, the batch is split between threads;
+	nothing can change the entities or the octree until it returns
+	ARGUMENTS:
+	-	MyRay const* a_pRays -> rays in global space
+	-	uint a_uCount -> number of rays
+	-	MyRayHit* a_pHits -> gets the nearest hit of each ray, as many as rays
+	OUTPUT: ---
+	*/
+	void RayCast(MyRay const* a_pRays, uint a_uCount, MyRayHit* a_pHits);
+	/*
+	USAGE: Finds the nearest entity under a point of the window, through the active camera
+	ARGUMENTS:
+	-	uint a_uX -> horizontal position in the window
+	-	uint a_uY -> vertical position in the window
+	-	MyRayHit& a_Hit -> gets the nearest hit
+	OUTPUT: was an entity hit?
+	*/
+	bool Pick(uint a_uX, uint a_uY, MyRayHit& a_Hit);
+	/*
+	USAGE: Intersects a ray with one entity, the global ARBB first and the oriented box only if the
+	ARBB is hit
+	ARGUMENTS:
+	-	uint a_uIndex -> index of the entity
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> normalized direction of the ray
+	-	float a_fMaxDistance -> hits further than this are ignored
+	-	float& a_fDistance -> gets the distance to the hit, 0 if the ray starts inside
+	-	vector3& a_v3Normal -> gets the normal of the face that was hit
+	OUTPUT: was the entity hit?
+	*/
+	bool IntersectRay(uint a_uIndex, vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance,
+		float& a_fDistance, vector3& a_v3Normal);
+	/*
+	USAGE: Slab test of a ray against an axis aligned box
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3InverseDirection -> 1 / direction of the ray, per component
+	-	vector3 a_v3Min -> minimum of the box
+	-	vector3 a_v3Max -> maximum of the box
+	-	float& a_fEnter -> gets the distance where the ray enters the box, negative if it starts inside
+	-	float& a_fExit -> gets the distance where the ray leaves the box
+	OUTPUT: does the line cross the box in front of the origin?
+	*/
+	static bool IntersectSlabs(vector3 a_v3Origin, vector3 a_v3InverseDirection, vector3 a_v3Min, vector3 a_v3Max,
+		float& a_fEnter, float& a_fExit);
 private:
 	/*
 	Usage: constructor
@@ -348,6 +705,90 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	Usage: adds an already generated entity at the end of the list
+	Arguments: MyEntity* a_pEntity -> entity to add
+	Output: ---
+	*/
+	void PushEntity(MyEntity* a_pEntity);
+	/*
+	Usage: sweeps the entities that use continuous collision against the others and limits
+	their step to the first time of impact, call between the velocity and position integration;
+	the ARBBs grown over the step are sorted along x and only the ones that overlap are swept
+	Arguments: ---
+	Output: ---
+	*/
+	void SweepContinuousEntities(void);
+	/*
+	Usage: adds the components of an entity at the end of the component lists
+	Arguments: MyEntity* a_pEntity -> entity that was added to the entity map
+	Output: ---
+	*/
+	void PushComponents(MyEntity* a_pEntity);
+	/*
+	Usage: removes the components of an entity, the last ones take their place like in the entity map
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void RemoveComponents(uint a_uIndex);
+	/*
+	Usage: sets the transform component of an entity, recomputes its bounds component and moves its
+	rigid body; the solver is left alone
+	Arguments:
+	-	uint a_uIndex -> index of the entity
+	-	matrix4 const& a_m4ToWorld -> model matrix
+	Output: ---
+	*/
+	void SetTransform(uint a_uIndex, matrix4 const& a_m4ToWorld);
+	/*
+	Usage: recomputes the bounds component of a range of entities from their transform component
+	Arguments:
+	-	uint a_uFirst -> index of the first entity
+	-	uint a_uCount -> number of entities
+	Output: ---
+	*/
+	void UpdateBounds(uint a_uFirst, uint a_uCount);
+	/*
+	Usage: reserves the entity map, the component lists and the solver bodies for more entities
+	Arguments: uint a_uCount -> number of entities that will be added
+	Output: ---
+	*/
+	void ReserveEntities(uint a_uCount);
+	/*
+	Usage: applies the flags and transforms of a batch to the entities added since the first index in
+	one pass over the components, then links the batch into the octree if it is loose
+	Arguments:
+	-	uint a_uFirst -> index of the first entity of the batch
+	-	matrix4 const* a_pTransforms -> model matrix of each entity, nullptr for identity
+	-	uint a_uFlags -> combination of eSpawnFlags
+	Output: number of entities in the batch
+	*/
+	uint SetupEntities(uint a_uFirst, matrix4 const* a_pTransforms, uint a_uFlags);
+	/*
+	Usage: asks if two entities share a dimension using the dimension components
+	Arguments:
+	-	uint a_uIndex -> index of one entity
+	-	uint a_uOther -> index of the other entity
+	Output: do they share a dimension?
+	*/
+	bool SharesDimensionByIndex(uint a_uIndex, uint a_uOther);
+	/*
+	Usage: casts a share of a batch of rays, the body of each thread of the batched RayCast
+	Arguments:
+	-	MyRay const* a_pRays -> rays of the share
+	-	uint a_uCount -> number of rays in the share
+	-	MyRayHit* a_pHits -> gets the nearest hit of each ray
+	Output: ---
+	*/
+	void RayCastRange(MyRay const* a_pRays, uint a_uCount, MyRayHit* a_pHits);
+	/*
+	Usage: tests the bounds of a pair of entities and reports the pair if they collide
+	Arguments:
+	-	uint a_uIndex -> index of one entity
+	-	uint a_uOther -> index of the other entity
+	Output: ---
+	*/
+	void TestPair(uint a_uIndex, uint a_uOther);
 };//class
 
 } //namespace Simplex
@@ -0,0 +1,102 @@
+#include "MyHierarchy.h"
+using namespace Simplex;
+//  MyHierarchy
+void MyHierarchy::Init(void)
+{
+	m_lParent.clear();
+	m_lLocal.clear();
+	m_lWorld.clear();
+	m_lDirty.clear();
+	m_uFirstDirty = 0;
+}
+void MyHierarchy::Release(void)
+{
+	m_lParent.clear();
+	m_lLocal.clear();
+	m_lWorld.clear();
+	m_lDirty.clear();
+}
+void MyHierarchy::Swap(MyHierarchy& other)
+{
+	std::swap(m_lParent, other.m_lParent);
+	std::swap(m_lLocal, other.m_lLocal);
+	std::swap(m_lWorld, other.m_lWorld);
+	std::swap(m_lDirty, other.m_lDirty);
+	std::swap(m_uFirstDirty, other.m_uFirstDirty);
+}
+//The big 3
+MyHierarchy::MyHierarchy(void) { Init(); }
+MyHierarchy::MyHierarchy(MyHierarchy const& other)
+{
+	m_lParent = other.m_lParent;
+	m_lLocal = other.m_lLocal;
+	m_lWorld = other.m_lWorld;
+	m_lDirty = other.m_lDirty;
+	m_uFirstDirty = other.m_uFirstDirty;
+}
+MyHierarchy& MyHierarchy::operator=(MyHierarchy const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyHierarchy temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyHierarchy::~MyHierarchy() { Release(); };
+//Accessors
+matrix4 MyHierarchy::GetLocal(uint a_uNode) { return m_lLocal[a_uNode]; }
+matrix4 MyHierarchy::GetWorld(uint a_uNode) { return m_lWorld[a_uNode]; }
+int MyHierarchy::GetParent(uint a_uNode) { return m_lParent[a_uNode]; }
+uint MyHierarchy::GetNodeCount(void) { return static_cast<uint>(m_lParent.size()); }
+void MyHierarchy::SetLocal(uint a_uNode, matrix4 a_m4Local)
+{
+	if (m_lLocal[a_uNode] == a_m4Local)
+		return;
+	m_lLocal[a_uNode] = a_m4Local;
+	m_lDirty[a_uNode] = 1;
+	m_uFirstDirty = std::min(m_uFirstDirty, a_uNode);
+}
+//--- Methods
+uint MyHierarchy::AddNode(int a_nParent, matrix4 a_m4Local)
+{
+	uint uNode = static_cast<uint>(m_lParent.size());
+	//a parent after its child would be read before it is computed
+	if (a_nParent >= static_cast<int>(uNode))
+		a_nParent = -1;
+	m_lParent.push_back(a_nParent);
+	m_lLocal.push_back(a_m4Local);
+	m_lWorld.push_back(a_m4Local);
+	m_lDirty.push_back(1);
+	m_uFirstDirty = std::min(m_uFirstDirty, uNode);
+	return uNode;
+}
+void MyHierarchy::Clear(void)
+{
+	Release();
+	Init();
+}
+void MyHierarchy::Update(std::vector<uint>& a_lUpdated)
+{
+	uint uCount = static_cast<uint>(m_lParent.size());
+	if (m_uFirstDirty >= uCount)
+		return;
+
+	//parents come first, so their flag and world matrix are final by the time a child reads them
+	uint uFirst = static_cast<uint>(a_lUpdated.size());
+	for (uint i = m_uFirstDirty; i < uCount; ++i)
+	{
+		int nParent = m_lParent[i];
+		if (nParent >= 0 && m_lDirty[nParent])
+			m_lDirty[i] = 1;
+		if (!m_lDirty[i])
+			continue;
+		m_lWorld[i] = nParent >= 0 ? m_lWorld[nParent] * m_lLocal[i] : m_lLocal[i];
+		a_lUpdated.push_back(i);
+	}
+	for (uint i = uFirst; i < a_lUpdated.size(); ++i)
+		m_lDirty[a_lUpdated[i]] = 0;
+	m_uFirstDirty = uCount;
+}
@@ -0,0 +1,130 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYHIERARCHY_H_
+#define __MYHIERARCHY_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+//Tree of transforms stored flat, every node after its parent, so the world matrices are one pass
+class MyHierarchy
+{
+	std::vector<int> m_lParent; //index of the parent of each node, -1 for the roots
+	std::vector<matrix4> m_lLocal; //transform of each node relative to its parent
+	std::vector<matrix4> m_lWorld; //transform of each node relative to the roots, valid after Update
+	std::vector<char> m_lDirty; //does the world matrix of the node need to be computed again?
+	uint m_uFirstDirty = 0; //nodes before this one are clean, the pass starts here
+
+public:
+	/*
+	Usage: Constructor, the hierarchy is empty
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyHierarchy(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyHierarchy(MyHierarchy const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyHierarchy& operator=(MyHierarchy const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyHierarchy(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyHierarchy& other);
+	/*
+	USAGE: Adds a node, the parent has to be added before it
+	ARGUMENTS:
+	-	int a_nParent -> index of the parent, -1 for a root
+	-	matrix4 a_m4Local -> transform relative to the parent
+	OUTPUT: index of the node
+	*/
+	uint AddNode(int a_nParent, matrix4 a_m4Local = IDENTITY_M4);
+	/*
+	USAGE: Removes every node
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Sets the transform of a node relative to its parent, it and its subtree are computed by the
+	next Update; setting the same transform marks nothing
+	ARGUMENTS:
+	-	uint a_uNode -> index of the node
+	-	matrix4 a_m4Local -> transform relative to the parent
+	OUTPUT: ---
+	*/
+	void SetLocal(uint a_uNode, matrix4 a_m4Local);
+	/*
+	USAGE: Gets the transform of a node relative to its parent
+	ARGUMENTS: uint a_uNode -> index of the node
+	OUTPUT: local transform
+	*/
+	matrix4 GetLocal(uint a_uNode);
+	/*
+	USAGE: Gets the transform of a node relative to the roots, as of the last Update
+	ARGUMENTS: uint a_uNode -> index of the node
+	OUTPUT: world transform
+	*/
+	matrix4 GetWorld(uint a_uNode);
+	/*
+	USAGE: Gets the parent of a node
+	ARGUMENTS: uint a_uNode -> index of the node
+	OUTPUT: index of the parent, -1 for a root
+	*/
+	int GetParent(uint a_uNode);
+	/*
+	USAGE: Gets the number of nodes
+	ARGUMENTS: ---
+	OUTPUT: node count
+	*/
+	uint GetNodeCount(void);
+	/*
+	USAGE: Computes the world matrices of the dirty nodes and their subtrees in a single pass over the
+	array, a node is dirty if it or its parent is, so nothing is walked twice and nothing recurses
+	ARGUMENTS: std::vector<uint>& a_lUpdated -> gets the index of every node that was computed
+	OUTPUT: ---
+	*/
+	void Update(std::vector<uint>& a_lUpdated);
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYHIERARCHY_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
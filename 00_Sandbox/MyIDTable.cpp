@@ -0,0 +1,207 @@
+#include "MyIDTable.h"
+using namespace Simplex;
+//  MyIDTable
+void MyIDTable::Init(void)
+{
+	//start with a few buckets so the first names do not grow the table
+	m_EntryList.assign(64, MyIDEntry());
+	m_NameList.clear();
+	m_SuffixList.clear();
+	m_ReferenceList.clear();
+	m_FreeList.clear();
+	m_uNameCount = 0;
+}
+void MyIDTable::Swap(MyIDTable& other)
+{
+	std::swap(m_EntryList, other.m_EntryList);
+	std::swap(m_NameList, other.m_NameList);
+	std::swap(m_SuffixList, other.m_SuffixList);
+	std::swap(m_ReferenceList, other.m_ReferenceList);
+	std::swap(m_FreeList, other.m_FreeList);
+	std::swap(m_uNameCount, other.m_uNameCount);
+}
+void MyIDTable::Release(void)
+{
+	m_EntryList.clear();
+	m_NameList.clear();
+	m_SuffixList.clear();
+	m_ReferenceList.clear();
+	m_FreeList.clear();
+	m_uNameCount = 0;
+}
+//The big 3
+MyIDTable::MyIDTable(void) { Init(); }
+MyIDTable::MyIDTable(MyIDTable const& other)
+{
+	m_EntryList = other.m_EntryList;
+	m_NameList = other.m_NameList;
+	m_SuffixList = other.m_SuffixList;
+	m_ReferenceList = other.m_ReferenceList;
+	m_FreeList = other.m_FreeList;
+	m_uNameCount = other.m_uNameCount;
+}
+MyIDTable& MyIDTable::operator=(MyIDTable const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyIDTable temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyIDTable::~MyIDTable() { Release(); }
+//Accessors
+uint MyIDTable::GetCount(void) { return m_uNameCount; }
+uint MyIDTable::GetIDRange(void) { return static_cast<uint>(m_NameList.size()); }
+String MyIDTable::GetName(uint a_uID)
+{
+	if (a_uID >= m_NameList.size())
+		return "";
+	return m_NameList[a_uID];
+}
+uint MyIDTable::NextSuffix(uint a_uID)
+{
+	if (a_uID >= m_SuffixList.size() || m_ReferenceList[a_uID] == 0)
+		return 0;
+	//the counter keeps the base name referenced, or removing it would start the suffixes over
+	if (m_SuffixList[a_uID] == 0)
+		++m_ReferenceList[a_uID];
+	return m_SuffixList[a_uID]++;
+}
+void MyIDTable::ClaimSuffix(String a_sName)
+{
+	//only a name that ends in "_" and up to nine digits can be generated from another one
+	size_t uSplit = a_sName.find_last_of('_');
+	if (uSplit == String::npos || uSplit + 1 == a_sName.size() || a_sName.size() - uSplit > 10)
+		return;
+	if (a_sName.find_first_not_of("0123456789", uSplit + 1) != String::npos)
+		return;
+	uint uSuffix = static_cast<uint>(std::stoul(a_sName.substr(uSplit + 1)));
+
+	//the reference Intern takes becomes the one of the counter, the counter holds a single one
+	uint uBase = Intern(a_sName.substr(0, uSplit));
+	if (m_SuffixList[uBase] != 0)
+		--m_ReferenceList[uBase];
+	m_SuffixList[uBase] = std::max(m_SuffixList[uBase], uSuffix + 1);
+}
+//Methods
+MyIDTable::Hash MyIDTable::HashName(String const& a_sName)
+{
+	Hash uHash = 14695981039346656037ULL;
+	for (uint i = 0; i < a_sName.size(); ++i)
+	{
+		uHash ^= static_cast<unsigned char>(a_sName[i]);
+		uHash *= 1099511628211ULL;
+	}
+	return uHash;
+}
+uint MyIDTable::FindBucket(String const& a_sName, Hash a_uHash)
+{
+	uint uMask = static_cast<uint>(m_EntryList.size()) - 1;
+	uint uBucket = static_cast<uint>(a_uHash) & uMask;
+	//linear probing, the table is never more than half full so an empty bucket is close
+	while (m_EntryList[uBucket].m_uID != static_cast<uint>(-1))
+	{
+		MyIDEntry const& entry = m_EntryList[uBucket];
+		if (entry.m_uHash == a_uHash && m_NameList[entry.m_uID] == a_sName)
+			return uBucket;
+		uBucket = (uBucket + 1) & uMask;
+	}
+	return uBucket;
+}
+void MyIDTable::Grow(void)
+{
+	std::vector<MyIDEntry> lOldList;
+	lOldList.swap(m_EntryList);
+	m_EntryList.assign(lOldList.size() * 2, MyIDEntry());
+
+	uint uMask = static_cast<uint>(m_EntryList.size()) - 1;
+	for (uint i = 0; i < lOldList.size(); ++i)
+	{
+		if (lOldList[i].m_uID == static_cast<uint>(-1))
+			continue;
+		//names are unique, so the first empty bucket is the right one
+		uint uBucket = static_cast<uint>(lOldList[i].m_uHash) & uMask;
+		while (m_EntryList[uBucket].m_uID != static_cast<uint>(-1))
+			uBucket = (uBucket + 1) & uMask;
+		m_EntryList[uBucket] = lOldList[i];
+	}
+}
+uint MyIDTable::Intern(String a_sName)
+{
+	Hash uHash = HashName(a_sName);
+	uint uBucket = FindBucket(a_sName, uHash);
+	if (m_EntryList[uBucket].m_uID != static_cast<uint>(-1))
+	{
+		uint uID = m_EntryList[uBucket].m_uID;
+		++m_ReferenceList[uID];
+		return uID;
+	}
+
+	uint uID = static_cast<uint>(m_NameList.size());
+	if (!m_FreeList.empty())
+	{
+		uID = m_FreeList.back();
+		m_FreeList.pop_back();
+		m_NameList[uID] = a_sName;
+		m_SuffixList[uID] = 0;
+		m_ReferenceList[uID] = 1;
+	}
+	else
+	{
+		m_NameList.push_back(a_sName);
+		m_SuffixList.push_back(0);
+		m_ReferenceList.push_back(1);
+	}
+	m_EntryList[uBucket].m_uHash = uHash;
+	m_EntryList[uBucket].m_uID = uID;
+	++m_uNameCount;
+
+	//keep the load under one half
+	if (m_uNameCount * 2 > m_EntryList.size())
+		Grow();
+	return uID;
+}
+void MyIDTable::Remove(uint a_uID)
+{
+	if (a_uID >= m_ReferenceList.size() || m_ReferenceList[a_uID] == 0)
+		return;
+	if (--m_ReferenceList[a_uID] > 0)
+		return;
+
+	EraseBucket(FindBucket(m_NameList[a_uID], HashName(m_NameList[a_uID])));
+	m_NameList[a_uID].clear();
+	m_SuffixList[a_uID] = 0;
+	m_FreeList.push_back(a_uID);
+	--m_uNameCount;
+}
+void MyIDTable::EraseBucket(uint a_uBucket)
+{
+	uint uMask = static_cast<uint>(m_EntryList.size()) - 1;
+	m_EntryList[a_uBucket] = MyIDEntry();
+
+	//an entry can move into the gap unless its own bucket lies after the gap, up to where it is
+	uint uGap = a_uBucket;
+	for (uint uBucket = (a_uBucket + 1) & uMask; m_EntryList[uBucket].m_uID != static_cast<uint>(-1); uBucket = (uBucket + 1) & uMask)
+	{
+		uint uHome = static_cast<uint>(m_EntryList[uBucket].m_uHash) & uMask;
+		bool bStays = uGap <= uBucket ? (uHome > uGap && uHome <= uBucket) : (uHome > uGap || uHome <= uBucket);
+		if (bStays)
+			continue;
+		m_EntryList[uGap] = m_EntryList[uBucket];
+		m_EntryList[uBucket] = MyIDEntry();
+		uGap = uBucket;
+	}
+}
+uint MyIDTable::Find(String a_sName)
+{
+	uint uBucket = FindBucket(a_sName, HashName(a_sName));
+	return m_EntryList[uBucket].m_uID;
+}
+void MyIDTable::Clear(void)
+{
+	Release();
+	Init();
+}
@@ -0,0 +1,174 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYIDTABLE_H_
+#define __MYIDTABLE_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+//System Class
+class MyIDTable
+{
+	typedef unsigned long long Hash; //64 bit hash of a name
+
+	//Bucket of the open addressing table
+	struct MyIDEntry
+	{
+		Hash m_uHash = 0; //hash of the name, kept so growing does not hash the names again
+		uint m_uID = -1; //ID of the name, -1 if the bucket is empty
+	};
+
+	std::vector<MyIDEntry> m_EntryList; //buckets, the size is always a power of 2
+	std::vector<String> m_NameList; //name of each ID
+	std::vector<uint> m_SuffixList; //next suffix used to generate names from each ID
+	std::vector<uint> m_ReferenceList; //references to each ID, the name leaves the table when it gets to 0
+	std::vector<uint> m_FreeList; //IDs of removed names, given to the next names interned
+	uint m_uNameCount = 0; //names in the table, the freed IDs not included
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyIDTable(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyIDTable(MyIDTable const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyIDTable& operator=(MyIDTable const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyIDTable(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyIDTable& other);
+
+	/*
+	USAGE: Gets the ID of the name, adding it if it is not in the table, and takes a reference to it.
+	IDs are small numbers that do not change while the name is in the table, so they can index lists
+	directly; the IDs of removed names are given to new ones
+	ARGUMENTS: String a_sName -> name to intern
+	OUTPUT: ID of the name
+	*/
+	uint Intern(String a_sName);
+	/*
+	USAGE: Drops a reference taken by Intern, the name leaves the table and its ID is recycled once
+	nothing references it
+	ARGUMENTS: uint a_uID -> ID of the name
+	OUTPUT: ---
+	*/
+	void Remove(uint a_uID);
+	/*
+	USAGE: Gets the ID of the name without adding it
+	ARGUMENTS: String a_sName -> name to look for
+	OUTPUT: ID of the name, -1 if it is not in the table
+	*/
+	uint Find(String a_sName);
+	/*
+	USAGE: Gets the name of the ID
+	ARGUMENTS: uint a_uID -> ID of the name
+	OUTPUT: name, empty if the ID is not in the table
+	*/
+	String GetName(uint a_uID);
+	/*
+	USAGE: Gets the next suffix to generate a name from the ID, every call returns a new one; the
+	base name stays in the table from the first call on so its counter is never lost
+	ARGUMENTS: uint a_uID -> ID of the base name
+	OUTPUT: suffix
+	*/
+	uint NextSuffix(uint a_uID);
+	/*
+	USAGE: Marks the suffix of a name picked by hand as used, if the name ends in "_" and a number the
+	counter of the base name moves past that number so NextSuffix never hands it out; the base name
+	stays in the table like it does once NextSuffix is called
+	ARGUMENTS: String a_sName -> name that was taken
+	OUTPUT: ---
+	*/
+	void ClaimSuffix(String a_sName);
+	/*
+	USAGE: Gets the number of names in the table
+	ARGUMENTS: ---
+	OUTPUT: name count
+	*/
+	uint GetCount(void);
+	/*
+	USAGE: Gets the number of IDs handed out, every ID in use is below it
+	ARGUMENTS: ---
+	OUTPUT: one past the largest ID
+	*/
+	uint GetIDRange(void);
+	/*
+	USAGE: Removes all names, the IDs given so far are no longer valid
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Doubles the buckets and places the IDs again using their stored hashes
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Grow(void);
+	/*
+	USAGE: Finds the bucket of the name, or the empty bucket where it would go
+	ARGUMENTS:
+	-	String const& a_sName -> name to look for
+	-	Hash a_uHash -> hash of the name
+	OUTPUT: index of the bucket
+	*/
+	uint FindBucket(String const& a_sName, Hash a_uHash);
+	/*
+	USAGE: Empties a bucket and moves back the entries after it that would not be found past the gap
+	ARGUMENTS: uint a_uBucket -> bucket to empty
+	OUTPUT: ---
+	*/
+	void EraseBucket(uint a_uBucket);
+	/*
+	USAGE: Hashes the name with 64 bit FNV-1a
+	ARGUMENTS: String const& a_sName -> name to hash
+	OUTPUT: hash
+	*/
+	static Hash HashName(String const& a_sName);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYIDTABLE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
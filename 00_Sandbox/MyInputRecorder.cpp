@@ -0,0 +1,265 @@
+#include "MyInputRecorder.h"
+#include <chrono>
+#include <iomanip>
+using namespace Simplex;
+//  MyInputRecorder
+MyInputRecorder* MyInputRecorder::m_pInstance = nullptr;
+void MyInputRecorder::Init(void)
+{
+	m_eMode = RECORDER_OFF;
+	m_uSeed = static_cast<uint>(std::chrono::steady_clock::now().time_since_epoch().count());
+	m_bFast = false;
+	m_fDelta = 0.0f;
+	m_uNextSample = 0;
+	m_uMismatchCount = 0;
+	m_uFrameCount = 0;
+}
+void MyInputRecorder::Release(void)
+{
+	Stop();
+	m_EventList.clear();
+	m_SampleList.clear();
+	m_FrameTimeList.clear();
+}
+MyInputRecorder* MyInputRecorder::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyInputRecorder();
+	}
+	return m_pInstance;
+}
+void MyInputRecorder::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyInputRecorder::MyInputRecorder() { Init(); }
+MyInputRecorder::MyInputRecorder(MyInputRecorder const& a_pOther) { }
+MyInputRecorder& MyInputRecorder::operator=(MyInputRecorder const& a_pOther) { return *this; }
+MyInputRecorder::~MyInputRecorder() { Release(); };
+//Accessors
+eRecorderMode MyInputRecorder::GetMode(void) { return m_eMode; }
+bool MyInputRecorder::IsReplaying(void) { return m_eMode == RECORDER_REPLAY; }
+uint MyInputRecorder::GetSeed(void) { return m_uSeed; }
+void MyInputRecorder::SetFast(bool a_bFast) { m_bFast = a_bFast; }
+bool MyInputRecorder::IsFast(void) { return m_bFast; }
+void MyInputRecorder::SetTimingFile(String a_sFileName) { m_sTimingFile = a_sFileName; }
+uint MyInputRecorder::GetMismatchCount(void) { return m_uMismatchCount; }
+uint MyInputRecorder::GetEventCount(void)
+{
+	//the events of a capture are the ones the window already handed over
+	return m_eMode == RECORDER_REPLAY ? static_cast<uint>(m_EventList.size()) : 0;
+}
+sf::Event MyInputRecorder::GetEvent(uint a_uIndex) { return m_EventList[a_uIndex]; }
+//--- Methods
+bool MyInputRecorder::StartCapture(String a_sFileName)
+{
+	Stop();
+	m_Output.open(a_sFileName, std::ios::binary);
+	if (!m_Output.is_open())
+	{
+		std::cout << "Input recorder: could not create " << a_sFileName << std::endl;
+		return false;
+	}
+	uint uHeader[3] = { RECORDER_MAGIC, RECORDER_VERSION, m_uSeed };
+	m_Output.write(reinterpret_cast<char const*>(uHeader), sizeof(uHeader));
+	m_eMode = RECORDER_CAPTURE;
+	m_uFrameCount = 0;
+	return true;
+}
+bool MyInputRecorder::StartReplay(String a_sFileName)
+{
+	Stop();
+	m_Input.open(a_sFileName, std::ios::binary);
+	uint uHeader[3] = { 0, 0, 0 };
+	if (m_Input.is_open())
+		m_Input.read(reinterpret_cast<char*>(uHeader), sizeof(uHeader));
+	if (!m_Input || uHeader[0] != RECORDER_MAGIC || uHeader[1] != RECORDER_VERSION)
+	{
+		std::cout << "Input recorder: " << a_sFileName << " is not a log of this version" << std::endl;
+		m_Input.close();
+		return false;
+	}
+	m_uSeed = uHeader[2];
+	m_eMode = RECORDER_REPLAY;
+	m_uFrameCount = 0;
+	m_uMismatchCount = 0;
+	m_FrameTimeList.clear();
+	return true;
+}
+void MyInputRecorder::Stop(void)
+{
+	if (m_eMode == RECORDER_REPLAY)
+		WriteTiming();
+	if (m_Output.is_open())
+		m_Output.close();
+	if (m_Input.is_open())
+		m_Input.close();
+	m_eMode = RECORDER_OFF;
+}
+bool MyInputRecorder::BeginFrame(void)
+{
+	m_EventList.clear();
+	m_SampleList.clear();
+	m_uNextSample = 0;
+	if (m_eMode != RECORDER_REPLAY)
+		return true;
+
+	//frame: delta, event count, events as the window gave them, sample count, samples
+	unsigned short uEventCount = 0;
+	m_Input.read(reinterpret_cast<char*>(&m_fDelta), sizeof(m_fDelta));
+	m_Input.read(reinterpret_cast<char*>(&uEventCount), sizeof(uEventCount));
+	if (!m_Input)
+		return false;
+	m_EventList.resize(uEventCount);
+	if (uEventCount > 0)
+		m_Input.read(reinterpret_cast<char*>(m_EventList.data()), uEventCount * sizeof(sf::Event));
+
+	unsigned short uSampleCount = 0;
+	m_Input.read(reinterpret_cast<char*>(&uSampleCount), sizeof(uSampleCount));
+	for (uint i = 0; i < uSampleCount && m_Input; ++i)
+	{
+		MyInputSample sample;
+		m_Input.read(reinterpret_cast<char*>(&sample.m_uKind), sizeof(sample.m_uKind));
+		if (sample.m_uKind == SAMPLE_MOUSE)
+		{
+			m_Input.read(reinterpret_cast<char*>(&sample.m_nX), sizeof(sample.m_nX));
+			m_Input.read(reinterpret_cast<char*>(&sample.m_nY), sizeof(sample.m_nY));
+		}
+		m_SampleList.push_back(sample);
+	}
+	return static_cast<bool>(m_Input);
+}
+void MyInputRecorder::EndFrame(double a_dMilliseconds)
+{
+	++m_uFrameCount;
+	if (m_eMode == RECORDER_REPLAY)
+	{
+		m_FrameTimeList.push_back(static_cast<float>(a_dMilliseconds));
+		return;
+	}
+	if (m_eMode != RECORDER_CAPTURE)
+		return;
+
+	unsigned short uEventCount = static_cast<unsigned short>(std::min<size_t>(m_EventList.size(), std::numeric_limits<unsigned short>::max()));
+	m_Output.write(reinterpret_cast<char const*>(&m_fDelta), sizeof(m_fDelta));
+	m_Output.write(reinterpret_cast<char const*>(&uEventCount), sizeof(uEventCount));
+	if (uEventCount > 0)
+		m_Output.write(reinterpret_cast<char const*>(m_EventList.data()), uEventCount * sizeof(sf::Event));
+
+	unsigned short uSampleCount = static_cast<unsigned short>(std::min<size_t>(m_SampleList.size(), std::numeric_limits<unsigned short>::max()));
+	m_Output.write(reinterpret_cast<char const*>(&uSampleCount), sizeof(uSampleCount));
+	for (uint i = 0; i < uSampleCount; ++i)
+	{
+		MyInputSample const& sample = m_SampleList[i];
+		m_Output.write(reinterpret_cast<char const*>(&sample.m_uKind), sizeof(sample.m_uKind));
+		if (sample.m_uKind == SAMPLE_MOUSE)
+		{
+			m_Output.write(reinterpret_cast<char const*>(&sample.m_nX), sizeof(sample.m_nX));
+			m_Output.write(reinterpret_cast<char const*>(&sample.m_nY), sizeof(sample.m_nY));
+		}
+	}
+}
+void MyInputRecorder::RecordEvent(sf::Event const& a_Event)
+{
+	if (m_eMode != RECORDER_CAPTURE)
+		return;
+	if (a_Event.type == sf::Event::Closed || a_Event.type == sf::Event::Resized)
+		return;
+	m_EventList.push_back(a_Event);
+}
+MyInputSample MyInputRecorder::NextSample(unsigned char a_uKind)
+{
+	//a key poll matches either state of a key sample
+	bool bKey = a_uKind != SAMPLE_MOUSE;
+	if (m_uNextSample < m_SampleList.size())
+	{
+		MyInputSample const& sample = m_SampleList[m_uNextSample];
+		if ((sample.m_uKind != SAMPLE_MOUSE) == bKey)
+		{
+			++m_uNextSample;
+			return sample;
+		}
+	}
+	++m_uMismatchCount;
+	MyInputSample sample;
+	sample.m_uKind = a_uKind;
+	return sample;
+}
+bool MyInputRecorder::IsKeyPressed(sf::Keyboard::Key a_eKey)
+{
+	if (m_eMode == RECORDER_REPLAY)
+		return NextSample(SAMPLE_KEY_UP).m_uKind == SAMPLE_KEY_DOWN;
+
+	bool bPressed = sf::Keyboard::isKeyPressed(a_eKey);
+	if (m_eMode == RECORDER_CAPTURE)
+	{
+		MyInputSample sample;
+		sample.m_uKind = bPressed ? SAMPLE_KEY_DOWN : SAMPLE_KEY_UP;
+		m_SampleList.push_back(sample);
+	}
+	return bPressed;
+}
+sf::Vector2i MyInputRecorder::GetMousePosition(sf::Vector2i a_v2Origin)
+{
+	if (m_eMode == RECORDER_REPLAY)
+	{
+		MyInputSample sample = NextSample(SAMPLE_MOUSE);
+		return a_v2Origin + sf::Vector2i(sample.m_nX, sample.m_nY);
+	}
+
+	sf::Vector2i v2Mouse = sf::Mouse::getPosition();
+	if (m_eMode == RECORDER_CAPTURE)
+	{
+		MyInputSample sample;
+		sample.m_uKind = SAMPLE_MOUSE;
+		sample.m_nX = v2Mouse.x - a_v2Origin.x;
+		sample.m_nY = v2Mouse.y - a_v2Origin.y;
+		m_SampleList.push_back(sample);
+	}
+	return v2Mouse;
+}
+float MyInputRecorder::FilterDeltaTime(float a_fDelta)
+{
+	if (m_eMode == RECORDER_REPLAY)
+		return m_fDelta;
+	m_fDelta = a_fDelta;
+	return a_fDelta;
+}
+void MyInputRecorder::WriteTiming(void)
+{
+	uint uFrames = static_cast<uint>(m_FrameTimeList.size());
+	double dTotal = 0.0;
+	for (uint i = 0; i < uFrames; ++i)
+		dTotal += m_FrameTimeList[i];
+	std::vector<float> lSorted = m_FrameTimeList;
+	std::sort(lSorted.begin(), lSorted.end());
+
+	std::ostringstream sJSON;
+	sJSON << std::fixed << std::setprecision(4);
+	sJSON << "{\n";
+	sJSON << "  \"seed\": " << m_uSeed << ",\n";
+	sJSON << "  \"frames\": " << uFrames << ",\n";
+	sJSON << "  \"mismatches\": " << m_uMismatchCount << ",\n";
+	sJSON << "  \"frame_ms\": { \"total\": " << dTotal;
+	sJSON << ", \"avg\": " << (uFrames > 0 ? dTotal / uFrames : 0.0);
+	sJSON << ", \"min\": " << (uFrames > 0 ? lSorted.front() : 0.0f);
+	sJSON << ", \"median\": " << (uFrames > 0 ? lSorted[uFrames / 2] : 0.0f);
+	sJSON << ", \"p95\": " << (uFrames > 0 ? lSorted[std::min(uFrames - 1, uFrames * 95 / 100)] : 0.0f);
+	sJSON << ", \"max\": " << (uFrames > 0 ? lSorted.back() : 0.0f) << " },\n";
+	sJSON << "  \"per_frame_ms\": [";
+	for (uint i = 0; i < uFrames; ++i)
+		sJSON << (i > 0 ? ", " : "") << m_FrameTimeList[i];
+	sJSON << "]\n";
+	sJSON << "}\n";
+
+	std::ofstream file(m_sTimingFile);
+	file << sJSON.str();
+	std::cout << "Replayed " << uFrames << " frames, " << (uFrames > 0 ? dTotal / uFrames : 0.0) <<
+		" ms per frame, timing written to " << m_sTimingFile << std::endl;
+}
@@ -0,0 +1,243 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYINPUTRECORDER_H_
+#define __MYINPUTRECORDER_H_
+
+#include "Definitions.h"
+
+#define RECORDER_MAGIC 0x52495853 //"SXIR" at the start of every log
+#define RECORDER_VERSION 1 //version of the log layout, a log of another version is not replayed
+
+namespace Simplex
+{
+
+//What the recorder does with the input
+enum eRecorderMode
+{
+	RECORDER_OFF = 0, //the input goes straight to the application
+	RECORDER_CAPTURE = 1, //the input goes to the application and to the log
+	RECORDER_REPLAY = 2, //the input comes from the log, only closing and resizing the window are listened to
+};
+
+//Kind of a polled sample, stored as one byte
+enum eRecorderSample
+{
+	SAMPLE_KEY_UP = 0, //a key was asked for and it was up
+	SAMPLE_KEY_DOWN = 1, //a key was asked for and it was down
+	SAMPLE_MOUSE = 2, //the mouse was asked for, followed by its position relative to the window
+};
+
+//State polled during a frame, replayed in the order it was asked for
+struct MyInputSample
+{
+	unsigned char m_uKind = SAMPLE_KEY_UP; //eRecorderSample
+	int m_nX = 0; //x of the mouse relative to the origin it was asked with
+	int m_nY = 0; //y of the mouse relative to the origin it was asked with
+};
+
+//System Class
+class MyInputRecorder
+{
+	eRecorderMode m_eMode = RECORDER_OFF; //what is done with the input
+	uint m_uSeed = 0; //seed of std::rand for the scene, read from the log on replay
+	bool m_bFast = false; //draw without vertical sync or frame limit?
+	String m_sTimingFile = "replay.json"; //where the replay writes the time of each frame
+
+	std::ofstream m_Output; //log being captured
+	std::ifstream m_Input; //log being replayed
+
+	float m_fDelta = 0.0f; //seconds of the frame, measured on capture and read on replay
+	std::vector<sf::Event> m_EventList; //events of the frame
+	std::vector<MyInputSample> m_SampleList; //polled state of the frame
+	uint m_uNextSample = 0; //next sample handed out on replay
+	uint m_uMismatchCount = 0; //polls on replay that did not match the log, 0 if the run was identical
+
+	uint m_uFrameCount = 0; //frames captured or replayed
+	std::vector<float> m_FrameTimeList; //milliseconds of each replayed frame
+
+	static MyInputRecorder* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyInputRecorder* GetInstance();
+	/*
+	Usage: Releases the content of the singleton, a replay writes its timing first
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Starts writing a log, the seed goes first
+	ARGUMENTS: String a_sFileName -> file of the log
+	OUTPUT: could the file be created?
+	*/
+	bool StartCapture(String a_sFileName);
+	/*
+	USAGE: Starts reading a log and takes its seed
+	ARGUMENTS: String a_sFileName -> file of the log
+	OUTPUT: could the file be read?
+	*/
+	bool StartReplay(String a_sFileName);
+	/*
+	USAGE: Closes the log, a replay writes the time of each frame to the timing file
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Stop(void);
+	/*
+	USAGE: Starts a frame, a replay reads it from the log
+	ARGUMENTS: ---
+	OUTPUT: false once a replay runs out of frames
+	*/
+	bool BeginFrame(void);
+	/*
+	USAGE: Ends a frame, a capture writes it to the log and a replay keeps its time
+	ARGUMENTS: double a_dMilliseconds -> time the frame took
+	OUTPUT: ---
+	*/
+	void EndFrame(double a_dMilliseconds);
+	/*
+	USAGE: Adds an event to the frame being captured; closing and resizing the window are not input
+	and are left out
+	ARGUMENTS: sf::Event const& a_Event -> event from the window
+	OUTPUT: ---
+	*/
+	void RecordEvent(sf::Event const& a_Event);
+	/*
+	USAGE: Gets the number of events of the frame being replayed
+	ARGUMENTS: ---
+	OUTPUT: event count, 0 unless replaying
+	*/
+	uint GetEventCount(void);
+	/*
+	USAGE: Gets an event of the frame being replayed
+	ARGUMENTS: uint a_uIndex -> index of the event
+	OUTPUT: event
+	*/
+	sf::Event GetEvent(uint a_uIndex);
+	/*
+	USAGE: Asks if a key is down, the answer is logged on capture and read from the log on replay
+	ARGUMENTS: sf::Keyboard::Key a_eKey -> key
+	OUTPUT: is it pressed?
+	*/
+	bool IsKeyPressed(sf::Keyboard::Key a_eKey);
+	/*
+	USAGE: Gets the position of the mouse on the screen, it is logged relative to the origin so a
+	window placed somewhere else gets the same movement
+	ARGUMENTS: sf::Vector2i a_v2Origin -> corner of the window on the screen
+	OUTPUT: position of the mouse on the screen
+	*/
+	sf::Vector2i GetMousePosition(sf::Vector2i a_v2Origin);
+	/*
+	USAGE: Takes the measured time of the frame, a capture logs it and a replay swaps it for the logged one
+	ARGUMENTS: float a_fDelta -> seconds measured
+	OUTPUT: seconds the frame uses
+	*/
+	float FilterDeltaTime(float a_fDelta);
+	/*
+	USAGE: Gets what the recorder does with the input
+	ARGUMENTS: ---
+	OUTPUT: mode
+	*/
+	eRecorderMode GetMode(void);
+	/*
+	USAGE: Asks if the input comes from a log
+	ARGUMENTS: ---
+	OUTPUT: is it replaying?
+	*/
+	bool IsReplaying(void);
+	/*
+	USAGE: Gets the seed std::rand has to get before the scene is spawned
+	ARGUMENTS: ---
+	OUTPUT: seed
+	*/
+	uint GetSeed(void);
+	/*
+	USAGE: Sets whether the frames are drawn without vertical sync or frame limit, before the window is made
+	ARGUMENTS: bool a_bFast -> draw as fast as possible?
+	OUTPUT: ---
+	*/
+	void SetFast(bool a_bFast);
+	/*
+	USAGE: Asks if the frames are drawn as fast as possible
+	ARGUMENTS: ---
+	OUTPUT: is it fast?
+	*/
+	bool IsFast(void);
+	/*
+	USAGE: Sets where the replay writes the time of each frame
+	ARGUMENTS: String a_sFileName -> JSON file
+	OUTPUT: ---
+	*/
+	void SetTimingFile(String a_sFileName);
+	/*
+	USAGE: Gets the polls on replay that did not match the log
+	ARGUMENTS: ---
+	OUTPUT: mismatch count
+	*/
+	uint GetMismatchCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyInputRecorder(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyInputRecorder(MyInputRecorder const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyInputRecorder& operator=(MyInputRecorder const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyInputRecorder(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton, the seed changes every run until a log is replayed
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	Usage: hands out the next sample of the frame being replayed
+	Arguments: unsigned char a_uKind -> kind of sample the application asks for
+	Output: sample, an empty one of that kind if the log has no such sample left
+	*/
+	MyInputSample NextSample(unsigned char a_uKind);
+	/*
+	Usage: writes the time of each replayed frame as JSON
+	Arguments: ---
+	Output: ---
+	*/
+	void WriteTiming(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYINPUTRECORDER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,115 @@
+#include "MyMappedFile.h"
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using namespace Simplex;
+//  MyMappedFile
+MyMappedFile::MyMappedFile(void) { }
+MyMappedFile::MyMappedFile(MyMappedFile const& other) { }
+MyMappedFile& MyMappedFile::operator=(MyMappedFile const& other) { return *this; }
+MyMappedFile::~MyMappedFile(void) { Close(); }
+//Accessors
+char const* MyMappedFile::GetData(void) { return m_pData; }
+size_t MyMappedFile::GetSize(void) { return m_uSize; }
+//Methods
+#if defined(_WIN32)
+bool MyMappedFile::Open(String a_sFileName)
+{
+	Close();
+	m_hFile = CreateFileA(a_sFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	//a view of an empty file cannot be made
+	if (!GetFileSizeEx(m_hFile, &size) || size.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+
+	m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_hMapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	m_pData = static_cast<char const*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_pData == nullptr)
+	{
+		Close();
+		return false;
+	}
+	m_uSize = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+void MyMappedFile::Close(void)
+{
+	if (m_pData != nullptr)
+		UnmapViewOfFile(m_pData);
+	if (m_hMapping != nullptr)
+		CloseHandle(m_hMapping);
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(m_hFile);
+	m_pData = nullptr;
+	m_uSize = 0;
+	m_hMapping = nullptr;
+	m_hFile = INVALID_HANDLE_VALUE;
+}
+bool MyMappedFile::GetStamp(String a_sFileName, unsigned long long& a_uSize, unsigned long long& a_uTime)
+{
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExA(a_sFileName.c_str(), GetFileExInfoStandard, &data))
+		return false;
+	a_uSize = (static_cast<unsigned long long>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+	a_uTime = (static_cast<unsigned long long>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+#else
+bool MyMappedFile::Open(String a_sFileName)
+{
+	Close();
+	int nFile = open(a_sFileName.c_str(), O_RDONLY);
+	if (nFile < 0)
+		return false;
+
+	struct stat info;
+	//a view of an empty file cannot be made
+	if (fstat(nFile, &info) != 0 || info.st_size == 0)
+	{
+		close(nFile);
+		return false;
+	}
+
+	void* pData = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, nFile, 0);
+	//the mapping keeps the file alive on its own
+	close(nFile);
+	if (pData == MAP_FAILED)
+		return false;
+
+	m_pData = static_cast<char const*>(pData);
+	m_uSize = static_cast<size_t>(info.st_size);
+	return true;
+}
+void MyMappedFile::Close(void)
+{
+	if (m_pData != nullptr)
+		munmap(const_cast<char*>(m_pData), m_uSize);
+	m_pData = nullptr;
+	m_uSize = 0;
+}
+bool MyMappedFile::GetStamp(String a_sFileName, unsigned long long& a_uSize, unsigned long long& a_uTime)
+{
+	struct stat info;
+	if (stat(a_sFileName.c_str(), &info) != 0)
+		return false;
+	a_uSize = static_cast<unsigned long long>(info.st_size);
+	a_uTime = static_cast<unsigned long long>(info.st_mtime);
+	return true;
+}
+#endif
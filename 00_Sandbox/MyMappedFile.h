@@ -0,0 +1,93 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYMAPPEDFILE_H_
+#define __MYMAPPEDFILE_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+//System Class
+class MyMappedFile
+{
+	char const* m_pData = nullptr; //first byte of the file, nullptr if nothing is mapped
+	size_t m_uSize = 0; //size of the file in bytes
+#if defined(_WIN32)
+	HANDLE m_hFile = INVALID_HANDLE_VALUE; //file being mapped
+	HANDLE m_hMapping = nullptr; //mapping object of the file
+#endif
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyMappedFile(void);
+	/*
+	Usage: Destructor, unmaps the file
+	Arguments: ---
+	Output: ---
+	*/
+	~MyMappedFile(void);
+	/*
+	USAGE: Maps the whole file in memory as read only, the pages are read by the system when they are touched
+	ARGUMENTS: String a_sFileName -> path of the file
+	OUTPUT: was the file mapped? empty files are not
+	*/
+	bool Open(String a_sFileName);
+	/*
+	USAGE: Unmaps the file, the data pointer is no longer valid
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Close(void);
+	/*
+	USAGE: Gets the first byte of the file
+	ARGUMENTS: ---
+	OUTPUT: data, nullptr if nothing is mapped
+	*/
+	char const* GetData(void);
+	/*
+	USAGE: Gets the size of the mapped file
+	ARGUMENTS: ---
+	OUTPUT: size in bytes
+	*/
+	size_t GetSize(void);
+	/*
+	USAGE: Gets the size and last write time of a file without opening it
+	ARGUMENTS:
+	-	String a_sFileName -> path of the file
+	-	unsigned long long& a_uSize -> size in bytes
+	-	unsigned long long& a_uTime -> last write time, only comparable with other calls
+	OUTPUT: does the file exist?
+	*/
+	static bool GetStamp(String a_sFileName, unsigned long long& a_uSize, unsigned long long& a_uTime);
+
+private:
+	/*
+	Usage: Copy Constructor, a mapping cannot be shared
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyMappedFile(MyMappedFile const& other);
+	/*
+	Usage: Copy Assignment Operator, a mapping cannot be shared
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyMappedFile& operator=(MyMappedFile const& other);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYMAPPEDFILE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
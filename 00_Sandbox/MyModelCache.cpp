@@ -0,0 +1,356 @@
+#include "MyModelCache.h"
+#include "MyAssetStreamer.h"
+using namespace Simplex;
+//  MyModelCache
+MyModelCache* MyModelCache::m_pInstance = nullptr;
+void MyModelCache::Init(void)
+{
+	m_AssetMap.clear();
+}
+void MyModelCache::Release(void)
+{
+	//it is not the job of the cache to release the models,
+	//it is for the mesh manager to do so.
+	for (auto asset = m_AssetMap.begin(); asset != m_AssetMap.end(); ++asset)
+		ReleaseTracks(asset->second);
+	m_AssetMap.clear();
+}
+MyModelCache* MyModelCache::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyModelCache();
+	}
+	return m_pInstance;
+}
+void MyModelCache::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyModelCache::MyModelCache() { Init(); }
+MyModelCache::MyModelCache(MyModelCache const& a_pOther) { }
+MyModelCache& MyModelCache::operator=(MyModelCache const& a_pOther) { return *this; }
+MyModelCache::~MyModelCache() { Release(); };
+//Accessors
+uint MyModelCache::GetAssetCount(void) { return static_cast<uint>(m_AssetMap.size()); }
+Model* MyModelCache::GetModel(String a_sKey)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	return asset == m_AssetMap.end() ? nullptr : asset->second.m_pModel;
+}
+std::vector<vector3> MyModelCache::GetBounds(String a_sKey)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	return asset == m_AssetMap.end() ? std::vector<vector3>() : asset->second.m_lBounds;
+}
+bool MyModelCache::IsStreaming(String a_sKey)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	return asset != m_AssetMap.end() && asset->second.m_bStreaming;
+}
+uint MyModelCache::GetReferenceCount(String a_sKey)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	return asset == m_AssetMap.end() ? 0 : asset->second.m_uReferences;
+}
+float MyModelCache::GetAnimationLength(String a_sKey)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	if (asset == m_AssetMap.end())
+		return 0.0f;
+	float fLength = 0.0f;
+	for (uint i = 0; i < asset->second.m_lTrackList.size(); ++i)
+		fLength = std::max(fLength, asset->second.m_lTrackList[i]->GetLength());
+	return fLength;
+}
+size_t MyModelCache::GetAnimationMemory(void)
+{
+	size_t uBytes = 0;
+	for (auto asset = m_AssetMap.begin(); asset != m_AssetMap.end(); ++asset)
+	{
+		for (uint i = 0; i < asset->second.m_lTrackList.size(); ++i)
+			uBytes += asset->second.m_lTrackList[i]->GetMemoryUsage();
+	}
+	return uBytes;
+}
+//--- Methods
+String MyModelCache::ResolvePath(String a_sFileName)
+{
+	//windows paths do not care about case or the direction of the slashes
+	String sKey = a_sFileName;
+	for (uint i = 0; i < sKey.size(); ++i)
+	{
+		if (sKey[i] == '/')
+			sKey[i] = '\\';
+		else
+			sKey[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(sKey[i])));
+	}
+	//a leading current folder is the same file
+	while (sKey.compare(0, 2, ".\\") == 0)
+		sKey = sKey.substr(2);
+	return sKey;
+}
+String MyModelCache::Acquire(String a_sFileName, bool a_bStream)
+{
+	String sKey = ResolvePath(a_sFileName);
+	auto asset = m_AssetMap.find(sKey);
+	if (asset != m_AssetMap.end())
+	{
+		++asset->second.m_uReferences;
+		return sKey;
+	}
+
+	MyModelAsset newAsset;
+	newAsset.m_uReferences = 1;
+	if (a_bStream)
+	{
+		//the rigid bodies need something to start with, they are fitted to the model when it arrives
+		newAsset.m_bStreaming = true;
+		newAsset.m_lBounds.push_back(vector3(-0.5f));
+		newAsset.m_lBounds.push_back(vector3(0.5f));
+		m_AssetMap[sKey] = newAsset;
+		MyAssetStreamer::GetInstance()->RequestModel(a_sFileName);
+		return sKey;
+	}
+
+	//if the model could not be loaded there is nothing to share
+	if (!LoadAsset(a_sFileName, newAsset))
+		return "";
+	m_AssetMap[sKey] = newAsset;
+	return sKey;
+}
+void MyModelCache::FinishStreaming(String a_sFileName)
+{
+	String sKey = ResolvePath(a_sFileName);
+	auto asset = m_AssetMap.find(sKey);
+	if (asset == m_AssetMap.end())
+	{
+		//nothing holds it so it stays in the cache until the next purge
+		MyModelAsset newAsset;
+		if (LoadAsset(a_sFileName, newAsset))
+			m_AssetMap[sKey] = newAsset;
+		return;
+	}
+	if (!asset->second.m_bStreaming)
+		return;
+
+	//a model that fails keeps the placeholder bounds and draws nothing
+	asset->second.m_bStreaming = false;
+	MyModelAsset loaded;
+	if (!LoadAsset(a_sFileName, loaded))
+		return;
+	asset->second.m_pModel = loaded.m_pModel;
+	asset->second.m_lBounds = loaded.m_lBounds;
+}
+bool MyModelCache::LoadAsset(String a_sFileName, MyModelAsset& a_Asset)
+{
+	//OBJ files come from their cooked file, with the bounds already computed
+	a_Asset.m_lBounds.clear();
+	Model* pModel = MyModelCooker::GetInstance()->Load(a_sFileName, a_Asset.m_lBounds);
+	if (pModel == nullptr)
+	{
+		pModel = new Model();
+		pModel->Load(a_sFileName);
+		if (pModel->GetName() == "")
+		{
+			SafeDelete(pModel);
+			return false;
+		}
+
+		//the bounding corners are all the rigid bodies need, the vertices are only read once
+		std::vector<vector3> lVertexList = pModel->GetVertexList();
+		if (lVertexList.size() > 0)
+		{
+			vector3 v3Min = lVertexList[0];
+			vector3 v3Max = lVertexList[0];
+			for (uint i = 1; i < lVertexList.size(); ++i)
+			{
+				v3Min = glm::min(v3Min, lVertexList[i]);
+				v3Max = glm::max(v3Max, lVertexList[i]);
+			}
+			a_Asset.m_lBounds.push_back(v3Min);
+			a_Asset.m_lBounds.push_back(v3Max);
+		}
+	}
+	a_Asset.m_pModel = pModel;
+	return true;
+}
+void MyModelCache::Release(String a_sKey)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	if (asset != m_AssetMap.end() && asset->second.m_uReferences > 0)
+		--asset->second.m_uReferences;
+}
+void MyModelCache::Purge(void)
+{
+	for (auto asset = m_AssetMap.begin(); asset != m_AssetMap.end();)
+	{
+		if (asset->second.m_uReferences == 0)
+		{
+			ReleaseTracks(asset->second);
+			asset = m_AssetMap.erase(asset);
+		}
+		else
+			++asset;
+	}
+}
+bool MyModelCache::CompressAnimation(String a_sKey, String a_sGroup)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	if (asset == m_AssetMap.end() || asset->second.m_pModel == nullptr)
+		return false;
+	Group* pGroup = asset->second.m_pModel->GetGroup(a_sGroup);
+	if (pGroup == nullptr)
+		return false;
+	//a compressed group is down to one frame already
+	MyModelAsset& modelAsset = asset->second;
+	for (uint i = 0; i < modelAsset.m_lAnimatedList.size(); ++i)
+	{
+		if (modelAsset.m_lAnimatedList[i] == pGroup)
+			return true;
+	}
+	if (pGroup->GetFrameCount() < 2)
+	{
+		//a static group under an animated one has to follow it
+		for (uint i = 0; i < modelAsset.m_lStaticList.size(); ++i)
+		{
+			if (modelAsset.m_lStaticList[i] == pGroup)
+				return false;
+		}
+		modelAsset.m_lStaticList.push_back(pGroup);
+		BuildHierarchy(modelAsset);
+		return false;
+	}
+
+	MyAnimationTrack* pTrack = new MyAnimationTrack();
+	pTrack->Compress(pGroup);
+
+	//the dense frames go away, the track writes the only one left
+	pGroup->GenerateFrames(1);
+	pTrack->Apply(pGroup, 0.0f);
+
+	modelAsset.m_lAnimatedList.push_back(pGroup);
+	modelAsset.m_lTrackList.push_back(pTrack);
+	BuildHierarchy(modelAsset);
+	return true;
+}
+void MyModelCache::Animate(String a_sKey, float a_fFrame)
+{
+	auto asset = m_AssetMap.find(a_sKey);
+	if (asset == m_AssetMap.end())
+		return;
+	MyModelAsset& modelAsset = asset->second;
+	if (modelAsset.m_lTrackList.size() == 0 || modelAsset.m_fAnimationFrame == a_fFrame)
+		return;
+	modelAsset.m_fAnimationFrame = a_fFrame;
+
+	for (uint i = 0; i < modelAsset.m_lNodeList.size(); ++i)
+	{
+		int nTrack = modelAsset.m_lNodeTrack[i];
+		if (nTrack < 0)
+			continue;
+		MyAnimationTrack* pTrack = modelAsset.m_lTrackList[nTrack];
+		modelAsset.m_Hierarchy.SetLocal(i, pTrack->GetTransform(a_fFrame));
+		//the visibility lives in the frame, it is only written when it flips
+		char bVisible = pTrack->IsVisible(a_fFrame) ? 1 : 0;
+		if (bVisible != modelAsset.m_lNodeVisible[i])
+		{
+			modelAsset.m_lNodeVisible[i] = bVisible;
+			pTrack->Apply(modelAsset.m_lNodeList[i], a_fFrame);
+		}
+	}
+
+	//only the subtrees under a node that moved are computed and written
+	m_lUpdatedList.clear();
+	modelAsset.m_Hierarchy.Update(m_lUpdatedList);
+	for (uint i = 0; i < m_lUpdatedList.size(); ++i)
+	{
+		uint uNode = m_lUpdatedList[i];
+		modelAsset.m_lNodeList[uNode]->SetModelMatrix(modelAsset.m_Hierarchy.GetWorld(uNode), 0);
+	}
+}
+void MyModelCache::ReleaseTracks(MyModelAsset& a_Asset)
+{
+	for (uint i = 0; i < a_Asset.m_lTrackList.size(); ++i)
+		SafeDelete(a_Asset.m_lTrackList[i]);
+	a_Asset.m_lTrackList.clear();
+	a_Asset.m_lAnimatedList.clear();
+	a_Asset.m_lStaticList.clear();
+	BuildHierarchy(a_Asset);
+}
+void MyModelCache::BuildHierarchy(MyModelAsset& a_Asset)
+{
+	a_Asset.m_Hierarchy.Clear();
+	a_Asset.m_lNodeList.clear();
+	a_Asset.m_lNodeTrack.clear();
+	a_Asset.m_lNodeVisible.clear();
+	a_Asset.m_fAnimationFrame = -1.0f;
+
+	//every animated group brings its ancestors, they carry it even if they do not move
+	std::map<Group*, int> groupTrackMap;
+	for (uint i = 0; i < a_Asset.m_lAnimatedList.size(); ++i)
+	{
+		groupTrackMap[a_Asset.m_lAnimatedList[i]] = static_cast<int>(i);
+		for (Group* pParent = a_Asset.m_lAnimatedList[i]->GetParent(); pParent != nullptr; pParent = pParent->GetParent())
+		{
+			if (groupTrackMap.find(pParent) == groupTrackMap.end())
+				groupTrackMap[pParent] = -1;
+		}
+	}
+	//a static group under an animated one comes along with every group between them, or it would
+	//stay where the animated group was at frame 0
+	for (uint i = 0; i < a_Asset.m_lStaticList.size(); ++i)
+	{
+		Group* pGroup = a_Asset.m_lStaticList[i];
+		bool bAnimatedAncestor = false;
+		for (Group* pParent = pGroup->GetParent(); pParent != nullptr && !bAnimatedAncestor; pParent = pParent->GetParent())
+		{
+			auto parent = groupTrackMap.find(pParent);
+			bAnimatedAncestor = parent != groupTrackMap.end() && parent->second >= 0;
+		}
+		if (!bAnimatedAncestor)
+			continue;
+		for (Group* pNode = pGroup; pNode != nullptr; pNode = pNode->GetParent())
+		{
+			if (groupTrackMap.find(pNode) == groupTrackMap.end())
+				groupTrackMap[pNode] = -1;
+		}
+	}
+
+	//sorting by depth puts every parent before its children
+	std::vector<std::pair<uint, Group*>> lDepthList;
+	for (auto group = groupTrackMap.begin(); group != groupTrackMap.end(); ++group)
+	{
+		uint uDepth = 0;
+		for (Group* pParent = group->first->GetParent(); pParent != nullptr; pParent = pParent->GetParent())
+			++uDepth;
+		lDepthList.push_back(std::pair<uint, Group*>(uDepth, group->first));
+	}
+	std::sort(lDepthList.begin(), lDepthList.end());
+
+	std::map<Group*, uint> groupNodeMap;
+	for (uint i = 0; i < lDepthList.size(); ++i)
+	{
+		Group* pGroup = lDepthList[i].second;
+		int nTrack = groupTrackMap[pGroup];
+		auto parent = groupNodeMap.find(pGroup->GetParent());
+		int nParent = parent == groupNodeMap.end() ? -1 : static_cast<int>(parent->second);
+
+		matrix4 m4Local = IDENTITY_M4;
+		if (nTrack < 0)
+		{
+			Frame frame = pGroup->GetFrame(0);
+			m4Local = MyAnimationTrack::ComposeTransform(frame.GetPos(), quaternion(glm::radians(frame.GetAng())),
+				frame.GetSize(), pGroup->GetPivot());
+		}
+		groupNodeMap[pGroup] = a_Asset.m_Hierarchy.AddNode(nParent, m4Local);
+		a_Asset.m_lNodeList.push_back(pGroup);
+		a_Asset.m_lNodeTrack.push_back(nTrack);
+		a_Asset.m_lNodeVisible.push_back(nTrack < 0 || a_Asset.m_lTrackList[nTrack]->IsVisible(0.0f) ? 1 : 0);
+	}
+}
@@ -0,0 +1,221 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYMODELCACHE_H_
+#define __MYMODELCACHE_H_
+
+#include "MyModelCooker.h"
+#include "MyAnimationTrack.h"
+#include "MyHierarchy.h"
+#include <unordered_map>
+
+namespace Simplex
+{
+
+//Model loaded once and shared by every entity that uses the same file
+struct MyModelAsset
+{
+	Model* m_pModel = nullptr; //shared model, owns the mesh buffers
+	uint m_uReferences = 0; //entities using the model
+	bool m_bStreaming = false; //is the model being cooked? until then there is no model and the bounds are a placeholder
+	std::vector<vector3> m_lBounds; //minimum and maximum local corners, enough to build a rigid body
+	std::vector<Group*> m_lAnimatedList; //groups whose frames were compressed
+	std::vector<MyAnimationTrack*> m_lTrackList; //compressed frames of each animated group, owned by the cache
+	std::vector<Group*> m_lStaticList; //groups passed to CompressAnimation with a single frame, they follow an animated ancestor
+	MyHierarchy m_Hierarchy; //animated groups, their ancestors and the known groups under them, flattened parents first
+	std::vector<Group*> m_lNodeList; //group of each node of the hierarchy
+	std::vector<int> m_lNodeTrack; //track of each node, -1 for a group that is not animated
+	std::vector<char> m_lNodeVisible; //visibility last written to the group of each node
+	float m_fAnimationFrame = -1.0f; //time the hierarchy was last sampled at, negative if never
+};
+
+//System Class
+class MyModelCache
+{
+	std::unordered_map<String, MyModelAsset> m_AssetMap; //loaded models by resolved path
+	std::vector<uint> m_lUpdatedList; //nodes computed by the last Animate, kept to reuse its memory
+
+	static MyModelCache* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyModelCache* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a reference to the model of the file, loading it only if it is not in the cache
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model to load
+	-	bool a_bStream = false -> hand a model that is not in the cache to the asset streamer instead of
+		loading it now; the asset has no model and a unit box as bounds until it arrives
+	OUTPUT: key of the asset in the cache, empty if the model could not be loaded
+	*/
+	String Acquire(String a_sFileName, bool a_bStream = false);
+	/*
+	USAGE: Loads a model the asset streamer cooked into its asset, from the GL thread; a model nobody
+	asked for is loaded without references, ready for the next Acquire
+	ARGUMENTS: String a_sFileName -> Name of the model
+	OUTPUT: ---
+	*/
+	void FinishStreaming(String a_sFileName);
+	/*
+	USAGE: Asks if the model of the asset is still being streamed
+	ARGUMENTS: String a_sKey -> key returned by Acquire
+	OUTPUT: is it streaming?
+	*/
+	bool IsStreaming(String a_sKey);
+	/*
+	USAGE: Removes a reference to the asset, assets without references stay loaded until Purge, the
+	entity manager purges every time it removes an entity with a model
+	ARGUMENTS: String a_sKey -> key returned by Acquire
+	OUTPUT: ---
+	*/
+	void Release(String a_sKey);
+	/*
+	USAGE: Forgets every asset that has no references
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Purge(void);
+	/*
+	USAGE: Gets the shared model of the asset, the model matrix of a shared model has to be set
+	right before adding it to the render list
+	ARGUMENTS: String a_sKey -> key returned by Acquire
+	OUTPUT: model, nullptr if not in the cache
+	*/
+	Model* GetModel(String a_sKey);
+	/*
+	USAGE: Gets the local bounding corners of the asset, computed once when it was loaded
+	ARGUMENTS: String a_sKey -> key returned by Acquire
+	OUTPUT: minimum and maximum corners, empty if not in the cache
+	*/
+	std::vector<vector3> GetBounds(String a_sKey);
+	/*
+	USAGE: Gets the number of entities using the asset
+	ARGUMENTS: String a_sKey -> key returned by Acquire
+	OUTPUT: reference count
+	*/
+	uint GetReferenceCount(String a_sKey);
+	/*
+	USAGE: Compresses the frames of a group of the asset into a track and frees them, leaving the group
+	with a single frame that Animate writes. After this the model only renders frame 0, which is what
+	entities draw. The model does not list its groups, so a group with a single frame passed here is
+	remembered instead: Animate moves it along with the animated group it hangs from
+	ARGUMENTS:
+	-	String a_sKey -> key returned by Acquire
+	-	String a_sGroup -> name of the group
+	OUTPUT: was the group animated? groups with a single frame keep their frame
+	*/
+	bool CompressAnimation(String a_sKey, String a_sGroup);
+	/*
+	USAGE: Samples every compressed group of the asset and writes the model matrices of the groups whose
+	world transform changed, in one pass over the flattened hierarchy. The model is shared so this has
+	to happen right before it is added to the render list; entities at the time the asset was last
+	sampled at cost nothing
+	ARGUMENTS:
+	-	String a_sKey -> key returned by Acquire
+	-	float a_fFrame -> time in frames, fractions included
+	OUTPUT: ---
+	*/
+	void Animate(String a_sKey, float a_fFrame);
+	/*
+	USAGE: Gets the length of the longest compressed track of the asset
+	ARGUMENTS: String a_sKey -> key returned by Acquire
+	OUTPUT: length in frames, 0 if nothing is animated
+	*/
+	float GetAnimationLength(String a_sKey);
+	/*
+	USAGE: Gets the bytes used by the compressed tracks of every asset
+	ARGUMENTS: ---
+	OUTPUT: memory usage
+	*/
+	size_t GetAnimationMemory(void);
+	/*
+	USAGE: Gets the number of assets in the cache
+	ARGUMENTS: ---
+	OUTPUT: asset count
+	*/
+	uint GetAssetCount(void);
+	/*
+	USAGE: Gets the key of a file, the same file written with other slashes or case gets the same key
+	ARGUMENTS: String a_sFileName -> Name of the model
+	OUTPUT: key of the file
+	*/
+	static String ResolvePath(String a_sFileName);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyModelCache(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyModelCache(MyModelCache const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyModelCache& operator=(MyModelCache const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyModelCache(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Deletes the compressed tracks of an asset
+	ARGUMENTS: MyModelAsset& a_Asset -> asset to clear
+	OUTPUT: ---
+	*/
+	void ReleaseTracks(MyModelAsset& a_Asset);
+	/*
+	USAGE: Loads the model of the file into an asset, from its cooked file if it has one
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model to load
+	-	MyModelAsset& a_Asset -> asset that gets the model and its bounds
+	OUTPUT: was the model loaded?
+	*/
+	bool LoadAsset(String a_sFileName, MyModelAsset& a_Asset);
+	/*
+	USAGE: Flattens the animated groups of an asset and their ancestors into its hierarchy, every
+	group after its parent
+	ARGUMENTS: MyModelAsset& a_Asset -> asset to flatten
+	OUTPUT: ---
+	*/
+	void BuildHierarchy(MyModelAsset& a_Asset);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYMODELCACHE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
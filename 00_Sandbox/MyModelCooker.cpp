@@ -0,0 +1,361 @@
+#include "MyModelCooker.h"
+#include "MyObjParser.h"
+#include "MyAssetStreamer.h"
+using namespace Simplex;
+//  MyModelCooker
+MyModelCooker* MyModelCooker::m_pInstance = nullptr;
+void MyModelCooker::Init(void)
+{
+	m_uCookCount = 0;
+	m_uReuseCount = 0;
+}
+void MyModelCooker::Release(void)
+{
+	m_uCookCount = 0;
+	m_uReuseCount = 0;
+}
+MyModelCooker* MyModelCooker::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyModelCooker();
+	}
+	return m_pInstance;
+}
+void MyModelCooker::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyModelCooker::MyModelCooker() { Init(); }
+MyModelCooker::MyModelCooker(MyModelCooker const& a_pOther) { }
+MyModelCooker& MyModelCooker::operator=(MyModelCooker const& a_pOther) { return *this; }
+MyModelCooker::~MyModelCooker() { Release(); };
+//Accessors
+uint MyModelCooker::GetCookCount(void) { return m_uCookCount; }
+uint MyModelCooker::GetReuseCount(void) { return m_uReuseCount; }
+//--- Methods
+Model* MyModelCooker::Load(String a_sFileName, std::vector<vector3>& a_lBounds)
+{
+	String sSource;
+	String sCooked;
+	if (!GetPaths(a_sFileName, sSource, sCooked))
+		return nullptr;
+
+	unsigned long long uSize = 0;
+	unsigned long long uTime = 0;
+	if (!MyMappedFile::GetStamp(sSource, uSize, uTime))
+		return nullptr;
+
+	MyMappedFile file;
+	if (file.Open(sCooked) && IsValid(file, uSize, uTime))
+	{
+		++m_uReuseCount;
+		return BuildModel(file, a_sFileName, a_lBounds);
+	}
+
+	//missing or stale, cook it and use what was just written
+	file.Close();
+	if (!Cook(sSource, sCooked))
+		return nullptr;
+	if (!file.Open(sCooked) || !IsValid(file, uSize, uTime))
+		return nullptr;
+	return BuildModel(file, a_sFileName, a_lBounds);
+}
+bool MyModelCooker::Prepare(String a_sFileName)
+{
+	String sSource;
+	String sCooked;
+	if (!GetPaths(a_sFileName, sSource, sCooked))
+		return false;
+
+	unsigned long long uSize = 0;
+	unsigned long long uTime = 0;
+	if (!MyMappedFile::GetStamp(sSource, uSize, uTime))
+		return false;
+
+	MyMappedFile file;
+	if (file.Open(sCooked) && IsValid(file, uSize, uTime))
+		return true;
+	file.Close();
+	return Cook(sSource, sCooked);
+}
+bool MyModelCooker::GetPaths(String a_sFileName, String& a_sSource, String& a_sCooked)
+{
+	//only OBJ files are cooked, the library has its own binary format for the rest
+	size_t uDot = a_sFileName.find_last_of('.');
+	if (uDot == String::npos)
+		return false;
+	String sExtension = a_sFileName.substr(uDot);
+	std::transform(sExtension.begin(), sExtension.end(), sExtension.begin(), ::tolower);
+	if (sExtension != ".obj")
+		return false;
+
+	String sFolder = Folder::GetInstance()->GetFolderMOBJ();
+	if (sFolder.size() > 0 && sFolder.back() != '\\' && sFolder.back() != '/')
+		sFolder += '\\';
+	a_sSource = sFolder + a_sFileName;
+	a_sCooked = sFolder + a_sFileName.substr(0, uDot) + COOKED_EXTENSION;
+	return true;
+}
+bool MyModelCooker::IsValid(MyMappedFile& a_File, unsigned long long a_uSize, unsigned long long a_uTime)
+{
+	size_t uFileSize = a_File.GetSize();
+	if (uFileSize < sizeof(MyCookedHeader))
+		return false;
+
+	MyCookedHeader const* pHeader = reinterpret_cast<MyCookedHeader const*>(a_File.GetData());
+	if (pHeader->m_uMagic != COOKED_MAGIC || pHeader->m_uVersion != COOKED_VERSION)
+		return false;
+	if (pHeader->m_uSourceSize != a_uSize || pHeader->m_uSourceTime != a_uTime)
+		return false;
+
+	//every section has to be inside the file
+	size_t uStream = static_cast<size_t>(pHeader->m_uVertexCount) * sizeof(vector3);
+	if (pHeader->m_uMeshOffset + static_cast<size_t>(pHeader->m_uMeshCount) * sizeof(MyCookedMesh) > uFileSize ||
+		pHeader->m_uPositionOffset + uStream > uFileSize ||
+		pHeader->m_uNormalOffset + uStream > uFileSize ||
+		pHeader->m_uUVOffset + uStream > uFileSize ||
+		pHeader->m_uColorOffset + uStream > uFileSize ||
+		pHeader->m_uStringOffset + static_cast<size_t>(pHeader->m_uStringSize) > uFileSize ||
+		pHeader->m_uStringSize == 0)
+		return false;
+
+	//and so does every mesh and string it points to
+	char const* pStrings = a_File.GetData() + pHeader->m_uStringOffset;
+	if (pStrings[pHeader->m_uStringSize - 1] != '\0')
+		return false;
+	MyCookedMesh const* pMesh = reinterpret_cast<MyCookedMesh const*>(a_File.GetData() + pHeader->m_uMeshOffset);
+	for (uint i = 0; i < pHeader->m_uMeshCount; ++i)
+	{
+		if (static_cast<size_t>(pMesh[i].m_uFirstVertex) + pMesh[i].m_uVertexCount > pHeader->m_uVertexCount)
+			return false;
+		if (pMesh[i].m_uGroup >= pHeader->m_uStringSize || pMesh[i].m_uMaterial >= pHeader->m_uStringSize ||
+			pMesh[i].m_uDiffuse >= pHeader->m_uStringSize || pMesh[i].m_uNormal >= pHeader->m_uStringSize ||
+			pMesh[i].m_uSpecular >= pHeader->m_uStringSize)
+			return false;
+	}
+	return true;
+}
+Model* MyModelCooker::BuildModel(MyMappedFile& a_File, String a_sName, std::vector<vector3>& a_lBounds)
+{
+	char const* pData = a_File.GetData();
+	MyCookedHeader const* pHeader = reinterpret_cast<MyCookedHeader const*>(pData);
+	MyCookedMesh const* pMesh = reinterpret_cast<MyCookedMesh const*>(pData + pHeader->m_uMeshOffset);
+	vector3 const* pPosition = reinterpret_cast<vector3 const*>(pData + pHeader->m_uPositionOffset);
+	vector3 const* pNormal = reinterpret_cast<vector3 const*>(pData + pHeader->m_uNormalOffset);
+	vector3 const* pUV = reinterpret_cast<vector3 const*>(pData + pHeader->m_uUVOffset);
+	vector3 const* pColor = reinterpret_cast<vector3 const*>(pData + pHeader->m_uColorOffset);
+	char const* pStrings = pData + pHeader->m_uStringOffset;
+
+	a_lBounds.clear();
+	a_lBounds.push_back(vector3(pHeader->m_fMin[0], pHeader->m_fMin[1], pHeader->m_fMin[2]));
+	a_lBounds.push_back(vector3(pHeader->m_fMax[0], pHeader->m_fMax[1], pHeader->m_fMax[2]));
+
+	Model* pModel = new Model();
+	pModel->SetName(a_sName);
+	MeshManager* pMeshMngr = MeshManager::GetInstance();
+	std::map<String, Group*> groupMap;
+	for (uint i = 0; i < pHeader->m_uMeshCount; ++i)
+	{
+		String sGroup = pStrings + pMesh[i].m_uGroup;
+		Group*& pGroup = groupMap[sGroup];
+		if (pGroup == nullptr)
+		{
+			pGroup = new Group();
+			pGroup->SetName(sGroup);
+		}
+
+		//the streams are copied straight out of the mapped pages, there is nothing to parse
+		uint uFirst = pMesh[i].m_uFirstVertex;
+		uint uEnd = uFirst + pMesh[i].m_uVertexCount;
+		Mesh* pNewMesh = new Mesh();
+		pNewMesh->SetVertexList(std::vector<vector3>(pPosition + uFirst, pPosition + uEnd));
+		pNewMesh->SetNormalList(std::vector<vector3>(pNormal + uFirst, pNormal + uEnd));
+		pNewMesh->SetUVList(std::vector<vector3>(pUV + uFirst, pUV + uEnd));
+		pNewMesh->SetColorList(std::vector<vector3>(pColor + uFirst, pColor + uEnd));
+		if (pStrings[pMesh[i].m_uMaterial] != '\0')
+		{
+			pNewMesh->SetMaterial(LoadMaterial(pStrings + pMesh[i].m_uMaterial, pStrings + pMesh[i].m_uDiffuse,
+				pStrings + pMesh[i].m_uNormal, pStrings + pMesh[i].m_uSpecular));
+		}
+		pNewMesh->CompileOpenGL3X();
+		//the mesh manager owns the meshes, like it does for the ones loaded by the model
+		pMeshMngr->AddMesh(pNewMesh);
+		pGroup->AddMesh(pNewMesh);
+	}
+	for (auto group = groupMap.begin(); group != groupMap.end(); ++group)
+	{
+		pModel->AddGroup(group->second);
+	}
+	return pModel;
+}
+int MyModelCooker::LoadMaterial(String a_sName, String a_sDiffuse, String a_sNormal, String a_sSpecular)
+{
+	MaterialManager* pMaterialMngr = MaterialManager::GetInstance();
+	int nMaterial = pMaterialMngr->IdentifyMaterial(a_sName);
+	if (nMaterial >= 0)
+		return nMaterial;
+
+	//the maps are streamed, the mesh draws with the placeholders until they arrive
+	MyAssetStreamer* pStreamer = MyAssetStreamer::GetInstance();
+	nMaterial = pMaterialMngr->AddMaterial(a_sName);
+	Material* pMaterial = pMaterialMngr->GetMaterial(nMaterial);
+	if (a_sDiffuse != "")
+	{
+		pMaterial->SetDiffuseMapName(a_sDiffuse);
+		pMaterial->SetDiffuseMapID(pStreamer->RequestTexture(a_sDiffuse, C_WHITE));
+	}
+	if (a_sNormal != "")
+	{
+		pMaterial->SetNormalMapName(a_sNormal);
+		pMaterial->SetNormalMapID(pStreamer->RequestTexture(a_sNormal, vector3(0.5f, 0.5f, 1.0f)));
+	}
+	if (a_sSpecular != "")
+	{
+		pMaterial->SetSpecularMapName(a_sSpecular);
+		pMaterial->SetSpecularMapID(pStreamer->RequestTexture(a_sSpecular, C_BLACK));
+	}
+	return nMaterial;
+}
+bool MyModelCooker::Cook(String a_sSource, String a_sCooked)
+{
+	MyCookedHeader header;
+	if (!MyMappedFile::GetStamp(a_sSource, header.m_uSourceSize, header.m_uSourceTime))
+		return false;
+
+	//a model requested from the streamer and loaded at the same time is cooked once at a time
+	std::lock_guard<std::mutex> lock(m_CookMutex);
+	MyCookedData data;
+	if (!ReadOBJ(a_sSource, data) || data.m_PositionList.size() == 0)
+		return false;
+
+	if (!Write(a_sCooked, header, data))
+		return false;
+	++m_uCookCount;
+	return true;
+}
+uint MyModelCooker::AddString(MyCookedData& a_Data, String a_sString)
+{
+	if (a_sString == "")
+		return 0;
+	uint uOffset = static_cast<uint>(a_Data.m_sStringTable.size());
+	a_Data.m_sStringTable += a_sString;
+	a_Data.m_sStringTable += '\0';
+	return uOffset;
+}
+void MyModelCooker::ReadMTL(String a_sFileName, MyCookedData& a_Data)
+{
+	std::ifstream file(a_sFileName);
+	if (!file.is_open())
+		return;
+
+	MyCookedMaterial* pMaterial = nullptr;
+	String sLine;
+	while (std::getline(file, sLine))
+	{
+		std::istringstream line(sLine);
+		String sKey;
+		line >> sKey;
+		if (sKey == "newmtl")
+		{
+			String sName;
+			line >> sName;
+			pMaterial = &a_Data.m_MaterialMap[sName];
+			pMaterial->m_uName = AddString(a_Data, sName);
+			continue;
+		}
+		if (pMaterial == nullptr)
+			continue;
+
+		if (sKey == "Kd")
+		{
+			line >> pMaterial->m_v3Color.x >> pMaterial->m_v3Color.y >> pMaterial->m_v3Color.z;
+			continue;
+		}
+		//the map is the first word that is not an option or the value of one
+		String sMap;
+		String sWord;
+		while (line >> sWord)
+		{
+			if (sWord[0] != '-' && sWord.find('.') != String::npos && !std::isdigit(static_cast<unsigned char>(sWord[0])))
+			{
+				sMap = sWord;
+				break;
+			}
+		}
+		if (sKey == "map_Kd")
+			pMaterial->m_uDiffuse = AddString(a_Data, sMap);
+		else if (sKey == "bump" || sKey == "map_Bump" || sKey == "map_bump")
+			pMaterial->m_uNormal = AddString(a_Data, sMap);
+		else if (sKey == "map_Ks")
+			pMaterial->m_uSpecular = AddString(a_Data, sMap);
+	}
+}
+bool MyModelCooker::ReadOBJ(String a_sSource, MyCookedData& a_Data)
+{
+	MyObjParser parser;
+	if (!parser.Read(a_sSource))
+		return false;
+
+	//the MTL files are next to the OBJ, their materials are needed before the faces are built
+	String sFolder = "";
+	size_t uSlash = a_sSource.find_last_of("\\/");
+	if (uSlash != String::npos)
+		sFolder = a_sSource.substr(0, uSlash + 1);
+	std::vector<String> lLibrary = parser.GetLibraryList();
+	for (uint i = 0; i < lLibrary.size(); ++i)
+	{
+		ReadMTL(sFolder + lLibrary[i], a_Data);
+	}
+
+	parser.Build(a_Data);
+	return true;
+}
+bool MyModelCooker::Write(String a_sCooked, MyCookedHeader a_Header, MyCookedData& a_Data)
+{
+	uint uVertexCount = static_cast<uint>(a_Data.m_PositionList.size());
+	uint uStream = uVertexCount * static_cast<uint>(sizeof(vector3));
+
+	//the bounds are computed once here and never again
+	vector3 v3Min = a_Data.m_PositionList[0];
+	vector3 v3Max = a_Data.m_PositionList[0];
+	for (uint i = 1; i < uVertexCount; ++i)
+	{
+		v3Min = glm::min(v3Min, a_Data.m_PositionList[i]);
+		v3Max = glm::max(v3Max, a_Data.m_PositionList[i]);
+	}
+	for (uint i = 0; i < 3; ++i)
+	{
+		a_Header.m_fMin[i] = v3Min[i];
+		a_Header.m_fMax[i] = v3Max[i];
+	}
+
+	//every section is a multiple of 4 bytes, the strings go last so they do not need padding
+	a_Header.m_uMeshCount = static_cast<uint>(a_Data.m_MeshList.size());
+	a_Header.m_uVertexCount = uVertexCount;
+	a_Header.m_uMeshOffset = static_cast<uint>(sizeof(MyCookedHeader));
+	a_Header.m_uPositionOffset = a_Header.m_uMeshOffset + a_Header.m_uMeshCount * static_cast<uint>(sizeof(MyCookedMesh));
+	a_Header.m_uNormalOffset = a_Header.m_uPositionOffset + uStream;
+	a_Header.m_uUVOffset = a_Header.m_uNormalOffset + uStream;
+	a_Header.m_uColorOffset = a_Header.m_uUVOffset + uStream;
+	a_Header.m_uStringOffset = a_Header.m_uColorOffset + uStream;
+	a_Header.m_uStringSize = static_cast<uint>(a_Data.m_sStringTable.size());
+
+	std::ofstream file(a_sCooked, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+	file.write(reinterpret_cast<char const*>(&a_Header), sizeof(MyCookedHeader));
+	if (a_Header.m_uMeshCount > 0)
+		file.write(reinterpret_cast<char const*>(a_Data.m_MeshList.data()), a_Header.m_uMeshCount * sizeof(MyCookedMesh));
+	file.write(reinterpret_cast<char const*>(a_Data.m_PositionList.data()), uStream);
+	file.write(reinterpret_cast<char const*>(a_Data.m_NormalList.data()), uStream);
+	file.write(reinterpret_cast<char const*>(a_Data.m_UVList.data()), uStream);
+	file.write(reinterpret_cast<char const*>(a_Data.m_ColorList.data()), uStream);
+	file.write(a_Data.m_sStringTable.data(), a_Data.m_sStringTable.size());
+	return file.good();
+}
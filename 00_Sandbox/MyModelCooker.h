@@ -0,0 +1,250 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYMODELCOOKER_H_
+#define __MYMODELCOOKER_H_
+
+#include "MyMappedFile.h"
+#include <atomic>
+#include <mutex>
+
+#define COOKED_MAGIC 0x4C444D43 //"CMDL" in the first 4 bytes of a cooked model
+#define COOKED_VERSION 1 //changes every time the layout changes, older files are cooked again
+#define COOKED_EXTENSION ".cmdl" //extension of the cooked file, written next to the source
+
+namespace Simplex
+{
+
+//Start of a cooked model. Every offset is in bytes from the start of the file and the sections are
+//4 byte aligned, so the streams can be used in place from a mapped file
+struct MyCookedHeader
+{
+	uint m_uMagic = COOKED_MAGIC; //COOKED_MAGIC
+	uint m_uVersion = COOKED_VERSION; //COOKED_VERSION
+	unsigned long long m_uSourceSize = 0; //size of the source when it was cooked
+	unsigned long long m_uSourceTime = 0; //last write time of the source when it was cooked
+	float m_fMin[3] = { 0.0f, 0.0f, 0.0f }; //minimum local corner of the model
+	float m_fMax[3] = { 0.0f, 0.0f, 0.0f }; //maximum local corner of the model
+	uint m_uMeshCount = 0; //number of entries in the mesh table
+	uint m_uVertexCount = 0; //number of vertices in each stream
+	uint m_uMeshOffset = 0; //mesh table
+	uint m_uPositionOffset = 0; //positions, 3 floats per vertex
+	uint m_uNormalOffset = 0; //normals, 3 floats per vertex
+	uint m_uUVOffset = 0; //texture coordinates, 3 floats per vertex
+	uint m_uColorOffset = 0; //colors, 3 floats per vertex
+	uint m_uStringOffset = 0; //string table, zero terminated strings, the first one is empty
+	uint m_uStringSize = 0; //size of the string table in bytes
+};
+
+//Entry of the mesh table, a range of triangles of the streams that use one material
+struct MyCookedMesh
+{
+	uint m_uFirstVertex = 0; //first vertex in the streams
+	uint m_uVertexCount = 0; //number of vertices, 3 per triangle
+	uint m_uGroup = 0; //name of the group, offset in the string table
+	uint m_uMaterial = 0; //name of the material, offset in the string table
+	uint m_uDiffuse = 0; //diffuse map, offset in the string table
+	uint m_uNormal = 0; //normal map, offset in the string table
+	uint m_uSpecular = 0; //specular map, offset in the string table
+};
+
+//Material read from a MTL file, the names are offsets in the string table being cooked
+struct MyCookedMaterial
+{
+	uint m_uName = 0; //name of the material
+	uint m_uDiffuse = 0; //diffuse map
+	uint m_uNormal = 0; //normal map
+	uint m_uSpecular = 0; //specular map
+	vector3 m_v3Color = C_WHITE; //diffuse color, baked in the color stream
+};
+
+//Model read from the source files, kept in memory until it is written
+struct MyCookedData
+{
+	std::vector<MyCookedMesh> m_MeshList; //mesh table
+	std::vector<vector3> m_PositionList; //position stream
+	std::vector<vector3> m_NormalList; //normal stream
+	std::vector<vector3> m_UVList; //texture coordinate stream
+	std::vector<vector3> m_ColorList; //color stream
+	String m_sStringTable = String(1, '\0'); //string table, starts with the empty string
+	std::map<String, MyCookedMaterial> m_MaterialMap; //materials of the MTL files by name
+};
+
+//System Class
+class MyModelCooker
+{
+	std::atomic<uint> m_uCookCount; //models cooked since the start
+	std::atomic<uint> m_uReuseCount; //models loaded from an up to date cooked file
+	std::mutex m_CookMutex; //one cook at a time, the streamer cooks on its workers
+
+	static MyModelCooker* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyModelCooker* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Loads an OBJ model from its cooked file, cooking it first if the file is missing or older
+	than the source. The meshes are handed to the mesh manager like Model::Load does
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model, as it would be given to Model::Load
+	-	std::vector<vector3>& a_lBounds -> filled with the minimum and maximum local corners
+	OUTPUT: loaded model, nullptr if it is not an OBJ or the source is not in the OBJ folder
+	*/
+	Model* Load(String a_sFileName, std::vector<vector3>& a_lBounds);
+	/*
+	USAGE: Cooks an OBJ model if the cooked file is missing or older than the source, without touching
+	OpenGL, so it can run on any thread
+	ARGUMENTS: String a_sFileName -> Name of the model, as it would be given to Model::Load
+	OUTPUT: is there an up to date cooked file?
+	*/
+	bool Prepare(String a_sFileName);
+	/*
+	USAGE: Converts an OBJ file and its materials to the cooked format
+	ARGUMENTS:
+	-	String a_sSource -> path of the OBJ file
+	-	String a_sCooked -> path of the cooked file to write
+	OUTPUT: was the file written?
+	*/
+	bool Cook(String a_sSource, String a_sCooked);
+	/*
+	USAGE: Gets the number of models cooked since the start
+	ARGUMENTS: ---
+	OUTPUT: cook count
+	*/
+	uint GetCookCount(void);
+	/*
+	USAGE: Gets the number of models that were loaded from an up to date cooked file
+	ARGUMENTS: ---
+	OUTPUT: reuse count
+	*/
+	uint GetReuseCount(void);
+	/*
+	USAGE: Adds a string to the string table being cooked
+	ARGUMENTS:
+	-	MyCookedData& a_Data -> model being cooked
+	-	String a_sString -> string to add
+	OUTPUT: offset of the string in the table, 0 for an empty string
+	*/
+	static uint AddString(MyCookedData& a_Data, String a_sString);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyModelCooker(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyModelCooker(MyModelCooker const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyModelCooker& operator=(MyModelCooker const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyModelCooker(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Gets the paths of the source and the cooked file of a model
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model
+	-	String& a_sSource -> path of the OBJ file
+	-	String& a_sCooked -> path of the cooked file
+	OUTPUT: is it an OBJ file?
+	*/
+	bool GetPaths(String a_sFileName, String& a_sSource, String& a_sCooked);
+	/*
+	USAGE: Checks that a mapped file is a cooked model of the current version, made from the stamped
+	source, and that every section is inside the file
+	ARGUMENTS:
+	-	MyMappedFile& a_File -> mapped cooked file
+	-	unsigned long long a_uSize -> size of the source
+	-	unsigned long long a_uTime -> last write time of the source
+	OUTPUT: can it be used?
+	*/
+	bool IsValid(MyMappedFile& a_File, unsigned long long a_uSize, unsigned long long a_uTime);
+	/*
+	USAGE: Generates the model out of a valid cooked file
+	ARGUMENTS:
+	-	MyMappedFile& a_File -> mapped cooked file
+	-	String a_sName -> name of the model
+	-	std::vector<vector3>& a_lBounds -> filled with the minimum and maximum local corners
+	OUTPUT: generated model
+	*/
+	Model* BuildModel(MyMappedFile& a_File, String a_sName, std::vector<vector3>& a_lBounds);
+	/*
+	USAGE: Gets the material of the material manager with that name, adding it with streamed maps if it
+	is not there
+	ARGUMENTS:
+	-	String a_sName -> name of the material
+	-	String a_sDiffuse -> diffuse map, empty for none
+	-	String a_sNormal -> normal map, empty for none
+	-	String a_sSpecular -> specular map, empty for none
+	OUTPUT: index of the material in the material manager
+	*/
+	int LoadMaterial(String a_sName, String a_sDiffuse, String a_sNormal, String a_sSpecular);
+	/*
+	USAGE: Reads the triangles of an OBJ file into the streams, one mesh per group and material
+	ARGUMENTS:
+	-	String a_sSource -> path of the OBJ file
+	-	MyCookedData& a_Data -> model being cooked
+	OUTPUT: was the file read?
+	*/
+	bool ReadOBJ(String a_sSource, MyCookedData& a_Data);
+	/*
+	USAGE: Reads the materials of a MTL file
+	ARGUMENTS:
+	-	String a_sFileName -> path of the MTL file
+	-	MyCookedData& a_Data -> model being cooked
+	OUTPUT: ---
+	*/
+	void ReadMTL(String a_sFileName, MyCookedData& a_Data);
+	/*
+	USAGE: Writes the cooked file
+	ARGUMENTS:
+	-	String a_sCooked -> path of the cooked file
+	-	MyCookedHeader a_Header -> header with the stamp of the source, the rest is filled here
+	-	MyCookedData& a_Data -> model being cooked
+	OUTPUT: was the file written?
+	*/
+	bool Write(String a_sCooked, MyCookedHeader a_Header, MyCookedData& a_Data);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYMODELCOOKER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,467 @@
+#include "MyObjParser.h"
+#include <thread>
+using namespace Simplex;
+//  MyObjParser
+MyObjParser::MyObjParser(void) { }
+MyObjParser::MyObjParser(MyObjParser const& other) { }
+MyObjParser& MyObjParser::operator=(MyObjParser const& other) { return *this; }
+MyObjParser::~MyObjParser(void) { m_File.Close(); }
+//Accessors
+uint MyObjParser::GetThreadCount(void) { return m_uThreadCount; }
+std::vector<String> MyObjParser::GetLibraryList(void)
+{
+	std::vector<String> lLibrary;
+	for (uint i = 0; i < m_ChunkList.size(); ++i)
+		lLibrary.insert(lLibrary.end(), m_ChunkList[i].m_LibraryList.begin(), m_ChunkList[i].m_LibraryList.end());
+	return lLibrary;
+}
+//--- Methods
+bool MyObjParser::Read(String a_sFileName)
+{
+	m_ChunkList.clear();
+	m_PositionList.clear();
+	m_UVList.clear();
+	m_NormalList.clear();
+	if (!m_File.Open(a_sFileName))
+		return false;
+
+	//a few chunks per thread so a slow chunk does not hold the others back
+	char const* pData = m_File.GetData();
+	size_t uSize = m_File.GetSize();
+	uint uThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	size_t uChunkCount = std::min<size_t>(uThreadCount * 4, std::max<size_t>(uSize / OBJ_CHUNK_SIZE, 1));
+	size_t uChunkSize = uSize / uChunkCount;
+
+	//every chunk ends right after a line break so no line is split
+	char const* pBegin = pData;
+	char const* pEnd = pData + uSize;
+	while (pBegin < pEnd)
+	{
+		char const* pSplit = pBegin + std::min(uChunkSize, static_cast<size_t>(pEnd - pBegin));
+		pSplit = static_cast<char const*>(memchr(pSplit, '\n', pEnd - pSplit));
+		pSplit = pSplit == nullptr ? pEnd : pSplit + 1;
+
+		MyObjChunk chunk;
+		chunk.m_pBegin = pBegin;
+		chunk.m_pEnd = pSplit;
+		m_ChunkList.push_back(chunk);
+		pBegin = pSplit;
+	}
+	m_uThreadCount = std::min(uThreadCount, static_cast<uint>(m_ChunkList.size()));
+	RunThreads(false);
+
+	//the vertices of a chunk come after the ones of the chunks before it
+	uint uBase[3] = { 0, 0, 0 };
+	for (uint i = 0; i < m_ChunkList.size(); ++i)
+	{
+		MyObjChunk& chunk = m_ChunkList[i];
+		for (uint j = 0; j < 3; ++j)
+			chunk.m_uBase[j] = uBase[j];
+		uBase[0] += static_cast<uint>(chunk.m_PositionList.size());
+		uBase[1] += static_cast<uint>(chunk.m_UVList.size());
+		uBase[2] += static_cast<uint>(chunk.m_NormalList.size());
+	}
+	m_PositionList.reserve(uBase[0]);
+	m_UVList.reserve(uBase[1]);
+	m_NormalList.reserve(uBase[2]);
+	for (uint i = 0; i < m_ChunkList.size(); ++i)
+	{
+		MyObjChunk& chunk = m_ChunkList[i];
+		m_PositionList.insert(m_PositionList.end(), chunk.m_PositionList.begin(), chunk.m_PositionList.end());
+		m_UVList.insert(m_UVList.end(), chunk.m_UVList.begin(), chunk.m_UVList.end());
+		m_NormalList.insert(m_NormalList.end(), chunk.m_NormalList.begin(), chunk.m_NormalList.end());
+		std::vector<vector3>().swap(chunk.m_PositionList);
+		std::vector<vector3>().swap(chunk.m_UVList);
+		std::vector<vector3>().swap(chunk.m_NormalList);
+	}
+	return true;
+}
+void MyObjParser::Build(MyCookedData& a_Data)
+{
+	//names are resolved in file order before the threads start, the string table is not shared with them
+	m_MaterialList.clear();
+	m_MaterialList.push_back(MyCookedMaterial());
+	std::map<String, uint> materialMap;
+	std::map<String, uint> groupMap;
+	uint uGroup = MyModelCooker::AddString(a_Data, "default");
+	groupMap["default"] = uGroup;
+	uint uMaterial = 0;
+	for (uint i = 0; i < m_ChunkList.size(); ++i)
+	{
+		MyObjChunk& chunk = m_ChunkList[i];
+		chunk.m_uGroup = uGroup;
+		chunk.m_uMaterial = uMaterial;
+		for (uint j = 0; j < chunk.m_CommandList.size(); ++j)
+		{
+			MyObjCommand& command = chunk.m_CommandList[j];
+			if (command.m_bMaterial)
+			{
+				auto material = materialMap.find(command.m_sName);
+				if (material == materialMap.end())
+				{
+					//a material missing from the MTL files is drawn with the default one
+					auto cooked = a_Data.m_MaterialMap.find(command.m_sName);
+					uint uIndex = 0;
+					if (cooked != a_Data.m_MaterialMap.end())
+					{
+						uIndex = static_cast<uint>(m_MaterialList.size());
+						m_MaterialList.push_back(cooked->second);
+					}
+					material = materialMap.insert(std::make_pair(command.m_sName, uIndex)).first;
+				}
+				command.m_uName = uMaterial = material->second;
+			}
+			else if (command.m_sName != "")
+			{
+				auto group = groupMap.find(command.m_sName);
+				if (group == groupMap.end())
+					group = groupMap.insert(std::make_pair(command.m_sName, MyModelCooker::AddString(a_Data, command.m_sName))).first;
+				command.m_uName = uGroup = group->second;
+			}
+			else
+			{
+				command.m_uName = uGroup;
+			}
+		}
+	}
+	RunThreads(true);
+
+	//append in file order, a mesh cut by a chunk boundary is joined again
+	uint uBase = static_cast<uint>(a_Data.m_PositionList.size());
+	for (uint i = 0; i < m_ChunkList.size(); ++i)
+	{
+		MyObjChunk& chunk = m_ChunkList[i];
+		for (uint j = 0; j < chunk.m_MeshList.size(); ++j)
+		{
+			MyCookedMesh mesh = chunk.m_MeshList[j];
+			mesh.m_uFirstVertex += uBase;
+			if (j == 0 && a_Data.m_MeshList.size() > 0)
+			{
+				MyCookedMesh& last = a_Data.m_MeshList.back();
+				if (last.m_uGroup == mesh.m_uGroup && last.m_uMaterial == mesh.m_uMaterial &&
+					last.m_uFirstVertex + last.m_uVertexCount == mesh.m_uFirstVertex)
+				{
+					last.m_uVertexCount += mesh.m_uVertexCount;
+					continue;
+				}
+			}
+			a_Data.m_MeshList.push_back(mesh);
+		}
+		a_Data.m_PositionList.insert(a_Data.m_PositionList.end(), chunk.m_OutPositionList.begin(), chunk.m_OutPositionList.end());
+		a_Data.m_NormalList.insert(a_Data.m_NormalList.end(), chunk.m_OutNormalList.begin(), chunk.m_OutNormalList.end());
+		a_Data.m_UVList.insert(a_Data.m_UVList.end(), chunk.m_OutUVList.begin(), chunk.m_OutUVList.end());
+		a_Data.m_ColorList.insert(a_Data.m_ColorList.end(), chunk.m_OutColorList.begin(), chunk.m_OutColorList.end());
+		uBase += static_cast<uint>(chunk.m_OutPositionList.size());
+	}
+	m_ChunkList.clear();
+	m_File.Close();
+}
+void MyObjParser::RunThreads(bool a_bBuild)
+{
+	//the calling thread takes the first share
+	std::vector<std::thread> lThread;
+	for (uint i = 1; i < m_uThreadCount; ++i)
+		lThread.push_back(std::thread(&MyObjParser::RunChunks, this, i, a_bBuild));
+	RunChunks(0, a_bBuild);
+	for (uint i = 0; i < lThread.size(); ++i)
+		lThread[i].join();
+}
+void MyObjParser::RunChunks(uint a_uThread, bool a_bBuild)
+{
+	for (uint i = a_uThread; i < m_ChunkList.size(); i += m_uThreadCount)
+	{
+		if (a_bBuild)
+			BuildChunk(m_ChunkList[i]);
+		else
+			ParseChunk(m_ChunkList[i]);
+	}
+}
+void MyObjParser::ParseChunk(MyObjChunk& a_Chunk)
+{
+	char const* pLine = a_Chunk.m_pBegin;
+	while (pLine < a_Chunk.m_pEnd)
+	{
+		char const* pEnd = static_cast<char const*>(memchr(pLine, '\n', a_Chunk.m_pEnd - pLine));
+		if (pEnd == nullptr)
+			pEnd = a_Chunk.m_pEnd;
+		char const* pCursor = pLine;
+		pLine = pEnd + 1;
+
+		while (pCursor < pEnd && (*pCursor == ' ' || *pCursor == '\t'))
+			++pCursor;
+		if (pEnd - pCursor < 2)
+			continue;
+
+		char cSecond = pCursor[1];
+		bool bSpace = cSecond == ' ' || cSecond == '\t';
+		if (pCursor[0] == 'v')
+		{
+			if (bSpace)
+				a_Chunk.m_PositionList.push_back(ReadVector(pCursor + 1, pEnd));
+			else if (cSecond == 't')
+				a_Chunk.m_UVList.push_back(ReadVector(pCursor + 2, pEnd));
+			else if (cSecond == 'n')
+				a_Chunk.m_NormalList.push_back(ReadVector(pCursor + 2, pEnd));
+		}
+		else if (pCursor[0] == 'f' && bSpace)
+		{
+			int nCount[3] = { static_cast<int>(a_Chunk.m_PositionList.size()),
+				static_cast<int>(a_Chunk.m_UVList.size()), static_cast<int>(a_Chunk.m_NormalList.size()) };
+			uint uCorners = 0;
+			pCursor += 1;
+			while (true)
+			{
+				while (pCursor < pEnd && (*pCursor == ' ' || *pCursor == '\t'))
+					++pCursor;
+				if (pCursor >= pEnd || *pCursor == '\r' || *pCursor == '#')
+					break;
+
+				//v, v/vt, v//vn or v/vt/vn
+				MyObjCorner corner;
+				for (uint i = 0; i < 3; ++i)
+				{
+					if (i > 0)
+					{
+						if (pCursor >= pEnd || *pCursor != '/')
+							break;
+						++pCursor;
+					}
+					int nValue = 0;
+					if (!ReadInt(pCursor, pEnd, nValue) || nValue == 0)
+						continue;
+					if (nValue > 0)
+					{
+						corner.m_nIndex[i] = nValue - 1;
+					}
+					else
+					{
+						//negative indices count back from the last vertex read, the chunk base is added later
+						corner.m_nIndex[i] = nCount[i] + nValue;
+						corner.m_uRelative |= 1u << i;
+					}
+				}
+				//skip anything left of a malformed corner
+				while (pCursor < pEnd && *pCursor != ' ' && *pCursor != '\t' && *pCursor != '\r')
+					++pCursor;
+				a_Chunk.m_CornerList.push_back(corner);
+				++uCorners;
+			}
+			a_Chunk.m_FaceList.push_back(uCorners);
+		}
+		else if ((pCursor[0] == 'g' || pCursor[0] == 'o') && bSpace)
+		{
+			MyObjCommand command;
+			command.m_uFace = static_cast<uint>(a_Chunk.m_FaceList.size());
+			command.m_sName = ReadWord(pCursor + 1, pEnd);
+			a_Chunk.m_CommandList.push_back(command);
+		}
+		else if (pEnd - pCursor > 6 && memcmp(pCursor, "usemtl", 6) == 0)
+		{
+			MyObjCommand command;
+			command.m_uFace = static_cast<uint>(a_Chunk.m_FaceList.size());
+			command.m_bMaterial = true;
+			command.m_sName = ReadWord(pCursor + 6, pEnd);
+			a_Chunk.m_CommandList.push_back(command);
+		}
+		else if (pEnd - pCursor > 6 && memcmp(pCursor, "mtllib", 6) == 0)
+		{
+			a_Chunk.m_LibraryList.push_back(ReadWord(pCursor + 6, pEnd));
+		}
+	}
+}
+void MyObjParser::BuildChunk(MyObjChunk& a_Chunk)
+{
+	int nCount[3] = { static_cast<int>(m_PositionList.size()),
+		static_cast<int>(m_UVList.size()), static_cast<int>(m_NormalList.size()) };
+
+	MyCookedMesh mesh;
+	mesh.m_uGroup = a_Chunk.m_uGroup;
+	MyCookedMaterial const* pMaterial = &m_MaterialList[a_Chunk.m_uMaterial];
+	mesh.m_uMaterial = pMaterial->m_uName;
+	mesh.m_uDiffuse = pMaterial->m_uDiffuse;
+	mesh.m_uNormal = pMaterial->m_uNormal;
+	mesh.m_uSpecular = pMaterial->m_uSpecular;
+
+	uint uCommand = 0;
+	uint uCorner = 0;
+	for (uint uFace = 0; uFace < a_Chunk.m_FaceList.size(); ++uFace)
+	{
+		//a new mesh starts when the group or the material changes
+		while (uCommand < a_Chunk.m_CommandList.size() && a_Chunk.m_CommandList[uCommand].m_uFace == uFace)
+		{
+			MyObjCommand const& command = a_Chunk.m_CommandList[uCommand++];
+			if (mesh.m_uVertexCount > 0)
+			{
+				a_Chunk.m_MeshList.push_back(mesh);
+				mesh.m_uFirstVertex += mesh.m_uVertexCount;
+				mesh.m_uVertexCount = 0;
+			}
+			if (command.m_bMaterial)
+			{
+				pMaterial = &m_MaterialList[command.m_uName];
+				mesh.m_uMaterial = pMaterial->m_uName;
+				mesh.m_uDiffuse = pMaterial->m_uDiffuse;
+				mesh.m_uNormal = pMaterial->m_uNormal;
+				mesh.m_uSpecular = pMaterial->m_uSpecular;
+			}
+			else
+			{
+				mesh.m_uGroup = command.m_uName;
+			}
+		}
+
+		//turn the indices of the corners into indices of the whole file
+		uint uCorners = a_Chunk.m_FaceList[uFace];
+		MyObjCorner* pCorner = &a_Chunk.m_CornerList[uCorner];
+		uCorner += uCorners;
+		for (uint i = 0; i < uCorners; ++i)
+		{
+			for (uint j = 0; j < 3; ++j)
+			{
+				int& nIndex = pCorner[i].m_nIndex[j];
+				if (pCorner[i].m_uRelative & (1u << j))
+					nIndex += static_cast<int>(a_Chunk.m_uBase[j]);
+				if (nIndex < 0 || nIndex >= nCount[j])
+					nIndex = -1;
+			}
+		}
+
+		//fan triangulation of the polygon
+		for (uint i = 1; i + 1 < uCorners; ++i)
+		{
+			MyObjCorner const* pTriangle[3] = { &pCorner[0], &pCorner[i], &pCorner[i + 1] };
+			if (pTriangle[0]->m_nIndex[0] < 0 || pTriangle[1]->m_nIndex[0] < 0 || pTriangle[2]->m_nIndex[0] < 0)
+				continue;
+
+			vector3 v3A = m_PositionList[pTriangle[0]->m_nIndex[0]];
+			vector3 v3B = m_PositionList[pTriangle[1]->m_nIndex[0]];
+			vector3 v3C = m_PositionList[pTriangle[2]->m_nIndex[0]];
+			//the face normal is used by the corners that do not have one
+			vector3 v3Face = glm::cross(v3B - v3A, v3C - v3A);
+			if (glm::length(v3Face) > 0.0f)
+				v3Face = glm::normalize(v3Face);
+
+			for (uint j = 0; j < 3; ++j)
+			{
+				int const* pIndex = pTriangle[j]->m_nIndex;
+				a_Chunk.m_OutPositionList.push_back(m_PositionList[pIndex[0]]);
+				a_Chunk.m_OutUVList.push_back(pIndex[1] < 0 ? ZERO_V3 : m_UVList[pIndex[1]]);
+				a_Chunk.m_OutNormalList.push_back(pIndex[2] < 0 ? v3Face : m_NormalList[pIndex[2]]);
+				a_Chunk.m_OutColorList.push_back(pMaterial->m_v3Color);
+			}
+			mesh.m_uVertexCount += 3;
+		}
+	}
+	if (mesh.m_uVertexCount > 0)
+		a_Chunk.m_MeshList.push_back(mesh);
+
+	//the corners are not needed anymore
+	std::vector<MyObjCorner>().swap(a_Chunk.m_CornerList);
+	std::vector<uint>().swap(a_Chunk.m_FaceList);
+}
+bool MyObjParser::ReadInt(char const*& a_pCursor, char const* a_pEnd, int& a_nValue)
+{
+	char const* pCursor = a_pCursor;
+	bool bNegative = false;
+	if (pCursor < a_pEnd && (*pCursor == '-' || *pCursor == '+'))
+		bNegative = *pCursor++ == '-';
+	if (pCursor >= a_pEnd || *pCursor < '0' || *pCursor > '9')
+		return false;
+
+	int nValue = 0;
+	while (pCursor < a_pEnd && *pCursor >= '0' && *pCursor <= '9')
+		nValue = nValue * 10 + (*pCursor++ - '0');
+	a_nValue = bNegative ? -nValue : nValue;
+	a_pCursor = pCursor;
+	return true;
+}
+bool MyObjParser::ReadFloat(char const*& a_pCursor, char const* a_pEnd, float& a_fValue)
+{
+	static double const dPower[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	char const* pCursor = a_pCursor;
+	bool bNegative = false;
+	if (pCursor < a_pEnd && (*pCursor == '-' || *pCursor == '+'))
+		bNegative = *pCursor++ == '-';
+
+	//the digits go in an integer, the ones that do not fit only move the exponent
+	unsigned long long uMantissa = 0;
+	int nExponent = 0;
+	uint uDigits = 0;
+	bool bAny = false;
+	while (pCursor < a_pEnd && *pCursor >= '0' && *pCursor <= '9')
+	{
+		if (uDigits < 19)
+		{
+			uMantissa = uMantissa * 10 + (*pCursor - '0');
+			if (uMantissa > 0)
+				++uDigits;
+		}
+		else
+		{
+			++nExponent;
+		}
+		++pCursor;
+		bAny = true;
+	}
+	if (pCursor < a_pEnd && *pCursor == '.')
+	{
+		++pCursor;
+		while (pCursor < a_pEnd && *pCursor >= '0' && *pCursor <= '9')
+		{
+			if (uDigits < 19)
+			{
+				uMantissa = uMantissa * 10 + (*pCursor - '0');
+				--nExponent;
+				if (uMantissa > 0)
+					++uDigits;
+			}
+			++pCursor;
+			bAny = true;
+		}
+	}
+	if (!bAny)
+		return false;
+
+	if (pCursor < a_pEnd && (*pCursor == 'e' || *pCursor == 'E'))
+	{
+		char const* pExponent = pCursor + 1;
+		int nValue = 0;
+		if (ReadInt(pExponent, a_pEnd, nValue))
+		{
+			nExponent += nValue;
+			pCursor = pExponent;
+		}
+	}
+
+	double dValue = static_cast<double>(uMantissa);
+	if (nExponent < 0)
+		dValue = -nExponent <= 22 ? dValue / dPower[-nExponent] : dValue * std::pow(10.0, nExponent);
+	else if (nExponent > 0)
+		dValue = nExponent <= 22 ? dValue * dPower[nExponent] : dValue * std::pow(10.0, nExponent);
+	a_fValue = static_cast<float>(bNegative ? -dValue : dValue);
+	a_pCursor = pCursor;
+	return true;
+}
+vector3 MyObjParser::ReadVector(char const* a_pCursor, char const* a_pEnd)
+{
+	vector3 v3Output;
+	for (uint i = 0; i < 3; ++i)
+	{
+		while (a_pCursor < a_pEnd && (*a_pCursor == ' ' || *a_pCursor == '\t'))
+			++a_pCursor;
+		if (!ReadFloat(a_pCursor, a_pEnd, v3Output[i]))
+			break;
+	}
+	return v3Output;
+}
+String MyObjParser::ReadWord(char const* a_pCursor, char const* a_pEnd)
+{
+	while (a_pCursor < a_pEnd && (*a_pCursor == ' ' || *a_pCursor == '\t'))
+		++a_pCursor;
+	char const* pEnd = a_pCursor;
+	while (pEnd < a_pEnd && *pEnd != ' ' && *pEnd != '\t' && *pEnd != '\r')
+		++pEnd;
+	return String(a_pCursor, pEnd);
+}
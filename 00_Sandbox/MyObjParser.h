@@ -0,0 +1,190 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYOBJPARSER_H_
+#define __MYOBJPARSER_H_
+
+#include "MyModelCooker.h"
+
+#define OBJ_CHUNK_SIZE 65536 //smallest part of the file given to a thread, in bytes
+
+namespace Simplex
+{
+
+//Corner of a face, indices are 0 based and -1 if the corner does not have one
+struct MyObjCorner
+{
+	int m_nIndex[3] = { -1, -1, -1 }; //position, texture coordinate and normal
+	uint m_uRelative = 0; //bit i is set if index i counts from the start of the chunk (it was negative in the file)
+};
+
+//Statement that changes the state of the faces that follow it
+struct MyObjCommand
+{
+	uint m_uFace = 0; //face of the chunk before which the statement is found
+	bool m_bMaterial = false; //usemtl if true, g or o otherwise
+	String m_sName = ""; //name of the group or the material
+	uint m_uName = 0; //group offset in the string table or material index in the material list, filled before building
+};
+
+//Line aligned part of the file parsed by one thread
+struct MyObjChunk
+{
+	char const* m_pBegin = nullptr; //first byte of the chunk
+	char const* m_pEnd = nullptr; //one past the last byte of the chunk
+
+	std::vector<vector3> m_PositionList; //positions declared in the chunk
+	std::vector<vector3> m_UVList; //texture coordinates declared in the chunk
+	std::vector<vector3> m_NormalList; //normals declared in the chunk
+	std::vector<MyObjCorner> m_CornerList; //corners of the faces of the chunk
+	std::vector<uint> m_FaceList; //number of corners of each face
+	std::vector<MyObjCommand> m_CommandList; //state changes in order
+	std::vector<String> m_LibraryList; //mtllib statements in order
+
+	uint m_uBase[3] = { 0, 0, 0 }; //positions, texture coordinates and normals declared before the chunk
+	uint m_uGroup = 0; //group when the chunk starts, offset in the string table
+	uint m_uMaterial = 0; //material when the chunk starts, index in the material list
+
+	std::vector<vector3> m_OutPositionList; //triangles of the chunk
+	std::vector<vector3> m_OutNormalList; //normals of the triangles of the chunk
+	std::vector<vector3> m_OutUVList; //texture coordinates of the triangles of the chunk
+	std::vector<vector3> m_OutColorList; //colors of the triangles of the chunk
+	std::vector<MyCookedMesh> m_MeshList; //meshes of the chunk, first vertex is local to the chunk
+};
+
+//System Class
+class MyObjParser
+{
+	MyMappedFile m_File; //OBJ being parsed
+	std::vector<MyObjChunk> m_ChunkList; //parts of the file, in order
+	uint m_uThreadCount = 1; //threads used by the last read
+
+	std::vector<vector3> m_PositionList; //positions of the whole file, merged in order
+	std::vector<vector3> m_UVList; //texture coordinates of the whole file, merged in order
+	std::vector<vector3> m_NormalList; //normals of the whole file, merged in order
+	std::vector<MyCookedMaterial> m_MaterialList; //materials used by the faces, the first one is the default
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyObjParser(void);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyObjParser(void);
+	/*
+	USAGE: Maps the file, splits it in line aligned chunks and parses them in parallel
+	ARGUMENTS: String a_sFileName -> path of the OBJ file
+	OUTPUT: could the file be read?
+	*/
+	bool Read(String a_sFileName);
+	/*
+	USAGE: Gets the MTL files named by the OBJ, they have to be read into the data before Build
+	ARGUMENTS: ---
+	OUTPUT: names of the MTL files, relative to the OBJ
+	*/
+	std::vector<String> GetLibraryList(void);
+	/*
+	USAGE: Triangulates the faces of every chunk in parallel and appends the streams and meshes to
+	the data in file order
+	ARGUMENTS: MyCookedData& a_Data -> model being cooked, with its materials already read
+	OUTPUT: ---
+	*/
+	void Build(MyCookedData& a_Data);
+	/*
+	USAGE: Gets the number of threads used by the last read
+	ARGUMENTS: ---
+	OUTPUT: thread count
+	*/
+	uint GetThreadCount(void);
+
+private:
+	/*
+	Usage: Copy Constructor, the parser owns a mapped file
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyObjParser(MyObjParser const& other);
+	/*
+	Usage: Copy Assignment Operator, the parser owns a mapped file
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyObjParser& operator=(MyObjParser const& other);
+	/*
+	USAGE: Parses the statements of a chunk
+	ARGUMENTS: MyObjChunk& a_Chunk -> chunk to parse
+	OUTPUT: ---
+	*/
+	void ParseChunk(MyObjChunk& a_Chunk);
+	/*
+	USAGE: Generates the triangles of a chunk, the bases and starting state have to be set
+	ARGUMENTS: MyObjChunk& a_Chunk -> chunk to triangulate
+	OUTPUT: ---
+	*/
+	void BuildChunk(MyObjChunk& a_Chunk);
+	/*
+	USAGE: Parses or builds the chunks of a thread, each thread takes every thread count-th chunk
+	ARGUMENTS:
+	-	uint a_uThread -> index of the thread
+	-	bool a_bBuild -> build the chunks instead of parsing them
+	OUTPUT: ---
+	*/
+	void RunChunks(uint a_uThread, bool a_bBuild);
+	/*
+	USAGE: Runs RunChunks on every thread and waits for them
+	ARGUMENTS: bool a_bBuild -> build the chunks instead of parsing them
+	OUTPUT: ---
+	*/
+	void RunThreads(bool a_bBuild);
+	/*
+	USAGE: Reads a signed integer, the pointer is left after it
+	ARGUMENTS:
+	-	char const*& a_pCursor -> current character
+	-	char const* a_pEnd -> end of the line
+	-	int& a_nValue -> read value
+	OUTPUT: was there a number?
+	*/
+	static bool ReadInt(char const*& a_pCursor, char const* a_pEnd, int& a_nValue);
+	/*
+	USAGE: Reads a floating point number in plain or scientific notation, not affected by the locale
+	ARGUMENTS:
+	-	char const*& a_pCursor -> current character
+	-	char const* a_pEnd -> end of the line
+	-	float& a_fValue -> read value
+	OUTPUT: was there a number?
+	*/
+	static bool ReadFloat(char const*& a_pCursor, char const* a_pEnd, float& a_fValue);
+	/*
+	USAGE: Reads up to 3 floats of a line, the missing ones are 0
+	ARGUMENTS:
+	-	char const* a_pCursor -> first character after the keyword
+	-	char const* a_pEnd -> end of the line
+	OUTPUT: read vector
+	*/
+	static vector3 ReadVector(char const* a_pCursor, char const* a_pEnd);
+	/*
+	USAGE: Reads the first word of the rest of a line
+	ARGUMENTS:
+	-	char const* a_pCursor -> first character after the keyword
+	-	char const* a_pEnd -> end of the line
+	OUTPUT: word, empty if there is none
+	*/
+	static String ReadWord(char const* a_pCursor, char const* a_pEnd);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYOBJPARSER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
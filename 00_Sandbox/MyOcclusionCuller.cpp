@@ -0,0 +1,305 @@
+#include "MyOcclusionCuller.h"
+using namespace Simplex;
+//  MyOcclusionCuller
+MyOcclusionCuller* MyOcclusionCuller::m_pInstance = nullptr;
+void MyOcclusionCuller::Init(void)
+{
+	m_bEnabled = true;
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_pOctree = nullptr;
+	m_uVAO = 0;
+	m_uVBO = 0;
+	m_uEBO = 0;
+	m_nMin = -1;
+	m_nMax = -1;
+	m_uTestedCount = 0;
+	m_uCulledCount = 0;
+	m_uOctantCulledCount = 0;
+}
+void MyOcclusionCuller::Release(void)
+{
+	//the queries and buffers only exist if a frame was tested, there might not even be a context
+	for (uint i = 0; i < m_lEntityQuery.size(); ++i)
+	{
+		if (m_lEntityQuery[i] != 0)
+			glDeleteQueries(1, &m_lEntityQuery[i]);
+	}
+	for (uint i = 0; i < m_lOctantQuery.size(); ++i)
+	{
+		if (m_lOctantQuery[i] != 0)
+			glDeleteQueries(1, &m_lOctantQuery[i]);
+	}
+	if (m_uEBO != 0)
+		glDeleteBuffers(1, &m_uEBO);
+	if (m_uVBO != 0)
+		glDeleteBuffers(1, &m_uVBO);
+	if (m_uVAO != 0)
+		glDeleteVertexArrays(1, &m_uVAO);
+	m_uEBO = 0;
+	m_uVBO = 0;
+	m_uVAO = 0;
+
+	m_lEntityQuery.clear();
+	m_lEntityPending.clear();
+	m_lEntityVisible.clear();
+	m_lEntityOctant.clear();
+	m_lEntityDrawn.clear();
+	m_lEntityMin.clear();
+	m_lEntityMax.clear();
+	m_lOctantQuery.clear();
+	m_lOctantPending.clear();
+	m_lOctantVisible.clear();
+	m_lOctantFilled.clear();
+	m_lOctantMin.clear();
+	m_lOctantMax.clear();
+}
+MyOcclusionCuller* MyOcclusionCuller::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyOcclusionCuller();
+	}
+	return m_pInstance;
+}
+void MyOcclusionCuller::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyOcclusionCuller::MyOcclusionCuller() { Init(); }
+MyOcclusionCuller::MyOcclusionCuller(MyOcclusionCuller const& a_pOther) { }
+MyOcclusionCuller& MyOcclusionCuller::operator=(MyOcclusionCuller const& a_pOther) { return *this; }
+MyOcclusionCuller::~MyOcclusionCuller() { Release(); };
+//Accessors
+void MyOcclusionCuller::SetEnabled(bool a_bEnabled) { m_bEnabled = a_bEnabled; }
+bool MyOcclusionCuller::IsEnabled(void) { return m_bEnabled; }
+uint MyOcclusionCuller::GetTestedCount(void) { return m_uTestedCount; }
+uint MyOcclusionCuller::GetCulledCount(void) { return m_uCulledCount; }
+uint MyOcclusionCuller::GetOctantCulledCount(void) { return m_uOctantCulledCount; }
+bool MyOcclusionCuller::IsVisible(uint a_uIndex)
+{
+	if (!m_bEnabled || a_uIndex >= m_lEntityDrawn.size())
+		return true;
+	return m_lEntityDrawn[a_uIndex] != 0;
+}
+//--- Methods
+bool MyOcclusionCuller::IsNear(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Camera)
+{
+	vector3 v3Margin = vector3(OCCLUSION_NEAR_MARGIN);
+	return glm::all(glm::greaterThanEqual(a_v3Camera, a_v3Min - v3Margin)) &&
+		glm::all(glm::lessThanEqual(a_v3Camera, a_v3Max + v3Margin));
+}
+void MyOcclusionCuller::ReadResult(GLuint a_uQuery, char& a_cPending, char& a_cVisible)
+{
+	if (!a_cPending)
+		return;
+	GLuint uAvailable = 0;
+	glGetQueryObjectuiv(a_uQuery, GL_QUERY_RESULT_AVAILABLE, &uAvailable);
+	if (!uAvailable)
+		return;
+	GLuint uPassed = 0;
+	glGetQueryObjectuiv(a_uQuery, GL_QUERY_RESULT, &uPassed);
+	a_cVisible = uPassed != 0;
+	a_cPending = 0;
+}
+void MyOcclusionCuller::Update(vector3 a_v3Camera)
+{
+	m_uCulledCount = 0;
+	m_uOctantCulledCount = 0;
+	if (!m_bEnabled)
+		return;
+
+	//new entities are drawn until they are tested, a removed one leaves its result to the entity taking
+	//its index for a frame
+	uint uCount = m_pEntityMngr->GetEntityCount();
+	m_lEntityQuery.resize(uCount, 0);
+	m_lEntityPending.resize(uCount, 0);
+	m_lEntityVisible.resize(uCount, 1);
+	m_lEntityDrawn.resize(uCount, 1);
+	m_lEntityOctant.assign(uCount, 0);
+	m_lEntityMin.resize(uCount);
+	m_lEntityMax.resize(uCount);
+
+	//the octants are listed in the order they got their first entity, a rebuilt tree starts over
+	MyOctree* pOctree = m_pEntityMngr->GetOctree();
+	if (pOctree != m_pOctree)
+	{
+		m_lOctantPending.assign(m_lOctantPending.size(), 0);
+		m_lOctantVisible.assign(m_lOctantVisible.size(), 1);
+		m_pOctree = pOctree;
+	}
+	uint uNodeCount = pOctree != nullptr ? pOctree->GetNodeCount() : 0;
+	m_lOctantQuery.resize(std::max(uNodeCount, static_cast<uint>(m_lOctantQuery.size())), 0);
+	m_lOctantPending.resize(m_lOctantQuery.size(), 0);
+	m_lOctantVisible.resize(m_lOctantQuery.size(), 1);
+	m_lOctantFilled.assign(m_lOctantQuery.size(), 0);
+	m_lOctantMin.resize(m_lOctantQuery.size());
+	m_lOctantMax.resize(m_lOctantQuery.size());
+	for (uint i = 0; i < uNodeCount; ++i)
+	{
+		MyOctree* pNode = pOctree->GetNode(i);
+		std::vector<MyHandle> const& lEntity = pNode->GetEntityList();
+		m_lOctantFilled[i] = !lEntity.empty();
+		m_lOctantMin[i] = pNode->GetLooseMinGlobal();
+		m_lOctantMax[i] = pNode->GetLooseMaxGlobal();
+		ReadResult(m_lOctantQuery[i], m_lOctantPending[i], m_lOctantVisible[i]);
+		bool bVisible = m_lOctantVisible[i] || IsNear(m_lOctantMin[i], m_lOctantMax[i], a_v3Camera);
+		if (!bVisible && !lEntity.empty())
+			++m_uOctantCulledCount;
+		for (uint j = 0; j < lEntity.size(); ++j)
+		{
+			int nIndex = m_pEntityMngr->GetEntityIndex(lEntity[j]);
+			if (nIndex < 0 || static_cast<uint>(nIndex) >= uCount)
+				continue;
+			if (bVisible)
+				m_lEntityOctant[nIndex] = 2;
+			else if (m_lEntityOctant[nIndex] == 0)
+				m_lEntityOctant[nIndex] = 1;
+		}
+	}
+
+	for (uint i = 0; i < uCount; ++i)
+	{
+		m_lEntityMin[i] = m_pEntityMngr->GetMinGlobal(i);
+		m_lEntityMax[i] = m_pEntityMngr->GetMaxGlobal(i);
+		ReadResult(m_lEntityQuery[i], m_lEntityPending[i], m_lEntityVisible[i]);
+		if (m_lEntityOctant[i] == 1)
+		{
+			//the entity is not tested while its octants hide it, it is drawn once they show up again
+			m_lEntityVisible[i] = 1;
+			m_lEntityDrawn[i] = 0;
+		}
+		else
+		{
+			m_lEntityDrawn[i] = m_lEntityVisible[i] || IsNear(m_lEntityMin[i], m_lEntityMax[i], a_v3Camera);
+		}
+		if (!m_lEntityDrawn[i])
+			++m_uCulledCount;
+	}
+}
+uint MyOcclusionCuller::Render(matrix4 a_m4ViewProjection, vector3 a_v3Camera)
+{
+	m_uTestedCount = 0;
+	if (!m_bEnabled)
+		return 0;
+
+	if (m_uVAO == 0)
+		InitDevice();
+	GLuint uProgram = MyShaderCache::GetInstance()->GetProgram("OcclusionBox");
+	if (uProgram == 0)
+		return 0;
+
+	//the boxes only touch the queries, the depth of the frame is tested as it is
+	GLboolean bCullFace = glIsEnabled(GL_CULL_FACE);
+	GLboolean bDepthTest = glIsEnabled(GL_DEPTH_TEST);
+	GLint nDepthFunc = GL_LESS;
+	glGetIntegerv(GL_DEPTH_FUNC, &nDepthFunc);
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_FALSE);
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LEQUAL);
+	glDisable(GL_CULL_FACE);
+
+	glUseProgram(uProgram);
+	glUniformMatrix4fv(glGetUniformLocation(uProgram, "VP"), 1, GL_FALSE, glm::value_ptr(a_m4ViewProjection));
+	glBindVertexArray(m_uVAO);
+
+	//a query still in flight is not issued again, its entity keeps the result it had
+	for (uint i = 0; i < m_lOctantFilled.size(); ++i)
+	{
+		if (!m_lOctantFilled[i] || m_lOctantPending[i] || IsNear(m_lOctantMin[i], m_lOctantMax[i], a_v3Camera))
+			continue;
+		TestBox(m_lOctantQuery[i], m_lOctantPending[i], m_lOctantMin[i], m_lOctantMax[i]);
+	}
+	for (uint i = 0; i < m_lEntityDrawn.size(); ++i)
+	{
+		if (m_lEntityOctant[i] == 1 || m_lEntityPending[i] || IsNear(m_lEntityMin[i], m_lEntityMax[i], a_v3Camera))
+			continue;
+		TestBox(m_lEntityQuery[i], m_lEntityPending[i], m_lEntityMin[i], m_lEntityMax[i]);
+	}
+
+	glBindVertexArray(0);
+	glUseProgram(0);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDepthMask(GL_TRUE);
+	glDepthFunc(nDepthFunc);
+	if (!bDepthTest)
+		glDisable(GL_DEPTH_TEST);
+	if (bCullFace)
+		glEnable(GL_CULL_FACE);
+	return m_uTestedCount;
+}
+void MyOcclusionCuller::TestBox(GLuint& a_uQuery, char& a_cPending, vector3 a_v3Min, vector3 a_v3Max)
+{
+	if (a_uQuery == 0)
+		glGenQueries(1, &a_uQuery);
+	vector3 v3Growth = (a_v3Max - a_v3Min) * OCCLUSION_BOX_GROWTH;
+	a_v3Min -= v3Growth;
+	a_v3Max += v3Growth;
+	glUniform3fv(m_nMin, 1, glm::value_ptr(a_v3Min));
+	glUniform3fv(m_nMax, 1, glm::value_ptr(a_v3Max));
+	glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, a_uQuery);
+	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_BYTE, nullptr);
+	glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+	a_cPending = 1;
+	++m_uTestedCount;
+}
+void MyOcclusionCuller::InitDevice(void)
+{
+	//the corners of the box are mixed from its minimum and maximum, so one cube serves every box
+	const GLchar* sVertex =
+		"#version 330\n"
+		"uniform mat4 VP;\n"
+		"uniform vec3 Min;\n"
+		"uniform vec3 Max;\n"
+		"in vec3 Position;\n"
+		"void main()\n"
+		"{\n"
+		"	gl_Position = VP * vec4(mix(Min, Max, Position), 1.0);\n"
+		"}\n";
+	const GLchar* sFragment =
+		"#version 330\n"
+		"out vec4 Fragment;\n"
+		"void main()\n"
+		"{\n"
+		"	Fragment = vec4(1.0);\n"
+		"}\n";
+	MyShaderCache* pShaderCache = MyShaderCache::GetInstance();
+	pShaderCache->AddProgram("OcclusionBox", sVertex, sFragment);
+	GLuint uProgram = pShaderCache->GetProgram("OcclusionBox");
+	m_nMin = glGetUniformLocation(uProgram, "Min");
+	m_nMax = glGetUniformLocation(uProgram, "Max");
+	GLint nPosition = glGetAttribLocation(uProgram, "Position");
+
+	//corners by bits (x, y, z), two triangles per face
+	static GLfloat const fCorner[24] = { 0,0,0, 1,0,0, 0,1,0, 1,1,0, 0,0,1, 1,0,1, 0,1,1, 1,1,1 };
+	static GLubyte const uIndex[36] = {
+		0, 2, 1, 1, 2, 3, //-z
+		4, 5, 6, 5, 7, 6, //+z
+		0, 4, 2, 2, 4, 6, //-x
+		1, 3, 5, 3, 7, 5, //+x
+		0, 1, 4, 1, 5, 4, //-y
+		2, 6, 3, 3, 6, 7  //+y
+	};
+	glGenVertexArrays(1, &m_uVAO);
+	glGenBuffers(1, &m_uVBO);
+	glGenBuffers(1, &m_uEBO);
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(fCorner), fCorner, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uEBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uIndex), uIndex, GL_STATIC_DRAW);
+	if (nPosition >= 0)
+	{
+		glEnableVertexAttribArray(nPosition);
+		glVertexAttribPointer(nPosition, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), nullptr);
+	}
+	//the element buffer stays bound to the vertex array
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,200 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYOCCLUSIONCULLER_H_
+#define __MYOCCLUSIONCULLER_H_
+
+#include "MyEntityManager.h"
+#include "MyOctree.h"
+#include "MyShaderCache.h"
+
+#define OCCLUSION_NEAR_MARGIN 1.0f //boxes closer than this to the camera are drawn without a test, the near plane could clip them
+#define OCCLUSION_BOX_GROWTH 0.01f //fraction of its size a box is grown by, so its faces do not fight with the model inside
+
+namespace Simplex
+{
+
+//System Class
+class MyOcclusionCuller
+{
+	bool m_bEnabled = true; //are the hidden entities skipped?
+	MyEntityManager* m_pEntityMngr = nullptr; //entity manager singleton
+
+	std::vector<GLuint> m_lEntityQuery; //query of each entity by index, 0 until it is first tested
+	std::vector<char> m_lEntityPending; //was the query of the entity issued and its result not read yet?
+	std::vector<char> m_lEntityVisible; //did the box of the entity pass its last test?
+	std::vector<char> m_lEntityOctant; //0 if in no octant, 1 if only in hidden octants, 2 if in a visible one
+	std::vector<char> m_lEntityDrawn; //is the entity submitted this frame?
+	std::vector<vector3> m_lEntityMin; //minimum of the ARBB of each entity in the frame being drawn
+	std::vector<vector3> m_lEntityMax; //maximum of the ARBB of each entity in the frame being drawn
+
+	MyOctree* m_pOctree = nullptr; //tree the results of the octants belong to
+	std::vector<GLuint> m_lOctantQuery; //query of each octant that holds entities, in the order of the tree
+	std::vector<char> m_lOctantPending; //was the query of the octant issued and its result not read yet?
+	std::vector<char> m_lOctantVisible; //did the loose bounds of the octant pass their last test?
+	std::vector<char> m_lOctantFilled; //did the octant hold entities in the frame being drawn?
+	std::vector<vector3> m_lOctantMin; //minimum of the loose bounds of each octant
+	std::vector<vector3> m_lOctantMax; //maximum of the loose bounds of each octant
+
+	GLuint m_uVAO = 0; //vertex array of the unit cube, 0 until the first test
+	GLuint m_uVBO = 0; //corners of the unit cube
+	GLuint m_uEBO = 0; //triangles of the unit cube
+	GLint m_nMin = -1; //location of the minimum of the box in the program
+	GLint m_nMax = -1; //location of the maximum of the box in the program
+
+	uint m_uTestedCount = 0; //boxes tested in the last frame, octants included
+	uint m_uCulledCount = 0; //entities skipped this frame
+	uint m_uOctantCulledCount = 0; //octants found hidden this frame
+
+	static MyOcclusionCuller* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyOcclusionCuller* GetInstance();
+	/*
+	Usage: Releases the content of the singleton, from the GL thread if a frame was tested
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Turns the culling on or off, every entity is drawn while it is off
+	ARGUMENTS: bool a_bEnabled -> cull hidden entities?
+	OUTPUT: ---
+	*/
+	void SetEnabled(bool a_bEnabled);
+	/*
+	USAGE: Asks if hidden entities are being culled
+	ARGUMENTS: ---
+	OUTPUT: is it enabled?
+	*/
+	bool IsEnabled(void);
+	/*
+	USAGE: Reads the queries of the last frame that are ready, without waiting for the rest, and decides
+	which entities are drawn; an entity is skipped if every octant it is in was hidden or if its own box
+	was, unless the camera is next to it. The bounds are copied for Render, so the entities can be
+	simulated again while the frame is drawn
+	ARGUMENTS: vector3 a_v3Camera -> position of the camera
+	OUTPUT: ---
+	*/
+	void Update(vector3 a_v3Camera);
+	/*
+	USAGE: Asks if an entity is drawn this frame, true for entities Update has not seen
+	ARGUMENTS: uint a_uIndex -> index of the entity in the entity manager
+	OUTPUT: is it drawn?
+	*/
+	bool IsVisible(uint a_uIndex);
+	/*
+	USAGE: Tests the bounds copied by Update against the depth of the frame just drawn, octants first and
+	then the entities they did not hide; the results are read by the next Update. Color and depth are
+	not written and neither the entities nor the tree are read
+	ARGUMENTS:
+	-	matrix4 a_m4ViewProjection -> projection * view of the camera
+	-	vector3 a_v3Camera -> position of the camera
+	OUTPUT: draw calls made, one per box tested
+	*/
+	uint Render(matrix4 a_m4ViewProjection, vector3 a_v3Camera);
+	/*
+	USAGE: Gets the boxes tested in the last frame, octants included
+	ARGUMENTS: ---
+	OUTPUT: box count
+	*/
+	uint GetTestedCount(void);
+	/*
+	USAGE: Gets the entities skipped this frame
+	ARGUMENTS: ---
+	OUTPUT: entity count
+	*/
+	uint GetCulledCount(void);
+	/*
+	USAGE: Gets the octants found hidden this frame
+	ARGUMENTS: ---
+	OUTPUT: octant count
+	*/
+	uint GetOctantCulledCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyOcclusionCuller(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyOcclusionCuller(MyOcclusionCuller const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyOcclusionCuller& operator=(MyOcclusionCuller const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyOcclusionCuller(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	Usage: creates the unit cube and adds the program to the shader cache
+	Arguments: ---
+	Output: ---
+	*/
+	void InitDevice(void);
+	/*
+	Usage: tests a box, growing it a little so it wins against the model inside
+	Arguments:
+	-	GLuint& a_uQuery -> query of the box, generated if 0
+	-	char& a_cPending -> set while the result is not read
+	-	vector3 a_v3Min -> minimum of the box
+	-	vector3 a_v3Max -> maximum of the box
+	Output: ---
+	*/
+	void TestBox(GLuint& a_uQuery, char& a_cPending, vector3 a_v3Min, vector3 a_v3Max);
+	/*
+	Usage: reads the result of a query if it is ready, the old result stays otherwise
+	Arguments:
+	-	GLuint a_uQuery -> query
+	-	char& a_cPending -> cleared once the result is read
+	-	char& a_cVisible -> gets the result
+	Output: ---
+	*/
+	static void ReadResult(GLuint a_uQuery, char& a_cPending, char& a_cVisible);
+	/*
+	Usage: asks if the camera is inside a box or close enough for the near plane to clip it
+	Arguments:
+	-	vector3 a_v3Min -> minimum of the box
+	-	vector3 a_v3Max -> maximum of the box
+	-	vector3 a_v3Camera -> position of the camera
+	Output: is it near?
+	*/
+	static bool IsNear(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Camera);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYOCCLUSIONCULLER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
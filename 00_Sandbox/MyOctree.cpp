@@ -0,0 +1,938 @@
+#include "MyOctree.h"
+
+using namespace Simplex;
+
+//set some variables for my MyOctree class
+
+uint MyOctree::m_uIdealEntityCount = 5;// ideal number of objects in a given subdivision
+uint MyOctree::m_uOctantCount = 0; //starting number of subdivisions
+uint MyOctree::m_uMaxLevel = 4; //Max number of subdivisions
+float MyOctree::m_fLooseness = 1.0f; //tight bounds, entities go to every leaf they touch
+
+//constructor
+MyOctree::MyOctree(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness)
+{
+	//the children read it when they are created
+	m_fLooseness = std::max(a_fLooseness, 1.0f);
+	Init();
+
+	m_uOctantCount = 0; //at the time of creation there are no octants
+	m_uID = m_uOctantCount;
+	m_uIdealEntityCount = a_nIdealEntityCount;
+	m_uMaxLevel = a_nMaxLevel;
+	
+
+
+	m_pRoot = this; //the first node is the root
+	m_lChild.clear();
+
+	std::vector<vector3> locMinMax;//holds the local min and max values of the objects' bounding boxes
+
+	//get the objects and add their mins and maxes to the locMinMax array to determine if the objects are colliding
+	uint nObjects = m_pEntityMngr->GetEntityCount();
+	for (uint i = 0; i < nObjects; i++) {
+		locMinMax.push_back(m_pEntityMngr->GetMinGlobal(i));
+		locMinMax.push_back(m_pEntityMngr->GetMaxGlobal(i));
+	}
+	MyRigidBody* pRigidBody = new MyRigidBody(locMinMax);
+
+	vector3 v3HalfWidth = pRigidBody->GetHalfWidth();
+	float fMax = v3HalfWidth.x;
+
+	//set the fMax
+	for (uint i = 0; i < 3; i++) {
+		if (fMax < v3HalfWidth[i]) {
+			fMax = v3HalfWidth[i];
+		}
+	}
+	vector3 v3Center = pRigidBody->GetCenterLocal();
+	locMinMax.clear();
+	SafeDelete(pRigidBody);
+
+	//determine size for top level octant
+	m_fSize = 2.0f* fMax;
+	m_v3Center = v3Center;
+	m_v3Max = m_v3Center + vector3(fMax);
+	m_v3Min = m_v3Center - vector3(fMax);
+	ComputeLooseBounds();
+
+	m_uOctantCount++;
+
+	ConstructTree(m_uMaxLevel);
+}
+//contructor
+MyOctree::MyOctree(vector3 a_v3Center, float a_fSize)
+{
+	Init();
+	m_v3Center = a_v3Center;
+	m_fSize = a_fSize;
+
+	m_v3Max = m_v3Center + (vector3(m_fSize) / 2.0f);
+	m_v3Min = m_v3Center - (vector3(m_fSize) / 2.0f);
+	ComputeLooseBounds();
+
+	m_uOctantCount++;
+}
+//copy constructor
+MyOctree::MyOctree(MyOctree const& other)
+{
+	
+	m_v3Center = other.m_v3Center;
+	m_v3Max = other.m_v3Max;
+	m_v3Min = other.m_v3Min;
+	m_v3LooseMin = other.m_v3LooseMin;
+	m_v3LooseMax = other.m_v3LooseMax;
+
+	m_uChildren = other.m_uChildren;
+	m_pParent = other.m_pParent;
+	m_pRoot = other.m_pRoot;
+	m_lChild = other.m_lChild;
+	m_bListed = other.m_bListed;
+	m_lEntityNode = other.m_lEntityNode;
+	m_lEntityLink = other.m_lEntityLink;
+
+	m_fSize = other.m_fSize;
+	m_uID = other.m_uID;
+	m_uLevel = other.m_uLevel;
+
+	m_pDebugDraw = other.m_pDebugDraw;
+	m_pEntityMngr = MyEntityManager::GetInstance();
+
+	for (uint i = 0; i < 8; i++) {
+		m_pChild[i] = other.m_pChild[i];
+	}
+}
+//assignement override contstructor
+MyOctree& MyOctree::operator=(MyOctree const& other)
+{
+	//if the object is not the current Octree
+	if (this != &other) {
+		Release();
+		Init();
+		MyOctree temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+//destructor
+MyOctree::~MyOctree(void)
+{
+	Release();
+}
+//swaps octree with passed in octree
+void MyOctree::Swap(MyOctree& other)
+{
+	//copy over MyOctree info from other into new
+	std::swap(m_lChild, other.m_lChild);
+	std::swap(m_bListed, other.m_bListed);
+	std::swap(m_lEntityNode, other.m_lEntityNode);
+	std::swap(m_lEntityLink, other.m_lEntityLink);
+	std::swap(m_uChildren, other.m_uChildren);
+	//swap children
+	for (uint i = 0; i < 8; i++) {
+		std::swap(m_pChild[i], other.m_pChild[i]);
+	}
+
+	std::swap(m_uLevel, other.m_uLevel);
+	std::swap(m_pParent, other.m_pParent);
+
+	std::swap(m_v3Center, other.m_v3Center);
+	std::swap(m_v3Min, other.m_v3Min);
+	std::swap(m_v3Max, other.m_v3Max);
+	std::swap(m_v3LooseMin, other.m_v3LooseMin);
+	std::swap(m_v3LooseMax, other.m_v3LooseMax);
+
+	std::swap(m_uID, other.m_uID);
+	std::swap(m_pRoot, other.m_pRoot);
+	std::swap(m_fSize, other.m_fSize);
+
+	//swap managers
+	std::swap(m_pDebugDraw, other.m_pDebugDraw);
+	m_pEntityMngr = MyEntityManager::GetInstance();
+}
+//gets size
+float MyOctree::GetSize(void)
+{
+	return m_fSize;
+}
+//gets centerpoint
+vector3 MyOctree::GetCenterGlobal(void)
+{
+	return m_v3Center;
+}
+//gets min of octant in global space
+vector3 MyOctree::GetMinGlobal(void)
+{
+	return m_v3Min;
+}
+//gets max of octant in global space
+vector3 MyOctree::GetMaxGlobal(void)
+{
+	return m_v3Max;
+}
+//returns true if the object with the given index is in the current octant
+bool MyOctree::IsColliding(uint a_uRBIndex)
+{
+	uint numObjs = m_pEntityMngr->GetEntityCount();
+
+	if (a_uRBIndex >= numObjs)
+		return false;//there aren't enough objects for there to be a collision
+
+	//the bounds component is kept by the manager, no need to go through the entity
+	vector3 v3EntityMin = m_pEntityMngr->GetMinGlobal(a_uRBIndex);
+	vector3 v3EntityMax = m_pEntityMngr->GetMaxGlobal(a_uRBIndex);
+
+	//check for x collisions
+	if (m_v3Max.x < v3EntityMin.x) {
+		return false;
+	}
+	if (m_v3Min.x > v3EntityMax.x) {
+		return false;
+	}
+	
+
+	//check for y collisions
+	if (m_v3Max.y < v3EntityMin.y) {
+		return false;
+	}
+	if (m_v3Min.y > v3EntityMax.y) {
+		return false;
+	}
+	
+
+	//check for z collisions
+	
+	if (m_v3Max.z < v3EntityMin.z) {
+		return false;
+	}
+	if (m_v3Min.z > v3EntityMax.z) {
+		return false;
+	}
+
+	//all negative checks failed, so there is a collision
+	return true;
+}
+//displays the octant bounds
+void MyOctree::Display(uint a_nIndex, vector3 a_v3Color)
+{
+	if (m_pDebugDraw == nullptr)
+		m_pDebugDraw = MyDebugDraw::GetInstance();
+	if (m_uID == a_nIndex) {
+		m_pDebugDraw->AddBox(glm::translate(IDENTITY_M4, m_v3Center)* glm::scale(vector3(m_fSize)), a_v3Color);
+		return;
+	}
+	for (uint i = 0; i < m_uChildren; i++) {
+		m_pChild[i]->Display(a_nIndex);
+	}
+}
+//displays the octant bounds
+void MyOctree::Display(vector3 a_v3Color)
+{
+	if (m_pDebugDraw == nullptr)
+		m_pDebugDraw = MyDebugDraw::GetInstance();
+	for (uint i = 0; i < m_uChildren; i++) {
+		m_pChild[i]->Display(a_v3Color);
+	}
+	m_pDebugDraw->AddBox(glm::translate(IDENTITY_M4, m_v3Center) * glm::scale(vector3(m_fSize)), a_v3Color);
+}
+//displays octant leaves
+void MyOctree::DisplayLeafs(vector3 a_v3Color)
+{
+	if (m_pDebugDraw == nullptr)
+		m_pDebugDraw = MyDebugDraw::GetInstance();
+	//loops through each child in lChild and renders it
+	uint nLeaves = m_lChild.size();
+	for (uint i = 0; i < nLeaves; i++) {
+		m_lChild[i]->DisplayLeafs(a_v3Color);
+	}
+	m_pDebugDraw->AddBox(glm::translate(IDENTITY_M4, m_v3Center) * glm::scale(vector3(m_fSize)), a_v3Color);
+
+}
+
+void MyOctree::ClearEntityList(void)
+{
+	//calls clearEntityList for each child in the list of children
+	for (uint i = 0; i < m_uChildren; i++) {
+		m_pChild[i]->ClearEntityList();
+	}
+	m_EntityList.clear();
+}
+//function which subdivides the octants based on how many entities are containted within it
+void MyOctree::Subdivide(void)
+{
+	if (m_uLevel >= m_uMaxLevel) {
+		return;//subdivision has already reached bottom of tree
+	}
+	if (m_uChildren != 0) {
+		return;//subdivision doesn't need to be divided
+	}
+
+	m_uChildren = 8; //since this is an octree it will always have 8 children
+
+	float fNewSize = m_fSize / 4.0f;
+	float fDoubleNewSize = fNewSize * 2.0f;
+	vector3 v3NewCenter;
+
+	//the 8 subdivisions that are created
+	//subdivision 1 Bottom Left Back
+	v3NewCenter = m_v3Center;
+	v3NewCenter.x -= fNewSize;
+	v3NewCenter.y -= fNewSize;
+	v3NewCenter.z -= fNewSize;
+	m_pChild[0] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//subdivision 2 Bottom Right Back
+	v3NewCenter.x += fDoubleNewSize;
+	m_pChild[1] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//subdivision 3 Bottom Right Front
+	v3NewCenter.z += fDoubleNewSize;
+	m_pChild[2] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//subdivision 4 Bottom Left Front
+	v3NewCenter.x -= fDoubleNewSize;
+	m_pChild[3] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//subdivision 5 Top Left Front
+	v3NewCenter.y += fDoubleNewSize;
+	m_pChild[4] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//subdivision 6 Top Left Back
+	v3NewCenter.z -= fDoubleNewSize;
+	m_pChild[5] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//subdivision 7 Top Right Back
+	v3NewCenter.x += fDoubleNewSize;
+	m_pChild[6] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//subdivision 7 Top Right Front
+	v3NewCenter.z += fDoubleNewSize;
+	m_pChild[7] = new MyOctree(v3NewCenter, fDoubleNewSize);
+
+	//pass info to the children and further subdivide if necessary
+	for (uint i = 0; i < 8; i++) {
+		m_pChild[i]->m_pRoot = m_pRoot;
+		m_pChild[i]->m_pParent = this;
+		m_pChild[i]->m_uLevel = m_uLevel + 1;
+		if (m_pChild[i]->ContainsMoreThan(m_uIdealEntityCount)) {
+			m_pChild[i]->Subdivide();
+		}
+	}
+}
+//gets the children of the octant
+MyOctree* MyOctree::GetChild(uint a_nChild)
+{
+	if (a_nChild > 7) {
+		return nullptr;
+	}
+	return m_pChild[a_nChild];
+}
+//gets the parent of the octant
+MyOctree* MyOctree::GetParent(void)
+{
+	return m_pParent;
+}
+//determines if octant is a leaf
+bool MyOctree::IsLeaf(void)
+{
+	if (m_uChildren == 0) return true;
+	else return false;
+}
+//returns true if the current octain contains more than the current perfered number of entities
+bool MyOctree::ContainsMoreThan(uint a_nEntities)
+{
+	uint currCount = 0;//count of objects in current octant
+	uint objectCount = m_pEntityMngr->GetEntityCount();
+	for (uint i = 0; i < objectCount; i++) {
+		if (IsColliding(i))//if the number of objects in the octant is greater than the number passed in, return true
+			currCount++;
+		if (currCount > a_nEntities)
+			return true;
+	}
+	return false;
+}
+//deletes all children
+void MyOctree::KillBranches(void)
+{
+	//recursivley loops through the children up the tree as each set of children is set to nullptr
+	for (uint i = 0; i < m_uChildren; i++) {
+		m_pChild[i]->KillBranches();
+		delete m_pChild[i];
+		m_pChild[i] = nullptr;
+	}
+	m_uChildren = 0;
+}
+//contructs the tree for the octree
+void MyOctree::ConstructTree(uint a_nMaxLevel)
+{
+	if (m_uLevel != 0)
+		return;
+
+	//set basic info
+	m_uMaxLevel = a_nMaxLevel;
+	m_uOctantCount = 1;
+
+	//clear tree incase there is previous data
+	m_EntityList.clear();
+	KillBranches();
+	m_lChild.clear();
+	m_bListed = false;
+	m_lEntityNode.clear();
+	m_lEntityLink.clear();
+
+	//if it needs to subdivide, do so
+	if (ContainsMoreThan(m_uIdealEntityCount)) {
+		Subdivide();
+	}
+
+	//assign container ID and create list
+	AssignIDtoEntity();
+	ConstructList();
+}
+//assigns an id to each entity based on the current octant it's in
+void MyOctree::AssignIDtoEntity(void)
+{
+	//a loose tree stores each entity once, from the root down
+	if (IsLoose())
+	{
+		if (m_pRoot != this)
+			return;
+		uint numEntities = m_pEntityMngr->GetEntityCount();
+		for (uint i = 0; i < numEntities; i++) {
+			FindLooseOctant(m_pEntityMngr->GetMinGlobal(i), m_pEntityMngr->GetMaxGlobal(i))->LinkEntity(i);
+		}
+		return;
+	}
+	for (uint i = 0; i < m_uChildren; i++) {
+		m_pChild[i]->AssignIDtoEntity();
+	}
+	//if you reach a leaf
+	if (m_uChildren == 0) {
+		uint numEntities = m_pEntityMngr->GetEntityCount();
+		for (uint i = 0; i < numEntities; i++) {
+			if (IsColliding(i)) {
+				//handles stay valid if other entities are removed before the tree is rebuilt
+				m_EntityList.push_back(m_pEntityMngr->GetEntityHandle(i));
+				m_pEntityMngr->AddDimension(i, m_uID);
+			}
+		}
+	}
+}
+//gets the number of octants
+uint MyOctree::GetOctantCount(void)
+{
+	return m_uOctantCount;
+}
+//casts a ray through the tree, nearest octants first
+bool MyOctree::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, MyRayHit& a_Hit)
+{
+	vector3 v3InverseDirection = 1.0f / a_v3Direction;
+	float fEnter = 0.0f;
+	float fExit = 0.0f;
+	if (!MyEntityManager::IntersectSlabs(a_v3Origin, v3InverseDirection, m_v3LooseMin, m_v3LooseMax, fEnter, fExit) ||
+		fEnter > a_fMaxDistance)
+		return false;
+
+	//each octant goes in with the distance the ray enters it
+	MyOctree* pStack[OCTREE_STACK_SIZE];
+	float fStack[OCTREE_STACK_SIZE];
+	uint uTop = 0;
+	pStack[uTop] = this;
+	fStack[uTop] = fEnter;
+	++uTop;
+
+	float fBest = a_fMaxDistance;
+	float fDistance = 0.0f;
+	vector3 v3Normal = ZERO_V3;
+	bool bHit = false;
+	while (uTop > 0)
+	{
+		--uTop;
+		MyOctree* pNode = pStack[uTop];
+		//the rest of the octant is behind the nearest hit
+		if (fStack[uTop] > fBest)
+			continue;
+
+		//an entity spans every leaf it touches, unless the tree is loose it can be tested more than once
+		for (uint i = 0; i < pNode->m_EntityList.size(); ++i)
+		{
+			int nIndex = m_pEntityMngr->GetEntityIndex(pNode->m_EntityList[i]);
+			if (nIndex < 0 || !m_pEntityMngr->IntersectRay(static_cast<uint>(nIndex), a_v3Origin, a_v3Direction, fBest, fDistance, v3Normal))
+				continue;
+			if (bHit && fDistance >= fBest)
+				continue;
+			fBest = fDistance;
+			a_Hit.m_nIndex = nIndex;
+			a_Hit.m_fDistance = fDistance;
+			a_Hit.m_v3Normal = v3Normal;
+			bHit = true;
+		}
+
+		//the children that are hit, sorted far to near so the nearest is popped first
+		MyOctree* pChild[8];
+		float fChild[8];
+		uint uHit = 0;
+		for (uint i = 0; i < pNode->m_uChildren; ++i)
+		{
+			MyOctree* pOctant = pNode->m_pChild[i];
+			if (!MyEntityManager::IntersectSlabs(a_v3Origin, v3InverseDirection, pOctant->m_v3LooseMin, pOctant->m_v3LooseMax, fEnter, fExit) ||
+				fEnter > fBest)
+				continue;
+			uint uSlot = uHit++;
+			while (uSlot > 0 && fChild[uSlot - 1] < fEnter)
+			{
+				pChild[uSlot] = pChild[uSlot - 1];
+				fChild[uSlot] = fChild[uSlot - 1];
+				--uSlot;
+			}
+			pChild[uSlot] = pOctant;
+			fChild[uSlot] = fEnter;
+		}
+		for (uint i = 0; i < uHit && uTop < OCTREE_STACK_SIZE; ++i)
+		{
+			pStack[uTop] = pChild[i];
+			fStack[uTop] = fChild[i];
+			++uTop;
+		}
+	}
+	return bHit;
+}
+//finds the entities overlapping a box
+uint MyOctree::QueryBox(vector3 a_v3Min, vector3 a_v3Max, uint* a_pResult, uint a_uCapacity)
+{
+	MyOctree* pStack[OCTREE_STACK_SIZE];
+	uint uTop = 0;
+	pStack[uTop++] = this;
+
+	//a loose tree stores each entity once, there is nothing to filter
+	bool bLoose = IsLoose();
+	uint uFound = 0;
+	while (uTop > 0)
+	{
+		MyOctree* pNode = pStack[--uTop];
+		if (glm::any(glm::lessThan(a_v3Max, pNode->m_v3LooseMin)) || glm::any(glm::greaterThan(a_v3Min, pNode->m_v3LooseMax)))
+			continue;
+
+		for (uint i = 0; i < pNode->m_EntityList.size(); ++i)
+		{
+			int nIndex = m_pEntityMngr->GetEntityIndex(pNode->m_EntityList[i]);
+			if (nIndex < 0)
+				continue;
+			vector3 v3Min = m_pEntityMngr->GetMinGlobal(nIndex);
+			vector3 v3Max = m_pEntityMngr->GetMaxGlobal(nIndex);
+			if (glm::any(glm::lessThan(a_v3Max, v3Min)) || glm::any(glm::greaterThan(a_v3Min, v3Max)))
+				continue;
+			//the minimum of the overlap is in exactly one of the octants that list the entity
+			if (!bLoose && !pNode->OwnsPoint(glm::max(a_v3Min, v3Min)))
+				continue;
+			if (uFound < a_uCapacity)
+				a_pResult[uFound] = static_cast<uint>(nIndex);
+			++uFound;
+		}
+
+		for (uint i = 0; i < pNode->m_uChildren && uTop < OCTREE_STACK_SIZE; ++i)
+			pStack[uTop++] = pNode->m_pChild[i];
+	}
+	return uFound;
+}
+//finds the entities overlapping a sphere
+uint MyOctree::QuerySphere(vector3 a_v3Center, float a_fRadius, uint* a_pResult, uint a_uCapacity)
+{
+	MyOctree* pStack[OCTREE_STACK_SIZE];
+	uint uTop = 0;
+	pStack[uTop++] = this;
+
+	float fRadiusSquared = a_fRadius * a_fRadius;
+	//a loose tree stores each entity once, there is nothing to filter
+	bool bLoose = IsLoose();
+	uint uFound = 0;
+	while (uTop > 0)
+	{
+		MyOctree* pNode = pStack[--uTop];
+		if (DistanceSquared(a_v3Center, pNode->m_v3LooseMin, pNode->m_v3LooseMax) > fRadiusSquared)
+			continue;
+
+		for (uint i = 0; i < pNode->m_EntityList.size(); ++i)
+		{
+			int nIndex = m_pEntityMngr->GetEntityIndex(pNode->m_EntityList[i]);
+			if (nIndex < 0)
+				continue;
+			vector3 v3Min = m_pEntityMngr->GetMinGlobal(nIndex);
+			vector3 v3Max = m_pEntityMngr->GetMaxGlobal(nIndex);
+			if (DistanceSquared(a_v3Center, v3Min, v3Max) > fRadiusSquared)
+				continue;
+			//the point of the ARBB nearest to the center is in exactly one of the octants that list the entity
+			if (!bLoose && !pNode->OwnsPoint(glm::clamp(a_v3Center, v3Min, v3Max)))
+				continue;
+			if (uFound < a_uCapacity)
+				a_pResult[uFound] = static_cast<uint>(nIndex);
+			++uFound;
+		}
+
+		for (uint i = 0; i < pNode->m_uChildren && uTop < OCTREE_STACK_SIZE; ++i)
+			pStack[uTop++] = pNode->m_pChild[i];
+	}
+	return uFound;
+}
+//finds the entities nearest to a point
+uint MyOctree::QueryNearest(vector3 a_v3Point, uint a_uCount, uint* a_pResult, float* a_pDistance)
+{
+	if (a_uCount == 0)
+		return 0;
+
+	//each octant goes in with its squared distance to the point
+	MyOctree* pStack[OCTREE_STACK_SIZE];
+	float fStack[OCTREE_STACK_SIZE];
+	uint uTop = 0;
+	pStack[uTop] = this;
+	fStack[uTop] = DistanceSquared(a_v3Point, m_v3LooseMin, m_v3LooseMax);
+	++uTop;
+
+	//the buffers hold the entities kept so far sorted by squared distance
+	uint uFound = 0;
+	while (uTop > 0)
+	{
+		--uTop;
+		MyOctree* pNode = pStack[uTop];
+		if (uFound == a_uCount && fStack[uTop] >= a_pDistance[uFound - 1])
+			continue;
+
+		for (uint i = 0; i < pNode->m_EntityList.size(); ++i)
+		{
+			int nIndex = m_pEntityMngr->GetEntityIndex(pNode->m_EntityList[i]);
+			if (nIndex < 0)
+				continue;
+			float fDistance = DistanceSquared(a_v3Point, m_pEntityMngr->GetMinGlobal(nIndex), m_pEntityMngr->GetMaxGlobal(nIndex));
+			if (uFound == a_uCount && fDistance >= a_pDistance[uFound - 1])
+				continue;
+			//an entity spanning several octants is met again, the kept list is short enough to scan
+			bool bKept = false;
+			for (uint j = 0; j < uFound && !bKept; ++j)
+				bKept = a_pResult[j] == static_cast<uint>(nIndex);
+			if (bKept)
+				continue;
+
+			uint uSlot = uFound < a_uCount ? uFound++ : a_uCount - 1;
+			while (uSlot > 0 && a_pDistance[uSlot - 1] > fDistance)
+			{
+				a_pResult[uSlot] = a_pResult[uSlot - 1];
+				a_pDistance[uSlot] = a_pDistance[uSlot - 1];
+				--uSlot;
+			}
+			a_pResult[uSlot] = static_cast<uint>(nIndex);
+			a_pDistance[uSlot] = fDistance;
+		}
+
+		//the children sorted far to near so the nearest is popped first
+		MyOctree* pChild[8];
+		float fChild[8];
+		uint uNear = 0;
+		for (uint i = 0; i < pNode->m_uChildren; ++i)
+		{
+			MyOctree* pOctant = pNode->m_pChild[i];
+			float fDistance = DistanceSquared(a_v3Point, pOctant->m_v3LooseMin, pOctant->m_v3LooseMax);
+			if (uFound == a_uCount && fDistance >= a_pDistance[uFound - 1])
+				continue;
+			uint uSlot = uNear++;
+			while (uSlot > 0 && fChild[uSlot - 1] < fDistance)
+			{
+				pChild[uSlot] = pChild[uSlot - 1];
+				fChild[uSlot] = fChild[uSlot - 1];
+				--uSlot;
+			}
+			pChild[uSlot] = pOctant;
+			fChild[uSlot] = fDistance;
+		}
+		for (uint i = 0; i < uNear && uTop < OCTREE_STACK_SIZE; ++i)
+		{
+			pStack[uTop] = pChild[i];
+			fStack[uTop] = fChild[i];
+			++uTop;
+		}
+	}
+
+	for (uint i = 0; i < uFound; ++i)
+		a_pDistance[i] = std::sqrt(a_pDistance[i]);
+	return uFound;
+}
+//asks if the point descends to this octant, the same way from the root for every octant
+bool MyOctree::OwnsPoint(vector3 a_v3Point)
+{
+	//sides of the centers, not the bounds, so rounding can not give a point to two siblings or none
+	MyOctree* pNode = this;
+	while (pNode->m_pParent != nullptr)
+	{
+		MyOctree* pParent = pNode->m_pParent;
+		for (uint i = 0; i < 3; ++i)
+		{
+			if ((pNode->m_v3Center[i] > pParent->m_v3Center[i]) != (a_v3Point[i] >= pParent->m_v3Center[i]))
+				return false;
+		}
+		pNode = pParent;
+	}
+	return true;
+}
+//squared distance from a point to a box
+float MyOctree::DistanceSquared(vector3 a_v3Point, vector3 a_v3Min, vector3 a_v3Max)
+{
+	vector3 v3Offset = a_v3Point - glm::clamp(a_v3Point, a_v3Min, a_v3Max);
+	return glm::dot(v3Offset, v3Offset);
+}
+//true if the entities are stored once in loose octants
+bool MyOctree::IsLoose(void)
+{
+	return m_fLooseness > 1.0f;
+}
+uint MyOctree::GetNodeCount(void)
+{
+	return static_cast<uint>(m_pRoot->m_lChild.size());
+}
+MyOctree* MyOctree::GetNode(uint a_uIndex)
+{
+	std::vector<MyOctree*>& lNode = m_pRoot->m_lChild;
+	if (a_uIndex >= lNode.size())
+		return nullptr;
+	return lNode[a_uIndex];
+}
+std::vector<MyHandle> const& MyOctree::GetEntityList(void)
+{
+	return m_EntityList;
+}
+vector3 MyOctree::GetLooseMinGlobal(void)
+{
+	return m_v3LooseMin;
+}
+vector3 MyOctree::GetLooseMaxGlobal(void)
+{
+	return m_v3LooseMax;
+}
+//pairs each entity with the ones of the octants its bounds reach
+void MyOctree::GetPairs(std::vector<uint>& a_lPair)
+{
+	MyOctree* pStack[OCTREE_STACK_SIZE];
+	std::vector<MyOctree*>& lNode = m_pRoot->m_lChild;
+	for (uint uNode = 0; uNode < lNode.size(); ++uNode)
+	{
+		std::vector<MyHandle>& lEntity = lNode[uNode]->m_EntityList;
+		for (uint i = 0; i < lEntity.size(); ++i)
+		{
+			int nIndex = m_pEntityMngr->GetEntityIndex(lEntity[i]);
+			if (nIndex < 0)
+				continue;
+			vector3 v3Min = m_pEntityMngr->GetMinGlobal(nIndex);
+			vector3 v3Max = m_pEntityMngr->GetMaxGlobal(nIndex);
+
+			//the loose bounds of siblings overlap, so besides its own octant and the ones above it an
+			//entity can touch the ones next to it; the pair is kept by the entity with the lower index
+			uint uTop = 0;
+			pStack[uTop++] = m_pRoot;
+			while (uTop > 0)
+			{
+				MyOctree* pOctant = pStack[--uTop];
+				if (glm::any(glm::lessThan(v3Max, pOctant->m_v3LooseMin)) || glm::any(glm::greaterThan(v3Min, pOctant->m_v3LooseMax)))
+					continue;
+				for (uint j = 0; j < pOctant->m_EntityList.size(); ++j)
+				{
+					int nOther = m_pEntityMngr->GetEntityIndex(pOctant->m_EntityList[j]);
+					if (nOther <= nIndex)
+						continue;
+					a_lPair.push_back(static_cast<uint>(nIndex));
+					a_lPair.push_back(static_cast<uint>(nOther));
+				}
+				for (uint j = 0; j < pOctant->m_uChildren && uTop < OCTREE_STACK_SIZE; ++j)
+					pStack[uTop++] = pOctant->m_pChild[j];
+			}
+		}
+	}
+}
+//moves an entity to the octant it fits in now
+void MyOctree::Relink(uint a_uIndex)
+{
+	if (!IsLoose() || a_uIndex >= m_pEntityMngr->GetEntityCount())
+		return;
+
+	vector3 v3Min = m_pEntityMngr->GetMinGlobal(a_uIndex);
+	vector3 v3Max = m_pEntityMngr->GetMaxGlobal(a_uIndex);
+	MyHandle handle = m_pEntityMngr->GetEntityHandle(a_uIndex);
+	std::vector<MyOctree*>& lEntityNode = m_pRoot->m_lEntityNode;
+	MyOctree* pNode = handle.m_uSlot < lEntityNode.size() ? lEntityNode[handle.m_uSlot] : nullptr;
+	//a slot reused by another entity still points at the octant of the one that was removed
+	if (pNode != nullptr && m_pRoot->m_lEntityLink[handle.m_uSlot] != handle)
+	{
+		pNode->UnlinkEntity(m_pRoot->m_lEntityLink[handle.m_uSlot]);
+		pNode = nullptr;
+	}
+	if (pNode == nullptr)
+	{
+		m_pRoot->FindLooseOctant(v3Min, v3Max)->LinkEntity(a_uIndex);
+		return;
+	}
+
+	//up to the first octant it still fits in, the root takes anything, then down as deep as it goes
+	MyOctree* pTarget = pNode;
+	while (pTarget != m_pRoot && !pTarget->FitsLoose(v3Min, v3Max))
+		pTarget = pTarget->m_pParent;
+	pTarget = pTarget->FindLooseOctant(v3Min, v3Max);
+	if (pTarget == pNode)
+		return;
+	pNode->UnlinkEntity(handle);
+	pTarget->LinkEntity(a_uIndex);
+}
+//links a batch of new entities
+void MyOctree::InsertEntities(uint a_uFirst, uint a_uCount)
+{
+	if (!IsLoose() || a_uFirst >= m_pEntityMngr->GetEntityCount())
+		return;
+	uint uEnd = std::min(a_uFirst + a_uCount, m_pEntityMngr->GetEntityCount());
+
+	//the slot lists grow once for the whole batch instead of once per new slot
+	uint uSlotCount = static_cast<uint>(m_pRoot->m_lEntityNode.size());
+	for (uint i = a_uFirst; i < uEnd; ++i)
+		uSlotCount = std::max(uSlotCount, m_pEntityMngr->GetEntityHandle(i).m_uSlot + 1);
+	m_pRoot->m_lEntityNode.resize(uSlotCount, nullptr);
+	m_pRoot->m_lEntityLink.resize(uSlotCount);
+
+	//a reused slot can still point at the octant of a removed entity, relinking takes care of it
+	for (uint i = a_uFirst; i < uEnd; ++i)
+		Relink(i);
+}
+//takes a removed entity out of its octant
+void MyOctree::RemoveEntity(MyHandle a_Handle)
+{
+	if (!IsLoose())
+		return;
+	std::vector<MyOctree*>& lEntityNode = m_pRoot->m_lEntityNode;
+	if (a_Handle.m_uSlot >= lEntityNode.size() || lEntityNode[a_Handle.m_uSlot] == nullptr)
+		return;
+	if (m_pRoot->m_lEntityLink[a_Handle.m_uSlot] == a_Handle)
+		lEntityNode[a_Handle.m_uSlot]->UnlinkEntity(a_Handle);
+}
+//loose bounds from the center and the size
+void MyOctree::ComputeLooseBounds(void)
+{
+	vector3 v3HalfWidth = (m_v3Max - m_v3Min) * 0.5f * m_fLooseness;
+	m_v3LooseMin = m_v3Center - v3HalfWidth;
+	m_v3LooseMax = m_v3Center + v3HalfWidth;
+}
+//true if the box is inside the loose bounds
+bool MyOctree::FitsLoose(vector3 a_v3Min, vector3 a_v3Max)
+{
+	return glm::all(glm::greaterThanEqual(a_v3Min, m_v3LooseMin)) && glm::all(glm::lessThanEqual(a_v3Max, m_v3LooseMax));
+}
+//deepest octant whose loose bounds contain the box
+MyOctree* MyOctree::FindLooseOctant(vector3 a_v3Min, vector3 a_v3Max)
+{
+	//the child holding the center has the most room around the box, if it does not fit none does
+	vector3 v3Center = (a_v3Min + a_v3Max) * 0.5f;
+	MyOctree* pNode = this;
+	while (pNode->m_uChildren > 0)
+	{
+		MyOctree* pNext = nullptr;
+		for (uint i = 0; i < pNode->m_uChildren && pNext == nullptr; ++i)
+		{
+			MyOctree* pChild = pNode->m_pChild[i];
+			if ((pChild->m_v3Center.x > pNode->m_v3Center.x) == (v3Center.x >= pNode->m_v3Center.x) &&
+				(pChild->m_v3Center.y > pNode->m_v3Center.y) == (v3Center.y >= pNode->m_v3Center.y) &&
+				(pChild->m_v3Center.z > pNode->m_v3Center.z) == (v3Center.z >= pNode->m_v3Center.z))
+				pNext = pChild;
+		}
+		if (pNext == nullptr || !pNext->FitsLoose(a_v3Min, a_v3Max))
+			break;
+		pNode = pNext;
+	}
+	return pNode;
+}
+//stores an entity in this octant
+void MyOctree::LinkEntity(uint a_uIndex)
+{
+	MyHandle handle = m_pEntityMngr->GetEntityHandle(a_uIndex);
+	//no dimension is added, the pairs come from the tree and the dimensions stay free for other filters
+	m_EntityList.push_back(handle);
+
+	std::vector<MyOctree*>& lEntityNode = m_pRoot->m_lEntityNode;
+	std::vector<MyHandle>& lEntityLink = m_pRoot->m_lEntityLink;
+	if (handle.m_uSlot >= lEntityNode.size())
+	{
+		lEntityNode.resize(handle.m_uSlot + 1, nullptr);
+		lEntityLink.resize(handle.m_uSlot + 1);
+	}
+	lEntityNode[handle.m_uSlot] = this;
+	lEntityLink[handle.m_uSlot] = handle;
+
+	if (!m_bListed)
+	{
+		m_pRoot->m_lChild.push_back(this);
+		m_bListed = true;
+	}
+}
+//removes an entity from this octant
+void MyOctree::UnlinkEntity(MyHandle a_Handle)
+{
+	for (uint i = 0; i < m_EntityList.size(); ++i)
+	{
+		if (m_EntityList[i] != a_Handle)
+			continue;
+		m_EntityList[i] = m_EntityList.back();
+		m_EntityList.pop_back();
+		break;
+	}
+	m_pRoot->m_lEntityNode[a_Handle.m_uSlot] = nullptr;
+}
+//removes all data from the octree
+void MyOctree::Release(void)
+{
+	//root release
+	if (m_uLevel == 0) {
+		KillBranches();
+	}
+	m_uChildren = 0;
+	m_fSize = 0.0f;
+	m_EntityList.clear();
+	m_lChild.clear();
+	m_bListed = false;
+	m_lEntityNode.clear();
+	m_lEntityLink.clear();
+}
+
+//sets initial values of MyOctree
+void MyOctree::Init(void)
+{
+	m_uChildren = 0; //no children
+	m_fSize = 0.0f; //initial size  = 0
+
+	m_uID = m_uOctantCount; //the id of the first octant is 0
+	m_uLevel = 0; //no subdivisions, so level is 0
+
+	//no max.min/center values have been added
+	m_v3Center = vector3(0.0f);
+	m_v3Max = vector3(0.0f);
+	m_v3Min = vector3(0.0f);
+	m_v3LooseMax = vector3(0.0f);
+	m_v3LooseMin = vector3(0.0f);
+	m_bListed = false;
+
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	//the debug draw is fetched the first time the octree is displayed
+	m_pDebugDraw = nullptr;
+	
+
+	m_pRoot = nullptr;
+	m_pParent = nullptr;
+
+	//parent node has 8 subdivisions, create the children
+	for (uint i = 0; i < 8; i++) {
+		m_pChild[i] = nullptr;
+	}
+
+}
+//adds children to each of the non-leaf octants
+void MyOctree::ConstructList(void)
+{
+	for (uint i = 0; i < m_uChildren; i++) {
+		m_pChild[i]->ConstructList();
+	}
+	if(m_EntityList.size() > 0 && !m_bListed) {
+		m_pRoot->m_lChild.push_back(this);
+		m_bListed = true;
+	}
+}
@@ -0,0 +1,414 @@
+#pragma once
+
+/*----------------------------------------------
+Based on Octant.h code created by Alberto Bobadilla
+----------------------------------------------*/
+#ifndef __MYOCTREECLASS_H_
+#define __MYOCTREECLASS_H_
+
+#include "MyEntityManager.h"
+
+#define OCTREE_STACK_SIZE 256 //octants a query can have pending, 7 per level plus one is enough past 30 levels
+
+namespace Simplex
+{
+
+	//System Class
+	class MyOctree
+	{
+		static uint m_uOctantCount; //will store the number of octants instantiated
+		static uint m_uMaxLevel;//will store the maximum level an octant can go to
+		static uint m_uIdealEntityCount; //will tell how many ideal Entities this object will contain
+		static float m_fLooseness; //loose bounds are the bounds scaled by this, 1 keeps the entities in the leafs
+
+		uint m_uID = 0; //Will store the current ID for this octant
+		uint m_uLevel = 0; //Will store the current level of the octant
+		uint m_uChildren = 0;// Number of children on the octant (either 0 or 8)
+
+		float m_fSize = 0.0f; //Size of the octant
+
+		
+		MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager Singleton
+		MyDebugDraw* m_pDebugDraw = nullptr;//Debug draw singleton, for displaying the octants
+
+		vector3 m_v3Center = vector3(0.0f); //Will store the center point of the octant
+		vector3 m_v3Min = vector3(0.0f); //Will store the minimum vector of the octant
+		vector3 m_v3Max = vector3(0.0f); //Will store the maximum vector of the octant
+		vector3 m_v3LooseMin = vector3(0.0f); //minimum of the loose bounds, an entity stored here fits in them
+		vector3 m_v3LooseMax = vector3(0.0f); //maximum of the loose bounds
+
+		MyOctree* m_pParent = nullptr;// Will store the parent of current octant
+		MyOctree* m_pChild[8];//Will store the children of the current octant
+
+		std::vector<MyHandle> m_EntityList; //List of Entities under this octant (Handle in Entity Manager)
+
+		MyOctree* m_pRoot = nullptr;//Root octant
+		std::vector<MyOctree*> m_lChild; //list of nodes that contain objects (this will be applied to root only)
+		bool m_bListed = false; //is the octant in the list of nodes that contain objects?
+		std::vector<MyOctree*> m_lEntityNode; //loose mode, octant of each entity by slot of its handle (root only)
+		std::vector<MyHandle> m_lEntityLink; //loose mode, handle each slot of m_lEntityNode was linked with (root only)
+
+	public:
+		/*
+		USAGE: Constructor, will create an octant containing all MagnaEntities Instances in the Mesh
+		manager	currently contains
+		ARGUMENTS:
+		- uint a_nMaxLevel = 2 -> Sets the maximum level of subdivision
+		- uint nIdealEntityCount = 5 -> Sets the ideal level of objects per octant
+		- float a_fLooseness = 1.0f -> Scale of the loose bounds, above 1 each entity is stored once in the
+		deepest octant whose loose bounds contain it instead of in every leaf it touches
+		OUTPUT: class object
+		*/
+		MyOctree(uint a_nMaxLevel = 1, uint a_nIdealEntityCount = 5, float a_fLooseness = 1.0f);
+		/*
+		USAGE: Constructor
+		ARGUMENTS:
+		- vector3 a_v3Center -> Center of the octant in global space
+		- float a_fSize -> size of each side of the octant volume
+		OUTPUT: class object
+		*/
+		MyOctree(vector3 a_v3Center, float a_fSize);
+		/*
+		USAGE: Copy Constructor
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyOctree(MyOctree const& other);
+		/*
+		USAGE: Copy Assignment Operator
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyOctree& operator=(MyOctree const& other);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyOctree(void);
+		/*
+		USAGE: Changes object contents for other object's
+		ARGUMENTS:
+		- MyOctree& other -> object to swap content from
+		OUTPUT: ---
+		*/
+		void Swap(MyOctree& other);
+		/*
+		USAGE: Gets this octant's size
+		ARGUMENTS: ---
+		OUTPUT: size of octant
+		*/
+		float GetSize(void);
+		/*
+		USAGE: Gets the center of the octant in global scape
+		ARGUMENTS: ---
+		OUTPUT: Center of the octant in global space
+		*/
+		vector3 GetCenterGlobal(void);
+		/*
+		USAGE: Gets the min corner of the octant in global space
+		ARGUMENTS: ---
+		OUTPUT: Minimum in global space
+		*/
+		vector3 GetMinGlobal(void);
+		/*
+		USAGE: Gets the max corner of the octant in global space
+		ARGUMENTS: ---
+		OUTPUT: Maximum in global space
+		*/
+		vector3 GetMaxGlobal(void);
+		/*
+		USAGE: Asks if there is a collision with the Entity specified by index from
+		the Bounding Object Manager
+		ARGUMENTS:
+		- int a_uRBIndex -> Index of the Entity in the Entity Manager
+		OUTPUT: check of the collision
+		*/
+		bool IsColliding(uint a_uRBIndex);
+		/*
+		USAGE: Displays the Octree volume specified by index including the objects underneath
+		ARGUMENTS:
+		- uint a_nIndex -> Octree to be displayed.
+		- vector3 a_v3Color = REYELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void Display(uint a_nIndex, vector3 a_v3Color = C_YELLOW);
+		/*
+		USAGE: Displays the Octree volume in the color specified
+		ARGUMENTS:
+		- vector3 a_v3Color = REYELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void Display(vector3 a_v3Color = C_YELLOW);
+		/*
+		USAGE: Displays the non empty leafs in the octree
+		ARGUMENTS:
+		- vector3 a_v3Color = REYELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void DisplayLeafs(vector3 a_v3Color = C_YELLOW);
+		/*
+		USAGE: Clears the Entity list for each node
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ClearEntityList(void);
+		/*
+		USAGE: allocates 8 smaller octants in the child pointers
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Subdivide(void);
+		/*
+		USAGE: returns the child specified in the index
+		ARGUMENTS: uint a_nChild -> index of the child (from 0 to 7)
+		OUTPUT: Octree object (child in index)
+		*/
+		MyOctree* GetChild(uint a_nChild);
+		/*
+		USAGE: returns the parent of the octant
+		ARGUMENTS: ---
+		OUTPUT: Octree object (parent)
+		*/
+		MyOctree* GetParent(void);
+		/*
+		USAGE: Asks the Octree if it does not contain any children (its a leaf)
+		ARGUMENTS: ---
+		OUTPUT: It contains no children
+		*/
+		bool IsLeaf(void);
+		/*
+		USAGE: Asks the Octree if it contains more than this many Bounding Objects
+		ARGUMENTS:
+		- uint a_nEntities -> Number of Entities to query
+		OUTPUT: It contains at least this many Entities
+		*/
+		bool ContainsMoreThan(uint a_nEntities);
+		/*
+		USAGE: Deletes all children and the children of their children (almost sounds apocalyptic)
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void KillBranches(void);
+		/*
+		USAGE: Creates a tree using subdivisions, the max number of objects and levels
+		ARGUMENTS:
+		- uint a_nMaxLevel = 3 -> Sets the maximum level of the tree while constructing it
+		OUTPUT: ---
+		*/
+		void ConstructTree(uint a_nMaxLevel = 3);
+		/*
+		USAGE: Traverse the tree up to the leafs and sets the objects in them to the index
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void AssignIDtoEntity(void);
+
+		/*
+		USAGE: Gets the total number of octants in the world
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		uint GetOctantCount(void);
+		/*
+		USAGE: Asks if the tree stores each entity once in an octant with loose bounds
+		ARGUMENTS: ---
+		OUTPUT: is it a loose octree?
+		*/
+		bool IsLoose(void);
+		/*
+		USAGE: Gets the number of octants that hold entities, the list only grows until the tree is rebuilt
+		ARGUMENTS: ---
+		OUTPUT: octant count
+		*/
+		uint GetNodeCount(void);
+		/*
+		USAGE: Gets an octant that holds entities
+		ARGUMENTS:
+		- uint a_uIndex -> index in the list of octants that hold entities
+		OUTPUT: octant, nullptr if out of bounds
+		*/
+		MyOctree* GetNode(uint a_uIndex);
+		/*
+		USAGE: Gets the handles of the entities of this octant
+		ARGUMENTS: ---
+		OUTPUT: entity list
+		*/
+		std::vector<MyHandle> const& GetEntityList(void);
+		/*
+		USAGE: Gets the min corner of the loose bounds, the same as the octant if the tree is not loose
+		ARGUMENTS: ---
+		OUTPUT: Minimum in global space
+		*/
+		vector3 GetLooseMinGlobal(void);
+		/*
+		USAGE: Gets the max corner of the loose bounds, the same as the octant if the tree is not loose
+		ARGUMENTS: ---
+		OUTPUT: Maximum in global space
+		*/
+		vector3 GetLooseMaxGlobal(void);
+		/*
+		USAGE: Gets the pairs of entities that can collide, each entity is paired with the entities of
+		every octant whose loose bounds its bounds reach; in loose mode every pair comes out once
+		ARGUMENTS:
+		- std::vector<uint>& a_lPair -> gets the index of both entities of each pair, one after the other
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<uint>& a_lPair);
+		/*
+		USAGE: Moves an entity to the octant its bounds fit in now, only in loose mode; an entity that
+		still fits where it is costs a bounds test, one that does not is unlinked and inserted again
+		ARGUMENTS:
+		- uint a_uIndex -> index of the entity in the entity manager
+		OUTPUT: ---
+		*/
+		void Relink(uint a_uIndex);
+		/*
+		USAGE: Takes an entity out of the tree before the entity manager removes it, only in loose mode;
+		its slot can be reused and the new entity has to be linked on its own
+		ARGUMENTS:
+		- MyHandle a_Handle -> handle of the entity
+		OUTPUT: ---
+		*/
+		void RemoveEntity(MyHandle a_Handle);
+		/*
+		USAGE: Links a batch of entities the entity manager just added, only in loose mode; a tree that
+		is not loose is built from the dimensions of the entities and has to be built again
+		ARGUMENTS:
+		- uint a_uFirst -> index of the first entity of the batch in the entity manager
+		- uint a_uCount -> number of entities in the batch
+		OUTPUT: ---
+		*/
+		void InsertEntities(uint a_uFirst, uint a_uCount);
+		/*
+		USAGE: Finds the nearest entity hit by a ray, the octants are visited front to back with an
+		explicit stack and the walk stops once the nearest hit is closer than the next octant; only
+		reads the tree, so several threads can cast at once
+		ARGUMENTS:
+		- vector3 a_v3Origin -> origin of the ray
+		- vector3 a_v3Direction -> normalized direction of the ray
+		- float a_fMaxDistance -> hits further than this are ignored
+		- MyRayHit& a_Hit -> gets the index, distance and normal of the nearest hit
+		OUTPUT: was an entity hit?
+		*/
+		bool RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, MyRayHit& a_Hit);
+		/*
+		USAGE: Finds the entities whose global ARBB overlaps a box, each one reported once even if it
+		spans several octants; walks the tree with an explicit stack and allocates nothing
+		ARGUMENTS:
+		- vector3 a_v3Min -> minimum of the box in global space
+		- vector3 a_v3Max -> maximum of the box in global space
+		- uint* a_pResult -> gets the index of each entity found
+		- uint a_uCapacity -> size of the buffer, the entities past it are counted but not written
+		OUTPUT: number of entities found, more than the capacity if the buffer was too small
+		*/
+		uint QueryBox(vector3 a_v3Min, vector3 a_v3Max, uint* a_pResult, uint a_uCapacity);
+		/*
+		USAGE: Finds the entities whose global ARBB overlaps a sphere, each one reported once even if it
+		spans several octants; walks the tree with an explicit stack and allocates nothing
+		ARGUMENTS:
+		- vector3 a_v3Center -> center of the sphere in global space
+		- float a_fRadius -> radius of the sphere
+		- uint* a_pResult -> gets the index of each entity found
+		- uint a_uCapacity -> size of the buffer, the entities past it are counted but not written
+		OUTPUT: number of entities found, more than the capacity if the buffer was too small
+		*/
+		uint QuerySphere(vector3 a_v3Center, float a_fRadius, uint* a_pResult, uint a_uCapacity);
+		/*
+		USAGE: Finds the entities whose global ARBB is nearest to a point, the octants are visited
+		nearest first and skipped once they are further than the furthest entity kept
+		ARGUMENTS:
+		- vector3 a_v3Point -> point in global space
+		- uint a_uCount -> number of entities wanted
+		- uint* a_pResult -> gets the index of each entity found, nearest first, as many as wanted
+		- float* a_pDistance -> gets the distance from the point to each ARBB, 0 if inside, as many as wanted
+		OUTPUT: number of entities found, less than wanted only if the tree has fewer
+		*/
+		uint QueryNearest(vector3 a_v3Point, uint a_uCount, uint* a_pResult, float* a_pDistance);
+
+	private:
+		/*
+		USAGE: Deallocates member fields
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Release(void);
+		/*
+		USAGE: Allocates member fields
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Init(void);
+		/*
+		USAGE: creates the list of all leafs that contains objects.
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ConstructList(void);
+		/*
+		USAGE: Asks if a point descends to this octant from the root, so every point belongs to a single
+		leaf; an entity spanning several octants is only reported by the one that owns a point of its
+		overlap with the query
+		ARGUMENTS:
+		- vector3 a_v3Point -> point in global space
+		OUTPUT: does the octant own the point?
+		*/
+		bool OwnsPoint(vector3 a_v3Point);
+		/*
+		USAGE: Gets the squared distance from a point to a box
+		ARGUMENTS:
+		- vector3 a_v3Point -> point
+		- vector3 a_v3Min -> minimum of the box
+		- vector3 a_v3Max -> maximum of the box
+		OUTPUT: squared distance, 0 if the point is inside
+		*/
+		static float DistanceSquared(vector3 a_v3Point, vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Sets the loose bounds from the center and the size
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ComputeLooseBounds(void);
+		/*
+		USAGE: Asks if a box fits in the loose bounds of the octant
+		ARGUMENTS:
+		- vector3 a_v3Min -> minimum of the box
+		- vector3 a_v3Max -> maximum of the box
+		OUTPUT: does it fit?
+		*/
+		bool FitsLoose(vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Finds the deepest octant under this one whose loose bounds contain a box, going down
+		through the child that holds the center of the box
+		ARGUMENTS:
+		- vector3 a_v3Min -> minimum of the box
+		- vector3 a_v3Max -> maximum of the box
+		OUTPUT: octant, this one if no child fits it
+		*/
+		MyOctree* FindLooseOctant(vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Stores an entity in this octant, loose mode only
+		ARGUMENTS:
+		- uint a_uIndex -> index of the entity in the entity manager
+		OUTPUT: ---
+		*/
+		void LinkEntity(uint a_uIndex);
+		/*
+		USAGE: Removes an entity from this octant, loose mode only
+		ARGUMENTS:
+		- MyHandle a_Handle -> handle the entity was linked with
+		OUTPUT: ---
+		*/
+		void UnlinkEntity(MyHandle a_Handle);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYOCTREECLASS_H_
+
+  /*
+  USAGE:
+  ARGUMENTS: ---
+  OUTPUT: ---
+  */
+
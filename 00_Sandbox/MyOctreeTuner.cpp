@@ -0,0 +1,206 @@
+#include "MyOctreeTuner.h"
+#include <chrono>
+using namespace Simplex;
+//  MyOctreeTuner
+void MyOctreeTuner::Release(void)
+{
+	//the entity manager would keep walking a deleted tree
+	if (m_pEntityMngr->GetOctree() == m_pRoot)
+		m_pEntityMngr->SetOctree(nullptr);
+	SafeDelete(m_pRoot);
+	m_lProbeLevel.clear();
+	m_lProbeIdeal.clear();
+}
+//The big 3
+MyOctreeTuner::MyOctreeTuner(uint a_uMaxLevel, uint a_uIdealEntityCount, float a_fLooseness)
+{
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_fLooseness = a_fLooseness;
+	SetConfiguration(a_uMaxLevel, a_uIdealEntityCount);
+}
+MyOctreeTuner::MyOctreeTuner(MyOctreeTuner const& other) { }
+MyOctreeTuner& MyOctreeTuner::operator=(MyOctreeTuner const& other) { return *this; }
+MyOctreeTuner::~MyOctreeTuner(void) { Release(); }
+//Accessors
+void MyOctreeTuner::SetAdaptive(bool a_bAdaptive)
+{
+	if (a_bAdaptive == m_bAdaptive)
+		return;
+	m_bAdaptive = a_bAdaptive;
+	//a probe could be in use, the best configuration found is kept or the search starts from it
+	SetConfiguration(m_uBestLevel, m_uBestIdeal);
+}
+bool MyOctreeTuner::IsAdaptive(void) { return m_bAdaptive; }
+void MyOctreeTuner::SetConfiguration(uint a_uMaxLevel, uint a_uIdealEntityCount)
+{
+	Apply(std::min<uint>(a_uMaxLevel, TUNER_MAX_LEVEL), std::max<uint>(a_uIdealEntityCount, TUNER_MIN_IDEAL));
+	m_uBestLevel = m_uMaxLevel;
+	m_uBestIdeal = m_uIdealEntityCount;
+	m_ePhase = m_bAdaptive ? TUNER_CENTER : TUNER_FIXED;
+}
+MyOctree* MyOctreeTuner::GetOctree(void) { return m_pRoot; }
+double MyOctreeTuner::GetBuildTime(void) { return m_dFrameBuild; }
+MyTunerReport MyOctreeTuner::GetReport(void) { return m_Report; }
+//--- Methods
+void MyOctreeTuner::Update(void)
+{
+	typedef std::chrono::steady_clock Clock;
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+	Clock::time_point start = Clock::now();
+	BuildTree();
+	Clock::time_point broadphase = Clock::now();
+	m_pEntityMngr->CheckCollisions();
+	Clock::time_point narrowphase = Clock::now();
+	m_dFrameBuild = Milliseconds(broadphase - start).count();
+
+	//the first frame of a window pays for the configuration before, it is not counted
+	if (m_uWindowFrame++ == 0)
+		return;
+	m_dWindowBuild += m_dFrameBuild;
+	m_dWindowNarrowphase += Milliseconds(narrowphase - broadphase).count();
+	m_uWindowPairs += m_pEntityMngr->GetPairTestCount();
+	if (m_uWindowFrame <= TUNER_WINDOW)
+		return;
+
+	double dFrames = static_cast<double>(TUNER_WINDOW);
+	m_Report.m_uMaxLevel = m_uMaxLevel;
+	m_Report.m_uIdealEntityCount = m_uIdealEntityCount;
+	m_Report.m_uOctantCount = m_pRoot->GetOctantCount();
+	m_Report.m_dBuild = m_dWindowBuild / dFrames;
+	m_Report.m_dNarrowphase = m_dWindowNarrowphase / dFrames;
+	m_Report.m_uPairTestCount = static_cast<uint>(m_uWindowPairs / TUNER_WINDOW);
+	m_uWindowFrame = 0;
+	m_dWindowBuild = 0.0;
+	m_dWindowNarrowphase = 0.0;
+	m_uWindowPairs = 0;
+
+	Judge(m_Report.m_dBuild + m_Report.m_dNarrowphase);
+	m_Report.m_ePhase = m_ePhase;
+	m_Report.m_uBestLevel = m_uBestLevel;
+	m_Report.m_uBestIdealEntityCount = m_uBestIdeal;
+	m_Report.m_dBestCost = m_dBestCost;
+}
+void MyOctreeTuner::BuildTree(void)
+{
+	uint uEntityCount = m_pEntityMngr->GetEntityCount();
+	if (m_pRoot != nullptr && !m_bRebuild && m_pRoot->IsLoose() && uEntityCount == m_uBuiltEntityCount)
+	{
+		//an entity that still fits in its octant costs a bounds test
+		for (uint i = 0; i < uEntityCount; ++i)
+			m_pRoot->Relink(i);
+		return;
+	}
+
+	//the octree adds dimensions to the entities, the old ones need to go first
+	m_pEntityMngr->ClearDimensionSetAll();
+	//the new tree is made before the old one goes, so it never gets its address and the occlusion
+	//culler can tell the results of the old octants apart
+	MyOctree* pOld = m_pRoot;
+	m_pRoot = new MyOctree(m_uMaxLevel, m_uIdealEntityCount, m_fLooseness);
+	SafeDelete(pOld);
+	m_pEntityMngr->SetOctree(m_pRoot);
+	m_uBuiltEntityCount = uEntityCount;
+	m_bRebuild = false;
+}
+void MyOctreeTuner::Judge(double a_dCost)
+{
+	switch (m_ePhase)
+	{
+	default:
+	case TUNER_FIXED:
+		m_dBestCost = a_dCost;
+		break;
+	case TUNER_CENTER:
+		m_dBestCost = a_dCost;
+		m_uBestEntityCount = m_pEntityMngr->GetEntityCount();
+		ListProbes();
+		m_uProbe = 0;
+		m_ePhase = m_lProbeLevel.empty() ? TUNER_SETTLED : TUNER_PROBE;
+		m_uSettledWindows = 0;
+		if (m_ePhase == TUNER_PROBE)
+			Apply(m_lProbeLevel[0], m_lProbeIdeal[0]);
+		break;
+	case TUNER_PROBE:
+		if (m_uProbe == 0 || a_dCost < m_dProbeBestCost)
+		{
+			m_uProbeBest = m_uProbe;
+			m_dProbeBestCost = a_dCost;
+		}
+		if (++m_uProbe < m_lProbeLevel.size())
+		{
+			Apply(m_lProbeLevel[m_uProbe], m_lProbeIdeal[m_uProbe]);
+			break;
+		}
+		//a neighbor that is only a little cheaper could be noise, the center is kept unless it clearly loses
+		if (m_dProbeBestCost < m_dBestCost * (1.0 - TUNER_HYSTERESIS))
+		{
+			m_uBestLevel = m_lProbeLevel[m_uProbeBest];
+			m_uBestIdeal = m_lProbeIdeal[m_uProbeBest];
+			m_dBestCost = m_dProbeBestCost;
+			ListProbes();
+			m_uProbe = 0;
+			if (!m_lProbeLevel.empty())
+			{
+				Apply(m_lProbeLevel[0], m_lProbeIdeal[0]);
+				break;
+			}
+		}
+		Apply(m_uBestLevel, m_uBestIdeal);
+		m_ePhase = TUNER_SETTLED;
+		m_uSettledWindows = 0;
+		break;
+	case TUNER_SETTLED:
+	{
+		//the scene changed enough for another configuration to win, or it is time to look again
+		double dEntityCount = static_cast<double>(m_pEntityMngr->GetEntityCount());
+		double dBestEntityCount = static_cast<double>(std::max<uint>(m_uBestEntityCount, 1));
+		bool bCostChanged = std::abs(a_dCost - m_dBestCost) > m_dBestCost * TUNER_RETUNE;
+		bool bSceneChanged = std::abs(dEntityCount - dBestEntityCount) > dBestEntityCount * TUNER_RETUNE;
+		if (bCostChanged || bSceneChanged || ++m_uSettledWindows >= TUNER_SETTLE_WINDOWS)
+			m_ePhase = TUNER_CENTER;
+		break;
+	}
+	}
+}
+void MyOctreeTuner::ListProbes(void)
+{
+	m_lProbeLevel.clear();
+	m_lProbeIdeal.clear();
+	if (m_uBestLevel > 0)
+	{
+		m_lProbeLevel.push_back(m_uBestLevel - 1);
+		m_lProbeIdeal.push_back(m_uBestIdeal);
+	}
+	if (m_uBestLevel < TUNER_MAX_LEVEL)
+	{
+		m_lProbeLevel.push_back(m_uBestLevel + 1);
+		m_lProbeIdeal.push_back(m_uBestIdeal);
+	}
+	//a tree of one level never subdivides, the entities per octant change nothing
+	if (m_uBestLevel == 0)
+		return;
+	if (m_uBestIdeal / 2 >= TUNER_MIN_IDEAL)
+	{
+		m_lProbeLevel.push_back(m_uBestLevel);
+		m_lProbeIdeal.push_back(m_uBestIdeal / 2);
+	}
+	if (m_uBestIdeal * 2 <= TUNER_MAX_IDEAL)
+	{
+		m_lProbeLevel.push_back(m_uBestLevel);
+		m_lProbeIdeal.push_back(m_uBestIdeal * 2);
+	}
+}
+void MyOctreeTuner::Apply(uint a_uMaxLevel, uint a_uIdealEntityCount)
+{
+	if (a_uMaxLevel == m_uMaxLevel && a_uIdealEntityCount == m_uIdealEntityCount && m_pRoot != nullptr)
+		return;
+	m_uMaxLevel = a_uMaxLevel;
+	m_uIdealEntityCount = a_uIdealEntityCount;
+	m_bRebuild = true;
+	//the window restarts with the new configuration
+	m_uWindowFrame = 0;
+	m_dWindowBuild = 0.0;
+	m_dWindowNarrowphase = 0.0;
+	m_uWindowPairs = 0;
+}
@@ -0,0 +1,197 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYOCTREETUNER_H_
+#define __MYOCTREETUNER_H_
+
+#include "MyOctree.h"
+
+#define TUNER_WINDOW 16 //frames measured per configuration, the first one after a change is left out
+#define TUNER_MAX_LEVEL 6 //deepest tree the search tries
+#define TUNER_MIN_IDEAL 1 //fewest entities per octant the search tries
+#define TUNER_MAX_IDEAL 64 //most entities per octant the search tries
+#define TUNER_HYSTERESIS 0.1f //a configuration has to be this much cheaper than the current one to replace it
+#define TUNER_RETUNE 0.5f //change in cost or entity count since the search ended that starts another one
+#define TUNER_SETTLE_WINDOWS 64 //windows a settled configuration runs before its neighbors are probed again
+
+namespace Simplex
+{
+
+//Step of the search the tuner is in
+enum eTunerPhase
+{
+	TUNER_FIXED = 0, //the configuration is not searched, it is only measured
+	TUNER_CENTER = 1, //measuring the configuration the probes are compared against
+	TUNER_PROBE = 2, //measuring the neighbors of the center, one window each
+	TUNER_SETTLED = 3, //no neighbor was cheaper enough, the center is kept
+};
+
+//Configuration and cost of the tree, copied so the GUI can read it while the tuner runs on a worker
+struct MyTunerReport
+{
+	uint m_uMaxLevel = 0; //levels of the tree
+	uint m_uIdealEntityCount = 0; //entities an octant holds before it is subdivided
+	uint m_uOctantCount = 0; //octants of the tree
+	eTunerPhase m_ePhase = TUNER_FIXED; //step of the search
+	double m_dBuild = 0.0; //milliseconds building or relinking the tree, averaged over the last window
+	double m_dNarrowphase = 0.0; //milliseconds testing the pairs, averaged over the last window
+	uint m_uPairTestCount = 0; //pairs tested per frame, averaged over the last window
+	uint m_uBestLevel = 0; //levels of the configuration the search holds as the best
+	uint m_uBestIdealEntityCount = 0; //entities per octant of the configuration the search holds as the best
+	double m_dBestCost = 0.0; //milliseconds per frame of the configuration the search holds as the best
+};
+
+//System Class
+class MyOctreeTuner
+{
+	MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager Singleton
+	MyOctree* m_pRoot = nullptr; //tree in use, rebuilt when the configuration changes
+	float m_fLooseness = 1.0f; //looseness of the tree, a loose tree is relinked instead of rebuilt
+	bool m_bAdaptive = true; //is the configuration searched?
+	eTunerPhase m_ePhase = TUNER_CENTER; //step of the search
+
+	uint m_uMaxLevel = 0; //levels of the tree in use
+	uint m_uIdealEntityCount = 0; //entities per octant of the tree in use
+	uint m_uBuiltEntityCount = 0; //entities when the tree was built
+	bool m_bRebuild = true; //does the configuration in use differ from the tree?
+
+	uint m_uBestLevel = 0; //levels of the center of the search
+	uint m_uBestIdeal = 0; //entities per octant of the center of the search
+	double m_dBestCost = 0.0; //milliseconds per frame of the center
+	uint m_uBestEntityCount = 0; //entities when the center was measured
+	std::vector<uint> m_lProbeLevel; //levels of each neighbor to probe
+	std::vector<uint> m_lProbeIdeal; //entities per octant of each neighbor to probe
+	uint m_uProbe = 0; //neighbor being measured
+	uint m_uProbeBest = 0; //cheapest neighbor measured so far
+	double m_dProbeBestCost = 0.0; //milliseconds per frame of the cheapest neighbor
+	uint m_uSettledWindows = 0; //windows the settled configuration has run
+
+	double m_dFrameBuild = 0.0; //milliseconds the last Update spent on the tree
+	uint m_uWindowFrame = 0; //frames of the window so far, the first one is not counted
+	double m_dWindowBuild = 0.0; //milliseconds building the tree in the window
+	double m_dWindowNarrowphase = 0.0; //milliseconds testing the pairs in the window
+	unsigned long long m_uWindowPairs = 0; //pairs tested in the window
+
+	MyTunerReport m_Report; //result of the last window
+
+public:
+	/*
+	Usage: Constructor, the tree is built by the first Update
+	Arguments:
+	-	uint a_uMaxLevel = 1 -> levels of the tree the search starts from
+	-	uint a_uIdealEntityCount = 5 -> entities per octant the search starts from
+	-	float a_fLooseness = 1.0f -> looseness of the tree, the search does not change it
+	Output: class object instance
+	*/
+	MyOctreeTuner(uint a_uMaxLevel = 1, uint a_uIdealEntityCount = 5, float a_fLooseness = 1.0f);
+	/*
+	Usage: Destructor, the entity manager is left without a tree
+	Arguments: ---
+	Output: ---
+	*/
+	~MyOctreeTuner(void);
+	/*
+	USAGE: Builds the tree, or relinks a loose one, and tests the pairs through it; both are timed and
+	once a window is measured the search moves to the next configuration to try. Runs on any thread
+	as long as nothing else reads the entities or the tree meanwhile
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Update(void);
+	/*
+	USAGE: Turns the search on or off, off keeps the best configuration found and only measures it
+	ARGUMENTS: bool a_bAdaptive -> search the configuration?
+	OUTPUT: ---
+	*/
+	void SetAdaptive(bool a_bAdaptive);
+	/*
+	USAGE: Asks if the configuration is being searched
+	ARGUMENTS: ---
+	OUTPUT: is it adaptive?
+	*/
+	bool IsAdaptive(void);
+	/*
+	USAGE: Sets the configuration of the tree, a search starts over from it
+	ARGUMENTS:
+	-	uint a_uMaxLevel -> levels of the tree
+	-	uint a_uIdealEntityCount -> entities an octant holds before it is subdivided
+	OUTPUT: ---
+	*/
+	void SetConfiguration(uint a_uMaxLevel, uint a_uIdealEntityCount);
+	/*
+	USAGE: Gets the tree in use, it is replaced when the configuration changes
+	ARGUMENTS: ---
+	OUTPUT: tree, nullptr before the first Update
+	*/
+	MyOctree* GetOctree(void);
+	/*
+	USAGE: Gets the time the last Update spent building or relinking the tree, the rest of it went to the pairs
+	ARGUMENTS: ---
+	OUTPUT: milliseconds
+	*/
+	double GetBuildTime(void);
+	/*
+	USAGE: Gets the configuration and the cost measured in the last window
+	ARGUMENTS: ---
+	OUTPUT: report
+	*/
+	MyTunerReport GetReport(void);
+
+private:
+	/*
+	Usage: copy constructor, not allowed
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyOctreeTuner(MyOctreeTuner const& other);
+	/*
+	Usage: copy assignment operator, not allowed
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyOctreeTuner& operator=(MyOctreeTuner const& other);
+	/*
+	Usage: deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: builds the tree with the configuration in use if it changed, if the entity count did or if
+	the tree is not loose; relinks every entity otherwise
+	Arguments: ---
+	Output: ---
+	*/
+	void BuildTree(void);
+	/*
+	Usage: moves the search along with the average cost of the window
+	Arguments: double a_dCost -> milliseconds per frame of the configuration in use
+	Output: ---
+	*/
+	void Judge(double a_dCost);
+	/*
+	Usage: lists the neighbors of the center, one level or half or double the entities per octant away
+	Arguments: ---
+	Output: ---
+	*/
+	void ListProbes(void);
+	/*
+	Usage: changes the configuration in use, the tree is rebuilt by the next Update
+	Arguments:
+	-	uint a_uMaxLevel -> levels of the tree
+	-	uint a_uIdealEntityCount -> entities per octant
+	Output: ---
+	*/
+	void Apply(uint a_uMaxLevel, uint a_uIdealEntityCount);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYOCTREETUNER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
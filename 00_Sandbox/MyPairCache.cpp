@@ -0,0 +1,134 @@
+#include "MyPairCache.h"
+using namespace Simplex;
+//  MyPairCache
+void MyPairCache::Init(void)
+{
+	m_uFrame = 0;
+	m_PairMap.clear();
+	m_EventList.clear();
+}
+void MyPairCache::Swap(MyPairCache& other)
+{
+	std::swap(m_uFrame, other.m_uFrame);
+	std::swap(m_PairMap, other.m_PairMap);
+	std::swap(m_EventList, other.m_EventList);
+}
+void MyPairCache::Release(void)
+{
+	m_PairMap.clear();
+	m_EventList.clear();
+}
+//The big 3
+MyPairCache::MyPairCache(void) { Init(); }
+MyPairCache::MyPairCache(MyPairCache const& other)
+{
+	m_uFrame = other.m_uFrame;
+	m_PairMap = other.m_PairMap;
+	m_EventList = other.m_EventList;
+}
+MyPairCache& MyPairCache::operator=(MyPairCache const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyPairCache temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyPairCache::~MyPairCache() { Release(); }
+//Accessors
+uint MyPairCache::GetPairCount(void) { return static_cast<uint>(m_PairMap.size()); }
+uint MyPairCache::GetEventCount(void) { return static_cast<uint>(m_EventList.size()); }
+MyContactEvent MyPairCache::GetEvent(uint a_uIndex)
+{
+	//if the list is empty return a default event
+	if (m_EventList.size() == 0)
+		return MyContactEvent();
+
+	//if out of bounds ask for the last one
+	if (a_uIndex >= m_EventList.size())
+		a_uIndex = static_cast<uint>(m_EventList.size()) - 1;
+
+	return m_EventList[a_uIndex];
+}
+//Methods
+MyPairCache::PairKey MyPairCache::MakeKey(uint a_uA, uint a_uB)
+{
+	if (a_uA > a_uB)
+		std::swap(a_uA, a_uB);
+	return (static_cast<PairKey>(a_uA) << 32) | static_cast<PairKey>(a_uB);
+}
+void MyPairCache::BeginFrame(void)
+{
+	++m_uFrame;
+	//clear keeps the capacity so the list is not reallocated every frame
+	m_EventList.clear();
+}
+void MyPairCache::AddPair(uint a_uA, uint a_uB)
+{
+	MyContactEvent event;
+	event.m_uA = std::min(a_uA, a_uB);
+	event.m_uB = std::max(a_uA, a_uB);
+
+	PairKey key = MakeKey(a_uA, a_uB);
+	auto pair = m_PairMap.find(key);
+	if (pair == m_PairMap.end())
+	{
+		//first time we see this pair
+		m_PairMap[key] = m_uFrame;
+		event.m_eState = CONTACT_BEGIN;
+	}
+	else
+	{
+		//already reported this frame, nothing changed
+		if (pair->second == m_uFrame)
+			return;
+		pair->second = m_uFrame;
+		event.m_eState = CONTACT_STAY;
+	}
+	m_EventList.push_back(event);
+}
+void MyPairCache::EndFrame(void)
+{
+	//every pair that was not stamped in this frame stopped colliding
+	for (auto pair = m_PairMap.begin(); pair != m_PairMap.end();)
+	{
+		if (pair->second != m_uFrame)
+		{
+			MyContactEvent event;
+			event.m_uA = static_cast<uint>(pair->first >> 32);
+			event.m_uB = static_cast<uint>(pair->first & 0xFFFFFFFF);
+			event.m_eState = CONTACT_END;
+			m_EventList.push_back(event);
+			pair = m_PairMap.erase(pair);
+		}
+		else
+			++pair;
+	}
+
+	//the solver is order dependent, a replay with another octree layout has to resolve the same way
+	std::sort(m_EventList.begin(), m_EventList.end());
+}
+bool MyPairCache::IsCached(uint a_uA, uint a_uB)
+{
+	return m_PairMap.find(MakeKey(a_uA, a_uB)) != m_PairMap.end();
+}
+void MyPairCache::RemoveIndex(uint a_uIndex)
+{
+	for (auto pair = m_PairMap.begin(); pair != m_PairMap.end();)
+	{
+		uint uA = static_cast<uint>(pair->first >> 32);
+		uint uB = static_cast<uint>(pair->first & 0xFFFFFFFF);
+		if (uA == a_uIndex || uB == a_uIndex)
+			pair = m_PairMap.erase(pair);
+		else
+			++pair;
+	}
+}
+void MyPairCache::Clear(void)
+{
+	m_PairMap.clear();
+	m_EventList.clear();
+}
@@ -0,0 +1,165 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYPAIRCACHE_H_
+#define __MYPAIRCACHE_H_
+
+#include "Simplex\Simplex.h"
+#include <unordered_map>
+
+namespace Simplex
+{
+
+//State of a contact between two entities in the current frame
+enum eContactState
+{
+	CONTACT_BEGIN = 0, //pair started colliding this frame
+	CONTACT_STAY = 1, //pair was colliding last frame and still is
+	CONTACT_END = 2, //pair was colliding last frame and no longer is
+};
+
+//Contact event produced by the pair cache
+struct MyContactEvent
+{
+	uint m_uA = 0; //slot of the first entity (always the smallest)
+	uint m_uB = 0; //slot of the second entity (always the largest)
+	eContactState m_eState = CONTACT_BEGIN; //what happened to the pair this frame
+
+	bool operator<(MyContactEvent const& other) const { return m_uA != other.m_uA ? m_uA < other.m_uA : m_uB < other.m_uB; }
+};
+
+//System Class
+class MyPairCache
+{
+	typedef unsigned long long PairKey; //(min, max) entity slot pair packed in 64 bits
+
+	uint m_uFrame = 0; //current frame stamp
+	std::unordered_map<PairKey, uint> m_PairMap; //colliding pairs and the last frame they were reported
+	std::vector<MyContactEvent> m_EventList; //events generated in the current frame
+
+public:
+	/*
+	Usage: Constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyPairCache(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyPairCache(MyPairCache const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyPairCache& operator=(MyPairCache const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyPairCache(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyPairCache& other);
+
+	/*
+	USAGE: Starts a new frame of contacts, clears the events of the last frame
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void BeginFrame(void);
+	/*
+	USAGE: Reports a pair as colliding in the current frame, generates a begin or stay event
+	ARGUMENTS:
+	-	uint a_uA -> index of one entity
+	-	uint a_uB -> index of the other entity
+	OUTPUT: ---
+	*/
+	void AddPair(uint a_uA, uint a_uB);
+	/*
+	USAGE: Finishes the frame, every cached pair not reported this frame generates an end event
+	and leaves the cache; the events are sorted by slot so their order, and the order the solver
+	gets the contacts in, does not depend on the order the broadphase found the pairs
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void EndFrame(void);
+	/*
+	USAGE: Asks if the pair is currently in the cache
+	ARGUMENTS:
+	-	uint a_uA -> index of one entity
+	-	uint a_uB -> index of the other entity
+	OUTPUT: is the pair colliding?
+	*/
+	bool IsCached(uint a_uA, uint a_uB);
+	/*
+	USAGE: Removes every pair that includes the index, the other indices do not change
+	ARGUMENTS: uint a_uIndex -> index being removed
+	OUTPUT: ---
+	*/
+	void RemoveIndex(uint a_uIndex);
+	/*
+	USAGE: Removes all pairs and events
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the number of pairs in the cache
+	ARGUMENTS: ---
+	OUTPUT: number of colliding pairs
+	*/
+	uint GetPairCount(void);
+	/*
+	USAGE: Gets the number of events generated in the current frame
+	ARGUMENTS: ---
+	OUTPUT: event count
+	*/
+	uint GetEventCount(void);
+	/*
+	USAGE: Gets the event specified by index
+	ARGUMENTS: uint a_uIndex -> index of the event
+	OUTPUT: event
+	*/
+	MyContactEvent GetEvent(uint a_uIndex);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Packs the pair into a key, smallest index first
+	ARGUMENTS:
+	-	uint a_uA -> index of one entity
+	-	uint a_uB -> index of the other entity
+	OUTPUT: key of the pair
+	*/
+	static PairKey MakeKey(uint a_uA, uint a_uB);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYPAIRCACHE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -3,7 +3,8 @@ using namespace Simplex;
 //Allocation
 void MyRigidBody::Init(void)
 {
-	m_pMeshMngr = MeshManager::GetInstance();
+	//the debug draw is fetched the first time the body is drawn
+	m_pDebugDraw = nullptr;
 	m_bVisibleBS = false;
 	m_bVisibleOBB = true;
 	m_bVisibleARBB = true;
@@ -31,7 +32,7 @@ void MyRigidBody::Init(void)
 }
 void MyRigidBody::Swap(MyRigidBody& other)
 {
-	std::swap(m_pMeshMngr, other.m_pMeshMngr);
+	std::swap(m_pDebugDraw, other.m_pDebugDraw);
 	std::swap(m_bVisibleBS, other.m_bVisibleBS);
 	std::swap(m_bVisibleOBB, other.m_bVisibleOBB);
 	std::swap(m_bVisibleARBB, other.m_bVisibleARBB);
@@ -59,7 +60,7 @@ void MyRigidBody::Swap(MyRigidBody& other)
 }
 void MyRigidBody::Release(void)
 {
-	m_pMeshMngr = nullptr;
+	m_pDebugDraw = nullptr;
 	ClearCollidingList();
 }
 //Accessors
@@ -134,6 +135,24 @@ void MyRigidBody::SetModelMatrix(matrix4 a_m4ModelMatrix)
 	//we calculate the distance between min and max vectors
 	m_v3ARBBSize = m_v3MaxG - m_v3MinG;
 }
+void MyRigidBody::SetLocalBounds(std::vector<vector3> a_pointList)
+{
+	if (a_pointList.size() == 0)
+		return;
+
+	//a body made from the points has the local box, it is taken without its colliding array
+	MyRigidBody fitted(a_pointList);
+	m_v3MinL = fitted.m_v3MinL;
+	m_v3MaxL = fitted.m_v3MaxL;
+	m_v3CenterL = fitted.m_v3CenterL;
+	m_v3HalfWidth = fitted.m_v3HalfWidth;
+	m_fRadius = fitted.m_fRadius;
+
+	//the same matrix would be skipped, the global box has to follow the local one
+	matrix4 m4ToWorld = m_m4ToWorld;
+	m_m4ToWorld = matrix4(0.0f);
+	SetModelMatrix(m4ToWorld);
+}
 //The big 3
 MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 {
@@ -176,7 +195,7 @@ MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 }
 MyRigidBody::MyRigidBody(MyRigidBody const& other)
 {
-	m_pMeshMngr = other.m_pMeshMngr;
+	m_pDebugDraw = other.m_pDebugDraw;
 
 	m_bVisibleBS = other.m_bVisibleBS;
 	m_bVisibleOBB = other.m_bVisibleOBB;
@@ -257,7 +276,7 @@ void MyRigidBody::RemoveCollisionWith(MyRigidBody* other)
 			pTemp = new PRigidBody[m_uCollidingCount - 1];
 			if (m_CollidingArray)
 			{
-				memcpy(pTemp, m_CollidingArray, sizeof(uint) * (m_uCollidingCount - 1));
+				memcpy(pTemp, m_CollidingArray, sizeof(PRigidBody) * (m_uCollidingCount - 1));
 				delete[] m_CollidingArray;
 				m_CollidingArray = nullptr;
 			}
@@ -279,11 +298,93 @@ void MyRigidBody::ClearCollidingList(void)
 }
 uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
 {
+	vector3 v3Normal;
+	float fPenetration;
+	return FindMinimumAxis(a_pOther, v3Normal, fPenetration);
+}
+uint MyRigidBody::FindMinimumAxis(MyRigidBody* const a_pOther, vector3& a_v3Normal, float& a_fPenetration)
+{
+	//axes and half extents of both boxes in global space, the model matrix may carry a scale
+	vector3 v3AxisA[3];
+	vector3 v3AxisB[3];
+	float fExtentA[3];
+	float fExtentB[3];
+	for (uint i = 0; i < 3; ++i)
+	{
+		v3AxisA[i] = vector3(m_m4ToWorld[i]);
+		float fScaleA = glm::length(v3AxisA[i]);
+		v3AxisA[i] = fScaleA > 0.0f ? v3AxisA[i] / fScaleA : ZERO_V3;
+		fExtentA[i] = m_v3HalfWidth[i] * fScaleA;
+
+		v3AxisB[i] = vector3(a_pOther->m_m4ToWorld[i]);
+		float fScaleB = glm::length(v3AxisB[i]);
+		v3AxisB[i] = fScaleB > 0.0f ? v3AxisB[i] / fScaleB : ZERO_V3;
+		fExtentB[i] = a_pOther->m_v3HalfWidth[i] * fScaleB;
+	}
+
+	//translation from this center to the other
+	vector3 v3Translation = a_pOther->m_v3CenterG - m_v3CenterG;
+
+	//the 15 candidate axes in the order of eSATResults: A0-A2, B0-B2 and the 9 edge cross products
+	vector3 v3Axis[15];
+	for (uint i = 0; i < 3; ++i)
+	{
+		v3Axis[i] = v3AxisA[i];
+		v3Axis[3 + i] = v3AxisB[i];
+		for (uint j = 0; j < 3; ++j)
+			v3Axis[6 + i * 3 + j] = glm::cross(v3AxisA[i], v3AxisB[j]);
+	}
+
+	a_fPenetration = std::numeric_limits<float>::max();
+	a_v3Normal = AXIS_Y;
+	for (uint uAxis = 0; uAxis < 15; ++uAxis)
+	{
+		vector3 v3L = v3Axis[uAxis];
+		//parallel edges give no axis, the face axes already cover that case
+		float fLength2 = glm::dot(v3L, v3L);
+		if (fLength2 < 0.000001f)
+			continue;
+		v3L /= std::sqrt(fLength2);
+
+		float fRadiusA = 0.0f;
+		float fRadiusB = 0.0f;
+		for (uint i = 0; i < 3; ++i)
+		{
+			fRadiusA += fExtentA[i] * std::abs(glm::dot(v3AxisA[i], v3L));
+			fRadiusB += fExtentB[i] * std::abs(glm::dot(v3AxisB[i], v3L));
+		}
+		float fDistance = glm::dot(v3Translation, v3L);
+		float fOverlap = fRadiusA + fRadiusB - std::abs(fDistance);
+
+		//first separating axis found
+		if (fOverlap < 0.0f)
+			return uAxis + 1;
+
+		//edge axes only win if they are clearly shallower, face normals give steadier contacts
+		float fBias = uAxis < 6 ? 1.0f : 0.95f;
+		if (fOverlap < a_fPenetration * fBias)
+		{
+			a_fPenetration = fOverlap;
+			a_v3Normal = fDistance < 0.0f ? -v3L : v3L;
+		}
+	}
+
 	// Since no separating axis found, the OBBs must be intersecting
-	/*
-	This is not complete as this is the solution of an assignment
-	*/
-	return 0;
+	return SAT_NONE;
+}
+bool MyRigidBody::GetContact(MyRigidBody* const a_pOther, vector3& a_v3Normal, float& a_fPenetration, vector3& a_v3Point)
+{
+	if (FindMinimumAxis(a_pOther, a_v3Normal, a_fPenetration) != SAT_NONE)
+		return false;
+
+	//projection of this box on the normal, its far face is where the overlap ends
+	float fRadius = 0.0f;
+	for (uint i = 0; i < 3; ++i)
+		fRadius += std::abs(glm::dot(vector3(m_m4ToWorld[i]), a_v3Normal)) * m_v3HalfWidth[i];
+
+	//halfway through the overlap, on the line that joins both centers
+	a_v3Point = m_v3CenterG + a_v3Normal * (fRadius - a_fPenetration * 0.5f);
+	return true;
 }
 bool MyRigidBody::IsColliding(MyRigidBody* const other)
 {
@@ -327,28 +428,86 @@ bool MyRigidBody::IsColliding(MyRigidBody* const other)
 	return bColliding;
 }
 
+bool MyRigidBody::IsSweptColliding(MyRigidBody* const other, vector3 a_v3Displacement, vector3 a_v3DisplacementOther)
+{
+	//work relative to the other object, only this one moves
+	vector3 v3Relative = a_v3Displacement - a_v3DisplacementOther;
+
+	//grow the box to cover where it starts and where it ends
+	vector3 v3Min = glm::min(m_v3MinG, m_v3MinG + v3Relative);
+	vector3 v3Max = glm::max(m_v3MaxG, m_v3MaxG + v3Relative);
+
+	if (v3Max.x < other->m_v3MinG.x || v3Min.x > other->m_v3MaxG.x)
+		return false;
+	if (v3Max.y < other->m_v3MinG.y || v3Min.y > other->m_v3MaxG.y)
+		return false;
+	if (v3Max.z < other->m_v3MinG.z || v3Min.z > other->m_v3MaxG.z)
+		return false;
+	return true;
+}
+float MyRigidBody::ARBBDistance(vector3 a_v3MinA, vector3 a_v3MaxA, vector3 a_v3MinB, vector3 a_v3MaxB)
+{
+	//gap on each axis, 0 if they overlap on it
+	vector3 v3Gap = glm::max(ZERO_V3, glm::max(a_v3MinB - a_v3MaxA, a_v3MinA - a_v3MaxB));
+	return glm::length(v3Gap);
+}
+float MyRigidBody::TimeOfImpact(MyRigidBody* const other, vector3 a_v3Displacement, vector3 a_v3DisplacementOther)
+{
+	const float fTolerance = 0.001f; //close enough to call it a contact
+	const uint uMaxIterations = 32; //the advancement converges in a few steps for boxes that translate
+
+	vector3 v3Relative = a_v3Displacement - a_v3DisplacementOther;
+	float fSpeed = glm::length(v3Relative);
+	//if they do not move relative to each other they can not start touching
+	if (fSpeed < fTolerance)
+		return 1.0f;
+
+	//boxes that already touch are not a tunneling case, stopping them here would freeze them every
+	//frame; the discrete resolution pushes them apart
+	if (ARBBDistance(m_v3MinG, m_v3MaxG, other->m_v3MinG, other->m_v3MaxG) < fTolerance)
+		return 1.0f;
+
+	float fTime = 0.0f;
+	for (uint i = 0; i < uMaxIterations; ++i)
+	{
+		vector3 v3Offset = v3Relative * fTime;
+		float fDistance = ARBBDistance(m_v3MinG + v3Offset, m_v3MaxG + v3Offset, other->m_v3MinG, other->m_v3MaxG);
+		if (fDistance < fTolerance)
+			return fTime;
+
+		//the distance can not shrink faster than the relative speed, so this step never overshoots
+		fTime += fDistance / fSpeed;
+		if (fTime >= 1.0f)
+			return 1.0f;
+	}
+	return fTime;
+}
+
 void MyRigidBody::AddToRenderList(void)
 {
+	if (m_pDebugDraw == nullptr)
+		m_pDebugDraw = MyDebugDraw::GetInstance();
+
 	if (m_bVisibleBS)
 	{
 		if (m_uCollidingCount > 0)
-			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
+			m_pDebugDraw->AddSphere(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
 		else
-			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
+			m_pDebugDraw->AddSphere(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
 	}
 	if (m_bVisibleOBB)
 	{
 		if (m_uCollidingCount > 0)
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorColliding);
+			m_pDebugDraw->AddBox(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorColliding);
 		else
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorNotColliding);
+			m_pDebugDraw->AddBox(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorNotColliding);
 	}
 	if (m_bVisibleARBB)
 	{
 		if (m_uCollidingCount > 0)
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
+			m_pDebugDraw->AddBox(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
 		else
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
+			m_pDebugDraw->AddBox(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
 	}
 }
 bool MyRigidBody::IsInCollidingArray(MyRigidBody* a_pEntry)
@@ -6,6 +6,7 @@ Date: 2017/06
 #define __MYRIGIDBODY_H_
 
 #include "Simplex\Mesh\Model.h"
+#include "MyDebugDraw.h"
 
 namespace Simplex
 {
@@ -17,7 +18,7 @@ public:
 	typedef MyRigidBody* PRigidBody; //MyEntity Pointer
 
 protected:
-	MeshManager* m_pMeshMngr = nullptr; //for displaying the Rigid Body
+	MyDebugDraw* m_pDebugDraw = nullptr; //for displaying the Rigid Body
 
 	bool m_bVisibleBS = false; //Visibility of bounding sphere
 	bool m_bVisibleOBB = true; //Visibility of Oriented bounding box
@@ -111,6 +112,38 @@ public:
 	OUTPUT: are they colliding?
 	*/
 	bool IsColliding(MyRigidBody* const other);
+	/*
+	USAGE: Tells if the ARBB of this object swept by its displacement overlaps the ARBB of the
+	incoming one swept by its own, does not mark the collision
+	ARGUMENTS:
+	-	MyRigidBody* const other -> inspected rigid body
+	-	vector3 a_v3Displacement -> how much this object moves in the step
+	-	vector3 a_v3DisplacementOther -> how much the inspected object moves in the step
+	OUTPUT: can they collide during the step?
+	*/
+	bool IsSweptColliding(MyRigidBody* const other, vector3 a_v3Displacement, vector3 a_v3DisplacementOther);
+	/*
+	USAGE: Finds when the ARBBs of both objects first touch during the step using conservative
+	advancement, it never moves them past the contact; boxes that already touch are left to the
+	discrete resolution
+	ARGUMENTS:
+	-	MyRigidBody* const other -> inspected rigid body
+	-	vector3 a_v3Displacement -> how much this object moves in the step
+	-	vector3 a_v3DisplacementOther -> how much the inspected object moves in the step
+	OUTPUT: fraction of the step (0, 1] at which they touch, 1.0f if they do not or already touch
+	*/
+	float TimeOfImpact(MyRigidBody* const other, vector3 a_v3Displacement, vector3 a_v3DisplacementOther);
+	/*
+	USAGE: Builds the contact between both oriented boxes from the axis of minimum penetration of
+	the Separation Axis Test, does not mark the collision
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> inspected rigid body
+	-	vector3& a_v3Normal -> (output) contact normal, points from this object to the other
+	-	float& a_fPenetration -> (output) overlap of both boxes along the normal
+	-	vector3& a_v3Point -> (output) point halfway through the overlap between both centers
+	OUTPUT: are the oriented boxes overlapping? outputs are only valid if they are
+	*/
+	bool GetContact(MyRigidBody* const a_pOther, vector3& a_v3Normal, float& a_fPenetration, vector3& a_v3Point);
 #pragma region Accessors
 	/*
 	Usage: Gets visibility of bounding sphere
@@ -233,6 +266,13 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ModelMatrix);
 	/*
+	USAGE: Fits the local box to another list of points, keeping the model matrix and the colliding
+	array; the rigid bodies colliding with this one keep pointing at it
+	ARGUMENTS: std::vector<vector3> a_pointList -> points to fit, an empty list changes nothing
+	OUTPUT: ---
+	*/
+	void SetLocalBounds(std::vector<vector3> a_pointList);
+	/*
 	USAGE: Gets the array of rigid bodies pointer this one is colliding with
 	ARGUMENTS: ---
 	OUTPUT: list of colliding rigid bodies
@@ -271,6 +311,25 @@ private:
 	OUTPUT: 0 for colliding, all other first axis that succeeds test
 	*/
 	uint SAT(MyRigidBody* const a_pOther);
+	/*
+	USAGE: Runs the Separation Axis Test on the 15 axes and keeps the one of minimum penetration
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> other rigid body to test against
+	-	vector3& a_v3Normal -> (output) axis of minimum penetration, points from this object to the other
+	-	float& a_fPenetration -> (output) overlap along that axis
+	OUTPUT: SAT_NONE if they overlap, otherwise the first separating axis (eSATResults)
+	*/
+	uint FindMinimumAxis(MyRigidBody* const a_pOther, vector3& a_v3Normal, float& a_fPenetration);
+	/*
+	USAGE: Gets the distance between two axis aligned boxes
+	ARGUMENTS:
+	-	vector3 a_v3MinA -> minimum of the first box
+	-	vector3 a_v3MaxA -> maximum of the first box
+	-	vector3 a_v3MinB -> minimum of the second box
+	-	vector3 a_v3MaxB -> maximum of the second box
+	OUTPUT: distance between the closest points, 0.0f if they overlap
+	*/
+	static float ARBBDistance(vector3 a_v3MinA, vector3 a_v3MaxA, vector3 a_v3MinB, vector3 a_v3MaxB);
 };//class
 
 } //namespace Simplex
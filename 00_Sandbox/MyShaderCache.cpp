@@ -0,0 +1,284 @@
+#include "MyShaderCache.h"
+using namespace Simplex;
+//  MyShaderCache
+MyShaderCache* MyShaderCache::m_pInstance = nullptr;
+void MyShaderCache::Init(void)
+{
+	m_uLoadCount = 0;
+	m_uCompileCount = 0;
+
+	//a binary is only good for the driver that made it
+	char const* pVendor = reinterpret_cast<char const*>(glGetString(GL_VENDOR));
+	char const* pRenderer = reinterpret_cast<char const*>(glGetString(GL_RENDERER));
+	char const* pVersion = reinterpret_cast<char const*>(glGetString(GL_VERSION));
+	m_sDriver = String(pVendor != nullptr ? pVendor : "") + "|" + (pRenderer != nullptr ? pRenderer : "") + "|" +
+		(pVersion != nullptr ? pVersion : "");
+
+	GLint nFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nFormats);
+	m_bBinary = glGetProgramBinary != nullptr && glProgramBinary != nullptr && nFormats > 0;
+
+	//let the driver use as many compiler threads as it wants
+	bool bParallel = false;
+	GLint nExtensions = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &nExtensions);
+	for (GLint i = 0; i < nExtensions && !bParallel; ++i)
+	{
+		char const* pExtension = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, i));
+		bParallel = pExtension != nullptr && (strcmp(pExtension, "GL_KHR_parallel_shader_compile") == 0 ||
+			strcmp(pExtension, "GL_ARB_parallel_shader_compile") == 0);
+	}
+#if defined(_WIN32)
+	if (bParallel)
+	{
+		typedef void (APIENTRY *MaxShaderCompilerThreads)(GLuint);
+		MaxShaderCompilerThreads pMaxThreads = reinterpret_cast<MaxShaderCompilerThreads>(wglGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+		if (pMaxThreads == nullptr)
+			pMaxThreads = reinterpret_cast<MaxShaderCompilerThreads>(wglGetProcAddress("glMaxShaderCompilerThreadsARB"));
+		if (pMaxThreads != nullptr)
+			pMaxThreads(0xFFFFFFFF);
+	}
+#endif
+}
+void MyShaderCache::Release(void)
+{
+	for (auto program = m_ProgramMap.begin(); program != m_ProgramMap.end(); ++program)
+	{
+		if (program->second.m_uProgram != 0)
+			glDeleteProgram(program->second.m_uProgram);
+	}
+	m_ProgramMap.clear();
+}
+MyShaderCache* MyShaderCache::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyShaderCache();
+	}
+	return m_pInstance;
+}
+void MyShaderCache::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyShaderCache::MyShaderCache() { Init(); }
+MyShaderCache::MyShaderCache(MyShaderCache const& a_pOther) { }
+MyShaderCache& MyShaderCache::operator=(MyShaderCache const& a_pOther) { return *this; }
+MyShaderCache::~MyShaderCache() { Release(); };
+//Accessors
+uint MyShaderCache::GetLoadCount(void) { return m_uLoadCount; }
+uint MyShaderCache::GetCompileCount(void) { return m_uCompileCount; }
+//--- Methods
+void MyShaderCache::AddProgram(String a_sName, String a_sVertex, String a_sFragment)
+{
+	//a program added again with the same sources is already there
+	unsigned long long uKey = Hash(m_sDriver, Hash(a_sFragment, Hash(a_sVertex)));
+	MyShaderProgram& program = m_ProgramMap[a_sName];
+	if (program.m_uKey == uKey)
+		return;
+
+	if (program.m_uProgram != 0)
+		glDeleteProgram(program.m_uProgram);
+	program = MyShaderProgram();
+	program.m_sVertex = a_sVertex;
+	program.m_sFragment = a_sFragment;
+	program.m_uKey = uKey;
+}
+bool MyShaderCache::AddProgramFiles(String a_sName, String a_sVertexFile, String a_sFragmentFile)
+{
+	String sFolder = Folder::GetInstance()->GetFolderShaders();
+	std::ifstream vertex(sFolder + a_sVertexFile);
+	std::ifstream fragment(sFolder + a_sFragmentFile);
+	if (!vertex.is_open() || !fragment.is_open())
+		return false;
+
+	std::stringstream vertexSource;
+	std::stringstream fragmentSource;
+	vertexSource << vertex.rdbuf();
+	fragmentSource << fragment.rdbuf();
+	AddProgram(a_sName, vertexSource.str(), fragmentSource.str());
+	return true;
+}
+GLuint MyShaderCache::GetProgram(String a_sName)
+{
+	auto program = m_ProgramMap.find(a_sName);
+	if (program == m_ProgramMap.end())
+		return 0;
+	if (!program->second.m_bBuilt)
+		Build();
+	return program->second.m_uProgram;
+}
+void MyShaderCache::Build(void)
+{
+	//the binaries first, what is left is compiled
+	std::vector<String> lCompile;
+	for (auto program = m_ProgramMap.begin(); program != m_ProgramMap.end(); ++program)
+	{
+		if (program->second.m_bBuilt)
+			continue;
+		if (LoadBinary(program->first, program->second))
+		{
+			program->second.m_bBuilt = true;
+			++m_uLoadCount;
+			continue;
+		}
+		lCompile.push_back(program->first);
+	}
+	if (lCompile.size() == 0)
+		return;
+
+	//every compile and link goes out before the first status query, the query is what waits
+	for (uint i = 0; i < lCompile.size(); ++i)
+	{
+		MyShaderProgram& program = m_ProgramMap[lCompile[i]];
+		std::cout << "Compiling shader: " << lCompile[i] << std::endl;
+		program.m_uVertex = CompileShader(GL_VERTEX_SHADER, program.m_sVertex);
+		program.m_uFragment = CompileShader(GL_FRAGMENT_SHADER, program.m_sFragment);
+	}
+	for (uint i = 0; i < lCompile.size(); ++i)
+	{
+		MyShaderProgram& program = m_ProgramMap[lCompile[i]];
+		program.m_uProgram = glCreateProgram();
+		if (m_bBinary)
+			glProgramParameteri(program.m_uProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glAttachShader(program.m_uProgram, program.m_uVertex);
+		glAttachShader(program.m_uProgram, program.m_uFragment);
+		glLinkProgram(program.m_uProgram);
+	}
+	for (uint i = 0; i < lCompile.size(); ++i)
+	{
+		MyShaderProgram& program = m_ProgramMap[lCompile[i]];
+		bool bLinked = CheckStatus(program.m_uVertex, false, lCompile[i]) &
+			CheckStatus(program.m_uFragment, false, lCompile[i]) &
+			CheckStatus(program.m_uProgram, true, lCompile[i]);
+
+		glDetachShader(program.m_uProgram, program.m_uVertex);
+		glDetachShader(program.m_uProgram, program.m_uFragment);
+		glDeleteShader(program.m_uVertex);
+		glDeleteShader(program.m_uFragment);
+		program.m_uVertex = 0;
+		program.m_uFragment = 0;
+		program.m_bBuilt = true;
+		if (!bLinked)
+		{
+			glDeleteProgram(program.m_uProgram);
+			program.m_uProgram = 0;
+			continue;
+		}
+		++m_uCompileCount;
+		SaveBinary(lCompile[i], program);
+	}
+}
+GLuint MyShaderCache::CompileShader(GLenum a_uType, String a_sSource)
+{
+	GLuint uShader = glCreateShader(a_uType);
+	char const* pSource = a_sSource.c_str();
+	glShaderSource(uShader, 1, &pSource, nullptr);
+	glCompileShader(uShader);
+	return uShader;
+}
+bool MyShaderCache::CheckStatus(GLuint a_uObject, bool a_bProgram, String a_sName)
+{
+	GLint nStatus = GL_FALSE;
+	GLint nLength = 0;
+	if (a_bProgram)
+	{
+		glGetProgramiv(a_uObject, GL_LINK_STATUS, &nStatus);
+		glGetProgramiv(a_uObject, GL_INFO_LOG_LENGTH, &nLength);
+	}
+	else
+	{
+		glGetShaderiv(a_uObject, GL_COMPILE_STATUS, &nStatus);
+		glGetShaderiv(a_uObject, GL_INFO_LOG_LENGTH, &nLength);
+	}
+	if (nStatus == GL_TRUE)
+		return true;
+
+	std::vector<char> lLog(std::max(nLength, 1), '\0');
+	if (a_bProgram)
+		glGetProgramInfoLog(a_uObject, nLength, nullptr, lLog.data());
+	else
+		glGetShaderInfoLog(a_uObject, nLength, nullptr, lLog.data());
+	std::cout << "Shader " << a_sName << " failed: " << lLog.data() << std::endl;
+	return false;
+}
+String MyShaderCache::GetCachePath(String a_sName)
+{
+	String sFolder = Folder::GetInstance()->GetFolderData();
+	if (sFolder.size() > 0 && sFolder.back() != '\\' && sFolder.back() != '/')
+		sFolder += '\\';
+	return sFolder + a_sName + SHADER_CACHE_EXTENSION;
+}
+bool MyShaderCache::LoadBinary(String a_sName, MyShaderProgram& a_Program)
+{
+	if (!m_bBinary)
+		return false;
+	std::ifstream file(GetCachePath(a_sName), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	//the sources or the driver changed since it was saved, it has to be compiled
+	MyShaderCacheHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(MyShaderCacheHeader));
+	if (!file.good() || header.m_uMagic != SHADER_CACHE_MAGIC || header.m_uVersion != SHADER_CACHE_VERSION ||
+		header.m_uKey != a_Program.m_uKey || header.m_uLength == 0)
+		return false;
+	std::vector<char> lBinary(header.m_uLength);
+	file.read(lBinary.data(), header.m_uLength);
+	if (!file.good())
+		return false;
+
+	//the driver can still refuse it, after an update that kept the version string for example
+	GLuint uProgram = glCreateProgram();
+	glProgramBinary(uProgram, header.m_uFormat, lBinary.data(), header.m_uLength);
+	GLint nStatus = GL_FALSE;
+	glGetProgramiv(uProgram, GL_LINK_STATUS, &nStatus);
+	if (nStatus != GL_TRUE)
+	{
+		glDeleteProgram(uProgram);
+		return false;
+	}
+	a_Program.m_uProgram = uProgram;
+	return true;
+}
+void MyShaderCache::SaveBinary(String a_sName, MyShaderProgram& a_Program)
+{
+	if (!m_bBinary)
+		return;
+	GLint nLength = 0;
+	glGetProgramiv(a_Program.m_uProgram, GL_PROGRAM_BINARY_LENGTH, &nLength);
+	if (nLength <= 0)
+		return;
+
+	MyShaderCacheHeader header;
+	header.m_uKey = a_Program.m_uKey;
+	std::vector<char> lBinary(nLength);
+	GLsizei nWritten = 0;
+	glGetProgramBinary(a_Program.m_uProgram, nLength, &nWritten, &header.m_uFormat, lBinary.data());
+	if (nWritten <= 0)
+		return;
+	header.m_uLength = static_cast<uint>(nWritten);
+
+	std::ofstream file(GetCachePath(a_sName), std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return;
+	file.write(reinterpret_cast<char const*>(&header), sizeof(MyShaderCacheHeader));
+	file.write(lBinary.data(), nWritten);
+}
+unsigned long long MyShaderCache::Hash(String a_sInput, unsigned long long a_uHash)
+{
+	for (size_t i = 0; i < a_sInput.size(); ++i)
+	{
+		a_uHash ^= static_cast<unsigned char>(a_sInput[i]);
+		a_uHash *= 1099511628211ULL;
+	}
+	//the end of the string goes in too, so "ab"+"c" and "a"+"bc" differ
+	a_uHash ^= 0xFF;
+	a_uHash *= 1099511628211ULL;
+	return a_uHash;
+}
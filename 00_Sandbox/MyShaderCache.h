@@ -0,0 +1,203 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYSHADERCACHE_H_
+#define __MYSHADERCACHE_H_
+
+#include "Simplex\Simplex.h"
+
+#define SHADER_CACHE_MAGIC 0x47525053 //"SPRG" in the first 4 bytes of a cached program
+#define SHADER_CACHE_VERSION 1 //changes every time the layout changes, older files are compiled again
+#define SHADER_CACHE_EXTENSION ".glbin" //extension of the cached program, written in the data folder
+
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0 //GL_KHR_parallel_shader_compile, not in this version of GLEW
+#define GL_COMPLETION_STATUS_KHR 0x91B1 //GL_KHR_parallel_shader_compile, not in this version of GLEW
+
+namespace Simplex
+{
+
+//Start of a cached program binary
+struct MyShaderCacheHeader
+{
+	uint m_uMagic = SHADER_CACHE_MAGIC; //SHADER_CACHE_MAGIC
+	uint m_uVersion = SHADER_CACHE_VERSION; //SHADER_CACHE_VERSION
+	unsigned long long m_uKey = 0; //hash of the sources and the driver that made the binary
+	GLenum m_uFormat = 0; //format given by glGetProgramBinary
+	uint m_uLength = 0; //bytes of the binary that follow the header
+};
+
+//Program added to the cache
+struct MyShaderProgram
+{
+	String m_sVertex = ""; //vertex shader source
+	String m_sFragment = ""; //fragment shader source
+	unsigned long long m_uKey = 0; //hash of the sources and the driver
+	GLuint m_uProgram = 0; //OpenGL program, 0 until built
+	GLuint m_uVertex = 0; //vertex shader while it is compiled
+	GLuint m_uFragment = 0; //fragment shader while it is compiled
+	bool m_bBuilt = false; //was the program built already?
+};
+
+//System Class
+class MyShaderCache
+{
+	std::map<String, MyShaderProgram> m_ProgramMap; //programs by name
+	String m_sDriver = ""; //vendor, renderer and version of the driver, part of every key
+	bool m_bBinary = false; //can the driver save and load program binaries?
+	uint m_uLoadCount = 0; //programs loaded from a binary
+	uint m_uCompileCount = 0; //programs compiled from their sources
+
+	static MyShaderCache* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer, the first call has to be made from the GL thread
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyShaderCache* GetInstance();
+	/*
+	Usage: Releases the content of the singleton, deletes every program
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a program from its sources, it is built with the rest by the next Build or GetProgram
+	ARGUMENTS:
+	-	String a_sName -> name of the program, also the name of its cached binary
+	-	String a_sVertex -> vertex shader source
+	-	String a_sFragment -> fragment shader source
+	OUTPUT: ---
+	*/
+	void AddProgram(String a_sName, String a_sVertex, String a_sFragment);
+	/*
+	USAGE: Adds a program from the files of the shaders folder
+	ARGUMENTS:
+	-	String a_sName -> name of the program, also the name of its cached binary
+	-	String a_sVertexFile -> vertex shader file
+	-	String a_sFragmentFile -> fragment shader file
+	OUTPUT: could both files be read?
+	*/
+	bool AddProgramFiles(String a_sName, String a_sVertexFile, String a_sFragmentFile);
+	/*
+	USAGE: Builds every program added since the last call. The cached binaries are loaded first, the
+	rest are compiled together: every compile and link is issued before any result is asked for, so a
+	driver with parallel compilation works on all of them at once
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Build(void);
+	/*
+	USAGE: Gets a program, building the pending ones if it is one of them
+	ARGUMENTS: String a_sName -> name of the program
+	OUTPUT: OpenGL program, 0 if it does not exist or could not be built
+	*/
+	GLuint GetProgram(String a_sName);
+	/*
+	USAGE: Gets the number of programs loaded from a cached binary
+	ARGUMENTS: ---
+	OUTPUT: load count
+	*/
+	uint GetLoadCount(void);
+	/*
+	USAGE: Gets the number of programs compiled from their sources
+	ARGUMENTS: ---
+	OUTPUT: compile count
+	*/
+	uint GetCompileCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyShaderCache(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyShaderCache(MyShaderCache const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyShaderCache& operator=(MyShaderCache const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyShaderCache(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton, reads the driver and asks for parallel compilation
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Gets the path of the cached binary of a program
+	ARGUMENTS: String a_sName -> name of the program
+	OUTPUT: path in the data folder
+	*/
+	String GetCachePath(String a_sName);
+	/*
+	USAGE: Makes the program out of its cached binary if the key matches and the driver takes it
+	ARGUMENTS:
+	-	String a_sName -> name of the program
+	-	MyShaderProgram& a_Program -> program to load
+	OUTPUT: was it loaded?
+	*/
+	bool LoadBinary(String a_sName, MyShaderProgram& a_Program);
+	/*
+	USAGE: Writes the binary of a linked program
+	ARGUMENTS:
+	-	String a_sName -> name of the program
+	-	MyShaderProgram& a_Program -> linked program
+	OUTPUT: ---
+	*/
+	void SaveBinary(String a_sName, MyShaderProgram& a_Program);
+	/*
+	USAGE: Creates a shader and issues its compilation without waiting for it
+	ARGUMENTS:
+	-	GLenum a_uType -> GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+	-	String a_sSource -> source of the shader
+	OUTPUT: OpenGL shader
+	*/
+	GLuint CompileShader(GLenum a_uType, String a_sSource);
+	/*
+	USAGE: Checks the result of a compile or a link, printing the log if it failed
+	ARGUMENTS:
+	-	GLuint a_uObject -> shader or program
+	-	bool a_bProgram -> is it a program?
+	-	String a_sName -> name of the program, for the log
+	OUTPUT: did it succeed?
+	*/
+	bool CheckStatus(GLuint a_uObject, bool a_bProgram, String a_sName);
+	/*
+	USAGE: Hashes a string with 64 bit FNV-1a
+	ARGUMENTS:
+	-	String a_sInput -> string to hash
+	-	unsigned long long a_uHash -> hash so far, to chain several strings
+	OUTPUT: hash
+	*/
+	static unsigned long long Hash(String a_sInput, unsigned long long a_uHash = 14695981039346656037ULL);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSHADERCACHE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,193 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYSLOTMAP_H_
+#define __MYSLOTMAP_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+//Stable reference to an element of a slot map, it goes stale when the element is erased
+struct MyHandle
+{
+	uint m_uSlot = -1; //slot of the element, stays the same while the element lives
+	uint m_uGeneration = 0; //generation of the slot when the handle was made
+
+	bool operator==(MyHandle const& other) const { return m_uSlot == other.m_uSlot && m_uGeneration == other.m_uGeneration; }
+	bool operator!=(MyHandle const& other) const { return !(*this == other); }
+};
+
+//System Class
+template <class T>
+class MySlotMap
+{
+	//Indirection of a handle into the dense list
+	struct MySlot
+	{
+		uint m_uDense = -1; //index in the dense list, or the next free slot if it is free
+		uint m_uGeneration = 0; //increased every time the element of the slot is erased
+	};
+
+	std::vector<T> m_DenseList; //elements packed together for iteration
+	std::vector<uint> m_DenseToSlot; //slot of each element of the dense list
+	std::vector<MySlot> m_SlotList; //slots of the handles
+	uint m_uFreeSlot = -1; //first free slot, -1 if there are none
+
+public:
+	/*
+	USAGE: Adds an element, reusing a free slot if there is one, O(1) amortized
+	ARGUMENTS: T const& a_Element -> element to add
+	OUTPUT: handle of the element
+	*/
+	MyHandle Insert(T const& a_Element)
+	{
+		uint uSlot = m_uFreeSlot;
+		if (uSlot != static_cast<uint>(-1))
+		{
+			m_uFreeSlot = m_SlotList[uSlot].m_uDense;
+		}
+		else
+		{
+			uSlot = static_cast<uint>(m_SlotList.size());
+			m_SlotList.push_back(MySlot());
+		}
+
+		m_SlotList[uSlot].m_uDense = static_cast<uint>(m_DenseList.size());
+		m_DenseList.push_back(a_Element);
+		m_DenseToSlot.push_back(uSlot);
+
+		MyHandle handle;
+		handle.m_uSlot = uSlot;
+		handle.m_uGeneration = m_SlotList[uSlot].m_uGeneration;
+		return handle;
+	}
+	/*
+	USAGE: Erases the element of the handle, the last element takes its place in the dense list, O(1)
+	ARGUMENTS: MyHandle a_Handle -> handle of the element
+	OUTPUT: was the handle valid?
+	*/
+	bool Erase(MyHandle a_Handle)
+	{
+		if (!IsValid(a_Handle))
+			return false;
+
+		uint uDense = m_SlotList[a_Handle.m_uSlot].m_uDense;
+		uint uLast = static_cast<uint>(m_DenseList.size()) - 1;
+		//swap and pop, the moved element keeps its slot
+		if (uDense != uLast)
+		{
+			m_DenseList[uDense] = m_DenseList[uLast];
+			m_DenseToSlot[uDense] = m_DenseToSlot[uLast];
+			m_SlotList[m_DenseToSlot[uDense]].m_uDense = uDense;
+		}
+		m_DenseList.pop_back();
+		m_DenseToSlot.pop_back();
+
+		//older handles of the slot go stale and the slot goes to the free list
+		++m_SlotList[a_Handle.m_uSlot].m_uGeneration;
+		m_SlotList[a_Handle.m_uSlot].m_uDense = m_uFreeSlot;
+		m_uFreeSlot = a_Handle.m_uSlot;
+		return true;
+	}
+	/*
+	USAGE: Asks if the handle still refers to an element
+	ARGUMENTS: MyHandle a_Handle -> handle to check
+	OUTPUT: is it valid?
+	*/
+	bool IsValid(MyHandle a_Handle) const
+	{
+		return a_Handle.m_uSlot < m_SlotList.size() && m_SlotList[a_Handle.m_uSlot].m_uGeneration == a_Handle.m_uGeneration;
+	}
+	/*
+	USAGE: Gets the element of the handle
+	ARGUMENTS: MyHandle a_Handle -> handle of the element
+	OUTPUT: pointer to the element, nullptr if the handle is stale
+	*/
+	T* Get(MyHandle a_Handle)
+	{
+		if (!IsValid(a_Handle))
+			return nullptr;
+		return &m_DenseList[m_SlotList[a_Handle.m_uSlot].m_uDense];
+	}
+	/*
+	USAGE: Gets the index of the element in the dense list, it changes when other elements are erased
+	ARGUMENTS: MyHandle a_Handle -> handle of the element
+	OUTPUT: dense index, -1 if the handle is stale
+	*/
+	uint GetDenseIndex(MyHandle a_Handle) const
+	{
+		if (!IsValid(a_Handle))
+			return -1;
+		return m_SlotList[a_Handle.m_uSlot].m_uDense;
+	}
+	/*
+	USAGE: Gets the handle of an element of the dense list
+	ARGUMENTS: uint a_uDense -> index in the dense list
+	OUTPUT: handle of the element
+	*/
+	MyHandle GetHandle(uint a_uDense) const
+	{
+		MyHandle handle;
+		handle.m_uSlot = m_DenseToSlot[a_uDense];
+		handle.m_uGeneration = m_SlotList[handle.m_uSlot].m_uGeneration;
+		return handle;
+	}
+	/*
+	USAGE: Gets the slot of an element of the dense list, slots do not change while the element lives
+	ARGUMENTS: uint a_uDense -> index in the dense list
+	OUTPUT: slot of the element
+	*/
+	uint GetSlot(uint a_uDense) const { return m_DenseToSlot[a_uDense]; }
+	/*
+	USAGE: Gets the element living in a slot, without checking the generation
+	ARGUMENTS: uint a_uSlot -> slot of the element
+	OUTPUT: element
+	*/
+	T& GetBySlot(uint a_uSlot) { return m_DenseList[m_SlotList[a_uSlot].m_uDense]; }
+	/*
+	USAGE: Gets the element of the dense list
+	ARGUMENTS: uint a_uDense -> index in the dense list
+	OUTPUT: element
+	*/
+	T& operator[](uint a_uDense) { return m_DenseList[a_uDense]; }
+	/*
+	USAGE: Gets the number of elements
+	ARGUMENTS: ---
+	OUTPUT: element count
+	*/
+	uint Size(void) const { return static_cast<uint>(m_DenseList.size()); }
+	/*
+	USAGE: Reserves memory for the elements so adding them does not reallocate
+	ARGUMENTS: uint a_uCount -> number of elements
+	OUTPUT: ---
+	*/
+	void Reserve(uint a_uCount)
+	{
+		m_DenseList.reserve(a_uCount);
+		m_DenseToSlot.reserve(a_uCount);
+		m_SlotList.reserve(a_uCount);
+	}
+	/*
+	USAGE: Erases every element, the handles given so far go stale
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void)
+	{
+		for (uint i = Size(); i > 0; --i)
+			Erase(GetHandle(i - 1));
+	}
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSLOTMAP_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -137,9 +137,9 @@ void MySolver::ResolveCollision(MySolver* a_pOther)
 	//If the forces are large apply them on each other
 	if (fMagThis > REPULSIONFORCE || fMagOther > REPULSIONFORCE)
 	{
-		//a_pOther->ApplyForce(GetVelocity());
-		ApplyForce(-m_v3Velocity);
-		a_pOther->ApplyForce(m_v3Velocity);
+		//exchange the velocities, each body gets what the other had
+		ApplyForce(a_pOther->m_v3Velocity - m_v3Velocity);
+		a_pOther->ApplyForce(m_v3Velocity - a_pOther->m_v3Velocity);
 	}
 	else//Objects are almost static but they need to be separated
 	{
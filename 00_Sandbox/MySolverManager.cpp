@@ -0,0 +1,482 @@
+#include "MySolverManager.h"
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+using namespace Simplex;
+//  MySolverManager
+MySolverManager* MySolverManager::m_pInstance = nullptr;
+void MySolverManager::Init(void)
+{
+	m_uBodyCount = 0;
+	m_FreeList.clear();
+}
+void MySolverManager::Release(void)
+{
+	m_uBodyCount = 0;
+	m_FreeList.clear();
+	m_PositionX.clear(); m_PositionY.clear(); m_PositionZ.clear();
+	m_VelocityX.clear(); m_VelocityY.clear(); m_VelocityZ.clear();
+	m_AccelerationX.clear(); m_AccelerationY.clear(); m_AccelerationZ.clear();
+	m_SizeX.clear(); m_SizeY.clear(); m_SizeZ.clear();
+	m_Mass.clear();
+	m_Colliding.clear();
+	m_Simulated.clear();
+	m_Continuous.clear();
+	m_Step.clear();
+	m_Orientation.clear();
+}
+MySolverManager* MySolverManager::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MySolverManager();
+	}
+	return m_pInstance;
+}
+void MySolverManager::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MySolverManager::MySolverManager() { Init(); }
+MySolverManager::MySolverManager(MySolverManager const& a_pOther) { }
+MySolverManager& MySolverManager::operator=(MySolverManager const& a_pOther) { return *this; }
+MySolverManager::~MySolverManager() { Release(); };
+//Accessors
+uint MySolverManager::GetBodyCount(void) { return m_uBodyCount; }
+void MySolverManager::SetPosition(uint a_uBody, vector3 a_v3Position)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	m_PositionX[a_uBody] = a_v3Position.x;
+	m_PositionY[a_uBody] = a_v3Position.y;
+	m_PositionZ[a_uBody] = a_v3Position.z;
+}
+vector3 MySolverManager::GetPosition(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return ZERO_V3;
+	return vector3(m_PositionX[a_uBody], m_PositionY[a_uBody], m_PositionZ[a_uBody]);
+}
+void MySolverManager::SetVelocity(uint a_uBody, vector3 a_v3Velocity)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	m_VelocityX[a_uBody] = a_v3Velocity.x;
+	m_VelocityY[a_uBody] = a_v3Velocity.y;
+	m_VelocityZ[a_uBody] = a_v3Velocity.z;
+}
+vector3 MySolverManager::GetVelocity(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return ZERO_V3;
+	return vector3(m_VelocityX[a_uBody], m_VelocityY[a_uBody], m_VelocityZ[a_uBody]);
+}
+void MySolverManager::SetSize(uint a_uBody, vector3 a_v3Size)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	m_SizeX[a_uBody] = a_v3Size.x;
+	m_SizeY[a_uBody] = a_v3Size.y;
+	m_SizeZ[a_uBody] = a_v3Size.z;
+}
+vector3 MySolverManager::GetSize(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return vector3(1.0f);
+	return vector3(m_SizeX[a_uBody], m_SizeY[a_uBody], m_SizeZ[a_uBody]);
+}
+void MySolverManager::SetOrientation(uint a_uBody, quaternion a_qOrientation)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	m_Orientation[a_uBody] = a_qOrientation;
+}
+quaternion MySolverManager::GetOrientation(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return quaternion();
+	return m_Orientation[a_uBody];
+}
+void MySolverManager::SetTransform(uint a_uBody, matrix4 const& a_m4ToWorld)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+
+	//the columns are the scaled axes, their lengths are the size and what is left is the rotation
+	matrix3 m3Rotation = matrix3(a_m4ToWorld);
+	vector3 v3Size = ZERO_V3;
+	for (uint i = 0; i < 3; ++i)
+	{
+		v3Size[i] = glm::length(m3Rotation[i]);
+		if (v3Size[i] > 0.0f)
+			m3Rotation[i] /= v3Size[i];
+	}
+	m_PositionX[a_uBody] = a_m4ToWorld[3].x;
+	m_PositionY[a_uBody] = a_m4ToWorld[3].y;
+	m_PositionZ[a_uBody] = a_m4ToWorld[3].z;
+	m_Orientation[a_uBody] = glm::quat_cast(m3Rotation);
+	m_SizeX[a_uBody] = v3Size.x;
+	m_SizeY[a_uBody] = v3Size.y;
+	m_SizeZ[a_uBody] = v3Size.z;
+}
+void MySolverManager::SetMass(uint a_uBody, float a_fMass)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	//check minimum mass
+	if (a_fMass < 0.01f)
+		a_fMass = 0.01f;
+	m_Mass[a_uBody] = a_fMass;
+}
+float MySolverManager::GetMass(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return 1.0f;
+	return m_Mass[a_uBody];
+}
+void MySolverManager::SetIsColliding(uint a_uBody, bool a_bIsColliding)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	m_Colliding[a_uBody] = a_bIsColliding ? 1.0f : 0.0f;
+}
+void MySolverManager::SetSimulated(uint a_uBody, bool a_bSimulated)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	m_Simulated[a_uBody] = a_bSimulated ? 1.0f : 0.0f;
+}
+void MySolverManager::SetContinuous(uint a_uBody, bool a_bContinuous)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	m_Continuous[a_uBody] = a_bContinuous ? 1.0f : 0.0f;
+}
+bool MySolverManager::IsContinuous(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return false;
+	return m_Continuous[a_uBody] > 0.0f;
+}
+bool MySolverManager::IsSimulated(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return false;
+	return m_Simulated[a_uBody] > 0.0f;
+}
+void MySolverManager::SetTimeOfImpact(uint a_uBody, float a_fTime)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	//keep the earliest impact of the step
+	a_fTime = glm::clamp(a_fTime, 0.0f, 1.0f);
+	if (a_fTime < m_Step[a_uBody])
+		m_Step[a_uBody] = a_fTime;
+}
+//Methods
+void MySolverManager::ResetBody(uint a_uBody)
+{
+	m_PositionX[a_uBody] = m_PositionY[a_uBody] = m_PositionZ[a_uBody] = 0.0f;
+	m_VelocityX[a_uBody] = m_VelocityY[a_uBody] = m_VelocityZ[a_uBody] = 0.0f;
+	m_AccelerationX[a_uBody] = m_AccelerationY[a_uBody] = m_AccelerationZ[a_uBody] = 0.0f;
+	m_SizeX[a_uBody] = m_SizeY[a_uBody] = m_SizeZ[a_uBody] = 1.0f;
+	m_Mass[a_uBody] = 1.0f;
+	m_Colliding[a_uBody] = 0.0f;
+	m_Simulated[a_uBody] = 0.0f;
+	m_Continuous[a_uBody] = 0.0f;
+	m_Step[a_uBody] = 1.0f;
+	m_Orientation[a_uBody] = quaternion();
+}
+uint MySolverManager::AddBody(void)
+{
+	uint uBody;
+	if (m_FreeList.size() > 0)
+	{
+		//reuse a freed slot
+		uBody = m_FreeList.back();
+		m_FreeList.pop_back();
+	}
+	else
+	{
+		uBody = m_uBodyCount;
+		++m_uBodyCount;
+		//grow the lists 8 slots at a time so the update never reads past the end
+		if (m_uBodyCount > m_PositionX.size())
+		{
+			size_t uSize = m_PositionX.size() + 8;
+			m_PositionX.resize(uSize, 0.0f); m_PositionY.resize(uSize, 0.0f); m_PositionZ.resize(uSize, 0.0f);
+			m_VelocityX.resize(uSize, 0.0f); m_VelocityY.resize(uSize, 0.0f); m_VelocityZ.resize(uSize, 0.0f);
+			m_AccelerationX.resize(uSize, 0.0f); m_AccelerationY.resize(uSize, 0.0f); m_AccelerationZ.resize(uSize, 0.0f);
+			m_SizeX.resize(uSize, 1.0f); m_SizeY.resize(uSize, 1.0f); m_SizeZ.resize(uSize, 1.0f);
+			m_Mass.resize(uSize, 1.0f);
+			m_Colliding.resize(uSize, 0.0f);
+			m_Simulated.resize(uSize, 0.0f);
+			m_Continuous.resize(uSize, 0.0f);
+			m_Step.resize(uSize, 1.0f);
+			m_Orientation.resize(uSize, quaternion());
+		}
+	}
+	ResetBody(uBody);
+	return uBody;
+}
+void MySolverManager::Reserve(uint a_uCount)
+{
+	//the lists grow 8 slots at a time, keep the reserve padded the same way
+	size_t uSize = (static_cast<size_t>(a_uCount) + 7) & ~static_cast<size_t>(7);
+	m_PositionX.reserve(uSize); m_PositionY.reserve(uSize); m_PositionZ.reserve(uSize);
+	m_VelocityX.reserve(uSize); m_VelocityY.reserve(uSize); m_VelocityZ.reserve(uSize);
+	m_AccelerationX.reserve(uSize); m_AccelerationY.reserve(uSize); m_AccelerationZ.reserve(uSize);
+	m_SizeX.reserve(uSize); m_SizeY.reserve(uSize); m_SizeZ.reserve(uSize);
+	m_Mass.reserve(uSize);
+	m_Colliding.reserve(uSize);
+	m_Simulated.reserve(uSize);
+	m_Continuous.reserve(uSize);
+	m_Step.reserve(uSize);
+	m_Orientation.reserve(uSize);
+}
+uint MySolverManager::CopyBody(uint a_uBody)
+{
+	uint uBody = AddBody();
+	if (a_uBody >= m_uBodyCount)
+		return uBody;
+
+	m_PositionX[uBody] = m_PositionX[a_uBody];
+	m_PositionY[uBody] = m_PositionY[a_uBody];
+	m_PositionZ[uBody] = m_PositionZ[a_uBody];
+	m_VelocityX[uBody] = m_VelocityX[a_uBody];
+	m_VelocityY[uBody] = m_VelocityY[a_uBody];
+	m_VelocityZ[uBody] = m_VelocityZ[a_uBody];
+	m_AccelerationX[uBody] = m_AccelerationX[a_uBody];
+	m_AccelerationY[uBody] = m_AccelerationY[a_uBody];
+	m_AccelerationZ[uBody] = m_AccelerationZ[a_uBody];
+	m_SizeX[uBody] = m_SizeX[a_uBody];
+	m_SizeY[uBody] = m_SizeY[a_uBody];
+	m_SizeZ[uBody] = m_SizeZ[a_uBody];
+	m_Mass[uBody] = m_Mass[a_uBody];
+	m_Colliding[uBody] = m_Colliding[a_uBody];
+	m_Simulated[uBody] = m_Simulated[a_uBody];
+	m_Continuous[uBody] = m_Continuous[a_uBody];
+	m_Orientation[uBody] = m_Orientation[a_uBody];
+	return uBody;
+}
+void MySolverManager::RemoveBody(uint a_uBody)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	//a reset body is not simulated so the update leaves it alone
+	ResetBody(a_uBody);
+	m_FreeList.push_back(a_uBody);
+}
+void MySolverManager::ApplyForce(uint a_uBody, vector3 a_v3Force)
+{
+	if (a_uBody >= m_uBodyCount)
+		return;
+	//f = m * a -> a = f / m
+	float fMass = m_Mass[a_uBody];
+	m_AccelerationX[a_uBody] += a_v3Force.x / fMass;
+	m_AccelerationY[a_uBody] += a_v3Force.y / fMass;
+	m_AccelerationZ[a_uBody] += a_v3Force.z / fMass;
+}
+void MySolverManager::Update(void)
+{
+	IntegrateVelocity();
+	IntegratePosition();
+}
+void MySolverManager::IntegrateVelocity(bool a_bHoldColliding)
+{
+	uint uSize = static_cast<uint>(m_PositionX.size());
+	const float fMaxVelocity2 = SOLVER_MAXVELOCITY * SOLVER_MAXVELOCITY;
+	const float fMinVelocity2 = SOLVER_MINVELOCITY * SOLVER_MINVELOCITY;
+#if defined(__AVX__)
+	const __m256 v8Zero = _mm256_setzero_ps();
+	const __m256 v8Half = _mm256_set1_ps(0.5f);
+	const __m256 v8ThreeHalves = _mm256_set1_ps(1.5f);
+	const __m256 v8Gravity = _mm256_set1_ps(SOLVER_GRAVITY);
+	const __m256 v8Friction = _mm256_set1_ps(1.0f - SOLVER_FRICTION);
+	const __m256 v8MaxVelocity = _mm256_set1_ps(SOLVER_MAXVELOCITY);
+	const __m256 v8MaxVelocity2 = _mm256_set1_ps(fMaxVelocity2);
+	const __m256 v8MinVelocity2 = _mm256_set1_ps(fMinVelocity2);
+	//the flags are 0.0f or 1.0f, comparing against 1.0f never marks a body as colliding
+	const __m256 v8CollidingLimit = _mm256_set1_ps(a_bHoldColliding ? 0.0f : 1.0f);
+	//the lists are padded to a multiple of 8, free slots are not simulated
+	for (uint i = 0; i < uSize; i += 8)
+	{
+		__m256 v8Simulated = _mm256_cmp_ps(_mm256_loadu_ps(&m_Simulated[i]), v8Zero, _CMP_GT_OQ);
+		__m256 v8Colliding = _mm256_cmp_ps(_mm256_loadu_ps(&m_Colliding[i]), v8CollidingLimit, _CMP_GT_OQ);
+
+		__m256 v8VelX0 = _mm256_loadu_ps(&m_VelocityX[i]);
+		__m256 v8VelY0 = _mm256_loadu_ps(&m_VelocityY[i]);
+		__m256 v8VelZ0 = _mm256_loadu_ps(&m_VelocityZ[i]);
+		__m256 v8AccX0 = _mm256_loadu_ps(&m_AccelerationX[i]);
+		__m256 v8AccY0 = _mm256_loadu_ps(&m_AccelerationY[i]);
+		__m256 v8AccZ0 = _mm256_loadu_ps(&m_AccelerationZ[i]);
+
+		//gravity is a force of g * m, divided by m it is just g
+		__m256 v8VelX = _mm256_add_ps(v8VelX0, v8AccX0);
+		__m256 v8VelY = _mm256_add_ps(v8VelY0, _mm256_add_ps(v8AccY0, v8Gravity));
+		__m256 v8VelZ = _mm256_add_ps(v8VelZ0, v8AccZ0);
+
+		//clamp to the max velocity, comparing squared lengths and scaling by the reciprocal square root
+		__m256 v8Length2 = _mm256_add_ps(_mm256_mul_ps(v8VelX, v8VelX),
+			_mm256_add_ps(_mm256_mul_ps(v8VelY, v8VelY), _mm256_mul_ps(v8VelZ, v8VelZ)));
+		__m256 v8Fast = _mm256_cmp_ps(v8Length2, v8MaxVelocity2, _CMP_GT_OQ);
+		__m256 v8InvLength = _mm256_rsqrt_ps(v8Length2);
+		//one Newton-Raphson step to refine the approximation
+		v8InvLength = _mm256_mul_ps(v8InvLength, _mm256_sub_ps(v8ThreeHalves,
+			_mm256_mul_ps(_mm256_mul_ps(v8Half, v8Length2), _mm256_mul_ps(v8InvLength, v8InvLength))));
+		__m256 v8Scale = _mm256_mul_ps(v8MaxVelocity, v8InvLength);
+		v8VelX = _mm256_blendv_ps(v8VelX, _mm256_mul_ps(v8VelX, v8Scale), v8Fast);
+		v8VelY = _mm256_blendv_ps(v8VelY, _mm256_mul_ps(v8VelY, v8Scale), v8Fast);
+		v8VelZ = _mm256_blendv_ps(v8VelZ, _mm256_mul_ps(v8VelZ, v8Scale), v8Fast);
+
+		//there is no friction falling
+		v8VelX = _mm256_mul_ps(v8VelX, v8Friction);
+		v8VelZ = _mm256_mul_ps(v8VelZ, v8Friction);
+
+		//if velocity is really small make it zero
+		v8Length2 = _mm256_add_ps(_mm256_mul_ps(v8VelX, v8VelX),
+			_mm256_add_ps(_mm256_mul_ps(v8VelY, v8VelY), _mm256_mul_ps(v8VelZ, v8VelZ)));
+		__m256 v8Slow = _mm256_cmp_ps(v8Length2, v8MinVelocity2, _CMP_LT_OQ);
+		v8VelX = _mm256_andnot_ps(v8Slow, v8VelX);
+		v8VelY = _mm256_andnot_ps(v8Slow, v8VelY);
+		v8VelZ = _mm256_andnot_ps(v8Slow, v8VelZ);
+
+		//colliding bodies can not keep falling
+		__m256 v8Falling = _mm256_and_ps(v8Colliding, _mm256_cmp_ps(v8VelY, v8Zero, _CMP_LT_OQ));
+		v8VelY = _mm256_andnot_ps(v8Falling, v8VelY);
+
+		//write back only the simulated bodies, their acceleration is consumed
+		_mm256_storeu_ps(&m_VelocityX[i], _mm256_blendv_ps(v8VelX0, v8VelX, v8Simulated));
+		_mm256_storeu_ps(&m_VelocityY[i], _mm256_blendv_ps(v8VelY0, v8VelY, v8Simulated));
+		_mm256_storeu_ps(&m_VelocityZ[i], _mm256_blendv_ps(v8VelZ0, v8VelZ, v8Simulated));
+		_mm256_storeu_ps(&m_AccelerationX[i], _mm256_andnot_ps(v8Simulated, v8AccX0));
+		_mm256_storeu_ps(&m_AccelerationY[i], _mm256_andnot_ps(v8Simulated, v8AccY0));
+		_mm256_storeu_ps(&m_AccelerationZ[i], _mm256_andnot_ps(v8Simulated, v8AccZ0));
+	}
+#else
+	for (uint i = 0; i < uSize; ++i)
+	{
+		if (m_Simulated[i] <= 0.0f)
+			continue;
+
+		//gravity is a force of g * m, divided by m it is just g
+		float fVelX = m_VelocityX[i] + m_AccelerationX[i];
+		float fVelY = m_VelocityY[i] + m_AccelerationY[i] + SOLVER_GRAVITY;
+		float fVelZ = m_VelocityZ[i] + m_AccelerationZ[i];
+
+		//clamp to the max velocity, the square root is only needed when the clamp happens
+		float fLength2 = fVelX * fVelX + fVelY * fVelY + fVelZ * fVelZ;
+		if (fLength2 > fMaxVelocity2)
+		{
+			float fScale = SOLVER_MAXVELOCITY / std::sqrt(fLength2);
+			fVelX *= fScale;
+			fVelY *= fScale;
+			fVelZ *= fScale;
+		}
+
+		//there is no friction falling
+		fVelX *= 1.0f - SOLVER_FRICTION;
+		fVelZ *= 1.0f - SOLVER_FRICTION;
+
+		//if velocity is really small make it zero
+		fLength2 = fVelX * fVelX + fVelY * fVelY + fVelZ * fVelZ;
+		if (fLength2 < fMinVelocity2)
+			fVelX = fVelY = fVelZ = 0.0f;
+
+		//colliding bodies can not keep falling
+		if (a_bHoldColliding && m_Colliding[i] > 0.0f && fVelY < 0.0f)
+			fVelY = 0.0f;
+
+		m_VelocityX[i] = fVelX;
+		m_VelocityY[i] = fVelY;
+		m_VelocityZ[i] = fVelZ;
+		m_AccelerationX[i] = m_AccelerationY[i] = m_AccelerationZ[i] = 0.0f;
+	}
+#endif
+}
+void MySolverManager::IntegratePosition(void)
+{
+	uint uSize = static_cast<uint>(m_PositionX.size());
+#if defined(__AVX__)
+	const __m256 v8Zero = _mm256_setzero_ps();
+	const __m256 v8One = _mm256_set1_ps(1.0f);
+	//the lists are padded to a multiple of 8, free slots are not simulated
+	for (uint i = 0; i < uSize; i += 8)
+	{
+		__m256 v8Simulated = _mm256_cmp_ps(_mm256_loadu_ps(&m_Simulated[i]), v8Zero, _CMP_GT_OQ);
+		__m256 v8Step = _mm256_loadu_ps(&m_Step[i]);
+
+		__m256 v8PosX0 = _mm256_loadu_ps(&m_PositionX[i]);
+		__m256 v8PosY0 = _mm256_loadu_ps(&m_PositionY[i]);
+		__m256 v8PosZ0 = _mm256_loadu_ps(&m_PositionZ[i]);
+		__m256 v8VelY0 = _mm256_loadu_ps(&m_VelocityY[i]);
+
+		//bodies stopped by the continuous collision only advance a fraction of their velocity
+		__m256 v8PosX = _mm256_add_ps(v8PosX0, _mm256_mul_ps(_mm256_loadu_ps(&m_VelocityX[i]), v8Step));
+		__m256 v8PosY = _mm256_add_ps(v8PosY0, _mm256_mul_ps(v8VelY0, v8Step));
+		__m256 v8PosZ = _mm256_add_ps(v8PosZ0, _mm256_mul_ps(_mm256_loadu_ps(&m_VelocityZ[i]), v8Step));
+
+		//ground plane
+		__m256 v8Ground = _mm256_cmp_ps(v8PosY, v8Zero, _CMP_LE_OQ);
+		v8PosY = _mm256_andnot_ps(v8Ground, v8PosY);
+		__m256 v8VelY = _mm256_andnot_ps(v8Ground, v8VelY0);
+
+		_mm256_storeu_ps(&m_PositionX[i], _mm256_blendv_ps(v8PosX0, v8PosX, v8Simulated));
+		_mm256_storeu_ps(&m_PositionY[i], _mm256_blendv_ps(v8PosY0, v8PosY, v8Simulated));
+		_mm256_storeu_ps(&m_PositionZ[i], _mm256_blendv_ps(v8PosZ0, v8PosZ, v8Simulated));
+		_mm256_storeu_ps(&m_VelocityY[i], _mm256_blendv_ps(v8VelY0, v8VelY, v8Simulated));
+		_mm256_storeu_ps(&m_Step[i], v8One);
+	}
+#else
+	for (uint i = 0; i < uSize; ++i)
+	{
+		float fStep = m_Step[i];
+		m_Step[i] = 1.0f;
+		if (m_Simulated[i] <= 0.0f)
+			continue;
+
+		//bodies stopped by the continuous collision only advance a fraction of their velocity
+		m_PositionX[i] += m_VelocityX[i] * fStep;
+		m_PositionY[i] += m_VelocityY[i] * fStep;
+		m_PositionZ[i] += m_VelocityZ[i] * fStep;
+
+		//ground plane
+		if (m_PositionY[i] <= 0.0f)
+		{
+			m_PositionY[i] = 0.0f;
+			m_VelocityY[i] = 0.0f;
+		}
+	}
+#endif
+}
+void MySolverManager::ResolveCollision(uint a_uBody, uint a_uOther)
+{
+	if (a_uBody >= m_uBodyCount || a_uOther >= m_uBodyCount)
+		return;
+
+	vector3 v3Velocity = GetVelocity(a_uBody);
+	vector3 v3VelocityOther = GetVelocity(a_uOther);
+	float fRepulsion2 = REPULSIONFORCE * REPULSIONFORCE;
+
+	//If the forces are large apply them on each other
+	if (glm::dot(v3Velocity, v3Velocity) > fRepulsion2 || glm::dot(v3VelocityOther, v3VelocityOther) > fRepulsion2)
+	{
+		ApplyForce(a_uBody, v3VelocityOther - v3Velocity);
+		ApplyForce(a_uOther, v3Velocity - v3VelocityOther);
+	}
+	else//Objects are almost static but they need to be separated
+	{
+		vector3 v3Direction = GetPosition(a_uBody) - GetPosition(a_uOther);
+		if (glm::dot(v3Direction, v3Direction) != 0.0f)
+			v3Direction = glm::normalize(v3Direction);
+		v3Direction *= 0.016f; //should be multiplied by the delta time
+
+		ApplyForce(a_uBody, v3Direction);
+		ApplyForce(a_uOther, -v3Direction);
+	}
+}
@@ -0,0 +1,302 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYSOLVERMANAGER_H_
+#define __MYSOLVERMANAGER_H_
+
+#include "MySolver.h"
+
+#define SOLVER_GRAVITY -0.12f //acceleration applied on y every update
+#define SOLVER_FRICTION 0.1f //friction applied on the xz plane every update
+#define SOLVER_MAXVELOCITY 5.0f //maximum length of the velocity
+#define SOLVER_MINVELOCITY 0.028f //velocities shorter than this are rounded to zero
+
+namespace Simplex
+{
+
+//System Class
+class MySolverManager
+{
+	uint m_uBodyCount = 0; //number of slots in use or freed
+	std::vector<uint> m_FreeList; //slots that can be reused
+
+	//State of the bodies stored as structure of arrays, all lists are padded to a multiple of 8
+	std::vector<float> m_PositionX; //x component of the position of each body
+	std::vector<float> m_PositionY; //y component of the position of each body
+	std::vector<float> m_PositionZ; //z component of the position of each body
+	std::vector<float> m_VelocityX; //x component of the velocity of each body
+	std::vector<float> m_VelocityY; //y component of the velocity of each body
+	std::vector<float> m_VelocityZ; //z component of the velocity of each body
+	std::vector<float> m_AccelerationX; //x component of the acceleration of each body
+	std::vector<float> m_AccelerationY; //y component of the acceleration of each body
+	std::vector<float> m_AccelerationZ; //z component of the acceleration of each body
+	std::vector<float> m_SizeX; //x component of the size of each body
+	std::vector<float> m_SizeY; //y component of the size of each body
+	std::vector<float> m_SizeZ; //z component of the size of each body
+	std::vector<float> m_Mass; //mass of each body
+	std::vector<float> m_Colliding; //1.0f if the body is colliding with any other, 0.0f otherwise
+	std::vector<float> m_Simulated; //1.0f if the body is integrated in the update, 0.0f otherwise
+	std::vector<float> m_Continuous; //1.0f if the body is swept against the others before moving, 0.0f otherwise
+	std::vector<float> m_Step; //fraction of the velocity applied in the next position integration
+	std::vector<quaternion> m_Orientation; //orientation of each body, not integrated
+
+	static MySolverManager* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MySolverManager* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a body with default values to the store
+	ARGUMENTS: ---
+	OUTPUT: handle of the body
+	*/
+	uint AddBody(void);
+	/*
+	USAGE: Adds a body with the same state as the specified one
+	ARGUMENTS: uint a_uBody -> handle of the body to copy
+	OUTPUT: handle of the new body
+	*/
+	uint CopyBody(uint a_uBody);
+	/*
+	USAGE: Reserves memory so the store can hold the bodies without reallocating
+	ARGUMENTS: uint a_uCount -> number of bodies
+	OUTPUT: ---
+	*/
+	void Reserve(uint a_uCount);
+	/*
+	USAGE: Frees the slot of the body so it can be reused
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: ---
+	*/
+	void RemoveBody(uint a_uBody);
+	/*
+	USAGE: Gets the number of slots of the store
+	ARGUMENTS: ---
+	OUTPUT: slots in use or free to be reused
+	*/
+	uint GetBodyCount(void);
+	/*
+	USAGE: Sets the position of the body
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	vector3 a_v3Position -> position to set
+	OUTPUT: ---
+	*/
+	void SetPosition(uint a_uBody, vector3 a_v3Position);
+	/*
+	USAGE: Gets the position of the body
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: position of the body
+	*/
+	vector3 GetPosition(uint a_uBody);
+	/*
+	USAGE: Sets the velocity of the body
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	vector3 a_v3Velocity -> velocity to set
+	OUTPUT: ---
+	*/
+	void SetVelocity(uint a_uBody, vector3 a_v3Velocity);
+	/*
+	USAGE: Gets the velocity of the body
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: velocity of the body
+	*/
+	vector3 GetVelocity(uint a_uBody);
+	/*
+	USAGE: Sets the size of the body
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	vector3 a_v3Size -> size to set
+	OUTPUT: ---
+	*/
+	void SetSize(uint a_uBody, vector3 a_v3Size);
+	/*
+	USAGE: Gets the size of the body
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: size of the body
+	*/
+	vector3 GetSize(uint a_uBody);
+	/*
+	USAGE: Sets the orientation of the body
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	quaternion a_qOrientation -> orientation to set
+	OUTPUT: ---
+	*/
+	void SetOrientation(uint a_uBody, quaternion a_qOrientation);
+	/*
+	USAGE: Gets the orientation of the body
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: orientation of the body
+	*/
+	quaternion GetOrientation(uint a_uBody);
+	/*
+	USAGE: Sets the position, orientation and size of the body from a model matrix made of them,
+	read straight from its columns
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	matrix4 const& a_m4ToWorld -> translation times rotation times scale
+	OUTPUT: ---
+	*/
+	void SetTransform(uint a_uBody, matrix4 const& a_m4ToWorld);
+	/*
+	USAGE: Sets the mass of the body, masses smaller than 0.01f get clamped
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	float a_fMass -> mass to set
+	OUTPUT: ---
+	*/
+	void SetMass(uint a_uBody, float a_fMass);
+	/*
+	USAGE: Gets the mass of the body
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: mass of the body
+	*/
+	float GetMass(uint a_uBody);
+	/*
+	USAGE: Sets the colliding flag of the body, colliding bodies can not fall
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	bool a_bIsColliding = true -> is the body colliding?
+	OUTPUT: ---
+	*/
+	void SetIsColliding(uint a_uBody, bool a_bIsColliding = true);
+	/*
+	USAGE: Sets if the body is integrated in the update
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	bool a_bSimulated = true -> integrate the body?
+	OUTPUT: ---
+	*/
+	void SetSimulated(uint a_uBody, bool a_bSimulated = true);
+	/*
+	USAGE: Asks if the body is integrated in the update
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: is it simulated?
+	*/
+	bool IsSimulated(uint a_uBody);
+	/*
+	USAGE: Sets if the body needs continuous collision, fast bodies that can cross others in one step
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	bool a_bContinuous = true -> sweep the body?
+	OUTPUT: ---
+	*/
+	void SetContinuous(uint a_uBody, bool a_bContinuous = true);
+	/*
+	USAGE: Asks if the body needs continuous collision
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: is it swept?
+	*/
+	bool IsContinuous(uint a_uBody);
+	/*
+	USAGE: Limits how far the body moves in the next position integration, the earliest time is kept
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	float a_fTime -> fraction of the step [0, 1] at which the body hits something
+	OUTPUT: ---
+	*/
+	void SetTimeOfImpact(uint a_uBody, float a_fTime);
+	/*
+	USAGE: Applies a force to the body
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	vector3 a_v3Force -> force to apply
+	OUTPUT: ---
+	*/
+	void ApplyForce(uint a_uBody, vector3 a_v3Force);
+	/*
+	USAGE: Integrates gravity, friction, velocity limits and the ground plane for every
+	simulated body, 8 bodies at a time when compiled with AVX. Same as calling IntegrateVelocity
+	and IntegratePosition
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Update(void);
+	/*
+	USAGE: Applies acceleration, gravity, friction and the velocity limits to every simulated body
+	ARGUMENTS: bool a_bHoldColliding = true -> stop colliding bodies from falling, turn it off when
+	the contacts are solved with impulses
+	OUTPUT: ---
+	*/
+	void IntegrateVelocity(bool a_bHoldColliding = true);
+	/*
+	USAGE: Moves every simulated body by its velocity, limited by its time of impact, and applies
+	the ground plane
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegratePosition(void);
+	/*
+	USAGE: Resolve the collision between two bodies
+	ARGUMENTS:
+	-	uint a_uBody -> handle of the body
+	-	uint a_uOther -> handle of the body it collides with
+	OUTPUT: ---
+	*/
+	void ResolveCollision(uint a_uBody, uint a_uOther);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MySolverManager(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MySolverManager(MySolverManager const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MySolverManager& operator=(MySolverManager const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MySolverManager(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Sets the slot to the default values of a body
+	ARGUMENTS: uint a_uBody -> handle of the body
+	OUTPUT: ---
+	*/
+	void ResetBody(uint a_uBody);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSOLVERMANAGER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
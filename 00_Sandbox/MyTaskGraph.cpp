@@ -0,0 +1,120 @@
+#include "MyTaskGraph.h"
+using namespace Simplex;
+//  MyTaskGraph
+void MyTaskGraph::Init(uint a_uThreadCount)
+{
+	m_uRemaining = 0;
+	m_bLaunched = false;
+	m_bExit = false;
+
+	if (a_uThreadCount == 0)
+		a_uThreadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	for (uint i = 0; i < a_uThreadCount; ++i)
+		m_ThreadList.push_back(std::thread(&MyTaskGraph::Work, this));
+}
+void MyTaskGraph::Release(void)
+{
+	Wait();
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bExit = true;
+	}
+	m_Condition.notify_all();
+	for (uint i = 0; i < m_ThreadList.size(); ++i)
+		m_ThreadList[i].join();
+	m_ThreadList.clear();
+	m_TaskList.clear();
+	m_ReadyList.clear();
+}
+//The big 3
+MyTaskGraph::MyTaskGraph(uint a_uThreadCount) { Init(a_uThreadCount); }
+MyTaskGraph::MyTaskGraph(MyTaskGraph const& other) { }
+MyTaskGraph& MyTaskGraph::operator=(MyTaskGraph const& other) { return *this; }
+MyTaskGraph::~MyTaskGraph() { Release(); }
+//Accessors
+bool MyTaskGraph::IsRunning(void) { return m_bLaunched; }
+uint MyTaskGraph::GetThreadCount(void) { return static_cast<uint>(m_ThreadList.size()); }
+//--- Methods
+uint MyTaskGraph::AddTask(std::function<void(void)> a_Function)
+{
+	MyTask task;
+	task.m_Function = a_Function;
+	m_TaskList.push_back(task);
+	return static_cast<uint>(m_TaskList.size()) - 1;
+}
+void MyTaskGraph::AddDependency(uint a_uTask, uint a_uBefore)
+{
+	uint uCount = static_cast<uint>(m_TaskList.size());
+	if (a_uTask >= uCount || a_uBefore >= uCount || a_uTask == a_uBefore)
+		return;
+	m_TaskList[a_uBefore].m_DependentList.push_back(a_uTask);
+	++m_TaskList[a_uTask].m_uWaiting;
+}
+void MyTaskGraph::Launch(void)
+{
+	if (m_bLaunched || m_TaskList.size() == 0)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_uRemaining = static_cast<uint>(m_TaskList.size());
+		for (uint i = 0; i < m_TaskList.size(); ++i)
+		{
+			if (m_TaskList[i].m_uWaiting == 0)
+				m_ReadyList.push_back(i);
+		}
+		m_bLaunched = true;
+	}
+	m_Condition.notify_all();
+}
+void MyTaskGraph::Wait(void)
+{
+	if (!m_bLaunched)
+		return;
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		while (m_uRemaining > 0)
+			m_DoneCondition.wait(lock);
+	}
+	m_TaskList.clear();
+	m_bLaunched = false;
+}
+void MyTaskGraph::Work(void)
+{
+	while (true)
+	{
+		uint uTask = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			while (!m_bExit && m_ReadyList.size() == 0)
+				m_Condition.wait(lock);
+			if (m_bExit)
+				return;
+			uTask = m_ReadyList.front();
+			m_ReadyList.pop_front();
+		}
+
+		//the list does not change while the graph runs, no lock is needed to reach the task
+		MyTask& task = m_TaskList[uTask];
+		task.m_Function();
+
+		bool bReady = false;
+		bool bDone = false;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			for (uint i = 0; i < task.m_DependentList.size(); ++i)
+			{
+				uint uDependent = task.m_DependentList[i];
+				if (--m_TaskList[uDependent].m_uWaiting == 0)
+				{
+					m_ReadyList.push_back(uDependent);
+					bReady = true;
+				}
+			}
+			bDone = --m_uRemaining == 0;
+		}
+		if (bReady)
+			m_Condition.notify_all();
+		if (bDone)
+			m_DoneCondition.notify_all();
+	}
+}
@@ -0,0 +1,133 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYTASKGRAPH_H_
+#define __MYTASKGRAPH_H_
+
+#include "Simplex\Simplex.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+namespace Simplex
+{
+
+//Task of the graph, it runs once every task it depends on is done
+struct MyTask
+{
+	std::function<void(void)> m_Function; //work of the task
+	std::vector<uint> m_DependentList; //tasks that wait for this one
+	uint m_uWaiting = 0; //tasks this one still waits for
+};
+
+//System Class
+class MyTaskGraph
+{
+	std::vector<std::thread> m_ThreadList; //workers that run the tasks
+	std::mutex m_Mutex; //guards the ready list, the counters and the exit flag
+	std::condition_variable m_Condition; //wakes the workers when a task is ready or on exit
+	std::condition_variable m_DoneCondition; //wakes Wait when the last task is done
+	std::vector<MyTask> m_TaskList; //tasks of the graph, not touched while it runs
+	std::deque<uint> m_ReadyList; //tasks with nothing left to wait for
+	uint m_uRemaining = 0; //tasks of the launched graph that are not done yet
+	bool m_bLaunched = false; //was the graph launched and not waited for?
+	bool m_bExit = false; //tells the workers to stop
+
+public:
+	/*
+	Usage: Constructor, starts the workers
+	Arguments: uint a_uThreadCount = 0 -> number of workers, 0 leaves one core for the calling thread
+	Output: class object instance
+	*/
+	MyTaskGraph(uint a_uThreadCount = 0);
+	/*
+	Usage: Destructor, waits for the launched tasks and stops the workers
+	Arguments: ---
+	Output: ---
+	*/
+	~MyTaskGraph(void);
+	/*
+	USAGE: Adds a task, only while the graph is not running
+	ARGUMENTS: std::function<void(void)> a_Function -> work of the task, a bound member function
+	OUTPUT: index of the task
+	*/
+	uint AddTask(std::function<void(void)> a_Function);
+	/*
+	USAGE: Makes a task wait for another, only while the graph is not running
+	ARGUMENTS:
+	-	uint a_uTask -> index of the task that waits
+	-	uint a_uBefore -> index of the task that has to be done first
+	OUTPUT: ---
+	*/
+	void AddDependency(uint a_uTask, uint a_uBefore);
+	/*
+	USAGE: Hands the tasks to the workers and returns right away, the tasks with nothing to wait for
+	start first
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Launch(void);
+	/*
+	USAGE: Blocks until every launched task is done and empties the graph for the next frame; returns
+	right away if nothing was launched
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Wait(void);
+	/*
+	USAGE: Asks if the graph was launched and not waited for yet
+	ARGUMENTS: ---
+	OUTPUT: is it running?
+	*/
+	bool IsRunning(void);
+	/*
+	USAGE: Gets the number of workers
+	ARGUMENTS: ---
+	OUTPUT: thread count
+	*/
+	uint GetThreadCount(void);
+private:
+	/*
+	Usage: copy constructor, the workers can not be copied
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyTaskGraph(MyTaskGraph const& other);
+	/*
+	Usage: copy assignment operator, the workers can not be copied
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyTaskGraph& operator=(MyTaskGraph const& other);
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: uint a_uThreadCount -> number of workers
+	Output: ---
+	*/
+	void Init(uint a_uThreadCount);
+	/*
+	Usage: loop of each worker, runs ready tasks until told to exit
+	Arguments: ---
+	Output: ---
+	*/
+	void Work(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYTASKGRAPH_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -0,0 +1,368 @@
+#include "MyTextureCooker.h"
+using namespace Simplex;
+//  MyTextureCooker
+MyTextureCooker* MyTextureCooker::m_pInstance = nullptr;
+void MyTextureCooker::Init(void)
+{
+	m_uCookCount = 0;
+	m_uReuseCount = 0;
+}
+void MyTextureCooker::Release(void)
+{
+	m_uCookCount = 0;
+	m_uReuseCount = 0;
+}
+MyTextureCooker* MyTextureCooker::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyTextureCooker();
+	}
+	return m_pInstance;
+}
+void MyTextureCooker::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyTextureCooker::MyTextureCooker() { Init(); }
+MyTextureCooker::MyTextureCooker(MyTextureCooker const& a_pOther) { }
+MyTextureCooker& MyTextureCooker::operator=(MyTextureCooker const& a_pOther) { return *this; }
+MyTextureCooker::~MyTextureCooker() { Release(); };
+//Accessors
+uint MyTextureCooker::GetCookCount(void) { return m_uCookCount; }
+uint MyTextureCooker::GetReuseCount(void) { return m_uReuseCount; }
+//--- Methods
+bool MyTextureCooker::Load(String a_sSource, MyMappedFile& a_File, MyCookedTexture& a_Texture)
+{
+	unsigned long long uSize = 0;
+	unsigned long long uTime = 0;
+	if (!MyMappedFile::GetStamp(a_sSource, uSize, uTime))
+		return false;
+
+	String sCooked = a_sSource + COOKED_TEXTURE_EXTENSION;
+	if (a_File.Open(sCooked) && IsValid(a_File, uSize, uTime, a_Texture))
+	{
+		++m_uReuseCount;
+		return true;
+	}
+
+	//missing or stale, cook it and use what was just written
+	a_File.Close();
+	if (!Cook(a_sSource, sCooked))
+		return false;
+	if (a_File.Open(sCooked) && IsValid(a_File, uSize, uTime, a_Texture))
+		return true;
+	a_File.Close();
+	return false;
+}
+bool MyTextureCooker::IsValid(MyMappedFile& a_File, unsigned long long a_uSize, unsigned long long a_uTime, MyCookedTexture& a_Texture)
+{
+	size_t uFileSize = a_File.GetSize();
+	if (uFileSize < sizeof(MyDDSHeader))
+		return false;
+
+	MyDDSHeader const* pHeader = reinterpret_cast<MyDDSHeader const*>(a_File.GetData());
+	MyDDSHeader header;
+	if (pHeader->m_uMagic != header.m_uMagic || pHeader->m_uSize != header.m_uSize)
+		return false;
+	uint const* pStamp = pHeader->m_uReserved1;
+	if (pStamp[0] != COOKED_TEXTURE_MAGIC || pStamp[1] != COOKED_TEXTURE_VERSION)
+		return false;
+	if (pStamp[2] != static_cast<uint>(a_uSize) || pStamp[3] != static_cast<uint>(a_uSize >> 32) ||
+		pStamp[4] != static_cast<uint>(a_uTime) || pStamp[5] != static_cast<uint>(a_uTime >> 32))
+		return false;
+
+	if (pHeader->m_PixelFormat.m_uFourCC == 0x31545844) //"DXT1"
+		a_Texture.m_uFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	else if (pHeader->m_PixelFormat.m_uFourCC == 0x35545844) //"DXT5"
+		a_Texture.m_uFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	else
+		return false;
+	if (pHeader->m_uWidth == 0 || pHeader->m_uHeight == 0 || pHeader->m_uMipMapCount == 0 || pHeader->m_uMipMapCount > 32)
+		return false;
+
+	//every level has to be inside the file
+	a_Texture.m_uWidth = pHeader->m_uWidth;
+	a_Texture.m_uHeight = pHeader->m_uHeight;
+	a_Texture.m_uLevels = pHeader->m_uMipMapCount;
+	a_Texture.m_uOffset = sizeof(MyDDSHeader);
+	a_Texture.m_uSize = 0;
+	uint uWidth = a_Texture.m_uWidth;
+	uint uHeight = a_Texture.m_uHeight;
+	for (uint i = 0; i < a_Texture.m_uLevels; ++i)
+	{
+		a_Texture.m_uSize += GetLevelSize(a_Texture.m_uFormat, uWidth, uHeight);
+		uWidth = std::max(uWidth / 2, 1u);
+		uHeight = std::max(uHeight / 2, 1u);
+	}
+	return a_Texture.m_uOffset + a_Texture.m_uSize <= uFileSize;
+}
+uint MyTextureCooker::GetLevelSize(GLenum a_uFormat, uint a_uWidth, uint a_uHeight)
+{
+	uint uBlockSize = a_uFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8 : 16;
+	return std::max((a_uWidth + 3) / 4, 1u) * std::max((a_uHeight + 3) / 4, 1u) * uBlockSize;
+}
+bool MyTextureCooker::ReadImage(String a_sFileName, uint& a_uWidth, uint& a_uHeight, std::vector<BYTE>& a_Texels)
+{
+	FREE_IMAGE_FORMAT format = FreeImage_GetFileType(a_sFileName.c_str(), 0);
+	if (format == FIF_UNKNOWN)
+		format = FreeImage_GetFIFFromFilename(a_sFileName.c_str());
+	if (format == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(format))
+		return false;
+
+	FIBITMAP* pImage = FreeImage_Load(format, a_sFileName.c_str());
+	if (pImage == nullptr)
+		return false;
+	FIBITMAP* pConverted = FreeImage_ConvertTo32Bits(pImage);
+	FreeImage_Unload(pImage);
+	if (pConverted == nullptr)
+		return false;
+
+	//the texels stay BGRA, OpenGL swizzles them on upload instead of a loop here
+	bool bRead = false;
+	uint uWidth = FreeImage_GetWidth(pConverted);
+	uint uHeight = FreeImage_GetHeight(pConverted);
+	uint uPitch = FreeImage_GetPitch(pConverted);
+	BYTE* pBits = FreeImage_GetBits(pConverted);
+	if (pBits != nullptr && uWidth > 0 && uHeight > 0)
+	{
+		uint uRow = uWidth * 4;
+		a_Texels.resize(static_cast<size_t>(uRow) * uHeight);
+		for (uint i = 0; i < uHeight; ++i)
+		{
+			memcpy(&a_Texels[static_cast<size_t>(i) * uRow], pBits + static_cast<size_t>(i) * uPitch, uRow);
+		}
+		a_uWidth = uWidth;
+		a_uHeight = uHeight;
+		bRead = true;
+	}
+	FreeImage_Unload(pConverted);
+	return bRead;
+}
+bool MyTextureCooker::Cook(String a_sSource, String a_sCooked)
+{
+	MyDDSHeader header;
+	unsigned long long uSize = 0;
+	unsigned long long uTime = 0;
+	if (!MyMappedFile::GetStamp(a_sSource, uSize, uTime))
+		return false;
+
+	uint uWidth = 0;
+	uint uHeight = 0;
+	std::vector<BYTE> lLevel;
+	if (!ReadImage(a_sSource, uWidth, uHeight, lLevel))
+		return false;
+
+	//a single texel that is not opaque needs the alpha block
+	bool bAlpha = false;
+	for (size_t i = 3; i < lLevel.size() && !bAlpha; i += 4)
+		bAlpha = lLevel[i] != 255;
+	GLenum uFormat = bAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+
+	header.m_uWidth = uWidth;
+	header.m_uHeight = uHeight;
+	header.m_uLinearSize = GetLevelSize(uFormat, uWidth, uHeight);
+	header.m_PixelFormat.m_uFourCC = bAlpha ? 0x35545844 : 0x31545844; //"DXT5" or "DXT1"
+	header.m_uReserved1[0] = COOKED_TEXTURE_MAGIC;
+	header.m_uReserved1[1] = COOKED_TEXTURE_VERSION;
+	header.m_uReserved1[2] = static_cast<uint>(uSize);
+	header.m_uReserved1[3] = static_cast<uint>(uSize >> 32);
+	header.m_uReserved1[4] = static_cast<uint>(uTime);
+	header.m_uReserved1[5] = static_cast<uint>(uTime >> 32);
+
+	//every level down to 1x1, each one made from the one before
+	std::vector<BYTE> lBlock;
+	std::vector<BYTE> lNext;
+	while (true)
+	{
+		EncodeLevel(lLevel, uWidth, uHeight, bAlpha, lBlock);
+		++header.m_uMipMapCount;
+		if (uWidth == 1 && uHeight == 1)
+			break;
+		Downsample(lLevel, uWidth, uHeight, lNext);
+		lLevel.swap(lNext);
+		uWidth = std::max(uWidth / 2, 1u);
+		uHeight = std::max(uHeight / 2, 1u);
+	}
+
+	std::ofstream file(a_sCooked, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+	file.write(reinterpret_cast<char const*>(&header), sizeof(MyDDSHeader));
+	file.write(reinterpret_cast<char const*>(lBlock.data()), lBlock.size());
+	if (!file.good())
+		return false;
+	++m_uCookCount;
+	return true;
+}
+void MyTextureCooker::Downsample(std::vector<BYTE> const& a_Source, uint a_uWidth, uint a_uHeight, std::vector<BYTE>& a_Output)
+{
+	uint uWidth = std::max(a_uWidth / 2, 1u);
+	uint uHeight = std::max(a_uHeight / 2, 1u);
+	a_Output.resize(static_cast<size_t>(uWidth) * uHeight * 4);
+	for (uint y = 0; y < uHeight; ++y)
+	{
+		uint uRow0 = std::min(y * 2, a_uHeight - 1);
+		uint uRow1 = std::min(y * 2 + 1, a_uHeight - 1);
+		for (uint x = 0; x < uWidth; ++x)
+		{
+			uint uColumn0 = std::min(x * 2, a_uWidth - 1);
+			uint uColumn1 = std::min(x * 2 + 1, a_uWidth - 1);
+			BYTE const* pTexel[4] = {
+				&a_Source[(static_cast<size_t>(uRow0) * a_uWidth + uColumn0) * 4],
+				&a_Source[(static_cast<size_t>(uRow0) * a_uWidth + uColumn1) * 4],
+				&a_Source[(static_cast<size_t>(uRow1) * a_uWidth + uColumn0) * 4],
+				&a_Source[(static_cast<size_t>(uRow1) * a_uWidth + uColumn1) * 4] };
+			BYTE* pOutput = &a_Output[(static_cast<size_t>(y) * uWidth + x) * 4];
+			for (uint c = 0; c < 4; ++c)
+				pOutput[c] = static_cast<BYTE>((pTexel[0][c] + pTexel[1][c] + pTexel[2][c] + pTexel[3][c] + 2) / 4);
+		}
+	}
+}
+void MyTextureCooker::EncodeLevel(std::vector<BYTE> const& a_Texels, uint a_uWidth, uint a_uHeight, bool a_bAlpha, std::vector<BYTE>& a_Output)
+{
+	BYTE lBlock[64];
+	for (uint y = 0; y < a_uHeight; y += 4)
+	{
+		for (uint x = 0; x < a_uWidth; x += 4)
+		{
+			for (uint i = 0; i < 16; ++i)
+			{
+				uint uRow = std::min(y + i / 4, a_uHeight - 1);
+				uint uColumn = std::min(x + i % 4, a_uWidth - 1);
+				memcpy(&lBlock[i * 4], &a_Texels[(static_cast<size_t>(uRow) * a_uWidth + uColumn) * 4], 4);
+			}
+			size_t uStart = a_Output.size();
+			a_Output.resize(uStart + (a_bAlpha ? 16 : 8));
+			if (a_bAlpha)
+			{
+				EncodeAlpha(lBlock, &a_Output[uStart]);
+				uStart += 8;
+			}
+			EncodeColor(lBlock, &a_Output[uStart]);
+		}
+	}
+}
+void MyTextureCooker::EncodeColor(BYTE const* a_pBlock, BYTE* a_pOutput)
+{
+	//bounding box of the block, moved in by a 16th so a few outliers do not spread the endpoints
+	int nMin[3] = { 255, 255, 255 };
+	int nMax[3] = { 0, 0, 0 };
+	for (uint i = 0; i < 16; ++i)
+	{
+		for (uint c = 0; c < 3; ++c)
+		{
+			nMin[c] = std::min(nMin[c], static_cast<int>(a_pBlock[i * 4 + c]));
+			nMax[c] = std::max(nMax[c], static_cast<int>(a_pBlock[i * 4 + c]));
+		}
+	}
+	for (uint c = 0; c < 3; ++c)
+	{
+		int nInset = (nMax[c] - nMin[c]) >> 4;
+		nMin[c] += nInset;
+		nMax[c] -= nInset;
+	}
+
+	//565 endpoints, the components are BGR so red goes in the high bits
+	uint uColor0 = ((nMax[2] * 31 + 127) / 255) << 11 | ((nMax[1] * 63 + 127) / 255) << 5 | ((nMax[0] * 31 + 127) / 255);
+	uint uColor1 = ((nMin[2] * 31 + 127) / 255) << 11 | ((nMin[1] * 63 + 127) / 255) << 5 | ((nMin[0] * 31 + 127) / 255);
+	//the 4 color mode needs the first endpoint to be the bigger one
+	if (uColor0 < uColor1)
+		std::swap(uColor0, uColor1);
+
+	//palette out of the quantized endpoints, the way the hardware decodes them
+	int nPalette[4][3];
+	uint uEndpoint[2] = { uColor0, uColor1 };
+	for (uint i = 0; i < 2; ++i)
+	{
+		uint uRed = (uEndpoint[i] >> 11) & 31;
+		uint uGreen = (uEndpoint[i] >> 5) & 63;
+		uint uBlue = uEndpoint[i] & 31;
+		nPalette[i][2] = (uRed << 3) | (uRed >> 2);
+		nPalette[i][1] = (uGreen << 2) | (uGreen >> 4);
+		nPalette[i][0] = (uBlue << 3) | (uBlue >> 2);
+	}
+	for (uint c = 0; c < 3; ++c)
+	{
+		nPalette[2][c] = (2 * nPalette[0][c] + nPalette[1][c]) / 3;
+		nPalette[3][c] = (nPalette[0][c] + 2 * nPalette[1][c]) / 3;
+	}
+
+	uint uIndices = 0;
+	if (uColor0 != uColor1)
+	{
+		for (uint i = 0; i < 16; ++i)
+		{
+			uint uBest = 0;
+			int nBestDistance = -1;
+			for (uint j = 0; j < 4; ++j)
+			{
+				int nDistance = 0;
+				for (uint c = 0; c < 3; ++c)
+				{
+					int nDelta = static_cast<int>(a_pBlock[i * 4 + c]) - nPalette[j][c];
+					nDistance += nDelta * nDelta;
+				}
+				if (nBestDistance < 0 || nDistance < nBestDistance)
+				{
+					nBestDistance = nDistance;
+					uBest = j;
+				}
+			}
+			uIndices |= uBest << (i * 2);
+		}
+	}
+
+	a_pOutput[0] = static_cast<BYTE>(uColor0);
+	a_pOutput[1] = static_cast<BYTE>(uColor0 >> 8);
+	a_pOutput[2] = static_cast<BYTE>(uColor1);
+	a_pOutput[3] = static_cast<BYTE>(uColor1 >> 8);
+	for (uint i = 0; i < 4; ++i)
+		a_pOutput[4 + i] = static_cast<BYTE>(uIndices >> (i * 8));
+}
+void MyTextureCooker::EncodeAlpha(BYTE const* a_pBlock, BYTE* a_pOutput)
+{
+	int nMin = 255;
+	int nMax = 0;
+	for (uint i = 0; i < 16; ++i)
+	{
+		nMin = std::min(nMin, static_cast<int>(a_pBlock[i * 4 + 3]));
+		nMax = std::max(nMax, static_cast<int>(a_pBlock[i * 4 + 3]));
+	}
+
+	//the 8 value mode needs the first endpoint to be the bigger one, equal endpoints use index 0
+	int nPalette[8] = { nMax, nMin, 0, 0, 0, 0, 0, 0 };
+	for (int i = 1; i < 7; ++i)
+		nPalette[i + 1] = ((7 - i) * nMax + i * nMin) / 7;
+
+	unsigned long long uIndices = 0;
+	if (nMax != nMin)
+	{
+		for (uint i = 0; i < 16; ++i)
+		{
+			int nAlpha = a_pBlock[i * 4 + 3];
+			unsigned long long uBest = 0;
+			int nBestDistance = -1;
+			for (uint j = 0; j < 8; ++j)
+			{
+				int nDistance = std::abs(nAlpha - nPalette[j]);
+				if (nBestDistance < 0 || nDistance < nBestDistance)
+				{
+					nBestDistance = nDistance;
+					uBest = j;
+				}
+			}
+			uIndices |= uBest << (i * 3);
+		}
+	}
+
+	a_pOutput[0] = static_cast<BYTE>(nMax);
+	a_pOutput[1] = static_cast<BYTE>(nMin);
+	for (uint i = 0; i < 6; ++i)
+		a_pOutput[2 + i] = static_cast<BYTE>(uIndices >> (i * 8));
+}
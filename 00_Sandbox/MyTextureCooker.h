@@ -0,0 +1,231 @@
+/*----------------------------------------------
+Programmer: Quinn Hopwood (qph6412@rit.edu)
+Date: 2017/12
+----------------------------------------------*/
+#ifndef __MYTEXTURECOOKER_H_
+#define __MYTEXTURECOOKER_H_
+
+#include "MyMappedFile.h"
+#include "FreeImage\FreeImage.h"
+#include <atomic>
+
+#define COOKED_TEXTURE_MAGIC 0x584C5053 //"SPLX" in the first reserved word of a cooked DDS
+#define COOKED_TEXTURE_VERSION 1 //changes every time the encoding changes, older files are cooked again
+#define COOKED_TEXTURE_EXTENSION ".dds" //appended to the name of the source, written next to it
+
+namespace Simplex
+{
+
+//DDS pixel format, only the FourCC compressed formats are written
+struct MyDDSPixelFormat
+{
+	uint m_uSize = 32; //size of the structure
+	uint m_uFlags = 0x4; //DDPF_FOURCC
+	uint m_uFourCC = 0; //"DXT1" or "DXT5"
+	uint m_uRGBBitCount = 0; //unused by compressed formats
+	uint m_uRBitMask = 0; //unused by compressed formats
+	uint m_uGBitMask = 0; //unused by compressed formats
+	uint m_uBBitMask = 0; //unused by compressed formats
+	uint m_uABitMask = 0; //unused by compressed formats
+};
+
+//Start of a DDS file, the magic included. The cooker keeps the stamp of the source in the reserved
+//words: magic, version, size low and high, time low and high. Rows go from the bottom up, the way
+//OpenGL takes them, unlike DDS files made by other tools
+struct MyDDSHeader
+{
+	uint m_uMagic = 0x20534444; //"DDS "
+	uint m_uSize = 124; //size of the header without the magic
+	uint m_uFlags = 0xA1007; //CAPS, HEIGHT, WIDTH, PIXELFORMAT, MIPMAPCOUNT and LINEARSIZE
+	uint m_uHeight = 0; //height of the first level
+	uint m_uWidth = 0; //width of the first level
+	uint m_uLinearSize = 0; //bytes of the first level
+	uint m_uDepth = 0; //unused by 2D textures
+	uint m_uMipMapCount = 0; //number of levels
+	uint m_uReserved1[11] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }; //stamp of the source
+	MyDDSPixelFormat m_PixelFormat; //block format
+	uint m_uCaps = 0x401008; //TEXTURE, MIPMAP and COMPLEX
+	uint m_uCaps2 = 0; //unused by 2D textures
+	uint m_uCaps3 = 0; //unused
+	uint m_uCaps4 = 0; //unused
+	uint m_uReserved2 = 0; //unused
+};
+
+//Levels of a cooked texture in a mapped file
+struct MyCookedTexture
+{
+	GLenum m_uFormat = 0; //compressed OpenGL format of the blocks
+	uint m_uWidth = 0; //width of the first level
+	uint m_uHeight = 0; //height of the first level
+	uint m_uLevels = 0; //number of levels, down to 1x1
+	size_t m_uOffset = 0; //first byte of the first level in the file
+	size_t m_uSize = 0; //bytes of every level together
+};
+
+//System Class
+class MyTextureCooker
+{
+	std::atomic<uint> m_uCookCount; //textures cooked since the start
+	std::atomic<uint> m_uReuseCount; //textures loaded from an up to date cooked file
+
+	static MyTextureCooker* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyTextureCooker* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Maps the cooked file of an image, cooking it first if the file is missing or older than the
+	image. Does not touch OpenGL, so it can run on any thread
+	ARGUMENTS:
+	-	String a_sSource -> path of the image
+	-	MyMappedFile& a_File -> gets the cooked file, it has to stay open while the levels are used
+	-	MyCookedTexture& a_Texture -> filled with the levels in the file
+	OUTPUT: is the cooked file mapped? if not the image has to be used as it is
+	*/
+	bool Load(String a_sSource, MyMappedFile& a_File, MyCookedTexture& a_Texture);
+	/*
+	USAGE: Makes the mip chain of an image, encodes it in blocks and writes it as DDS; BC3 is used if
+	any texel is not opaque and BC1 otherwise
+	ARGUMENTS:
+	-	String a_sSource -> path of the image
+	-	String a_sCooked -> path of the cooked file to write
+	OUTPUT: was the file written?
+	*/
+	bool Cook(String a_sSource, String a_sCooked);
+	/*
+	USAGE: Reads an image with FreeImage into 32 bit texels
+	ARGUMENTS:
+	-	String a_sFileName -> path of the image
+	-	uint& a_uWidth -> width of the image
+	-	uint& a_uHeight -> height of the image
+	-	std::vector<BYTE>& a_Texels -> BGRA rows from the bottom up, the way OpenGL takes them
+	OUTPUT: was the image read?
+	*/
+	static bool ReadImage(String a_sFileName, uint& a_uWidth, uint& a_uHeight, std::vector<BYTE>& a_Texels);
+	/*
+	USAGE: Gets the bytes of a level in blocks of 4x4 texels
+	ARGUMENTS:
+	-	GLenum a_uFormat -> compressed OpenGL format
+	-	uint a_uWidth -> width of the level
+	-	uint a_uHeight -> height of the level
+	OUTPUT: size of the level
+	*/
+	static uint GetLevelSize(GLenum a_uFormat, uint a_uWidth, uint a_uHeight);
+	/*
+	USAGE: Gets the number of textures cooked since the start
+	ARGUMENTS: ---
+	OUTPUT: cook count
+	*/
+	uint GetCookCount(void);
+	/*
+	USAGE: Gets the number of textures that were loaded from an up to date cooked file
+	ARGUMENTS: ---
+	OUTPUT: reuse count
+	*/
+	uint GetReuseCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyTextureCooker(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyTextureCooker(MyTextureCooker const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyTextureCooker& operator=(MyTextureCooker const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyTextureCooker(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Checks that a mapped file is a cooked texture of the current version, made from the stamped
+	image, and that every level is inside the file
+	ARGUMENTS:
+	-	MyMappedFile& a_File -> mapped cooked file
+	-	unsigned long long a_uSize -> size of the image
+	-	unsigned long long a_uTime -> last write time of the image
+	-	MyCookedTexture& a_Texture -> filled with the levels in the file
+	OUTPUT: can it be used?
+	*/
+	bool IsValid(MyMappedFile& a_File, unsigned long long a_uSize, unsigned long long a_uTime, MyCookedTexture& a_Texture);
+	/*
+	USAGE: Halves a level with a box filter, odd edges repeat their last texel
+	ARGUMENTS:
+	-	std::vector<BYTE> const& a_Source -> BGRA texels of the level
+	-	uint a_uWidth -> width of the level
+	-	uint a_uHeight -> height of the level
+	-	std::vector<BYTE>& a_Output -> BGRA texels of the next level
+	OUTPUT: ---
+	*/
+	void Downsample(std::vector<BYTE> const& a_Source, uint a_uWidth, uint a_uHeight, std::vector<BYTE>& a_Output);
+	/*
+	USAGE: Encodes a level in blocks of 4x4 texels, the texels past the edges repeat the last ones
+	ARGUMENTS:
+	-	std::vector<BYTE> const& a_Texels -> BGRA texels of the level
+	-	uint a_uWidth -> width of the level
+	-	uint a_uHeight -> height of the level
+	-	bool a_bAlpha -> BC3 if true, BC1 otherwise
+	-	std::vector<BYTE>& a_Output -> the blocks are appended here
+	OUTPUT: ---
+	*/
+	void EncodeLevel(std::vector<BYTE> const& a_Texels, uint a_uWidth, uint a_uHeight, bool a_bAlpha, std::vector<BYTE>& a_Output);
+	/*
+	USAGE: Encodes the color of a block as two 565 endpoints on the inset bounding box and a 2 bit
+	index per texel, always in the 4 color mode
+	ARGUMENTS:
+	-	BYTE const* a_pBlock -> 16 BGRA texels
+	-	BYTE* a_pOutput -> 8 bytes
+	OUTPUT: ---
+	*/
+	void EncodeColor(BYTE const* a_pBlock, BYTE* a_pOutput);
+	/*
+	USAGE: Encodes the alpha of a block as two endpoints and a 3 bit index per texel, in the 8 value mode
+	ARGUMENTS:
+	-	BYTE const* a_pBlock -> 16 BGRA texels
+	-	BYTE* a_pOutput -> 8 bytes
+	OUTPUT: ---
+	*/
+	void EncodeAlpha(BYTE const* a_pBlock, BYTE* a_pOutput);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYTEXTURECOOKER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/